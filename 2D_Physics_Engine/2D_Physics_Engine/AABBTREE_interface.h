@@ -0,0 +1,155 @@
+#ifndef __AABBTREE_INTERFACE_H__
+#define __AABBTREE_INTERFACE_H__
+
+/**
+ * @brief Default margin added around every body when its fat bounding box is computed.
+ */
+#define AABBTREE_DEFAULT_MARGIN         2.0f
+
+/**
+ * @brief Number of steps of motion by which fat boxes are stretched along the body velocity.
+ */
+#define AABBTREE_DISPLACEMENT_STEPS     4.0f
+
+/**
+ * @struct AabbTreeNode
+ * @brief Node of the dynamic bounding volume tree.
+ */
+typedef struct
+{
+    Aabb box;           /**< Fat box for leaves, union of the children for internal nodes. */
+    int parent;         /**< Parent node, or the next free node while the node is unused. */
+    int child1;         /**< First child, -1 for leaves. */
+    int child2;         /**< Second child, -1 for leaves. */
+    int height;         /**< 0 for leaves, -1 for unused nodes. */
+    int slot;           /**< World handle slot of the body stored in a leaf. */
+} AabbTreeNode;
+
+/**
+ * @struct AabbTree
+ * @brief Incrementally maintained dynamic AABB tree over the bodies of a World.
+ *
+ * Each body is stored in a leaf whose box is enlarged ("fat") by a margin and by the body's
+ * expected motion. A body is only removed and reinserted when its tight box leaves its fat box,
+ * so resting and static bodies cost nothing per update. Insertion picks the sibling with the
+ * smallest perimeter growth and the tree is kept balanced with AVL-style rotations.
+ *
+ * Leaves are keyed by World handle slots, so removing other bodies does not disturb them.
+ * aabbTreeUpdateParallel() runs the pair queries of chunks of bodies on a JobSystem and concatenates
+ * the results in chunk order, so it reports the same pairs in the same order as aabbTreeUpdate().
+ *
+ * The World and Job headers must be included before this header.
+ */
+typedef struct
+{
+    AabbTreeNode* nodes;        /**< Node pool. */
+    int nodeCapacity;           /**< Number of nodes in the pool. */
+    int freeList;               /**< First unused node (-1 when the pool is full). */
+    int root;                   /**< Root node (-1 for an empty tree). */
+
+    int* leafOfSlot;            /**< Leaf storing each World handle slot (-1 when absent). */
+    unsigned int* generationOfSlot; /**< Handle generation of the body stored for each slot. */
+    int slotCapacity;           /**< Number of slots the two arrays above can hold. */
+    unsigned int trackedVersion; /**< World structure version seen by the last update. */
+    int tracking;               /**< Non-zero once the tree has been synchronized with a world. */
+
+    float margin;               /**< Margin added around every fat box. */
+
+    BodyPair* pairs;            /**< Candidate pairs produced by the last update. */
+    int pairCapacity;           /**< Number of pairs the buffer can hold. */
+    PairList* chunks;           /**< Pairs found by each chunk of a parallel update. */
+    int chunkCapacity;          /**< Number of chunk lists allocated. */
+
+    int pairCount;              /**< Counter: candidate pairs produced by the last update. */
+    int reinsertCount;          /**< Counter: leaves reinserted by the last update. */
+    int rotationCount;          /**< Counter: balancing rotations done by the last update. */
+    double buildTimeMs;         /**< Counter: time spent in the last update, in milliseconds. */
+} AabbTree;
+
+
+/**
+ * @brief Initializes an empty tree.
+ * @param tree Pointer to the AabbTree struct to initialize.
+ * @param margin Margin added around every fat box (AABBTREE_DEFAULT_MARGIN is a good start).
+ */
+void aabbTreeInit(AabbTree* tree, float margin);
+
+/**
+ * @brief Releases all storage owned by a tree.
+ * @param tree Pointer to the AabbTree struct to release.
+ */
+void aabbTreeFree(AabbTree* tree);
+
+/**
+ * @brief Brings the tree up to date with the world and collects the candidate pairs.
+ *
+ * Bodies added to or removed from the world since the last update get their leaves inserted or
+ * removed. Bodies whose tight box left their fat box are reinserted. Afterwards tree->pairs holds
+ * tree->pairCount pairs whose tight boxes overlap; pairs of two bodies that are static or asleep
+ * are never reported.
+ *
+ * @param tree Pointer to the AabbTree struct.
+ * @param world Pointer to the World whose bodies are tracked.
+ * @param deltaTime The time step used to predict the motion covered by the fat boxes.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int aabbTreeUpdate(AabbTree* tree, const World* world, float deltaTime);
+
+/**
+ * @brief Same as aabbTreeUpdate(), with the pair queries spread over the threads of a job system.
+ *
+ * Inserting, removing and reinserting leaves stays on the calling thread.
+ *
+ * @param tree Pointer to the AabbTree struct.
+ * @param world Pointer to the World whose bodies are tracked.
+ * @param deltaTime The time step used to predict the motion covered by the fat boxes.
+ * @param jobs Pointer to the JobSystem running the queries, or NULL to behave like aabbTreeUpdate().
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int aabbTreeUpdateParallel(AabbTree* tree, const World* world, float deltaTime, JobSystem* jobs);
+
+/**
+ * @brief Finds the bodies whose shape contains a point.
+ * @param tree Pointer to the AabbTree struct.
+ * @param world Pointer to the World whose bodies are tracked.
+ * @param x The x coordinate of the point.
+ * @param y The y coordinate of the point.
+ * @param bodies Receives the dense indices of the bodies found.
+ * @param maxBodies Capacity of the bodies array.
+ * @return Number of bodies written to the array, or -1 if the traversal stack of a tree taller than
+ *         the built-in stack could not be allocated.
+ */
+int aabbTreeQueryPoint(const AabbTree* tree, const World* world, float x, float y, int* bodies, int maxBodies);
+
+/**
+ * @brief Finds the bodies whose fat box overlaps a box.
+ *
+ * Fat boxes cover the bodies as of the last update, so this finds every body that was inside the
+ * box then, and some more around it.
+ *
+ * @param tree Pointer to the AabbTree struct.
+ * @param world Pointer to the World whose bodies are tracked.
+ * @param box The box to search.
+ * @param bodies Receives the dense indices of the bodies found.
+ * @param maxBodies Capacity of the bodies array.
+ * @return Number of bodies found, which may exceed maxBodies (only the first maxBodies are written),
+ *         or -1 if the traversal stack of a tree taller than the built-in stack could not be allocated.
+ */
+int aabbTreeQueryBox(const AabbTree* tree, const World* world, const Aabb* box, int* bodies, int maxBodies);
+
+/**
+ * @brief Casts a ray segment and finds the closest body it hits.
+ * @param tree Pointer to the AabbTree struct.
+ * @param world Pointer to the World whose bodies are tracked.
+ * @param startX The x coordinate of the segment start.
+ * @param startY The y coordinate of the segment start.
+ * @param endX The x coordinate of the segment end.
+ * @param endY The y coordinate of the segment end.
+ * @param fraction Receives the hit position as a fraction of the segment (0 at the start, 1 at the end).
+ * @return The dense index of the closest body hit, or -1 if the segment hits nothing or the traversal
+ *         stack of a tree taller than the built-in stack could not be allocated.
+ */
+int aabbTreeRayCast(const AabbTree* tree, const World* world, float startX, float startY, float endX, float endY, float* fraction);
+
+
+#endif /**< __AABBTREE_INTERFACE_H__ */
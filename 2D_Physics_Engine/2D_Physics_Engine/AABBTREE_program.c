@@ -0,0 +1,917 @@
+#include <stdlib.h>
+#include <math.h>
+#include "WORLD_interface.h"
+#include "TIMER_interface.h"
+#include "JOB_interface.h"
+#include "AABBTREE_interface.h"
+
+#define AABBTREE_NULL_NODE      (-1)
+#define AABBTREE_STACK_SIZE     256     /**< Traversal stack kept on the C stack; taller trees use the heap. */
+#define AABBTREE_CHUNKS_PER_WORKER 4    /**< Query chunks per worker thread in a parallel update. */
+
+static float aabbPerimeter(const Aabb* box)
+{
+    return 2.0f * ((box->maxX - box->minX) + (box->maxY - box->minY));
+}
+
+static Aabb aabbCombine(const Aabb* a, const Aabb* b)
+{
+    Aabb combined;
+    combined.minX = a->minX < b->minX ? a->minX : b->minX;
+    combined.minY = a->minY < b->minY ? a->minY : b->minY;
+    combined.maxX = a->maxX > b->maxX ? a->maxX : b->maxX;
+    combined.maxY = a->maxY > b->maxY ? a->maxY : b->maxY;
+    return combined;
+}
+
+static int aabbContains(const Aabb* outer, const Aabb* inner)
+{
+    return outer->minX <= inner->minX && outer->minY <= inner->minY
+        && outer->maxX >= inner->maxX && outer->maxY >= inner->maxY;
+}
+
+static int aabbOverlaps(const Aabb* a, const Aabb* b)
+{
+    return a->minX <= b->maxX && b->minX <= a->maxX && a->minY <= b->maxY && b->minY <= a->maxY;
+}
+
+void aabbTreeInit(AabbTree* tree, float margin)
+{
+    tree->nodes = NULL;
+    tree->nodeCapacity = 0;
+    tree->freeList = AABBTREE_NULL_NODE;
+    tree->root = AABBTREE_NULL_NODE;
+    tree->leafOfSlot = NULL;
+    tree->generationOfSlot = NULL;
+    tree->slotCapacity = 0;
+    tree->trackedVersion = 0;
+    tree->tracking = 0;
+    tree->margin = margin;
+    tree->pairs = NULL;
+    tree->pairCapacity = 0;
+    tree->chunks = NULL;
+    tree->chunkCapacity = 0;
+    tree->pairCount = 0;
+    tree->reinsertCount = 0;
+    tree->rotationCount = 0;
+    tree->buildTimeMs = 0.0;
+}
+
+void aabbTreeFree(AabbTree* tree)
+{
+    free(tree->nodes);
+    free(tree->leafOfSlot);
+    free(tree->generationOfSlot);
+    free(tree->pairs);
+    for (int i = 0; i < tree->chunkCapacity; i++)
+    {
+        free(tree->chunks[i].pairs);
+    }
+    free(tree->chunks);
+    aabbTreeInit(tree, tree->margin);
+}
+
+static int aabbTreeAllocateNode(AabbTree* tree)
+{
+    if (tree->freeList == AABBTREE_NULL_NODE)
+    {
+        int capacity = tree->nodeCapacity > 0 ? tree->nodeCapacity * 2 : 64;
+        AabbTreeNode* nodes = realloc(tree->nodes, sizeof(AabbTreeNode) * (size_t)capacity);
+        if (nodes == NULL)
+        {
+            return AABBTREE_NULL_NODE;
+        }
+
+        // Chain the new nodes into the free list
+        for (int i = tree->nodeCapacity; i < capacity; i++)
+        {
+            nodes[i].parent = i + 1 < capacity ? i + 1 : AABBTREE_NULL_NODE;
+            nodes[i].height = -1;
+        }
+        tree->nodes = nodes;
+        tree->freeList = tree->nodeCapacity;
+        tree->nodeCapacity = capacity;
+    }
+
+    int node = tree->freeList;
+    tree->freeList = tree->nodes[node].parent;
+    tree->nodes[node].parent = AABBTREE_NULL_NODE;
+    tree->nodes[node].child1 = AABBTREE_NULL_NODE;
+    tree->nodes[node].child2 = AABBTREE_NULL_NODE;
+    tree->nodes[node].height = 0;
+    tree->nodes[node].slot = -1;
+    return node;
+}
+
+static void aabbTreeFreeNode(AabbTree* tree, int node)
+{
+    tree->nodes[node].parent = tree->freeList;
+    tree->nodes[node].height = -1;
+    tree->freeList = node;
+}
+
+static void aabbTreeFixParentLink(AabbTree* tree, int parent, int oldChild, int newChild)
+{
+    if (parent == AABBTREE_NULL_NODE)
+    {
+        tree->root = newChild;
+    }
+    else if (tree->nodes[parent].child1 == oldChild)
+    {
+        tree->nodes[parent].child1 = newChild;
+    }
+    else
+    {
+        tree->nodes[parent].child2 = newChild;
+    }
+}
+
+static int aabbTreeRotateUp(AabbTree* tree, int iA, int iUp, int iStay)
+{
+    // iUp becomes the parent of iA; of its two children the taller one stays under it
+    AabbTreeNode* nodes = tree->nodes;
+    int iF = nodes[iUp].child1;
+    int iG = nodes[iUp].child2;
+
+    nodes[iUp].child1 = iA;
+    nodes[iUp].parent = nodes[iA].parent;
+    nodes[iA].parent = iUp;
+    aabbTreeFixParentLink(tree, nodes[iUp].parent, iA, iUp);
+
+    int iTall = nodes[iF].height > nodes[iG].height ? iF : iG;
+    int iShort = iTall == iF ? iG : iF;
+    nodes[iUp].child2 = iTall;
+    if (nodes[iA].child1 == iUp)
+    {
+        nodes[iA].child1 = iShort;
+    }
+    else
+    {
+        nodes[iA].child2 = iShort;
+    }
+    nodes[iShort].parent = iA;
+
+    nodes[iA].box = aabbCombine(&nodes[iStay].box, &nodes[iShort].box);
+    nodes[iA].height = 1 + (nodes[iStay].height > nodes[iShort].height ? nodes[iStay].height : nodes[iShort].height);
+    nodes[iUp].box = aabbCombine(&nodes[iA].box, &nodes[iTall].box);
+    nodes[iUp].height = 1 + (nodes[iA].height > nodes[iTall].height ? nodes[iA].height : nodes[iTall].height);
+
+    tree->rotationCount++;
+    return iUp;
+}
+
+static int aabbTreeBalance(AabbTree* tree, int iA)
+{
+    AabbTreeNode* a = &tree->nodes[iA];
+    if (a->child1 == AABBTREE_NULL_NODE || a->height < 2)
+    {
+        return iA;
+    }
+
+    int iB = a->child1;
+    int iC = a->child2;
+    int balance = tree->nodes[iC].height - tree->nodes[iB].height;
+
+    if (balance > 1)
+    {
+        return aabbTreeRotateUp(tree, iA, iC, iB);
+    }
+    if (balance < -1)
+    {
+        return aabbTreeRotateUp(tree, iA, iB, iC);
+    }
+    return iA;
+}
+
+static void aabbTreeRefitFrom(AabbTree* tree, int index)
+{
+    // Walk to the root, rebalancing and refreshing boxes and heights on the way
+    while (index != AABBTREE_NULL_NODE)
+    {
+        index = aabbTreeBalance(tree, index);
+
+        AabbTreeNode* node = &tree->nodes[index];
+        const AabbTreeNode* child1 = &tree->nodes[node->child1];
+        const AabbTreeNode* child2 = &tree->nodes[node->child2];
+        node->height = 1 + (child1->height > child2->height ? child1->height : child2->height);
+        node->box = aabbCombine(&child1->box, &child2->box);
+
+        index = node->parent;
+    }
+}
+
+// Returns 0 and leaves the tree unchanged if the new parent node could not be allocated
+static int aabbTreeInsertLeaf(AabbTree* tree, int leaf)
+{
+    if (tree->root == AABBTREE_NULL_NODE)
+    {
+        tree->root = leaf;
+        tree->nodes[leaf].parent = AABBTREE_NULL_NODE;
+        return 1;
+    }
+
+    // Descend towards the sibling whose enclosing box grows the least
+    Aabb leafBox = tree->nodes[leaf].box;
+    int index = tree->root;
+    while (tree->nodes[index].child1 != AABBTREE_NULL_NODE)
+    {
+        const AabbTreeNode* node = &tree->nodes[index];
+        float area = aabbPerimeter(&node->box);
+        Aabb combined = aabbCombine(&node->box, &leafBox);
+        float combinedArea = aabbPerimeter(&combined);
+
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCost[2];
+        int children[2] = { node->child1, node->child2 };
+        for (int c = 0; c < 2; c++)
+        {
+            const AabbTreeNode* child = &tree->nodes[children[c]];
+            Aabb grown = aabbCombine(&leafBox, &child->box);
+            childCost[c] = aabbPerimeter(&grown) + inheritanceCost;
+            if (child->child1 != AABBTREE_NULL_NODE)
+            {
+                childCost[c] -= aabbPerimeter(&child->box);
+            }
+        }
+
+        if (cost < childCost[0] && cost < childCost[1])
+        {
+            break;
+        }
+        index = childCost[0] < childCost[1] ? children[0] : children[1];
+    }
+
+    // Replace the sibling by a new parent holding both the sibling and the leaf
+    int sibling = index;
+    int oldParent = tree->nodes[sibling].parent;
+    int newParent = aabbTreeAllocateNode(tree);
+    if (newParent == AABBTREE_NULL_NODE)
+    {
+        return 0;
+    }
+    AabbTreeNode* parent = &tree->nodes[newParent];
+    parent->parent = oldParent;
+    parent->box = aabbCombine(&leafBox, &tree->nodes[sibling].box);
+    parent->height = tree->nodes[sibling].height + 1;
+    parent->child1 = sibling;
+    parent->child2 = leaf;
+    aabbTreeFixParentLink(tree, oldParent, sibling, newParent);
+    tree->nodes[sibling].parent = newParent;
+    tree->nodes[leaf].parent = newParent;
+
+    aabbTreeRefitFrom(tree, tree->nodes[leaf].parent);
+    return 1;
+}
+
+static void aabbTreeRemoveLeaf(AabbTree* tree, int leaf)
+{
+    if (leaf == tree->root)
+    {
+        tree->root = AABBTREE_NULL_NODE;
+        return;
+    }
+
+    int parent = tree->nodes[leaf].parent;
+    int grandParent = tree->nodes[parent].parent;
+    int sibling = tree->nodes[parent].child1 == leaf ? tree->nodes[parent].child2 : tree->nodes[parent].child1;
+
+    // The sibling takes the place of the removed parent
+    aabbTreeFixParentLink(tree, grandParent, parent, sibling);
+    tree->nodes[sibling].parent = grandParent;
+    aabbTreeFreeNode(tree, parent);
+
+    aabbTreeRefitFrom(tree, grandParent);
+}
+
+static void aabbTreeFatBox(const AabbTree* tree, const World* world, int body, float deltaTime, Aabb* fat)
+{
+    worldGetBounds(world, body, fat);
+    fat->minX -= tree->margin;
+    fat->minY -= tree->margin;
+    fat->maxX += tree->margin;
+    fat->maxY += tree->margin;
+
+    // Stretch the box along the predicted motion so that fast bodies are not reinserted every step
+    float displacementX = world->velX[body] * deltaTime * AABBTREE_DISPLACEMENT_STEPS;
+    float displacementY = world->velY[body] * deltaTime * AABBTREE_DISPLACEMENT_STEPS;
+    if (displacementX < 0.0f) fat->minX += displacementX; else fat->maxX += displacementX;
+    if (displacementY < 0.0f) fat->minY += displacementY; else fat->maxY += displacementY;
+}
+
+static int aabbTreeReserveSlots(AabbTree* tree, int slotCount)
+{
+    if (slotCount <= tree->slotCapacity)
+    {
+        return 1;
+    }
+
+    int capacity = tree->slotCapacity > 0 ? tree->slotCapacity : 64;
+    while (capacity < slotCount)
+    {
+        capacity *= 2;
+    }
+
+    int* leafOfSlot = realloc(tree->leafOfSlot, sizeof(int) * (size_t)capacity);
+    if (leafOfSlot != NULL) tree->leafOfSlot = leafOfSlot;
+    unsigned int* generationOfSlot = realloc(tree->generationOfSlot, sizeof(unsigned int) * (size_t)capacity);
+    if (generationOfSlot != NULL) tree->generationOfSlot = generationOfSlot;
+    if (leafOfSlot == NULL || generationOfSlot == NULL)
+    {
+        return 0;
+    }
+
+    for (int slot = tree->slotCapacity; slot < capacity; slot++)
+    {
+        tree->leafOfSlot[slot] = AABBTREE_NULL_NODE;
+    }
+    tree->slotCapacity = capacity;
+    return 1;
+}
+
+static int aabbTreeSynchronize(AabbTree* tree, const World* world, float deltaTime)
+{
+    if (!aabbTreeReserveSlots(tree, world->slotCount))
+    {
+        return 0;
+    }
+
+    // Drop the leaves of bodies that were removed from the world
+    for (int slot = 0; slot < tree->slotCapacity; slot++)
+    {
+        int leaf = tree->leafOfSlot[slot];
+        BodyHandle handle = { (unsigned int)slot, tree->generationOfSlot[slot] };
+        if (leaf != AABBTREE_NULL_NODE && worldGetIndex(world, handle) < 0)
+        {
+            aabbTreeRemoveLeaf(tree, leaf);
+            aabbTreeFreeNode(tree, leaf);
+            tree->leafOfSlot[slot] = AABBTREE_NULL_NODE;
+        }
+    }
+
+    // Insert the bodies that were added since the last synchronization
+    for (int body = 0; body < world->count; body++)
+    {
+        unsigned int slot = world->bodySlot[body];
+        if (tree->leafOfSlot[slot] != AABBTREE_NULL_NODE)
+        {
+            continue;
+        }
+
+        int leaf = aabbTreeAllocateNode(tree);
+        if (leaf == AABBTREE_NULL_NODE)
+        {
+            return 0;
+        }
+        tree->nodes[leaf].slot = (int)slot;
+        aabbTreeFatBox(tree, world, body, deltaTime, &tree->nodes[leaf].box);
+        if (!aabbTreeInsertLeaf(tree, leaf))
+        {
+            aabbTreeFreeNode(tree, leaf);
+            return 0;
+        }
+        tree->leafOfSlot[slot] = leaf;
+        tree->generationOfSlot[slot] = world->slotGeneration[slot];
+    }
+
+    tree->trackedVersion = world->structureVersion;
+    tree->tracking = 1;
+    return 1;
+}
+
+// A depth-first walk holds at most one pending sibling per level plus two children, the root height plus one
+// nodes; returns the local stack when that fits in it, a heap stack otherwise, or NULL if it cannot be allocated
+static int* aabbTreeBeginTraversal(const AabbTree* tree, int* localStack)
+{
+    if (tree->root == AABBTREE_NULL_NODE || tree->nodes[tree->root].height + 1 <= AABBTREE_STACK_SIZE)
+    {
+        return localStack;
+    }
+    return malloc(sizeof(int) * (size_t)(tree->nodes[tree->root].height + 1));
+}
+
+static void aabbTreeEndTraversal(int* stack, int* localStack)
+{
+    if (stack != localStack)
+    {
+        free(stack);
+    }
+}
+
+// Queries the tree with every awake body of [begin, end) and collects the overlapping pairs
+static int aabbTreeCollectRange(const AabbTree* tree, const World* world, int begin, int end, PairList* list)
+{
+    int localStack[AABBTREE_STACK_SIZE];
+    int* stack = aabbTreeBeginTraversal(tree, localStack);
+    if (stack == NULL)
+    {
+        return 0;
+    }
+
+    for (int body = begin; body < end; body++)
+    {
+        // Only awake bodies start queries, so static and sleeping bodies never pair with each other
+        if (!world->awake[body] || tree->root == AABBTREE_NULL_NODE)
+        {
+            continue;
+        }
+
+        Aabb bounds;
+        worldGetBounds(world, body, &bounds);
+
+        int top = 0;
+        stack[top++] = tree->root;
+        while (top > 0)
+        {
+            const AabbTreeNode* node = &tree->nodes[stack[--top]];
+            if (!aabbOverlaps(&node->box, &bounds))
+            {
+                continue;
+            }
+
+            if (node->child1 != AABBTREE_NULL_NODE)
+            {
+                stack[top++] = node->child1;
+                stack[top++] = node->child2;
+                continue;
+            }
+
+            // A pair of awake bodies is reported by its lower index only
+            int other = world->slotIndex[node->slot];
+            if (other == body || (world->awake[other] && other < body))
+            {
+                continue;
+            }
+
+            Aabb otherBounds;
+            worldGetBounds(world, other, &otherBounds);
+            if (aabbOverlaps(&bounds, &otherBounds) && !pairListPush(list, body, other))
+            {
+                aabbTreeEndTraversal(stack, localStack);
+                return 0;
+            }
+        }
+    }
+    aabbTreeEndTraversal(stack, localStack);
+    return 1;
+}
+
+static int aabbTreeCollectPairs(AabbTree* tree, const World* world)
+{
+    PairList list = { tree->pairs, 0, tree->pairCapacity };
+    int success = aabbTreeCollectRange(tree, world, 0, world->count, &list);
+
+    tree->pairs = list.pairs;
+    tree->pairCapacity = list.capacity;
+    tree->pairCount = list.count;
+    return success;
+}
+
+static int aabbTreeReserveChunks(AabbTree* tree, int chunkCount)
+{
+    if (chunkCount <= tree->chunkCapacity)
+    {
+        return 1;
+    }
+
+    PairList* chunks = realloc(tree->chunks, sizeof(PairList) * (size_t)chunkCount);
+    if (chunks == NULL)
+    {
+        return 0;
+    }
+    for (int i = tree->chunkCapacity; i < chunkCount; i++)
+    {
+        chunks[i].pairs = NULL;
+        chunks[i].count = 0;
+        chunks[i].capacity = 0;
+    }
+    tree->chunks = chunks;
+    tree->chunkCapacity = chunkCount;
+    return 1;
+}
+
+typedef struct
+{
+    const AabbTree* tree;
+    const World* world;
+    int chunkCount;
+} AabbTreeCollectJob;
+
+static void aabbTreeCollectChunks(void* data, int begin, int end)
+{
+    const AabbTreeCollectJob* job = data;
+    int bodyCount = job->world->count;
+
+    for (int chunk = begin; chunk < end; chunk++)
+    {
+        PairList* list = &job->tree->chunks[chunk];
+        int first = (int)((long long)bodyCount * chunk / job->chunkCount);
+        int last = (int)((long long)bodyCount * (chunk + 1) / job->chunkCount);
+
+        list->count = 0;
+        if (!aabbTreeCollectRange(job->tree, job->world, first, last, list))
+        {
+            list->count = -1; // Lets the merge report the failure
+        }
+    }
+}
+
+static int aabbTreeCollectPairsParallel(AabbTree* tree, const World* world, JobSystem* jobs)
+{
+    int chunkCount = jobs->workerCount * AABBTREE_CHUNKS_PER_WORKER;
+    if (!aabbTreeReserveChunks(tree, chunkCount))
+    {
+        return 0;
+    }
+
+    // The tree is only read while the queries run
+    AabbTreeCollectJob job = { tree, world, chunkCount };
+    jobSystemParallelFor(jobs, aabbTreeCollectChunks, &job, chunkCount, 1);
+
+    PairList list = { tree->pairs, 0, tree->pairCapacity };
+    int success = 1;
+    for (int chunk = 0; success && chunk < chunkCount; chunk++)
+    {
+        success = tree->chunks[chunk].count >= 0 && pairListAppend(&list, &tree->chunks[chunk]);
+    }
+
+    tree->pairs = list.pairs;
+    tree->pairCapacity = list.capacity;
+    tree->pairCount = list.count;
+    return success;
+}
+
+// Inserts and removes leaves for added and removed bodies, then reinserts the bodies that escaped their fat box
+static int aabbTreeRefresh(AabbTree* tree, const World* world, float deltaTime)
+{
+    tree->pairCount = 0;
+    tree->reinsertCount = 0;
+    tree->rotationCount = 0;
+
+    if (!tree->tracking || tree->trackedVersion != world->structureVersion)
+    {
+        if (!aabbTreeSynchronize(tree, world, deltaTime))
+        {
+            return 0;
+        }
+    }
+
+    for (int body = 0; body < world->count; body++)
+    {
+        // Sleeping bodies do not move
+        if (!world->awake[body] && world->invMass[body] > 0.0f)
+        {
+            continue;
+        }
+
+        int leaf = tree->leafOfSlot[world->bodySlot[body]];
+        Aabb bounds;
+        worldGetBounds(world, body, &bounds);
+        if (aabbContains(&tree->nodes[leaf].box, &bounds))
+        {
+            continue;
+        }
+
+        aabbTreeRemoveLeaf(tree, leaf);
+        aabbTreeFatBox(tree, world, body, deltaTime, &tree->nodes[leaf].box);
+        if (!aabbTreeInsertLeaf(tree, leaf))
+        {
+            // Drop the leaf so that the next update inserts the body again
+            aabbTreeFreeNode(tree, leaf);
+            tree->leafOfSlot[world->bodySlot[body]] = AABBTREE_NULL_NODE;
+            tree->tracking = 0;
+            return 0;
+        }
+        tree->reinsertCount++;
+    }
+    return 1;
+}
+
+int aabbTreeUpdate(AabbTree* tree, const World* world, float deltaTime)
+{
+    double start = timerGetMilliseconds();
+
+    int success = aabbTreeRefresh(tree, world, deltaTime) && aabbTreeCollectPairs(tree, world);
+    tree->buildTimeMs = timerGetMilliseconds() - start;
+    return success;
+}
+
+int aabbTreeUpdateParallel(AabbTree* tree, const World* world, float deltaTime, JobSystem* jobs)
+{
+    if (jobs == NULL || jobs->workerCount <= 1)
+    {
+        return aabbTreeUpdate(tree, world, deltaTime);
+    }
+
+    double start = timerGetMilliseconds();
+
+    int success = aabbTreeRefresh(tree, world, deltaTime) && aabbTreeCollectPairsParallel(tree, world, jobs);
+    tree->buildTimeMs = timerGetMilliseconds() - start;
+    return success;
+}
+
+static int aabbTreeShapeContainsPoint(const World* world, int body, float x, float y)
+{
+    float dx = x - world->posX[body];
+    float dy = y - world->posY[body];
+    if (world->type[body] == BODY_CIRCLE)
+    {
+        return dx * dx + dy * dy <= world->radius[body] * world->radius[body];
+    }
+
+    // Rotate the point into the frame of the rectangle or polygon
+    float cosine = cosf(world->angle[body]);
+    float sine = sinf(world->angle[body]);
+    float localX = cosine * dx + sine * dy;
+    float localY = cosine * dy - sine * dx;
+    if (world->type[body] == BODY_RECTANGLE)
+    {
+        return fabsf(localX) <= world->extentX[body] && fabsf(localY) <= world->extentY[body];
+    }
+
+    // Inside a counter-clockwise polygon means on the left of every edge
+    int start = world->vertexStart[body];
+    int count = world->vertexCount[body];
+    for (int i = 0; i < count; i++)
+    {
+        int j = (i + 1) % count;
+        float edgeX = world->vertexX[start + j] - world->vertexX[start + i];
+        float edgeY = world->vertexY[start + j] - world->vertexY[start + i];
+        if (edgeX * (localY - world->vertexY[start + i]) - edgeY * (localX - world->vertexX[start + i]) < 0.0f)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int aabbTreeQueryPoint(const AabbTree* tree, const World* world, float x, float y, int* bodies, int maxBodies)
+{
+    int localStack[AABBTREE_STACK_SIZE];
+    int* stack = aabbTreeBeginTraversal(tree, localStack);
+    int top = 0;
+    int found = 0;
+
+    if (stack == NULL)
+    {
+        return -1;
+    }
+    if (tree->root != AABBTREE_NULL_NODE)
+    {
+        stack[top++] = tree->root;
+    }
+    while (top > 0 && found < maxBodies)
+    {
+        const AabbTreeNode* node = &tree->nodes[stack[--top]];
+        if (x < node->box.minX || x > node->box.maxX || y < node->box.minY || y > node->box.maxY)
+        {
+            continue;
+        }
+
+        if (node->child1 != AABBTREE_NULL_NODE)
+        {
+            stack[top++] = node->child1;
+            stack[top++] = node->child2;
+        }
+        else if (aabbTreeShapeContainsPoint(world, world->slotIndex[node->slot], x, y))
+        {
+            bodies[found++] = world->slotIndex[node->slot];
+        }
+    }
+    aabbTreeEndTraversal(stack, localStack);
+    return found;
+}
+
+int aabbTreeQueryBox(const AabbTree* tree, const World* world, const Aabb* box, int* bodies, int maxBodies)
+{
+    int localStack[AABBTREE_STACK_SIZE];
+    int* stack = aabbTreeBeginTraversal(tree, localStack);
+    int top = 0;
+    int found = 0;
+
+    if (stack == NULL)
+    {
+        return -1;
+    }
+    if (tree->root != AABBTREE_NULL_NODE)
+    {
+        stack[top++] = tree->root;
+    }
+    while (top > 0)
+    {
+        const AabbTreeNode* node = &tree->nodes[stack[--top]];
+        if (!aabbOverlaps(&node->box, box))
+        {
+            continue;
+        }
+
+        if (node->child1 != AABBTREE_NULL_NODE)
+        {
+            stack[top++] = node->child1;
+            stack[top++] = node->child2;
+        }
+        else
+        {
+            // Keep counting past a full array so that the caller knows how large it must be
+            if (found < maxBodies)
+            {
+                bodies[found] = world->slotIndex[node->slot];
+            }
+            found++;
+        }
+    }
+    aabbTreeEndTraversal(stack, localStack);
+    return found;
+}
+
+static int aabbRaySlab(const Aabb* box, float startX, float startY, float dirX, float dirY, float maxFraction, float* entry)
+{
+    // Clip the segment against the x and y slabs of the box
+    float tMin = 0.0f;
+    float tMax = maxFraction;
+    float start[2] = { startX, startY };
+    float dir[2] = { dirX, dirY };
+    float lower[2] = { box->minX, box->minY };
+    float upper[2] = { box->maxX, box->maxY };
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (fabsf(dir[axis]) < 1e-12f)
+        {
+            if (start[axis] < lower[axis] || start[axis] > upper[axis])
+            {
+                return 0;
+            }
+            continue;
+        }
+
+        float inverse = 1.0f / dir[axis];
+        float t1 = (lower[axis] - start[axis]) * inverse;
+        float t2 = (upper[axis] - start[axis]) * inverse;
+        if (t1 > t2)
+        {
+            float swap = t1;
+            t1 = t2;
+            t2 = swap;
+        }
+        tMin = t1 > tMin ? t1 : tMin;
+        tMax = t2 < tMax ? t2 : tMax;
+        if (tMin > tMax)
+        {
+            return 0;
+        }
+    }
+
+    *entry = tMin;
+    return 1;
+}
+
+static int aabbTreeRayPolygon(const World* world, int body, float startX, float startY, float dirX, float dirY, float maxFraction, float* fraction)
+{
+    int start = world->vertexStart[body];
+    int count = world->vertexCount[body];
+    float tMin = 0.0f;
+    float tMax = maxFraction;
+
+    // Clip the segment against the half-plane of every edge (outward normal on the right of the edge)
+    for (int i = 0; i < count; i++)
+    {
+        int j = (i + 1) % count;
+        float normalX = world->vertexY[start + j] - world->vertexY[start + i];
+        float normalY = world->vertexX[start + i] - world->vertexX[start + j];
+        float numerator = normalX * (world->vertexX[start + i] - startX) + normalY * (world->vertexY[start + i] - startY);
+        float denominator = normalX * dirX + normalY * dirY;
+
+        if (fabsf(denominator) < 1e-12f)
+        {
+            if (numerator < 0.0f)
+            {
+                return 0;
+            }
+            continue;
+        }
+
+        float t = numerator / denominator;
+        if (denominator < 0.0f)
+        {
+            tMin = t > tMin ? t : tMin;
+        }
+        else
+        {
+            tMax = t < tMax ? t : tMax;
+        }
+        if (tMin > tMax)
+        {
+            return 0;
+        }
+    }
+
+    *fraction = tMin;
+    return 1;
+}
+
+static int aabbTreeRayShape(const World* world, int body, float startX, float startY, float dirX, float dirY, float maxFraction, float* fraction)
+{
+    if (world->type[body] == BODY_POLYGON)
+    {
+        // Same clipping in the frame of the polygon
+        float cosine = cosf(world->angle[body]);
+        float sine = sinf(world->angle[body]);
+        float dx = startX - world->posX[body];
+        float dy = startY - world->posY[body];
+        return aabbTreeRayPolygon(world, body, cosine * dx + sine * dy, cosine * dy - sine * dx,
+            cosine * dirX + sine * dirY, cosine * dirY - sine * dirX, maxFraction, fraction);
+    }
+    if (world->type[body] == BODY_RECTANGLE)
+    {
+        // Clip the segment in the frame of the rectangle, where the rectangle is an axis-aligned box
+        float cosine = cosf(world->angle[body]);
+        float sine = sinf(world->angle[body]);
+        float dx = startX - world->posX[body];
+        float dy = startY - world->posY[body];
+        Aabb box = { -world->extentX[body], -world->extentY[body], world->extentX[body], world->extentY[body] };
+        return aabbRaySlab(&box, cosine * dx + sine * dy, cosine * dy - sine * dx,
+            cosine * dirX + sine * dirY, cosine * dirY - sine * dirX, maxFraction, fraction);
+    }
+
+    // Solve |start + t * dir - center|^2 = radius^2 for the first root
+    float mx = startX - world->posX[body];
+    float my = startY - world->posY[body];
+    float radius = world->radius[body];
+    float c = mx * mx + my * my - radius * radius;
+    if (c <= 0.0f)
+    {
+        *fraction = 0.0f; // The segment starts inside the circle
+        return 1;
+    }
+
+    float a = dirX * dirX + dirY * dirY;
+    float b = mx * dirX + my * dirY;
+    float discriminant = b * b - a * c;
+    if (a < 1e-12f || discriminant < 0.0f)
+    {
+        return 0;
+    }
+
+    float t = (-b - sqrtf(discriminant)) / a;
+    if (t < 0.0f || t > maxFraction)
+    {
+        return 0;
+    }
+    *fraction = t;
+    return 1;
+}
+
+int aabbTreeRayCast(const AabbTree* tree, const World* world, float startX, float startY, float endX, float endY, float* fraction)
+{
+    int localStack[AABBTREE_STACK_SIZE];
+    int* stack = aabbTreeBeginTraversal(tree, localStack);
+    int top = 0;
+    int closest = -1;
+    float closestFraction = 1.0f;
+    float dirX = endX - startX;
+    float dirY = endY - startY;
+
+    if (stack == NULL)
+    {
+        return -1;
+    }
+    if (tree->root != AABBTREE_NULL_NODE)
+    {
+        stack[top++] = tree->root;
+    }
+    while (top > 0)
+    {
+        const AabbTreeNode* node = &tree->nodes[stack[--top]];
+
+        // Nodes entered beyond the closest hit so far cannot contain a closer one
+        float entry;
+        if (!aabbRaySlab(&node->box, startX, startY, dirX, dirY, closestFraction, &entry))
+        {
+            continue;
+        }
+
+        if (node->child1 != AABBTREE_NULL_NODE)
+        {
+            stack[top++] = node->child1;
+            stack[top++] = node->child2;
+            continue;
+        }
+
+        int body = world->slotIndex[node->slot];
+        float hit;
+        if (aabbTreeRayShape(world, body, startX, startY, dirX, dirY, closestFraction, &hit))
+        {
+            closest = body;
+            closestFraction = hit;
+        }
+    }
+    aabbTreeEndTraversal(stack, localStack);
+
+    if (closest >= 0)
+    {
+        *fraction = closestFraction;
+    }
+    return closest;
+}
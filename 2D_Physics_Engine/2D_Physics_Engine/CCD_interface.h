@@ -0,0 +1,73 @@
+#ifndef __CCD_INTERFACE_H__
+#define __CCD_INTERFACE_H__
+
+/**
+ * @brief Default number of impacts resolved per bullet in one step.
+ */
+#define CCD_DEFAULT_MAX_SUBSTEPS        4
+
+/**
+ * @struct Ccd
+ * @brief Continuous collision detection for the bodies flagged as bullets.
+ *
+ * Discrete collision only sees where bodies are at the end of a step, so a body moving farther than
+ * the thickness of another body in one step can pass through it. After integration each awake
+ * bullet is swept along its motion of the step against the other bodies (moving too). The bullet
+ * is moved to the first impact, bounces off, and continues for the rest of the step, up to
+ * maxSubSteps impacts. Bullets are not swept against each other.
+ *
+ * With an AabbTree the bodies a bullet may hit are found by querying the tree with the box the
+ * bullet sweeps, so a pass costs O(bullets * log n) per impact; without one every bullet is swept
+ * against every body. The box is grown by the largest motion of any other body in the step, and the
+ * tree margin absorbs the solver's position corrections.
+ *
+ * The time of impact is exact for two circles only. Any other pair is swept as two axis-aligned
+ * boxes built from the rotated bounds (halfWidth, halfHeight), which contain the shapes: a rotated
+ * rectangle or a polygon is found no later than its true impact, but the bullet may bounce off the
+ * empty corner of the box, with the normal of a box face rather than of the shape.
+ *
+ * The World, Job and AabbTree headers must be included before this header.
+ */
+typedef struct
+{
+    int maxSubSteps;            /**< Largest number of impacts resolved per bullet and step. */
+    float restitution;          /**< Coefficient of restitution of bullet impacts. */
+
+    int* candidates;            /**< Bodies the last bullet was swept against (every body without a tree). */
+    int candidateCapacity;      /**< Number of bodies the candidate buffer can hold. */
+
+    int bulletCount;            /**< Counter: bullets swept by the last pass. */
+    int impactCount;            /**< Counter: impacts found by the last pass. */
+    double sweepTimeMs;         /**< Counter: time spent in the last pass, in milliseconds. */
+} Ccd;
+
+
+/**
+ * @brief Initializes continuous collision detection with the default settings.
+ * @param ccd Pointer to the Ccd struct to initialize.
+ */
+void ccdInit(Ccd* ccd);
+
+/**
+ * @brief Releases all storage owned by continuous collision detection.
+ * @param ccd Pointer to the Ccd struct to release.
+ */
+void ccdFree(Ccd* ccd);
+
+/**
+ * @brief Moves every awake bullet back to its first impact of the step and resolves it.
+ *
+ * Call it right after the positions were integrated with the same time step; the start of the
+ * step is recovered from the velocities. Bodies hit by a bullet are woken and receive the
+ * opposite impulse.
+ *
+ * @param ccd Pointer to the Ccd struct.
+ * @param world Pointer to the World holding the bodies.
+ * @param tree Pointer to an AabbTree updated with the world at the start of the step, or NULL to
+ *             sweep the bullets against every body.
+ * @param deltaTime The time step the positions were just integrated with.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int ccdSweepBullets(Ccd* ccd, World* world, const AabbTree* tree, float deltaTime);
+
+#endif /**< __CCD_INTERFACE_H__ */
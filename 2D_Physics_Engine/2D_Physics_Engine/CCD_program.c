@@ -0,0 +1,299 @@
+#include <stdlib.h>
+#include <math.h>
+#include "WORLD_interface.h"
+#include "JOB_interface.h"
+#include "AABBTREE_interface.h"
+#include "CCD_interface.h"
+#include "TIMER_interface.h"
+
+void ccdInit(Ccd* ccd)
+{
+    ccd->maxSubSteps = CCD_DEFAULT_MAX_SUBSTEPS;
+    ccd->restitution = 0.5f;
+    ccd->candidates = NULL;
+    ccd->candidateCapacity = 0;
+    ccd->bulletCount = 0;
+    ccd->impactCount = 0;
+    ccd->sweepTimeMs = 0.0;
+}
+
+void ccdFree(Ccd* ccd)
+{
+    free(ccd->candidates);
+    ccd->candidates = NULL;
+    ccd->candidateCapacity = 0;
+}
+
+// Fraction of the motion at which two circles touch, or -1 when they do not. The other circle sits at
+// (deltaX, deltaY) from the bullet and moves by (moveX, moveY) relative to it; circles that already
+// overlap or move apart are left to the discrete solver.
+static float ccdCircleTimeOfImpact(float deltaX, float deltaY, float moveX, float moveY, float radius, float* normalX, float* normalY)
+{
+    float a = moveX * moveX + moveY * moveY;
+    float b = deltaX * moveX + deltaY * moveY;
+    float c = deltaX * deltaX + deltaY * deltaY - radius * radius;
+    if (c <= 0.0f || b >= 0.0f)
+    {
+        return -1.0f;
+    }
+
+    // Smaller root of a*s^2 + 2*b*s + c = 0
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f)
+    {
+        return -1.0f;
+    }
+    float fraction = (-b - sqrtf(discriminant)) / a;
+    if (fraction > 1.0f)
+    {
+        return -1.0f;
+    }
+
+    *normalX = (deltaX + moveX * fraction) / radius;
+    *normalY = (deltaY + moveY * fraction) / radius;
+    return fraction;
+}
+
+// Same as ccdCircleTimeOfImpact for two boxes, whose summed half extents are extentX and extentY
+static float ccdBoxTimeOfImpact(float deltaX, float deltaY, float moveX, float moveY, float extentX, float extentY, float* normalX, float* normalY)
+{
+    float entryX = -INFINITY, exitX = INFINITY;
+    float entryY = -INFINITY, exitY = INFINITY;
+
+    // Interval of the motion during which the boxes overlap along each axis
+    if (moveX != 0.0f)
+    {
+        float first = (-extentX - deltaX) / moveX;
+        float second = (extentX - deltaX) / moveX;
+        entryX = fminf(first, second);
+        exitX = fmaxf(first, second);
+    }
+    else if (fabsf(deltaX) > extentX)
+    {
+        return -1.0f;
+    }
+    if (moveY != 0.0f)
+    {
+        float first = (-extentY - deltaY) / moveY;
+        float second = (extentY - deltaY) / moveY;
+        entryY = fminf(first, second);
+        exitY = fmaxf(first, second);
+    }
+    else if (fabsf(deltaY) > extentY)
+    {
+        return -1.0f;
+    }
+
+    float entry = fmaxf(entryX, entryY);
+    float exit = fminf(exitX, exitY);
+    if (entry > exit || entry <= 0.0f || entry > 1.0f)
+    {
+        return -1.0f;
+    }
+
+    // The normal is the axis that started overlapping last
+    *normalX = 0.0f;
+    *normalY = 0.0f;
+    if (entryX > entryY)
+    {
+        *normalX = deltaX + moveX * entry > 0.0f ? 1.0f : -1.0f;
+    }
+    else
+    {
+        *normalY = deltaY + moveY * entry > 0.0f ? 1.0f : -1.0f;
+    }
+    return entry;
+}
+
+static int ccdReserveCandidates(Ccd* ccd, int count)
+{
+    if (count <= ccd->candidateCapacity)
+    {
+        return 1;
+    }
+
+    int capacity = ccd->candidateCapacity > 0 ? ccd->candidateCapacity : 64;
+    while (capacity < count)
+    {
+        capacity *= 2;
+    }
+    int* candidates = realloc(ccd->candidates, sizeof(int) * (size_t)capacity);
+    if (candidates == NULL)
+    {
+        return 0;
+    }
+    ccd->candidates = candidates;
+    ccd->candidateCapacity = capacity;
+    return 1;
+}
+
+// Collects the bodies whose fat box overlaps the box into ccd->candidates; returns their number, or -1
+static int ccdQueryTree(Ccd* ccd, const World* world, const AabbTree* tree, const Aabb* box)
+{
+    int found = aabbTreeQueryBox(tree, world, box, ccd->candidates, ccd->candidateCapacity);
+    if (found > ccd->candidateCapacity)
+    {
+        if (!ccdReserveCandidates(ccd, found))
+        {
+            return -1;
+        }
+        found = aabbTreeQueryBox(tree, world, box, ccd->candidates, ccd->candidateCapacity);
+    }
+    return found;
+}
+
+int ccdSweepBullets(Ccd* ccd, World* world, const AabbTree* tree, float deltaTime)
+{
+    double start = timerGetMilliseconds();
+    float* posX = world->posX;
+    float* posY = world->posY;
+    float* velX = world->velX;
+    float* velY = world->velY;
+
+    ccd->bulletCount = 0;
+    ccd->impactCount = 0;
+
+    // The fat boxes of the tree hold the bodies as they were before integration, so the swept box is
+    // grown by the farthest any other body moved since
+    float reachX = 0.0f;
+    float reachY = 0.0f;
+    for (int body = 0; body < world->count; body++)
+    {
+        if (world->bullet[body])
+        {
+            ccd->bulletCount += world->awake[body];
+            continue;
+        }
+        reachX = fmaxf(reachX, fabsf(velX[body]) * deltaTime);
+        reachY = fmaxf(reachY, fabsf(velY[body]) * deltaTime);
+    }
+    if (ccd->bulletCount == 0)
+    {
+        ccd->sweepTimeMs = timerGetMilliseconds() - start;
+        return 1;
+    }
+
+    // Without a tree every body is a candidate of every bullet
+    int candidateCount = world->count;
+    if (tree == NULL)
+    {
+        if (!ccdReserveCandidates(ccd, world->count))
+        {
+            return 0;
+        }
+        for (int body = 0; body < world->count; body++)
+        {
+            ccd->candidates[body] = body;
+        }
+    }
+
+    for (int bullet = 0; bullet < world->count; bullet++)
+    {
+        if (!world->bullet[bullet] || !world->awake[bullet])
+        {
+            continue;
+        }
+
+        // Integration moved every body by velocity * deltaTime, so this is where the bullet started
+        float time = 0.0f;
+        float x = posX[bullet] - velX[bullet] * deltaTime;
+        float y = posY[bullet] - velY[bullet] * deltaTime;
+
+        for (int subStep = 0; subStep < ccd->maxSubSteps; subStep++)
+        {
+            float remaining = (1.0f - time) * deltaTime;
+            float first = 2.0f;
+            int hit = -1;
+            float normalX = 0.0f, normalY = 0.0f;
+
+            if (tree != NULL)
+            {
+                // Box covering the bullet for the rest of the step
+                float endX = x + velX[bullet] * remaining;
+                float endY = y + velY[bullet] * remaining;
+                Aabb swept;
+                swept.minX = fminf(x, endX) - world->halfWidth[bullet] - reachX;
+                swept.minY = fminf(y, endY) - world->halfHeight[bullet] - reachY;
+                swept.maxX = fmaxf(x, endX) + world->halfWidth[bullet] + reachX;
+                swept.maxY = fmaxf(y, endY) + world->halfHeight[bullet] + reachY;
+                candidateCount = ccdQueryTree(ccd, world, tree, &swept);
+                if (candidateCount < 0)
+                {
+                    return 0;
+                }
+            }
+
+            const int* candidates = ccd->candidates;
+            for (int candidate = 0; candidate < candidateCount; candidate++)
+            {
+                int other = candidates[candidate];
+                if (other == bullet || world->bullet[other])
+                {
+                    continue;
+                }
+
+                // Where the other body is now, and how it moves relative to the bullet until the end of the step
+                float deltaX = posX[other] - velX[other] * remaining - x;
+                float deltaY = posY[other] - velY[other] * remaining - y;
+                float moveX = (velX[other] - velX[bullet]) * remaining;
+                float moveY = (velY[other] - velY[bullet]) * remaining;
+
+                float hitNormalX, hitNormalY;
+                float fraction = world->type[bullet] == BODY_CIRCLE && world->type[other] == BODY_CIRCLE
+                    ? ccdCircleTimeOfImpact(deltaX, deltaY, moveX, moveY, world->radius[bullet] + world->radius[other], &hitNormalX, &hitNormalY)
+                    : ccdBoxTimeOfImpact(deltaX, deltaY, moveX, moveY, world->halfWidth[bullet] + world->halfWidth[other],
+                        world->halfHeight[bullet] + world->halfHeight[other], &hitNormalX, &hitNormalY);
+                if (fraction >= 0.0f && fraction < first)
+                {
+                    first = fraction;
+                    hit = other;
+                    normalX = hitNormalX;
+                    normalY = hitNormalY;
+                }
+            }
+            if (hit < 0)
+            {
+                break;
+            }
+
+            // Advance the bullet to the impact
+            x += velX[bullet] * remaining * first;
+            y += velY[bullet] * remaining * first;
+            time += (1.0f - time) * first;
+            ccd->impactCount++;
+
+            // Bounce, with the impulse shared by both bodies according to their inverse masses
+            float normalVelocity = (velX[hit] - velX[bullet]) * normalX + (velY[hit] - velY[bullet]) * normalY;
+            if (normalVelocity >= 0.0f)
+            {
+                continue;
+            }
+            float invMassBullet = world->invMass[bullet];
+            float invMassHit = world->invMass[hit];
+            float impulse = -(1.0f + ccd->restitution) * normalVelocity / (invMassBullet + invMassHit);
+
+            velX[bullet] -= impulse * invMassBullet * normalX;
+            velY[bullet] -= impulse * invMassBullet * normalY;
+            if (invMassHit > 0.0f)
+            {
+                // The body hit keeps its new velocity for the rest of the step
+                float changeX = impulse * invMassHit * normalX;
+                float changeY = impulse * invMassHit * normalY;
+                worldWakeBody(world, hit);
+                velX[hit] += changeX;
+                velY[hit] += changeY;
+                posX[hit] += changeX * (1.0f - time) * deltaTime;
+                posY[hit] += changeY * (1.0f - time) * deltaTime;
+                reachX += fabsf(changeX) * deltaTime;
+                reachY += fabsf(changeY) * deltaTime;
+            }
+        }
+
+        // Finish the step from the last impact
+        posX[bullet] = x + velX[bullet] * (1.0f - time) * deltaTime;
+        posY[bullet] = y + velY[bullet] * (1.0f - time) * deltaTime;
+    }
+
+    ccd->sweepTimeMs = timerGetMilliseconds() - start;
+    return 1;
+}
@@ -4,13 +4,15 @@
 /**
  * @struct Circle
  * @brief Represents a circle with position, velocity, radius, and mass.
+ *
+ * Fields use the Scalar type, so the Scalar header must be included before this header.
  */
 typedef struct
 {
-    float x, y;         /**< The x and y coordinates of the circle's center. */
-    float velX, velY;   /**< The velocity components of the circle. */
-    float radius;       /**< The radius of the circle. */
-    float mass;         /**< The mass of the circle. */
+    Scalar x, y;        /**< The x and y coordinates of the circle's center. */
+    Scalar velX, velY;  /**< The velocity components of the circle. */
+    Scalar radius;      /**< The radius of the circle. */
+    Scalar mass;        /**< The mass of the circle. */
 } Circle;
 
 
@@ -19,17 +21,21 @@ typedef struct
  * @param circle Pointer to the Circle struct to apply gravity to.
  * @param deltaTime The time step for the simulation.
  */
-void applyGravity(Circle* circle, float deltaTime);
+void applyGravity(Circle* circle, Scalar deltaTime);
 
 /**
  * @brief Updates the position of a circle based on its velocity.
  * @param circle Pointer to the Circle struct to update its position.
  * @param deltaTime The time step for the simulation.
  */
-void updateCirclePosition(Circle* circle, float deltaTime);
+void updateCirclePosition(Circle* circle, Scalar deltaTime);
 
 /**
  * @brief Checks for collision between two circles.
+ *
+ * Compares squared distances after a bounding box rejection, so no square root is taken and
+ * the squares stay within the fixed-point range for nearby circles.
+ *
  * @param c1 Pointer to the first Circle struct.
  * @param c2 Pointer to the second Circle struct.
  * @return 1 if the circles collide, 0 otherwise.
@@ -48,14 +54,29 @@ int checkCollision(Circle* c1, Circle* c2);
  */
 void resolveCollision(Circle* c1, Circle* c2);
 
+/**
+ * @brief Runs checkCollision and resolveCollision over candidate pairs of circles stored in a World.
+ *
+ * Pairs involving a non-circle body are skipped. The World header must be included before this header.
+ *
+ * @param world Pointer to the World holding the bodies.
+ * @param pairs Candidate pairs, for example produced by a broadphase.
+ * @param pairCount Number of pairs in the array.
+ */
+void collideCirclePairs(World* world, const BodyPair* pairs, int pairCount);
+
+#ifndef PHYSICS_HEADLESS
 /**
  * @brief Implementation of Bresenham's Circle Drawing Algorithm.
+ *
+ * Not declared when PHYSICS_HEADLESS is defined, for builds that do not use SDL such as the benchmarks.
  * @param renderer SDL_Renderer pointer to draw the circle.
  * @param x The x coordinate of the circle's center.
  * @param y The y coordinate of the circle's center.
  * @param radius The radius of the circle to be drawn.
  */
 void drawCircle(SDL_Renderer* renderer, int x, int y, int radius);
+#endif
 
 
 #endif /**< __CIRCLE_INTERFACE_H__ */
@@ -1,72 +1,136 @@
+#ifndef PHYSICS_HEADLESS
 #include <SDL.h>
+#endif
+#include "SCALAR_interface.h"
+#include "WORLD_interface.h"
 #include "CIRCLE_interface.h"
 
-void applyGravity(Circle* circle, float deltaTime)
+void applyGravity(Circle* circle, Scalar deltaTime)
 {
     // Apply gravity (in this case, downward acceleration)
-    float gravity = 9.81f; // Adjust the value as needed
-    circle->velY += gravity * deltaTime; // Vf = Vi + a * dt
+    Scalar gravity = SCALAR_FROM_FLOAT(9.81f); // Adjust the value as needed
+    circle->velY += scalarMul(gravity, deltaTime); // Vf = Vi + a * dt
 }
 
-void updateCirclePosition(Circle* circle, float deltaTime)
+void updateCirclePosition(Circle* circle, Scalar deltaTime)
 {
-    circle->x += circle->velX * deltaTime;
-    circle->y += circle->velY * deltaTime;
+    circle->x += scalarMul(circle->velX, deltaTime);
+    circle->y += scalarMul(circle->velY, deltaTime);
 }
 
 int checkCollision(Circle* c1, Circle* c2)
 {
-    double dx = c2->x - c1->x;
-    double dy = c2->y - c1->y;
-    double distance = sqrt(dx * dx + dy * dy);
-    return distance <= (c1->radius + c2->radius);
+    Scalar dx = c2->x - c1->x;
+    Scalar dy = c2->y - c1->y;
+    Scalar radiusSum = c1->radius + c2->radius;
+
+    // Reject on the bounding boxes first: far apart circles could overflow the fixed-point squares
+    if (dx > radiusSum || dx < -radiusSum || dy > radiusSum || dy < -radiusSum)
+    {
+        return 0;
+    }
+    return scalarMul(dx, dx) + scalarMul(dy, dy) <= scalarMul(radiusSum, radiusSum);
 }
 
 void resolveCollision(Circle* c1, Circle* c2)
 {
     // Calculate the distance between the centers of the two circles
-    double dx = c2->x - c1->x;
-    double dy = c2->y - c1->y;
-    double distance = sqrt(dx * dx + dy * dy);
+    Scalar dx = c2->x - c1->x;
+    Scalar dy = c2->y - c1->y;
+    Scalar distance = scalarSqrt(scalarMul(dx, dx) + scalarMul(dy, dy));
+
+    // Coincident centers have no collision normal
+    if (distance == 0)
+    {
+        return;
+    }
 
     // Calculate the normalized collision normal (direction of collision)
-    double nx = dx / distance;
-    double ny = dy / distance;
+    Scalar inverseDistance = scalarReciprocal(distance);
+    Scalar nx = scalarMul(dx, inverseDistance);
+    Scalar ny = scalarMul(dy, inverseDistance);
 
     // Calculate the amount of overlap between the circles
-    double overlap = (c1->radius + c2->radius) - distance;
+    Scalar overlap = (c1->radius + c2->radius) - distance;
 
     // Separate the circles by adjusting their positions along the collision normal
-    c1->x -= overlap * nx;
-    c1->y -= overlap * ny;
+    c1->x -= scalarMul(overlap, nx);
+    c1->y -= scalarMul(overlap, ny);
 
     // Calculate the relative velocity of the circles along the collision normal
-    double relativeVelocity = c1->velX * nx + c1->velY * ny - c2->velX * nx - c2->velY * ny;
+    Scalar relativeVelocity = scalarMul(c1->velX - c2->velX, nx) + scalarMul(c1->velY - c2->velY, ny);
 
     // Calculate the impulse (change in momentum) for the collision resolution
-    double impulse = 2 * relativeVelocity / (c1->mass + c2->mass);
+    Scalar impulse = scalarDiv(2 * relativeVelocity, c1->mass + c2->mass);
 
     // Update the velocities of the circles after the collision
-    c1->velX -= impulse * c2->mass * nx;
-    c1->velY -= impulse * c2->mass * ny;
+    Scalar impulseMass = scalarMul(impulse, c2->mass);
+    c1->velX -= scalarMul(impulseMass, nx);
+    c1->velY -= scalarMul(impulseMass, ny);
+}
+
+void collideCirclePairs(World* world, const BodyPair* pairs, int pairCount)
+{
+    for (int i = 0; i < pairCount; i++)
+    {
+        int a = pairs[i].a;
+        int b = pairs[i].b;
+        if (world->type[a] != BODY_CIRCLE || world->type[b] != BODY_CIRCLE)
+        {
+            continue;
+        }
+
+        // Gather both bodies into the Circle layout expected by the pairwise functions
+        Circle c1 = { SCALAR_FROM_FLOAT(world->posX[a]), SCALAR_FROM_FLOAT(world->posY[a]),
+            SCALAR_FROM_FLOAT(world->velX[a]), SCALAR_FROM_FLOAT(world->velY[a]), SCALAR_FROM_FLOAT(world->radius[a]),
+            SCALAR_FROM_FLOAT(world->invMass[a] > 0.0f ? 1.0f / world->invMass[a] : 0.0f) };
+        Circle c2 = { SCALAR_FROM_FLOAT(world->posX[b]), SCALAR_FROM_FLOAT(world->posY[b]),
+            SCALAR_FROM_FLOAT(world->velX[b]), SCALAR_FROM_FLOAT(world->velY[b]), SCALAR_FROM_FLOAT(world->radius[b]),
+            SCALAR_FROM_FLOAT(world->invMass[b] > 0.0f ? 1.0f / world->invMass[b] : 0.0f) };
+
+        if (!checkCollision(&c1, &c2))
+        {
+            continue;
+        }
+        resolveCollision(&c1, &c2);
+
+        // Scatter the result back into the world
+        world->posX[a] = SCALAR_TO_FLOAT(c1.x);
+        world->posY[a] = SCALAR_TO_FLOAT(c1.y);
+        world->velX[a] = SCALAR_TO_FLOAT(c1.velX);
+        world->velY[a] = SCALAR_TO_FLOAT(c1.velY);
+        world->posX[b] = SCALAR_TO_FLOAT(c2.x);
+        world->posY[b] = SCALAR_TO_FLOAT(c2.y);
+        world->velX[b] = SCALAR_TO_FLOAT(c2.velX);
+        world->velY[b] = SCALAR_TO_FLOAT(c2.velY);
+    }
 }
 
+#ifndef PHYSICS_HEADLESS
 void drawCircle(SDL_Renderer* renderer, int x, int y, int radius)
 {
+    // Points are submitted in blocks rather than with one renderer call each
+    SDL_Point points[256];
+    int count = 0;
     int centerX = radius;
     int centerY = 0;
     int errorVal = 0;
 
     while (centerX >= centerY)
     {
-        SDL_RenderDrawPoint(renderer, x + centerX, y + centerY);
-        SDL_RenderDrawPoint(renderer, x + centerY, y + centerX);
-        SDL_RenderDrawPoint(renderer, x - centerY, y + centerX);
-        SDL_RenderDrawPoint(renderer, x - centerX, y + centerY);
-        SDL_RenderDrawPoint(renderer, x - centerX, y - centerY);
-        SDL_RenderDrawPoint(renderer, x - centerY, y - centerX);
-        SDL_RenderDrawPoint(renderer, x + centerY, y - centerX);
-        SDL_RenderDrawPoint(renderer, x + centerX, y - centerY);
+        if (count > 256 - 8)
+        {
+            SDL_RenderDrawPoints(renderer, points, count);
+            count = 0;
+        }
+        points[count++] = (SDL_Point){ x + centerX, y + centerY };
+        points[count++] = (SDL_Point){ x + centerY, y + centerX };
+        points[count++] = (SDL_Point){ x - centerY, y + centerX };
+        points[count++] = (SDL_Point){ x - centerX, y + centerY };
+        points[count++] = (SDL_Point){ x - centerX, y - centerY };
+        points[count++] = (SDL_Point){ x - centerY, y - centerX };
+        points[count++] = (SDL_Point){ x + centerY, y - centerX };
+        points[count++] = (SDL_Point){ x + centerX, y - centerY };
 
         if (errorVal <= 0)
         {
@@ -80,4 +144,6 @@ void drawCircle(SDL_Renderer* renderer, int x, int y, int radius)
             errorVal -= 2 * centerX + 1;
         }
     }
+    SDL_RenderDrawPoints(renderer, points, count);
 }
+#endif
@@ -0,0 +1,75 @@
+#ifndef __DIRTY_INTERFACE_H__
+#define __DIRTY_INTERFACE_H__
+
+/**
+ * @struct DirtyBounds
+ * @brief Screen bounds a body was last drawn with.
+ */
+typedef struct
+{
+    short left;             /**< First screen column covered. */
+    short top;              /**< First screen row covered. */
+    short right;            /**< Screen column just right of the bounds. */
+    short bottom;           /**< Screen row just below the bounds. */
+    float posX;             /**< Position the body was drawn at, along the X-axis. */
+    float posY;             /**< Position the body was drawn at, along the Y-axis. */
+    float angle;            /**< Rotation the body was drawn with. */
+    int index;              /**< Dense index the body was drawn at; bodies are drawn in index order. */
+    unsigned int frame;     /**< Update in which the body was last seen. */
+    unsigned char awake;    /**< Awake state the body was drawn with, which selects its color. */
+    unsigned char drawn;    /**< 1 if the bounds are on screen from an earlier update. */
+} DirtyBounds;
+
+/**
+ * @struct DirtyTracker
+ * @brief Finds the parts of the screen a world changed since the previous frame.
+ *
+ * The tracker remembers the screen bounds every body was drawn with, keyed by handle slot so that
+ * removing bodies does not mix them up. Each update adds to an SFB_DirtyRegion_t the old and new
+ * bounds of every body that moved (even by less than a pixel, since its outline is rounded to
+ * pixels), turned, changed color or changed place in the drawing order, the new bounds of added
+ * bodies and the old bounds of removed ones. The region merges rectangles that overlap, so a body
+ * that moved a little yields the union of its two positions. Bodies that did not change add nothing, so a scene at rest redraws and
+ * sends nothing.
+ *
+ * The STD_TYPES, FB config, FB and WORLD headers must be included before this header.
+ */
+typedef struct
+{
+    DirtyBounds* bounds;    /**< Bounds of each handle slot. */
+    int capacity;           /**< Number of slots the array can hold. */
+    unsigned int frame;     /**< Number of updates so far. */
+    int invalidated;        /**< 1 if the next update marks the whole screen. */
+} DirtyTracker;
+
+
+/**
+ * @brief Initializes an empty tracker whose first update marks the whole screen.
+ * @param tracker Pointer to the DirtyTracker struct to initialize.
+ */
+void dirtyTrackerInit(DirtyTracker* tracker);
+
+/**
+ * @brief Releases the storage owned by a tracker.
+ * @param tracker Pointer to the DirtyTracker struct to release.
+ */
+void dirtyTrackerFree(DirtyTracker* tracker);
+
+/**
+ * @brief Makes the next update mark the whole screen, for example after the display was cleared.
+ * @param tracker Pointer to the DirtyTracker.
+ */
+void dirtyTrackerInvalidate(DirtyTracker* tracker);
+
+/**
+ * @brief Adds the screen areas changed since the previous update to a dirty region.
+ * @param tracker Pointer to the DirtyTracker.
+ * @param world Pointer to the World about to be drawn.
+ * @param scale Screen pixels per world unit, the scale the world is drawn with.
+ * @param dirty The dirty region to add to; its screen size is the screen the world is drawn on.
+ * @return 1 on success, 0 if the storage could not grow (the whole screen is then marked).
+ */
+int dirtyTrackerUpdate(DirtyTracker* tracker, const World* world, float scale, SFB_DirtyRegion_t* dirty);
+
+
+#endif /**< __DIRTY_INTERFACE_H__ */
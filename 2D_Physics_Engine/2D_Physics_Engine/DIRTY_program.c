@@ -0,0 +1,125 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "STD_TYPES.h"
+#include "FB_config.h"
+#include "FB_interface.h"
+#include "WORLD_interface.h"
+#include "DIRTY_interface.h"
+
+void dirtyTrackerInit(DirtyTracker* tracker)
+{
+    memset(tracker, 0, sizeof(*tracker));
+    tracker->invalidated = 1;
+}
+
+void dirtyTrackerFree(DirtyTracker* tracker)
+{
+    free(tracker->bounds);
+    dirtyTrackerInit(tracker);
+}
+
+void dirtyTrackerInvalidate(DirtyTracker* tracker)
+{
+    tracker->invalidated = 1;
+}
+
+// Grows the bounds array to hold at least needed slots, doubling its capacity
+static int dirtyReserve(DirtyTracker* tracker, int needed)
+{
+    if (needed <= tracker->capacity)
+    {
+        return 1;
+    }
+
+    int capacity = tracker->capacity > 0 ? tracker->capacity : 256;
+    while (capacity < needed)
+    {
+        capacity *= 2;
+    }
+    DirtyBounds* bounds = realloc(tracker->bounds, sizeof(DirtyBounds) * (size_t)capacity);
+    if (bounds == NULL)
+    {
+        return 0;
+    }
+    memset(&bounds[tracker->capacity], 0, sizeof(DirtyBounds) * (size_t)(capacity - tracker->capacity));
+    tracker->bounds = bounds;
+    tracker->capacity = capacity;
+    return 1;
+}
+
+// Saturates a screen coordinate to the range of the rasterizer's s16 coordinates
+static short dirtyCoordinate(float value)
+{
+    return value < -32768.0f ? -32768 : value > 32767.0f ? 32767 : (short)value;
+}
+
+static void dirtyAddBounds(SFB_DirtyRegion_t* dirty, const DirtyBounds* bounds)
+{
+    SFB_voidDirtyAdd(dirty, bounds->left, bounds->top, (s16)(bounds->right - bounds->left), (s16)(bounds->bottom - bounds->top));
+}
+
+int dirtyTrackerUpdate(DirtyTracker* tracker, const World* world, float scale, SFB_DirtyRegion_t* dirty)
+{
+    if (!dirtyReserve(tracker, world->slotCount))
+    {
+        tracker->invalidated = 1;
+        SFB_voidDirtyAdd(dirty, 0, 0, (s16)dirty->ScreenWidth, (s16)dirty->ScreenHeight);
+        return 0;
+    }
+    tracker->frame++;
+
+    for (int i = 0; i < world->count; i++)
+    {
+        // Bounding box in whole pixels, with a pixel of slack for the rounding of the rasterizer
+        DirtyBounds current;
+        current.left = dirtyCoordinate(floorf((world->posX[i] - world->halfWidth[i]) * scale) - 1.0f);
+        current.top = dirtyCoordinate(floorf((world->posY[i] - world->halfHeight[i]) * scale) - 1.0f);
+        current.right = dirtyCoordinate(ceilf((world->posX[i] + world->halfWidth[i]) * scale) + 2.0f);
+        current.bottom = dirtyCoordinate(ceilf((world->posY[i] + world->halfHeight[i]) * scale) + 2.0f);
+        current.posX = world->posX[i];
+        current.posY = world->posY[i];
+        current.angle = world->angle[i];
+        current.index = i;
+        current.frame = tracker->frame;
+        current.awake = world->awake[i];
+        current.drawn = 1;
+
+        DirtyBounds* previous = &tracker->bounds[world->bodySlot[i]];
+        if (!tracker->invalidated)
+        {
+            if (!previous->drawn)
+            {
+                dirtyAddBounds(dirty, &current);
+            }
+            else if (previous->posX != current.posX || previous->posY != current.posY || previous->angle != current.angle
+                || previous->awake != current.awake || previous->index != current.index)
+            {
+                dirtyAddBounds(dirty, previous);
+                dirtyAddBounds(dirty, &current);
+            }
+        }
+        *previous = current;
+    }
+
+    // Slots not seen in this update belong to removed bodies: clear where they were
+    for (int slot = 0; slot < tracker->capacity; slot++)
+    {
+        DirtyBounds* previous = &tracker->bounds[slot];
+        if (previous->drawn && previous->frame != tracker->frame)
+        {
+            if (!tracker->invalidated)
+            {
+                dirtyAddBounds(dirty, previous);
+            }
+            previous->drawn = 0;
+        }
+    }
+
+    if (tracker->invalidated)
+    {
+        SFB_voidDirtyAdd(dirty, 0, 0, (s16)dirty->ScreenWidth, (s16)dirty->ScreenHeight);
+        tracker->invalidated = 0;
+    }
+    return 1;
+}
@@ -0,0 +1,97 @@
+#ifndef __GRID_INTERFACE_H__
+#define __GRID_INTERFACE_H__
+
+/**
+ * @struct Grid
+ * @brief Uniform-grid (spatial hash) broadphase over the bodies of a World.
+ *
+ * Every body is stored in the cell containing its center, and cells are hashed into a fixed
+ * number of buckets holding doubly linked body lists. Candidate pairs are found by visiting the
+ * 3x3 neighborhood of each body's cell, which is exact as long as no body is wider than a cell.
+ * Bodies larger than the cell size are kept in a separate list and tested against everything.
+ *
+ * The grid is updated incrementally: only bodies whose cell changed since the previous update
+ * are unlinked and relinked. Adding or removing bodies in the World triggers a full rebuild.
+ *
+ * gridUpdateParallel() splits the pair search into chunks of bodies run by a JobSystem. Each chunk
+ * collects into its own list and the lists are concatenated in chunk order, so the pairs come out
+ * in the same order as with gridUpdate().
+ *
+ * The World and Job headers must be included before this header.
+ */
+typedef struct
+{
+    float cellSize;             /**< Edge length of a grid cell. */
+    float invCellSize;          /**< 1 / cellSize. */
+
+    int bucketCount;            /**< Number of hash buckets (a power of two). */
+    int* bucketHead;            /**< First body of each bucket, plus the oversized list at [bucketCount]. */
+
+    int bodyCapacity;           /**< Number of bodies the per-body arrays can hold. */
+    int* next;                  /**< Next body in the same bucket (-1 at the end). */
+    int* prev;                  /**< Previous body in the same bucket (-1 at the head). */
+    int* bucket;                /**< Bucket currently holding each body. */
+    int* cellX;                 /**< Cell column currently holding each body. */
+    int* cellY;                 /**< Cell row currently holding each body. */
+
+    int trackedCount;           /**< World body count seen by the last update. */
+    unsigned int trackedVersion; /**< World structure version seen by the last update. */
+
+    BodyPair* pairs;            /**< Candidate pairs produced by the last update. */
+    int pairCapacity;           /**< Number of pairs the buffer can hold. */
+    PairList* chunks;           /**< Pairs found by each chunk of a parallel update. */
+    int chunkCapacity;          /**< Number of chunk lists allocated. */
+
+    int pairCount;              /**< Counter: candidate pairs produced by the last update. */
+    int movedCount;             /**< Counter: bodies relinked by the last update. */
+    double buildTimeMs;         /**< Counter: time spent in the last update, in milliseconds. */
+} Grid;
+
+
+/**
+ * @brief Initializes an empty grid.
+ * @param grid Pointer to the Grid struct to initialize.
+ * @param cellSize Edge length of a grid cell; should be at least the largest common body diameter.
+ */
+void gridInit(Grid* grid, float cellSize);
+
+/**
+ * @brief Releases all storage owned by a grid.
+ * @param grid Pointer to the Grid struct to release.
+ */
+void gridFree(Grid* grid);
+
+/**
+ * @brief Changes the cell size; the next update rebuilds the grid.
+ * @param grid Pointer to the Grid struct.
+ * @param cellSize New edge length of a grid cell.
+ */
+void gridSetCellSize(Grid* grid, float cellSize);
+
+/**
+ * @brief Brings the grid up to date with the world and collects the candidate pairs.
+ *
+ * After this call grid->pairs holds grid->pairCount pairs whose bounding boxes overlap, ready to
+ * be passed to a narrowphase. Pairs of two bodies that are static or asleep are skipped, and
+ * sleeping bodies are not relinked. The counters describe the work done by this call.
+ *
+ * @param grid Pointer to the Grid struct.
+ * @param world Pointer to the World whose bodies are tracked.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int gridUpdate(Grid* grid, const World* world);
+
+/**
+ * @brief Same as gridUpdate(), with the pair search spread over the threads of a job system.
+ *
+ * Relinking moved bodies and testing oversized bodies stay on the calling thread.
+ *
+ * @param grid Pointer to the Grid struct.
+ * @param world Pointer to the World whose bodies are tracked.
+ * @param jobs Pointer to the JobSystem running the chunks, or NULL to behave like gridUpdate().
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int gridUpdateParallel(Grid* grid, const World* world, JobSystem* jobs);
+
+
+#endif /**< __GRID_INTERFACE_H__ */
@@ -0,0 +1,402 @@
+#include <stdlib.h>
+#include <math.h>
+#include "WORLD_interface.h"
+#include "TIMER_interface.h"
+#include "JOB_interface.h"
+#include "GRID_interface.h"
+
+#define GRID_OVERSIZED_CELL     0x7FFFFFFF  /**< Cell coordinate marking a body kept in the oversized list. */
+#define GRID_CHUNKS_PER_WORKER  4           /**< Pair search chunks per worker thread in a parallel update. */
+
+void gridInit(Grid* grid, float cellSize)
+{
+    grid->cellSize = cellSize;
+    grid->invCellSize = 1.0f / cellSize;
+    grid->bucketCount = 0;
+    grid->bucketHead = NULL;
+    grid->bodyCapacity = 0;
+    grid->next = NULL;
+    grid->prev = NULL;
+    grid->bucket = NULL;
+    grid->cellX = NULL;
+    grid->cellY = NULL;
+    grid->trackedCount = -1;
+    grid->trackedVersion = 0;
+    grid->pairs = NULL;
+    grid->pairCapacity = 0;
+    grid->chunks = NULL;
+    grid->chunkCapacity = 0;
+    grid->pairCount = 0;
+    grid->movedCount = 0;
+    grid->buildTimeMs = 0.0;
+}
+
+void gridFree(Grid* grid)
+{
+    free(grid->bucketHead);
+    free(grid->next);
+    free(grid->prev);
+    free(grid->bucket);
+    free(grid->cellX);
+    free(grid->cellY);
+    free(grid->pairs);
+    for (int i = 0; i < grid->chunkCapacity; i++)
+    {
+        free(grid->chunks[i].pairs);
+    }
+    free(grid->chunks);
+    gridInit(grid, grid->cellSize);
+}
+
+void gridSetCellSize(Grid* grid, float cellSize)
+{
+    grid->cellSize = cellSize;
+    grid->invCellSize = 1.0f / cellSize;
+    grid->trackedCount = -1; // Force a rebuild on the next update
+}
+
+static int gridHashCell(const Grid* grid, int cellX, int cellY)
+{
+    unsigned int hash = ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellY * 19349663u);
+    return (int)(hash & (unsigned int)(grid->bucketCount - 1));
+}
+
+static void gridLink(Grid* grid, int body, int bucket)
+{
+    int head = grid->bucketHead[bucket];
+    grid->prev[body] = -1;
+    grid->next[body] = head;
+    if (head >= 0)
+    {
+        grid->prev[head] = body;
+    }
+    grid->bucketHead[bucket] = body;
+    grid->bucket[body] = bucket;
+}
+
+static void gridUnlink(Grid* grid, int body)
+{
+    int prev = grid->prev[body];
+    int next = grid->next[body];
+    if (prev >= 0)
+    {
+        grid->next[prev] = next;
+    }
+    else
+    {
+        grid->bucketHead[grid->bucket[body]] = next;
+    }
+    if (next >= 0)
+    {
+        grid->prev[next] = prev;
+    }
+}
+
+static int gridReserveBodies(Grid* grid, int count)
+{
+    if (count <= grid->bodyCapacity && grid->bucketHead != NULL)
+    {
+        return 1;
+    }
+
+    int capacity = grid->bodyCapacity > 0 ? grid->bodyCapacity : 64;
+    while (capacity < count)
+    {
+        capacity *= 2;
+    }
+
+    // Keep roughly two buckets per body to make hash collisions rare
+    int bucketCount = 1;
+    while (bucketCount < capacity * 2)
+    {
+        bucketCount *= 2;
+    }
+
+    int* bucketHead = realloc(grid->bucketHead, sizeof(int) * (size_t)(bucketCount + 1));
+    int* next = realloc(grid->next, sizeof(int) * (size_t)capacity);
+    int* prev = realloc(grid->prev, sizeof(int) * (size_t)capacity);
+    int* bucket = realloc(grid->bucket, sizeof(int) * (size_t)capacity);
+    int* cellX = realloc(grid->cellX, sizeof(int) * (size_t)capacity);
+    int* cellY = realloc(grid->cellY, sizeof(int) * (size_t)capacity);
+
+    // Keep whatever was reallocated so that gridFree releases it
+    if (bucketHead != NULL) grid->bucketHead = bucketHead;
+    if (next != NULL) grid->next = next;
+    if (prev != NULL) grid->prev = prev;
+    if (bucket != NULL) grid->bucket = bucket;
+    if (cellX != NULL) grid->cellX = cellX;
+    if (cellY != NULL) grid->cellY = cellY;
+
+    if (bucketHead == NULL || next == NULL || prev == NULL || bucket == NULL || cellX == NULL || cellY == NULL)
+    {
+        return 0;
+    }
+
+    grid->bodyCapacity = capacity;
+    grid->bucketCount = bucketCount;
+    grid->trackedCount = -1; // The bucket count changed, so every body must be rehashed
+    return 1;
+}
+
+static void gridComputeCell(const Grid* grid, const World* world, int body, int* cellX, int* cellY)
+{
+    float extent = world->halfWidth[body] > world->halfHeight[body] ? world->halfWidth[body] : world->halfHeight[body];
+    if (2.0f * extent > grid->cellSize)
+    {
+        *cellX = GRID_OVERSIZED_CELL;
+        *cellY = GRID_OVERSIZED_CELL;
+        return;
+    }
+
+    *cellX = (int)floorf(world->posX[body] * grid->invCellSize);
+    *cellY = (int)floorf(world->posY[body] * grid->invCellSize);
+}
+
+static int gridBucketOfCell(const Grid* grid, int cellX, int cellY)
+{
+    return cellX == GRID_OVERSIZED_CELL ? grid->bucketCount : gridHashCell(grid, cellX, cellY);
+}
+
+static int gridOverlap(const World* world, int a, int b)
+{
+    return fabsf(world->posX[a] - world->posX[b]) <= world->halfWidth[a] + world->halfWidth[b]
+        && fabsf(world->posY[a] - world->posY[b]) <= world->halfHeight[a] + world->halfHeight[b];
+}
+
+static void gridRebuild(Grid* grid, const World* world)
+{
+    for (int i = 0; i <= grid->bucketCount; i++)
+    {
+        grid->bucketHead[i] = -1;
+    }
+
+    for (int body = 0; body < world->count; body++)
+    {
+        gridComputeCell(grid, world, body, &grid->cellX[body], &grid->cellY[body]);
+        gridLink(grid, body, gridBucketOfCell(grid, grid->cellX[body], grid->cellY[body]));
+    }
+
+    grid->movedCount = world->count;
+    grid->trackedCount = world->count;
+    grid->trackedVersion = world->structureVersion;
+}
+
+static void gridRelinkMoved(Grid* grid, const World* world)
+{
+    grid->movedCount = 0;
+    for (int body = 0; body < world->count; body++)
+    {
+        // Sleeping bodies do not move
+        if (!world->awake[body] && world->invMass[body] > 0.0f)
+        {
+            continue;
+        }
+
+        int cellX, cellY;
+        gridComputeCell(grid, world, body, &cellX, &cellY);
+        if (cellX == grid->cellX[body] && cellY == grid->cellY[body])
+        {
+            continue;
+        }
+
+        gridUnlink(grid, body);
+        grid->cellX[body] = cellX;
+        grid->cellY[body] = cellY;
+        gridLink(grid, body, gridBucketOfCell(grid, cellX, cellY));
+        grid->movedCount++;
+    }
+}
+
+// Collects the pairs found by the bodies of [begin, end) that fit in a cell
+static int gridCollectRange(const Grid* grid, const World* world, int begin, int end, PairList* list)
+{
+    for (int body = begin; body < end; body++)
+    {
+        // Only awake bodies search for pairs, so resting and static bodies never pair with each other
+        if (!world->awake[body] || grid->cellX[body] == GRID_OVERSIZED_CELL)
+        {
+            continue;
+        }
+
+        // Visit the 3x3 neighborhood, skipping buckets already visited through a hash collision
+        int visited[9];
+        int visitedCount = 0;
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                int bucket = gridHashCell(grid, grid->cellX[body] + dx, grid->cellY[body] + dy);
+                int seen = 0;
+                for (int v = 0; v < visitedCount; v++)
+                {
+                    seen |= visited[v] == bucket;
+                }
+                if (seen)
+                {
+                    continue;
+                }
+                visited[visitedCount++] = bucket;
+
+                // A pair of awake bodies is reported by its lower index only
+                for (int other = grid->bucketHead[bucket]; other >= 0; other = grid->next[other])
+                {
+                    int report = world->awake[other] ? other > body : 1;
+                    if (report && gridOverlap(world, body, other) && !pairListPush(list, body, other))
+                    {
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// Oversized bodies do not fit the neighborhood rule, so test them against every body
+static int gridCollectOversized(const Grid* grid, const World* world, PairList* list)
+{
+    for (int body = grid->bucketHead[grid->bucketCount]; body >= 0; body = grid->next[body])
+    {
+        for (int other = 0; other < world->count; other++)
+        {
+            int otherOversized = grid->cellX[other] == GRID_OVERSIZED_CELL;
+            if (other == body || (otherOversized && other < body) || (!world->awake[body] && !world->awake[other]))
+            {
+                continue;
+            }
+            if (gridOverlap(world, body, other) && !pairListPush(list, body, other))
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static int gridCollectPairs(Grid* grid, const World* world)
+{
+    PairList list = { grid->pairs, 0, grid->pairCapacity };
+    int success = gridCollectRange(grid, world, 0, world->count, &list) && gridCollectOversized(grid, world, &list);
+
+    grid->pairs = list.pairs;
+    grid->pairCapacity = list.capacity;
+    grid->pairCount = list.count;
+    return success;
+}
+
+static int gridReserveChunks(Grid* grid, int chunkCount)
+{
+    if (chunkCount <= grid->chunkCapacity)
+    {
+        return 1;
+    }
+
+    PairList* chunks = realloc(grid->chunks, sizeof(PairList) * (size_t)chunkCount);
+    if (chunks == NULL)
+    {
+        return 0;
+    }
+    for (int i = grid->chunkCapacity; i < chunkCount; i++)
+    {
+        chunks[i].pairs = NULL;
+        chunks[i].count = 0;
+        chunks[i].capacity = 0;
+    }
+    grid->chunks = chunks;
+    grid->chunkCapacity = chunkCount;
+    return 1;
+}
+
+typedef struct
+{
+    const Grid* grid;
+    const World* world;
+    int chunkCount;
+} GridCollectJob;
+
+static void gridCollectChunks(void* data, int begin, int end)
+{
+    const GridCollectJob* job = data;
+    int bodyCount = job->world->count;
+
+    for (int chunk = begin; chunk < end; chunk++)
+    {
+        PairList* list = &job->grid->chunks[chunk];
+        int first = (int)((long long)bodyCount * chunk / job->chunkCount);
+        int last = (int)((long long)bodyCount * (chunk + 1) / job->chunkCount);
+
+        list->count = 0;
+        if (!gridCollectRange(job->grid, job->world, first, last, list))
+        {
+            list->count = -1; // Lets the merge report the failure
+        }
+    }
+}
+
+static int gridCollectPairsParallel(Grid* grid, const World* world, JobSystem* jobs)
+{
+    int chunkCount = jobs->workerCount * GRID_CHUNKS_PER_WORKER;
+    if (!gridReserveChunks(grid, chunkCount))
+    {
+        return 0;
+    }
+
+    GridCollectJob job = { grid, world, chunkCount };
+    jobSystemParallelFor(jobs, gridCollectChunks, &job, chunkCount, 1);
+
+    // Concatenate in chunk order, which is the order of the serial search
+    PairList list = { grid->pairs, 0, grid->pairCapacity };
+    int success = 1;
+    for (int chunk = 0; success && chunk < chunkCount; chunk++)
+    {
+        success = grid->chunks[chunk].count >= 0 && pairListAppend(&list, &grid->chunks[chunk]);
+    }
+    success = success && gridCollectOversized(grid, world, &list);
+
+    grid->pairs = list.pairs;
+    grid->pairCapacity = list.capacity;
+    grid->pairCount = list.count;
+    return success;
+}
+
+// Brings the buckets up to date with the world before a pair search
+static int gridSynchronize(Grid* grid, const World* world)
+{
+    if (!gridReserveBodies(grid, world->count))
+    {
+        return 0;
+    }
+
+    if (grid->trackedCount != world->count || grid->trackedVersion != world->structureVersion)
+    {
+        gridRebuild(grid, world);
+    }
+    else
+    {
+        gridRelinkMoved(grid, world);
+    }
+    return 1;
+}
+
+int gridUpdate(Grid* grid, const World* world)
+{
+    double start = timerGetMilliseconds();
+
+    int success = gridSynchronize(grid, world) && gridCollectPairs(grid, world);
+    grid->buildTimeMs = timerGetMilliseconds() - start;
+    return success;
+}
+
+int gridUpdateParallel(Grid* grid, const World* world, JobSystem* jobs)
+{
+    if (jobs == NULL || jobs->workerCount <= 1)
+    {
+        return gridUpdate(grid, world);
+    }
+
+    double start = timerGetMilliseconds();
+
+    int success = gridSynchronize(grid, world) && gridCollectPairsParallel(grid, world, jobs);
+    grid->buildTimeMs = timerGetMilliseconds() - start;
+    return success;
+}
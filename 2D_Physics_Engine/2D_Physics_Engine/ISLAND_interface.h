@@ -0,0 +1,86 @@
+#ifndef __ISLAND_INTERFACE_H__
+#define __ISLAND_INTERFACE_H__
+
+/**
+ * @brief Default speed below which a body counts as resting, in pixels per second.
+ */
+#define ISLAND_DEFAULT_SLEEP_VELOCITY   1.0f
+
+/**
+ * @brief Default time every body of an island must rest before the island falls asleep, in seconds.
+ */
+#define ISLAND_DEFAULT_TIME_TO_SLEEP    0.5f
+
+/**
+ * @struct Islands
+ * @brief Groups of awake bodies connected by contacts, used to put resting piles to sleep.
+ *
+ * Islands are rebuilt every step with union-find over the contacts between awake dynamic bodies;
+ * static bodies do not connect islands. The bodies and the contacts of each island are stored
+ * contiguously, so that an island can be processed (or put to sleep) as a unit.
+ *
+ * The World and Narrowphase headers must be included before this header.
+ */
+typedef struct
+{
+    int* parent;                /**< Union-find parent of each body. */
+    int* islandOfBody;          /**< Island of each body, -1 for static and sleeping bodies. */
+
+    int islandCount;            /**< Number of islands found by the last build. */
+    int* bodyStart;             /**< Offset of each island in bodies, plus the total at [islandCount]. */
+    int* bodies;                /**< Dense indices of the awake bodies, grouped by island. */
+    int* contactStart;          /**< Offset of each island in contacts, plus the total at [islandCount]. */
+    int* contacts;              /**< Indices into the contact buffer, grouped by island. */
+
+    int bodyCapacity;           /**< Number of bodies the per-body arrays can hold. */
+    int contactCapacity;        /**< Number of contacts the contacts array can hold. */
+
+    float sleepVelocity;        /**< Speed below which a body counts as resting. */
+    float timeToSleep;          /**< Resting time after which an island falls asleep. */
+
+    int wokenCount;             /**< Counter: sleeping islands woken by contacts during the last build. */
+    int sleepingCount;          /**< Counter: dynamic bodies asleep after the last sleep update. */
+    double buildTimeMs;         /**< Counter: time spent in the last build and sleep update, in milliseconds. */
+} Islands;
+
+
+/**
+ * @brief Initializes an empty island set with the default sleep settings.
+ * @param islands Pointer to the Islands struct to initialize.
+ */
+void islandsInit(Islands* islands);
+
+/**
+ * @brief Releases all storage owned by an island set.
+ * @param islands Pointer to the Islands struct to release.
+ */
+void islandsFree(Islands* islands);
+
+/**
+ * @brief Builds the islands of the current step from the contacts.
+ *
+ * A contact between an awake body and a sleeping one first wakes the whole sleeping island,
+ * so that both end up in the same island.
+ *
+ * @param islands Pointer to the Islands struct.
+ * @param world Pointer to the World holding the bodies.
+ * @param pairs The candidate pairs passed to the narrowphase.
+ * @param buffer The contacts produced from those pairs.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int islandsBuild(Islands* islands, World* world, const BodyPair* pairs, const ContactBuffer* buffer);
+
+/**
+ * @brief Updates the sleep timers and puts to sleep the islands whose bodies all rested long enough.
+ *
+ * Call it after the solver, with the islands of the same step. Sleeping bodies get zero velocity
+ * and are linked into a ring in world->sleepNext so that worldWakeBody() wakes the whole island.
+ *
+ * @param islands Pointer to the Islands struct.
+ * @param world Pointer to the World holding the bodies.
+ * @param deltaTime The time step for the simulation.
+ */
+void islandsUpdateSleep(Islands* islands, World* world, float deltaTime);
+
+
+#endif /**< __ISLAND_INTERFACE_H__ */
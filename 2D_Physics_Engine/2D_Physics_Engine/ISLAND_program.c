@@ -0,0 +1,294 @@
+#include <stdlib.h>
+#include "WORLD_interface.h"
+#include "NARROWPHASE_interface.h"
+#include "ISLAND_interface.h"
+#include "TIMER_interface.h"
+
+void islandsInit(Islands* islands)
+{
+    islands->parent = NULL;
+    islands->islandOfBody = NULL;
+    islands->islandCount = 0;
+    islands->bodyStart = NULL;
+    islands->bodies = NULL;
+    islands->contactStart = NULL;
+    islands->contacts = NULL;
+    islands->bodyCapacity = 0;
+    islands->contactCapacity = 0;
+
+    islands->sleepVelocity = ISLAND_DEFAULT_SLEEP_VELOCITY;
+    islands->timeToSleep = ISLAND_DEFAULT_TIME_TO_SLEEP;
+
+    islands->wokenCount = 0;
+    islands->sleepingCount = 0;
+    islands->buildTimeMs = 0.0;
+}
+
+void islandsFree(Islands* islands)
+{
+    free(islands->parent);
+    free(islands->islandOfBody);
+    free(islands->bodyStart);
+    free(islands->bodies);
+    free(islands->contactStart);
+    free(islands->contacts);
+    islandsInit(islands);
+}
+
+static int islandsGrow(int** array, int capacity)
+{
+    int* grown = realloc(*array, sizeof(int) * (size_t)capacity);
+    if (grown == NULL)
+    {
+        return 0;
+    }
+    *array = grown;
+    return 1;
+}
+
+static int islandsReserve(Islands* islands, int bodyCount, int contactCount)
+{
+    if (bodyCount > islands->bodyCapacity)
+    {
+        int capacity = islands->bodyCapacity > 0 ? islands->bodyCapacity : 64;
+        while (capacity < bodyCount)
+        {
+            capacity *= 2;
+        }
+
+        // There are never more islands than bodies, so the offset arrays are sized by bodies too
+        if (!islandsGrow(&islands->parent, capacity)
+            || !islandsGrow(&islands->islandOfBody, capacity)
+            || !islandsGrow(&islands->bodies, capacity)
+            || !islandsGrow(&islands->bodyStart, capacity + 1)
+            || !islandsGrow(&islands->contactStart, capacity + 1))
+        {
+            return 0;
+        }
+        islands->bodyCapacity = capacity;
+    }
+
+    if (contactCount > islands->contactCapacity)
+    {
+        int capacity = islands->contactCapacity > 0 ? islands->contactCapacity : 64;
+        while (capacity < contactCount)
+        {
+            capacity *= 2;
+        }
+        if (!islandsGrow(&islands->contacts, capacity))
+        {
+            return 0;
+        }
+        islands->contactCapacity = capacity;
+    }
+    return 1;
+}
+
+static int islandsFind(int* parent, int body)
+{
+    // Path halving keeps the trees flat without recursion
+    while (parent[body] != body)
+    {
+        parent[body] = parent[parent[body]];
+        body = parent[body];
+    }
+    return body;
+}
+
+static void islandsWakeTouched(Islands* islands, World* world, const BodyPair* pairs, const ContactBuffer* buffer)
+{
+    islands->wokenCount = 0;
+
+    for (int i = 0; i < buffer->count; i++)
+    {
+        const BodyPair* pair = &pairs[buffer->contacts[i].pairIndex];
+        int sleeping = world->awake[pair->a] ? pair->b : pair->a;
+        if (world->awake[sleeping] || world->invMass[sleeping] == 0.0f)
+        {
+            continue;
+        }
+
+        // One side is awake (broadphases never pair two resting bodies), so wake the other island
+        worldWakeBody(world, sleeping);
+        islands->wokenCount++;
+    }
+}
+
+// Turns per-island counts stored at start[island + 1] into offsets
+static void islandsPrefixSum(int* start, int islandCount)
+{
+    start[0] = 0;
+    for (int island = 0; island < islandCount; island++)
+    {
+        start[island + 1] += start[island];
+    }
+}
+
+int islandsBuild(Islands* islands, World* world, const BodyPair* pairs, const ContactBuffer* buffer)
+{
+    double start = timerGetMilliseconds();
+    int count = world->count;
+
+    if (!islandsReserve(islands, count, buffer->count))
+    {
+        return 0;
+    }
+
+    islandsWakeTouched(islands, world, pairs, buffer);
+
+    int* parent = islands->parent;
+    int* islandOfBody = islands->islandOfBody;
+    for (int body = 0; body < count; body++)
+    {
+        parent[body] = body;
+        islandOfBody[body] = -1;
+    }
+
+    // Union the bodies of every contact between two awake bodies
+    for (int i = 0; i < buffer->count; i++)
+    {
+        const BodyPair* pair = &pairs[buffer->contacts[i].pairIndex];
+        if (!world->awake[pair->a] || !world->awake[pair->b])
+        {
+            continue;
+        }
+
+        int rootA = islandsFind(parent, pair->a);
+        int rootB = islandsFind(parent, pair->b);
+        if (rootA != rootB)
+        {
+            parent[rootA] = rootB;
+        }
+    }
+
+    // Number the roots, then give every awake body the number of its root
+    int islandCount = 0;
+    for (int body = 0; body < count; body++)
+    {
+        if (world->awake[body] && islandsFind(parent, body) == body)
+        {
+            islandOfBody[body] = islandCount++;
+        }
+    }
+    for (int body = 0; body < count; body++)
+    {
+        if (world->awake[body])
+        {
+            islandOfBody[body] = islandOfBody[islandsFind(parent, body)];
+        }
+    }
+    islands->islandCount = islandCount;
+
+    // Group the bodies by island with a counting sort
+    int* bodyStart = islands->bodyStart;
+    for (int island = 0; island <= islandCount; island++)
+    {
+        bodyStart[island] = 0;
+    }
+    for (int body = 0; body < count; body++)
+    {
+        if (islandOfBody[body] >= 0)
+        {
+            bodyStart[islandOfBody[body] + 1]++;
+        }
+    }
+    islandsPrefixSum(bodyStart, islandCount);
+    for (int body = 0; body < count; body++)
+    {
+        if (islandOfBody[body] >= 0)
+        {
+            islands->bodies[bodyStart[islandOfBody[body]]++] = body;
+        }
+    }
+
+    // Group the contacts the same way; a contact with a static body belongs to the island of the other body
+    int* contactStart = islands->contactStart;
+    for (int island = 0; island <= islandCount; island++)
+    {
+        contactStart[island] = 0;
+    }
+    for (int i = 0; i < buffer->count; i++)
+    {
+        const BodyPair* pair = &pairs[buffer->contacts[i].pairIndex];
+        int island = islandOfBody[pair->a] >= 0 ? islandOfBody[pair->a] : islandOfBody[pair->b];
+        if (island >= 0)
+        {
+            contactStart[island + 1]++;
+        }
+    }
+    islandsPrefixSum(contactStart, islandCount);
+    for (int i = 0; i < buffer->count; i++)
+    {
+        const BodyPair* pair = &pairs[buffer->contacts[i].pairIndex];
+        int island = islandOfBody[pair->a] >= 0 ? islandOfBody[pair->a] : islandOfBody[pair->b];
+        if (island >= 0)
+        {
+            islands->contacts[contactStart[island]++] = i;
+        }
+    }
+
+    // The fill loops advanced every offset to the start of the next island; shift them back
+    for (int island = islandCount; island > 0; island--)
+    {
+        bodyStart[island] = bodyStart[island - 1];
+        contactStart[island] = contactStart[island - 1];
+    }
+    bodyStart[0] = 0;
+    contactStart[0] = 0;
+
+    islands->buildTimeMs = timerGetMilliseconds() - start;
+    return 1;
+}
+
+void islandsUpdateSleep(Islands* islands, World* world, float deltaTime)
+{
+    double start = timerGetMilliseconds();
+    float sleepVelocitySquared = islands->sleepVelocity * islands->sleepVelocity;
+
+    for (int island = 0; island < islands->islandCount; island++)
+    {
+        int begin = islands->bodyStart[island];
+        int end = islands->bodyStart[island + 1];
+
+        // The island may sleep once its most recently moving body has rested long enough
+        float minSleepTime = islands->timeToSleep;
+        for (int i = begin; i < end; i++)
+        {
+            int body = islands->bodies[i];
+            // Spin counts through the speed of the corners
+            float spinSquared = world->angularVelocity[body] * world->angularVelocity[body]
+                * (world->extentX[body] * world->extentX[body] + world->extentY[body] * world->extentY[body]);
+            float speedSquared = world->velX[body] * world->velX[body] + world->velY[body] * world->velY[body] + spinSquared;
+            world->sleepTime[body] = speedSquared > sleepVelocitySquared ? 0.0f : world->sleepTime[body] + deltaTime;
+            if (world->sleepTime[body] < minSleepTime)
+            {
+                minSleepTime = world->sleepTime[body];
+            }
+        }
+        if (minSleepTime < islands->timeToSleep)
+        {
+            continue;
+        }
+
+        // Put the island to sleep and link its bodies into a ring of handle slots
+        int first = (int)world->bodySlot[islands->bodies[begin]];
+        for (int i = begin; i < end; i++)
+        {
+            int body = islands->bodies[i];
+            int slot = (int)world->bodySlot[body];
+            world->awake[body] = 0;
+            world->velX[body] = 0.0f;
+            world->velY[body] = 0.0f;
+            world->angularVelocity[body] = 0.0f;
+            world->sleepNext[slot] = i + 1 < end ? (int)world->bodySlot[islands->bodies[i + 1]] : first;
+        }
+    }
+
+    int sleepingCount = 0;
+    for (int body = 0; body < world->count; body++)
+    {
+        sleepingCount += !world->awake[body] && world->invMass[body] > 0.0f;
+    }
+    islands->sleepingCount = sleepingCount;
+    islands->buildTimeMs += timerGetMilliseconds() - start;
+}
@@ -0,0 +1,58 @@
+#ifndef __JOB_INTERFACE_H__
+#define __JOB_INTERFACE_H__
+
+/**
+ * @brief Function run by a job over the item range [begin, end).
+ */
+typedef void (*JobFunction)(void* data, int begin, int end);
+
+/**
+ * @struct JobSystem
+ * @brief Pool of worker threads with one work-stealing deque per thread.
+ *
+ * The thread that calls jobSystemParallelFor() takes part as worker 0. It pushes the chunks of the
+ * loop on its own deque, then runs them from the bottom while idle workers steal from the top of
+ * the other deques. Each deque has its own lock, so threads only contend when they touch the same
+ * deque, and idle workers block on a condition variable instead of spinning.
+ *
+ * Windows threads are used on Windows and POSIX threads elsewhere; the platform state is private.
+ */
+typedef struct
+{
+    int workerCount;                    /**< Number of threads running jobs, including the calling thread. */
+    struct JobSystemState* state;       /**< Deques, threads and synchronization objects. */
+    volatile long stealCount;           /**< Counter: jobs taken from another thread's deque. */
+} JobSystem;
+
+
+/**
+ * @brief Starts the worker threads.
+ * @param jobs Pointer to the JobSystem struct to initialize.
+ * @param threadCount Total number of threads including the caller; 0 uses one per logical CPU.
+ * @return 1 on success, 0 if memory or threads could not be created.
+ */
+int jobSystemInit(JobSystem* jobs, int threadCount);
+
+/**
+ * @brief Stops the worker threads and releases all storage.
+ * @param jobs Pointer to the JobSystem struct to release.
+ */
+void jobSystemFree(JobSystem* jobs);
+
+/**
+ * @brief Runs a function over [0, count) split into chunks, and returns once every chunk is done.
+ *
+ * Chunks may run on any worker in any order, so the function must only write to data owned by its
+ * range. With one worker, or a single chunk, the function runs directly on the calling thread.
+ * The caller runs chunks while it waits, so loops may be nested inside jobs.
+ *
+ * @param jobs Pointer to the JobSystem struct, or NULL to run everything on the calling thread.
+ * @param function The function to run on each chunk.
+ * @param data Pointer passed to every call of the function.
+ * @param count Number of items.
+ * @param grain Items per chunk; 0 picks about four chunks per worker.
+ */
+void jobSystemParallelFor(JobSystem* jobs, JobFunction function, void* data, int count, int grain);
+
+
+#endif /**< __JOB_INTERFACE_H__ */
@@ -0,0 +1,390 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include "JOB_interface.h"
+#include "TRACE_interface.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+typedef CRITICAL_SECTION JobMutex;
+typedef CONDITION_VARIABLE JobCondition;
+typedef HANDLE JobThread;
+
+#define jobMutexInit(mutex)             InitializeCriticalSection(mutex)
+#define jobMutexDestroy(mutex)          DeleteCriticalSection(mutex)
+#define jobMutexLock(mutex)             EnterCriticalSection(mutex)
+#define jobMutexUnlock(mutex)           LeaveCriticalSection(mutex)
+#define jobConditionInit(condition)     InitializeConditionVariable(condition)
+#define jobConditionDestroy(condition)  ((void)(condition))
+#define jobConditionWait(condition, mutex) SleepConditionVariableCS(condition, mutex, INFINITE)
+#define jobConditionWakeAll(condition)  WakeAllConditionVariable(condition)
+#define jobAtomicAdd(value, amount)     InterlockedExchangeAdd(value, amount)
+#define jobAtomicLoad(value)            InterlockedCompareExchange(value, 0, 0)
+#define jobYield()                      SwitchToThread()
+#define JOB_THREAD_LOCAL                __declspec(thread)
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+typedef pthread_mutex_t JobMutex;
+typedef pthread_cond_t JobCondition;
+typedef pthread_t JobThread;
+
+#define jobMutexInit(mutex)             pthread_mutex_init(mutex, NULL)
+#define jobMutexDestroy(mutex)          pthread_mutex_destroy(mutex)
+#define jobMutexLock(mutex)             pthread_mutex_lock(mutex)
+#define jobMutexUnlock(mutex)           pthread_mutex_unlock(mutex)
+#define jobConditionInit(condition)     pthread_cond_init(condition, NULL)
+#define jobConditionDestroy(condition)  pthread_cond_destroy(condition)
+#define jobConditionWait(condition, mutex) pthread_cond_wait(condition, mutex)
+#define jobConditionWakeAll(condition)  pthread_cond_broadcast(condition)
+#define jobAtomicAdd(value, amount)     __atomic_fetch_add(value, amount, __ATOMIC_ACQ_REL)
+#define jobAtomicLoad(value)            __atomic_load_n(value, __ATOMIC_ACQUIRE)
+#define jobYield()                      sched_yield()
+#define JOB_THREAD_LOCAL                _Thread_local
+#endif
+
+#define JOB_MAX_WORKERS         64      /**< Upper bound on the thread count. */
+#define JOB_DEQUE_CAPACITY      256     /**< Jobs per deque (a power of two); pushes beyond it run inline. */
+#define JOB_CHUNKS_PER_WORKER   4       /**< Chunks per worker used when no grain is given, to even out the load. */
+
+typedef struct
+{
+    JobFunction function;
+    void* data;
+    int begin;
+    int end;
+    volatile long* remaining;   // Chunks of the parallel for that are not finished yet
+} Job;
+
+typedef struct
+{
+    JobMutex lock;
+    Job jobs[JOB_DEQUE_CAPACITY];
+    int top;                    // Next job to steal; top and bottom only grow and wrap through the mask
+    int bottom;                 // Next free entry for the owner
+} JobDeque;
+
+struct JobSystemState;
+
+typedef struct
+{
+    struct JobSystemState* state;
+    int index;
+} JobWorker;
+
+struct JobSystemState
+{
+    JobSystem* jobs;
+    JobDeque* deques;
+    JobWorker* workers;
+    JobThread* threads;
+    int threadCount;            // Threads actually started (worker 0 is the caller and has none)
+
+    JobMutex sleepLock;
+    JobCondition wake;
+    volatile long pending;      // Jobs sitting in the deques
+    int quit;
+};
+
+// Worker of the thread running the code; threads outside the pool share deque 0 with the caller
+static JOB_THREAD_LOCAL JobWorker* jobCurrentWorker = NULL;
+
+static int jobCpuCount(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+static int jobPush(JobDeque* deque, const Job* job)
+{
+    jobMutexLock(&deque->lock);
+    int pushed = deque->bottom - deque->top < JOB_DEQUE_CAPACITY;
+    if (pushed)
+    {
+        deque->jobs[deque->bottom & (JOB_DEQUE_CAPACITY - 1)] = *job;
+        deque->bottom++;
+    }
+    jobMutexUnlock(&deque->lock);
+    return pushed;
+}
+
+// The owner takes its newest job, which is the one most likely to still be in its cache
+static int jobPop(JobDeque* deque, Job* job)
+{
+    jobMutexLock(&deque->lock);
+    int popped = deque->bottom > deque->top;
+    if (popped)
+    {
+        deque->bottom--;
+        *job = deque->jobs[deque->bottom & (JOB_DEQUE_CAPACITY - 1)];
+    }
+    jobMutexUnlock(&deque->lock);
+    return popped;
+}
+
+// Thieves take the oldest job, which is usually the largest block of untouched work
+static int jobStealFrom(JobDeque* deque, Job* job)
+{
+    jobMutexLock(&deque->lock);
+    int stolen = deque->bottom > deque->top;
+    if (stolen)
+    {
+        *job = deque->jobs[deque->top & (JOB_DEQUE_CAPACITY - 1)];
+        deque->top++;
+    }
+    jobMutexUnlock(&deque->lock);
+    return stolen;
+}
+
+static int jobTake(struct JobSystemState* state, int index, Job* job)
+{
+    int workerCount = state->jobs->workerCount;
+
+    int taken = jobPop(&state->deques[index], job);
+    for (int i = 1; !taken && i < workerCount; i++)
+    {
+        taken = jobStealFrom(&state->deques[(index + i) % workerCount], job);
+        if (taken)
+        {
+            jobAtomicAdd(&state->jobs->stealCount, 1);
+        }
+    }
+
+    if (taken)
+    {
+        jobAtomicAdd(&state->pending, -1);
+    }
+    return taken;
+}
+
+static void jobRun(const Job* job)
+{
+    TraceZone zone = TRACE_BEGIN("job");
+    job->function(job->data, job->begin, job->end);
+    TRACE_END(zone);
+
+    // Release the results of the chunk before the caller can see it finished
+    jobAtomicAdd(job->remaining, -1);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI jobWorkerMain(LPVOID argument)
+#else
+static void* jobWorkerMain(void* argument)
+#endif
+{
+    JobWorker* worker = argument;
+    struct JobSystemState* state = worker->state;
+    jobCurrentWorker = worker;
+    TRACE_THREAD_NAME("job worker");
+
+    for (;;)
+    {
+        Job job;
+        if (jobTake(state, worker->index, &job))
+        {
+            jobRun(&job);
+            continue;
+        }
+
+        // Sleep until new jobs are pushed; pending is checked under the lock the pusher takes to wake us
+        jobMutexLock(&state->sleepLock);
+        while (jobAtomicLoad(&state->pending) == 0 && !state->quit)
+        {
+            jobConditionWait(&state->wake, &state->sleepLock);
+        }
+        int quit = state->quit;
+        jobMutexUnlock(&state->sleepLock);
+
+        if (quit)
+        {
+            break;
+        }
+    }
+
+#if defined(_WIN32)
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static void jobStopThreads(struct JobSystemState* state)
+{
+    jobMutexLock(&state->sleepLock);
+    state->quit = 1;
+    jobConditionWakeAll(&state->wake);
+    jobMutexUnlock(&state->sleepLock);
+
+    for (int i = 0; i < state->threadCount; i++)
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(state->threads[i], INFINITE);
+        CloseHandle(state->threads[i]);
+#else
+        pthread_join(state->threads[i], NULL);
+#endif
+    }
+    state->threadCount = 0;
+}
+
+int jobSystemInit(JobSystem* jobs, int threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = jobCpuCount();
+    }
+    if (threadCount > JOB_MAX_WORKERS)
+    {
+        threadCount = JOB_MAX_WORKERS;
+    }
+
+    jobs->workerCount = threadCount;
+    jobs->stealCount = 0;
+    jobs->state = NULL;
+
+    struct JobSystemState* state = calloc(1, sizeof(struct JobSystemState));
+    if (state == NULL)
+    {
+        return 0;
+    }
+    state->jobs = jobs;
+    state->deques = calloc((size_t)threadCount, sizeof(JobDeque));
+    state->workers = calloc((size_t)threadCount, sizeof(JobWorker));
+    state->threads = calloc((size_t)threadCount, sizeof(JobThread));
+    if (state->deques == NULL || state->workers == NULL || state->threads == NULL)
+    {
+        free(state->deques);
+        free(state->workers);
+        free(state->threads);
+        free(state);
+        return 0;
+    }
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        jobMutexInit(&state->deques[i].lock);
+        state->workers[i].state = state;
+        state->workers[i].index = i;
+    }
+    jobMutexInit(&state->sleepLock);
+    jobConditionInit(&state->wake);
+    jobs->state = state;
+
+    // Worker 0 is whichever thread calls jobSystemParallelFor(), so one thread fewer is started
+    for (int i = 1; i < threadCount; i++)
+    {
+#if defined(_WIN32)
+        state->threads[state->threadCount] = CreateThread(NULL, 0, jobWorkerMain, &state->workers[i], 0, NULL);
+        int started = state->threads[state->threadCount] != NULL;
+#else
+        int started = pthread_create(&state->threads[state->threadCount], NULL, jobWorkerMain, &state->workers[i]) == 0;
+#endif
+        if (!started)
+        {
+            jobSystemFree(jobs);
+            return 0;
+        }
+        state->threadCount++;
+    }
+    return 1;
+}
+
+void jobSystemFree(JobSystem* jobs)
+{
+    struct JobSystemState* state = jobs->state;
+    if (state == NULL)
+    {
+        return;
+    }
+
+    jobStopThreads(state);
+    for (int i = 0; i < jobs->workerCount; i++)
+    {
+        jobMutexDestroy(&state->deques[i].lock);
+    }
+    jobMutexDestroy(&state->sleepLock);
+    jobConditionDestroy(&state->wake);
+
+    free(state->deques);
+    free(state->workers);
+    free(state->threads);
+    free(state);
+    jobs->state = NULL;
+    jobs->workerCount = 1;
+}
+
+void jobSystemParallelFor(JobSystem* jobs, JobFunction function, void* data, int count, int grain)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    int workerCount = jobs != NULL && jobs->state != NULL ? jobs->workerCount : 1;
+    if (grain <= 0)
+    {
+        grain = (count + workerCount * JOB_CHUNKS_PER_WORKER - 1) / (workerCount * JOB_CHUNKS_PER_WORKER);
+    }
+    if (workerCount == 1 || grain >= count)
+    {
+        function(data, 0, count);
+        return;
+    }
+
+    struct JobSystemState* state = jobs->state;
+    JobWorker* worker = jobCurrentWorker;
+    int index = worker != NULL && worker->state == state ? worker->index : 0;
+
+    int chunkCount = (count + grain - 1) / grain;
+    volatile long remaining = chunkCount;
+
+    // Push the chunks from the last one, so that the caller pops them in order while thieves take the tail
+    for (int chunk = chunkCount - 1; chunk >= 0; chunk--)
+    {
+        Job job;
+        job.function = function;
+        job.data = data;
+        job.begin = chunk * grain;
+        job.end = job.begin + grain < count ? job.begin + grain : count;
+        job.remaining = &remaining;
+
+        // Count the job as pending before it becomes visible, so that takers never see pending below zero
+        jobAtomicAdd(&state->pending, 1);
+        if (!jobPush(&state->deques[index], &job))
+        {
+            jobAtomicAdd(&state->pending, -1);
+            jobRun(&job);
+        }
+    }
+
+    jobMutexLock(&state->sleepLock);
+    jobConditionWakeAll(&state->wake);
+    jobMutexUnlock(&state->sleepLock);
+
+    // Help until every chunk is done, including chunks of other loops; this keeps nested loops from deadlocking
+    while (jobAtomicLoad(&remaining) > 0)
+    {
+        Job job;
+        if (jobTake(state, index, &job))
+        {
+            jobRun(&job);
+        }
+        else
+        {
+            jobYield();
+        }
+    }
+}
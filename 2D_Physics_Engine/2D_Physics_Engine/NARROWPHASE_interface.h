@@ -0,0 +1,159 @@
+#ifndef __NARROWPHASE_INTERFACE_H__
+#define __NARROWPHASE_INTERFACE_H__
+
+/**
+ * @brief Largest number of contacts one pair can produce (two clipped points for rectangle pairs).
+ */
+#define NARROWPHASE_MAX_MANIFOLD_POINTS 2
+
+/**
+ * @struct Contact
+ * @brief Compact description of one contact point of a touching pair, produced by the narrowphase.
+ *
+ * Circle pairs produce a single contact; rectangle pairs produce a manifold of up to
+ * NARROWPHASE_MAX_MANIFOLD_POINTS contacts that share the pair index and the normal.
+ */
+typedef struct
+{
+    float normalX;      /**< Unit collision normal along the X-axis, pointing from body a to body b. */
+    float normalY;      /**< Unit collision normal along the Y-axis, pointing from body a to body b. */
+    float depth;        /**< Penetration depth along the normal (0 when the bodies just touch). */
+    float pointX;       /**< World contact point along the X-axis, halfway between the two surfaces. */
+    float pointY;       /**< World contact point along the Y-axis, halfway between the two surfaces. */
+    unsigned int feature; /**< Identifies the edges and vertices that produced the point, stable while they stay in contact. */
+    int pairIndex;      /**< Index of the pair in the candidate pair array. */
+} Contact;
+
+/**
+ * @struct SimplexCacheEntry
+ * @brief Support vertices a GJK query on one body pair ended with, used to start the next query.
+ */
+typedef struct
+{
+    unsigned int slotA;         /**< Handle slot of the first shape of the query. */
+    unsigned int slotB;         /**< Handle slot of the second shape, WORLD_INVALID_SLOT for an empty entry. */
+    unsigned char count;        /**< Number of simplex vertices (1 to 3). */
+    unsigned char indexA[3];    /**< Vertex of the first shape behind each simplex vertex. */
+    unsigned char indexB[3];    /**< Vertex of the second shape behind each simplex vertex. */
+} SimplexCacheEntry;
+
+/**
+ * @struct ContactBuffer
+ * @brief Growable array of contacts reused from step to step.
+ *
+ * The buffer also keeps the GJK simplex of every pair involving a polygon. Bodies move little from
+ * one step to the next, so the query starts from the simplex of the previous step and usually
+ * converges in one or two iterations. Like the solver cache, the table is rebuilt every call so
+ * that pairs that left the broadphase drop out.
+ */
+typedef struct
+{
+    Contact* contacts;  /**< The contacts found by the last narrowphase call. */
+    int count;          /**< Number of valid contacts. */
+    int capacity;       /**< Number of contacts the array can hold. */
+
+    SimplexCacheEntry* simplexCache;        /**< Simplices of the previous call. */
+    SimplexCacheEntry* nextSimplexCache;    /**< Simplices of the current call, swapped with simplexCache at the end. */
+    int simplexCapacity;                    /**< Number of entries of each table (a power of two). */
+
+    int gjkPairCount;       /**< Counter: pairs tested with GJK by the last call. */
+    int gjkCachedCount;     /**< Counter: pairs of the last call that started from a cached simplex. */
+    int gjkIterationCount;  /**< Counter: GJK iterations of the last call, summed over the pairs. */
+} ContactBuffer;
+
+/**
+ * @enum NarrowphasePath
+ * @brief Instruction set used by the batched circle narrowphase.
+ */
+typedef enum
+{
+    NARROWPHASE_SCALAR = 0,     /**< Portable C loop, one pair at a time. */
+    NARROWPHASE_SSE = 1,        /**< SSE, four pairs at a time. */
+    NARROWPHASE_AVX2 = 2        /**< AVX2, eight pairs at a time. */
+} NarrowphasePath;
+
+
+/**
+ * @brief Initializes an empty contact buffer.
+ * @param buffer Pointer to the ContactBuffer struct to initialize.
+ */
+void contactBufferInit(ContactBuffer* buffer);
+
+/**
+ * @brief Releases the storage owned by a contact buffer.
+ * @param buffer Pointer to the ContactBuffer struct to release.
+ */
+void contactBufferFree(ContactBuffer* buffer);
+
+/**
+ * @brief Detects the fastest path supported by the running CPU.
+ *
+ * The result is computed once and cached.
+ *
+ * @return The best NarrowphasePath available.
+ */
+NarrowphasePath narrowphaseDetectPath(void);
+
+/**
+ * @brief Tests candidate circle pairs in batches using the best path available on this CPU.
+ *
+ * Overlap is decided on squared distances, so the square root is only taken for touching pairs,
+ * once, to build the normal and depth stored in the contact. Pairs involving a non-circle body
+ * are skipped. The World header must be included before this header.
+ *
+ * @param world Pointer to the World holding the bodies.
+ * @param pairs Candidate pairs, for example produced by a broadphase.
+ * @param pairCount Number of pairs in the array.
+ * @param buffer Receives one contact per touching pair (previous contents are discarded).
+ * @return 1 on success, 0 if the contact buffer could not grow.
+ */
+int narrowphaseCollideCircles(const World* world, const BodyPair* pairs, int pairCount, ContactBuffer* buffer);
+
+/**
+ * @brief Same as narrowphaseCollideCircles() but forces a given path.
+ *
+ * A path the CPU does not support falls back to the scalar loop.
+ *
+ * @param path The path to use.
+ * @param world Pointer to the World holding the bodies.
+ * @param pairs Candidate pairs.
+ * @param pairCount Number of pairs in the array.
+ * @param buffer Receives one contact per touching pair.
+ * @return 1 on success, 0 if the contact buffer could not grow.
+ */
+int narrowphaseCollideCirclesWith(NarrowphasePath path, const World* world, const BodyPair* pairs, int pairCount, ContactBuffer* buffer);
+
+/**
+ * @brief Tests candidate pairs of any shapes.
+ *
+ * Circle pairs go through the batched kernels of narrowphaseCollideCircles(). The other pairs are
+ * handled in a second pass over the same pair array:
+ * - rectangle-rectangle pairs get a separating-axis test and a manifold of up to two points, made
+ *   by clipping the incident edge against the reference face;
+ * - rectangle-circle pairs produce one point;
+ * - pairs involving a polygon run GJK from the cached simplex of the pair. Overlapping polygons
+ *   then run EPA for the penetration normal, which selects the faces clipped into the manifold;
+ *   polygon-circle pairs produce one point.
+ *
+ * @param world Pointer to the World holding the bodies.
+ * @param pairs Candidate pairs, for example produced by a broadphase.
+ * @param pairCount Number of pairs in the array.
+ * @param buffer Receives the contacts of every touching pair (previous contents are discarded).
+ * @return 1 on success, 0 if the contact buffer could not grow.
+ */
+int narrowphaseCollide(const World* world, const BodyPair* pairs, int pairCount, ContactBuffer* buffer);
+
+/**
+ * @brief Resolves contacts produced by the narrowphase without recomputing any distance.
+ *
+ * Applies the same positional correction and impulse as resolveCollision, using the normal and
+ * depth stored in each contact.
+ *
+ * @param world Pointer to the World holding the bodies.
+ * @param pairs The candidate pairs passed to the narrowphase.
+ * @param buffer The contacts produced from those pairs.
+ */
+void narrowphaseResolveContacts(World* world, const BodyPair* pairs, const ContactBuffer* buffer);
+
+
+#endif /**< __NARROWPHASE_INTERFACE_H__ */
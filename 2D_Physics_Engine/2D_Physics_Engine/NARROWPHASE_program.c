@@ -0,0 +1,1205 @@
+#include <stdlib.h>
+#include <math.h>
+#include "WORLD_interface.h"
+#include "NARROWPHASE_interface.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define NARROWPHASE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define NARROWPHASE_TARGET_SSE
+#define NARROWPHASE_TARGET_AVX2
+#else
+#define NARROWPHASE_TARGET_SSE __attribute__((target("sse2")))
+#define NARROWPHASE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define NARROWPHASE_X86 0
+#endif
+
+#define NARROWPHASE_RELATIVE_TOLERANCE   0.95f   /**< Reference face hysteresis, relative to the separation of body a. */
+#define NARROWPHASE_ABSOLUTE_TOLERANCE   0.5f    /**< Reference face hysteresis in pixels. */
+#define NARROWPHASE_ALIGNMENT_TOLERANCE  0.01f   /**< Reference face hysteresis of polygon pairs, on the cosine to the EPA normal. */
+#define NARROWPHASE_GJK_MAX_ITERATIONS   20      /**< Bound on GJK iterations; cached queries usually need one or two. */
+#define NARROWPHASE_GJK_EPSILON          1e-4f   /**< Distances below this (in pixels) count as touching. */
+#define NARROWPHASE_EPA_MAX_VERTICES     32      /**< Largest EPA polytope; polygons have few vertices, so this is rarely reached. */
+#define NARROWPHASE_EPA_TOLERANCE        0.01f   /**< EPA stops when the boundary is closer than this (in pixels). */
+
+void contactBufferInit(ContactBuffer* buffer)
+{
+    buffer->contacts = NULL;
+    buffer->count = 0;
+    buffer->capacity = 0;
+    buffer->simplexCache = NULL;
+    buffer->nextSimplexCache = NULL;
+    buffer->simplexCapacity = 0;
+    buffer->gjkPairCount = 0;
+    buffer->gjkCachedCount = 0;
+    buffer->gjkIterationCount = 0;
+}
+
+void contactBufferFree(ContactBuffer* buffer)
+{
+    free(buffer->contacts);
+    free(buffer->simplexCache);
+    free(buffer->nextSimplexCache);
+    contactBufferInit(buffer);
+}
+
+static int contactBufferReserve(ContactBuffer* buffer, int capacity)
+{
+    if (capacity <= buffer->capacity)
+    {
+        return 1;
+    }
+
+    Contact* contacts = realloc(buffer->contacts, sizeof(Contact) * (size_t)capacity);
+    if (contacts == NULL)
+    {
+        return 0;
+    }
+    buffer->contacts = contacts;
+    buffer->capacity = capacity;
+    return 1;
+}
+
+static void narrowphaseEmit(const World* world, const BodyPair* pair, int pairIndex,
+    float dx, float dy, float distance, float radiusSum, ContactBuffer* buffer)
+{
+    // The SIMD paths test every lane; rectangles are filtered here, on the rare touching pairs
+    if (world->type[pair->a] != BODY_CIRCLE || world->type[pair->b] != BODY_CIRCLE)
+    {
+        return;
+    }
+
+    Contact* contact = &buffer->contacts[buffer->count++];
+    if (distance > 0.0f)
+    {
+        float inverse = 1.0f / distance;
+        contact->normalX = dx * inverse;
+        contact->normalY = dy * inverse;
+    }
+    else
+    {
+        // Coincident centers: any direction separates them
+        contact->normalX = 1.0f;
+        contact->normalY = 0.0f;
+    }
+    contact->depth = radiusSum - distance;
+    float reach = world->radius[pair->a] - contact->depth * 0.5f;
+    contact->pointX = world->posX[pair->a] + contact->normalX * reach;
+    contact->pointY = world->posY[pair->a] + contact->normalY * reach;
+    contact->feature = 0;
+    contact->pairIndex = pairIndex;
+}
+
+static void narrowphaseScalar(const World* world, const BodyPair* pairs, int begin, int end, ContactBuffer* buffer)
+{
+    const float* posX = world->posX;
+    const float* posY = world->posY;
+    const float* radius = world->radius;
+
+    for (int i = begin; i < end; i++)
+    {
+        int a = pairs[i].a;
+        int b = pairs[i].b;
+        float dx = posX[b] - posX[a];
+        float dy = posY[b] - posY[a];
+        float radiusSum = radius[a] + radius[b];
+        float distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared > radiusSum * radiusSum)
+        {
+            continue;
+        }
+        narrowphaseEmit(world, &pairs[i], i, dx, dy, sqrtf(distanceSquared), radiusSum, buffer);
+    }
+}
+
+#if NARROWPHASE_X86
+
+NARROWPHASE_TARGET_SSE
+static int narrowphaseSse(const World* world, const BodyPair* pairs, int pairCount, ContactBuffer* buffer)
+{
+    const float* posX = world->posX;
+    const float* posY = world->posY;
+    const float* radius = world->radius;
+    int i = 0;
+
+    for (; i + 4 <= pairCount; i += 4)
+    {
+        const BodyPair* p = &pairs[i];
+        __m128 ax = _mm_set_ps(posX[p[3].a], posX[p[2].a], posX[p[1].a], posX[p[0].a]);
+        __m128 ay = _mm_set_ps(posY[p[3].a], posY[p[2].a], posY[p[1].a], posY[p[0].a]);
+        __m128 ar = _mm_set_ps(radius[p[3].a], radius[p[2].a], radius[p[1].a], radius[p[0].a]);
+        __m128 bx = _mm_set_ps(posX[p[3].b], posX[p[2].b], posX[p[1].b], posX[p[0].b]);
+        __m128 by = _mm_set_ps(posY[p[3].b], posY[p[2].b], posY[p[1].b], posY[p[0].b]);
+        __m128 br = _mm_set_ps(radius[p[3].b], radius[p[2].b], radius[p[1].b], radius[p[0].b]);
+
+        __m128 dx = _mm_sub_ps(bx, ax);
+        __m128 dy = _mm_sub_ps(by, ay);
+        __m128 radiusSum = _mm_add_ps(ar, br);
+        __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int mask = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(radiusSum, radiusSum)));
+        if (mask == 0)
+        {
+            continue;
+        }
+
+        float laneDx[4], laneDy[4], laneDistance[4], laneRadiusSum[4];
+        _mm_storeu_ps(laneDx, dx);
+        _mm_storeu_ps(laneDy, dy);
+        _mm_storeu_ps(laneDistance, _mm_sqrt_ps(distanceSquared));
+        _mm_storeu_ps(laneRadiusSum, radiusSum);
+        for (int lane = 0; lane < 4; lane++)
+        {
+            if (mask & (1 << lane))
+            {
+                narrowphaseEmit(world, &p[lane], i + lane, laneDx[lane], laneDy[lane], laneDistance[lane], laneRadiusSum[lane], buffer);
+            }
+        }
+    }
+
+    narrowphaseScalar(world, pairs, i, pairCount, buffer);
+    return 1;
+}
+
+NARROWPHASE_TARGET_AVX2
+static int narrowphaseAvx2(const World* world, const BodyPair* pairs, int pairCount, ContactBuffer* buffer)
+{
+    const float* posX = world->posX;
+    const float* posY = world->posY;
+    const float* radius = world->radius;
+    int i = 0;
+
+    for (; i + 8 <= pairCount; i += 8)
+    {
+        // Lanes are filled with scalar loads: vgatherdps is microcoded (and slowed further by the
+        // gather data sampling mitigation) on many CPUs, and is no faster for random indices
+        const BodyPair* p = &pairs[i];
+        __m256 ax = _mm256_set_ps(posX[p[7].a], posX[p[6].a], posX[p[5].a], posX[p[4].a], posX[p[3].a], posX[p[2].a], posX[p[1].a], posX[p[0].a]);
+        __m256 ay = _mm256_set_ps(posY[p[7].a], posY[p[6].a], posY[p[5].a], posY[p[4].a], posY[p[3].a], posY[p[2].a], posY[p[1].a], posY[p[0].a]);
+        __m256 ar = _mm256_set_ps(radius[p[7].a], radius[p[6].a], radius[p[5].a], radius[p[4].a], radius[p[3].a], radius[p[2].a], radius[p[1].a], radius[p[0].a]);
+        __m256 bx = _mm256_set_ps(posX[p[7].b], posX[p[6].b], posX[p[5].b], posX[p[4].b], posX[p[3].b], posX[p[2].b], posX[p[1].b], posX[p[0].b]);
+        __m256 by = _mm256_set_ps(posY[p[7].b], posY[p[6].b], posY[p[5].b], posY[p[4].b], posY[p[3].b], posY[p[2].b], posY[p[1].b], posY[p[0].b]);
+        __m256 br = _mm256_set_ps(radius[p[7].b], radius[p[6].b], radius[p[5].b], radius[p[4].b], radius[p[3].b], radius[p[2].b], radius[p[1].b], radius[p[0].b]);
+
+        __m256 dx = _mm256_sub_ps(bx, ax);
+        __m256 dy = _mm256_sub_ps(by, ay);
+        __m256 radiusSum = _mm256_add_ps(ar, br);
+        __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, _mm256_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ));
+        if (mask == 0)
+        {
+            continue;
+        }
+
+        float laneDx[8], laneDy[8], laneDistance[8], laneRadiusSum[8];
+        _mm256_storeu_ps(laneDx, dx);
+        _mm256_storeu_ps(laneDy, dy);
+        _mm256_storeu_ps(laneDistance, _mm256_sqrt_ps(distanceSquared));
+        _mm256_storeu_ps(laneRadiusSum, radiusSum);
+
+        // narrowphaseEmit is plain SSE code: clear the upper halves to avoid AVX/SSE transition stalls
+        _mm256_zeroupper();
+        for (int lane = 0; lane < 8; lane++)
+        {
+            if (mask & (1 << lane))
+            {
+                narrowphaseEmit(world, &p[lane], i + lane, laneDx[lane], laneDy[lane], laneDistance[lane], laneRadiusSum[lane], buffer);
+            }
+        }
+    }
+
+    narrowphaseScalar(world, pairs, i, pairCount, buffer);
+    return 1;
+}
+
+static int narrowphaseCpuHasSse2(void)
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    return 1; // SSE2 is part of the x86-64 baseline
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] >> 26) & 1;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+static int narrowphaseCpuHasAvx2(void)
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return 0;
+    }
+
+    // AVX state must also be enabled by the operating system (OSXSAVE + XCR0)
+    __cpuid(info, 1);
+    if (!((info[2] >> 27) & 1) || !((info[2] >> 28) & 1) || (_xgetbv(0) & 6) != 6)
+    {
+        return 0;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] >> 5) & 1;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif /**< NARROWPHASE_X86 */
+
+NarrowphasePath narrowphaseDetectPath(void)
+{
+    static int detectedPath = -1;
+
+    if (detectedPath < 0)
+    {
+        detectedPath = NARROWPHASE_SCALAR;
+#if NARROWPHASE_X86
+        if (narrowphaseCpuHasAvx2())
+        {
+            detectedPath = NARROWPHASE_AVX2;
+        }
+        else if (narrowphaseCpuHasSse2())
+        {
+            detectedPath = NARROWPHASE_SSE;
+        }
+#endif
+    }
+    return (NarrowphasePath)detectedPath;
+}
+
+int narrowphaseCollideCirclesWith(NarrowphasePath path, const World* world, const BodyPair* pairs, int pairCount, ContactBuffer* buffer)
+{
+    // At most one contact per pair, so the buffer never grows inside the kernels
+    buffer->count = 0;
+    if (!contactBufferReserve(buffer, pairCount))
+    {
+        return 0;
+    }
+
+    if (path > narrowphaseDetectPath())
+    {
+        path = NARROWPHASE_SCALAR;
+    }
+
+#if NARROWPHASE_X86
+    if (path == NARROWPHASE_AVX2)
+    {
+        return narrowphaseAvx2(world, pairs, pairCount, buffer);
+    }
+    if (path == NARROWPHASE_SSE)
+    {
+        return narrowphaseSse(world, pairs, pairCount, buffer);
+    }
+#endif
+
+    narrowphaseScalar(world, pairs, 0, pairCount, buffer);
+    return 1;
+}
+
+int narrowphaseCollideCircles(const World* world, const BodyPair* pairs, int pairCount, ContactBuffer* buffer)
+{
+    return narrowphaseCollideCirclesWith(narrowphaseDetectPath(), world, pairs, pairCount, buffer);
+}
+
+// World-space outline of a rectangle or polygon, counter-clockwise in a Y-up frame; edge i runs
+// from vertex i to vertex i + 1 and its outward normal is on its right
+typedef struct
+{
+    int count;
+    float vertexX[WORLD_MAX_POLYGON_VERTICES];
+    float vertexY[WORLD_MAX_POLYGON_VERTICES];
+    float normalX[WORLD_MAX_POLYGON_VERTICES];
+    float normalY[WORLD_MAX_POLYGON_VERTICES];
+} NarrowphasePolygon;
+
+static void narrowphaseMakePolygon(const World* world, int body, NarrowphasePolygon* polygon)
+{
+    static const float cornerX[4] = { -1.0f, 1.0f, 1.0f, -1.0f };
+    static const float cornerY[4] = { -1.0f, -1.0f, 1.0f, 1.0f };
+    float cosine = cosf(world->angle[body]);
+    float sine = sinf(world->angle[body]);
+
+    if (world->type[body] == BODY_RECTANGLE)
+    {
+        polygon->count = 4;
+        for (int i = 0; i < 4; i++)
+        {
+            float localX = cornerX[i] * world->extentX[body];
+            float localY = cornerY[i] * world->extentY[body];
+            polygon->vertexX[i] = world->posX[body] + cosine * localX - sine * localY;
+            polygon->vertexY[i] = world->posY[body] + sine * localX + cosine * localY;
+        }
+    }
+    else
+    {
+        int start = world->vertexStart[body];
+        polygon->count = world->vertexCount[body];
+        for (int i = 0; i < polygon->count; i++)
+        {
+            float localX = world->vertexX[start + i];
+            float localY = world->vertexY[start + i];
+            polygon->vertexX[i] = world->posX[body] + cosine * localX - sine * localY;
+            polygon->vertexY[i] = world->posY[body] + sine * localX + cosine * localY;
+        }
+    }
+
+    for (int i = 0; i < polygon->count; i++)
+    {
+        int j = i + 1 < polygon->count ? i + 1 : 0;
+        float edgeX = polygon->vertexX[j] - polygon->vertexX[i];
+        float edgeY = polygon->vertexY[j] - polygon->vertexY[i];
+        float inverse = 1.0f / sqrtf(edgeX * edgeX + edgeY * edgeY);
+        polygon->normalX[i] = edgeY * inverse;
+        polygon->normalY[i] = -edgeX * inverse;
+    }
+}
+
+// Largest separation of the other polygon from the edges of a polygon, and the edge that gives it
+static float narrowphaseMaxSeparation(const NarrowphasePolygon* polygon, const NarrowphasePolygon* other, int* edge)
+{
+    float best = -INFINITY;
+    for (int i = 0; i < polygon->count; i++)
+    {
+        float separation = INFINITY;
+        for (int j = 0; j < other->count; j++)
+        {
+            float distance = polygon->normalX[i] * (other->vertexX[j] - polygon->vertexX[i])
+                + polygon->normalY[i] * (other->vertexY[j] - polygon->vertexY[i]);
+            separation = distance < separation ? distance : separation;
+        }
+        if (separation > best)
+        {
+            best = separation;
+            *edge = i;
+        }
+    }
+    return best;
+}
+
+// Keeps the part of a segment on the inner side of the line direction . point <= offset
+static int narrowphaseClipSegment(const float inX[2], const float inY[2], float directionX, float directionY, float offset,
+    float outX[2], float outY[2], int outVertex[2], const int inVertex[2])
+{
+    float distance0 = directionX * inX[0] + directionY * inY[0] - offset;
+    float distance1 = directionX * inX[1] + directionY * inY[1] - offset;
+    int count = 0;
+
+    if (distance0 <= 0.0f)
+    {
+        outX[count] = inX[0];
+        outY[count] = inY[0];
+        outVertex[count++] = inVertex[0];
+    }
+    if (distance1 <= 0.0f)
+    {
+        outX[count] = inX[1];
+        outY[count] = inY[1];
+        outVertex[count++] = inVertex[1];
+    }
+
+    // The segment crosses the line: add the intersection, which keeps the id of the clipped vertex
+    if (distance0 * distance1 < 0.0f)
+    {
+        float t = distance0 / (distance0 - distance1);
+        outX[count] = inX[0] + t * (inX[1] - inX[0]);
+        outY[count] = inY[0] + t * (inY[1] - inY[0]);
+        outVertex[count++] = distance0 > 0.0f ? inVertex[0] : inVertex[1];
+    }
+    return count;
+}
+
+// Clips the incident edge against a reference face and emits the points below that face. flip is
+// non-zero when the reference polygon is body b, since contact normals point from a to b
+static void narrowphaseClipManifold(const NarrowphasePolygon* reference, int referenceEdge, const NarrowphasePolygon* incident,
+    int flip, int pairIndex, ContactBuffer* buffer)
+{
+    float normalX = reference->normalX[referenceEdge];
+    float normalY = reference->normalY[referenceEdge];
+
+    // The incident edge is the edge of the other polygon facing the reference face the most
+    int incidentEdge = 0;
+    float minimum = INFINITY;
+    for (int i = 0; i < incident->count; i++)
+    {
+        float facing = normalX * incident->normalX[i] + normalY * incident->normalY[i];
+        if (facing < minimum)
+        {
+            minimum = facing;
+            incidentEdge = i;
+        }
+    }
+    int incidentVertex[2] = { incidentEdge, incidentEdge + 1 < incident->count ? incidentEdge + 1 : 0 };
+    float segmentX[2] = { incident->vertexX[incidentVertex[0]], incident->vertexX[incidentVertex[1]] };
+    float segmentY[2] = { incident->vertexY[incidentVertex[0]], incident->vertexY[incidentVertex[1]] };
+
+    // Clip the incident edge to the side planes of the reference face
+    int referenceNext = referenceEdge + 1 < reference->count ? referenceEdge + 1 : 0;
+    float tangentX = -normalY;
+    float tangentY = normalX;
+    float clipX[2], clipY[2], finalX[2], finalY[2];
+    int clipVertex[2], finalVertex[2];
+    float sideOffset1 = -(tangentX * reference->vertexX[referenceEdge] + tangentY * reference->vertexY[referenceEdge]);
+    float sideOffset2 = tangentX * reference->vertexX[referenceNext] + tangentY * reference->vertexY[referenceNext];
+    if (narrowphaseClipSegment(segmentX, segmentY, -tangentX, -tangentY, sideOffset1, clipX, clipY, clipVertex, incidentVertex) < 2
+        || narrowphaseClipSegment(clipX, clipY, tangentX, tangentY, sideOffset2, finalX, finalY, finalVertex, clipVertex) < 2)
+    {
+        return;
+    }
+
+    // Keep the clipped points below the reference face
+    float frontOffset = normalX * reference->vertexX[referenceEdge] + normalY * reference->vertexY[referenceEdge];
+    for (int i = 0; i < 2; i++)
+    {
+        float separation = normalX * finalX[i] + normalY * finalY[i] - frontOffset;
+        if (separation > 0.0f)
+        {
+            continue;
+        }
+
+        Contact* contact = &buffer->contacts[buffer->count++];
+        contact->normalX = flip ? -normalX : normalX;
+        contact->normalY = flip ? -normalY : normalY;
+        contact->depth = -separation;
+        contact->pointX = finalX[i] - normalX * separation * 0.5f;
+        contact->pointY = finalY[i] - normalY * separation * 0.5f;
+        contact->feature = ((unsigned int)flip << 12) | ((unsigned int)referenceEdge << 8)
+            | ((unsigned int)incidentEdge << 4) | (unsigned int)finalVertex[i];
+        contact->pairIndex = pairIndex;
+    }
+}
+
+static void narrowphaseBoxBox(const World* world, const BodyPair* pair, int pairIndex, ContactBuffer* buffer)
+{
+    NarrowphasePolygon boxA, boxB;
+    narrowphaseMakePolygon(world, pair->a, &boxA);
+    narrowphaseMakePolygon(world, pair->b, &boxB);
+
+    int edgeA = 0, edgeB = 0;
+    float separationA = narrowphaseMaxSeparation(&boxA, &boxB, &edgeA);
+    if (separationA > 0.0f)
+    {
+        return;
+    }
+    float separationB = narrowphaseMaxSeparation(&boxB, &boxA, &edgeB);
+    if (separationB > 0.0f)
+    {
+        return;
+    }
+
+    // Prefer the face of body a unless b is clearly better, so that the reference face (and with it
+    // the feature ids used for warm starting) does not flicker between faces of equal depth
+    if (separationB > NARROWPHASE_RELATIVE_TOLERANCE * separationA + NARROWPHASE_ABSOLUTE_TOLERANCE)
+    {
+        narrowphaseClipManifold(&boxB, edgeB, &boxA, 1, pairIndex, buffer);
+    }
+    else
+    {
+        narrowphaseClipManifold(&boxA, edgeA, &boxB, 0, pairIndex, buffer);
+    }
+}
+
+static void narrowphaseBoxCircle(const World* world, int box, int circle, int circleIsA, int pairIndex, ContactBuffer* buffer)
+{
+    float cosine = cosf(world->angle[box]);
+    float sine = sinf(world->angle[box]);
+    float extentX = world->extentX[box];
+    float extentY = world->extentY[box];
+    float radius = world->radius[circle];
+
+    // Circle center in the frame of the box
+    float dx = world->posX[circle] - world->posX[box];
+    float dy = world->posY[circle] - world->posY[box];
+    float localX = cosine * dx + sine * dy;
+    float localY = cosine * dy - sine * dx;
+
+    float closestX = fmaxf(-extentX, fminf(localX, extentX));
+    float closestY = fmaxf(-extentY, fminf(localY, extentY));
+    float offsetX = localX - closestX;
+    float offsetY = localY - closestY;
+    float distanceSquared = offsetX * offsetX + offsetY * offsetY;
+    if (distanceSquared > radius * radius)
+    {
+        return;
+    }
+
+    float normalX, normalY, depth;
+    if (distanceSquared > 0.0f)
+    {
+        float distance = sqrtf(distanceSquared);
+        normalX = offsetX / distance;
+        normalY = offsetY / distance;
+        depth = radius - distance;
+    }
+    else
+    {
+        // The center is inside the box: push it out through the nearest face
+        float gapX = extentX - fabsf(localX);
+        float gapY = extentY - fabsf(localY);
+        normalX = gapX < gapY ? (localX < 0.0f ? -1.0f : 1.0f) : 0.0f;
+        normalY = gapX < gapY ? 0.0f : (localY < 0.0f ? -1.0f : 1.0f);
+        closestX = gapX < gapY ? normalX * extentX : localX;
+        closestY = gapX < gapY ? localY : normalY * extentY;
+        depth = radius + (gapX < gapY ? gapX : gapY);
+    }
+
+    // Halfway between the box surface and the deepest point of the circle, back in world space
+    float pointX = 0.5f * (closestX + localX - normalX * radius);
+    float pointY = 0.5f * (closestY + localY - normalY * radius);
+
+    Contact* contact = &buffer->contacts[buffer->count++];
+    float worldNormalX = cosine * normalX - sine * normalY;
+    float worldNormalY = sine * normalX + cosine * normalY;
+    contact->normalX = circleIsA ? -worldNormalX : worldNormalX;
+    contact->normalY = circleIsA ? -worldNormalY : worldNormalY;
+    contact->depth = depth;
+    contact->pointX = world->posX[box] + cosine * pointX - sine * pointY;
+    contact->pointY = world->posY[box] + sine * pointX + cosine * pointY;
+    contact->feature = 0;
+    contact->pairIndex = pairIndex;
+}
+
+// One vertex of the GJK simplex, a point of the Minkowski difference B - A
+typedef struct
+{
+    float pointAX, pointAY;     // Support point on shape A
+    float pointBX, pointBY;     // Support point on shape B
+    float x, y;                 // pointB - pointA
+    float weight;               // Barycentric coordinate of the closest point to the origin
+    int indexA, indexB;
+} NarrowphaseSimplexVertex;
+
+typedef struct
+{
+    NarrowphaseSimplexVertex vertex[3];
+    int count;
+} NarrowphaseSimplex;
+
+static int narrowphaseSupport(const NarrowphasePolygon* polygon, float directionX, float directionY)
+{
+    int best = 0;
+    float bestDot = polygon->vertexX[0] * directionX + polygon->vertexY[0] * directionY;
+    for (int i = 1; i < polygon->count; i++)
+    {
+        float dot = polygon->vertexX[i] * directionX + polygon->vertexY[i] * directionY;
+        if (dot > bestDot)
+        {
+            best = i;
+            bestDot = dot;
+        }
+    }
+    return best;
+}
+
+static void narrowphaseSetSimplexVertex(NarrowphaseSimplexVertex* vertex, const NarrowphasePolygon* shapeA, int indexA,
+    const NarrowphasePolygon* shapeB, int indexB)
+{
+    vertex->indexA = indexA;
+    vertex->indexB = indexB;
+    vertex->pointAX = shapeA->vertexX[indexA];
+    vertex->pointAY = shapeA->vertexY[indexA];
+    vertex->pointBX = shapeB->vertexX[indexB];
+    vertex->pointBY = shapeB->vertexY[indexB];
+    vertex->x = vertex->pointBX - vertex->pointAX;
+    vertex->y = vertex->pointBY - vertex->pointAY;
+    vertex->weight = 1.0f;
+}
+
+// Reduces a segment to the sub-simplex closest to the origin
+static void narrowphaseSolveSegment(NarrowphaseSimplex* simplex)
+{
+    NarrowphaseSimplexVertex* v = simplex->vertex;
+    float edgeX = v[1].x - v[0].x;
+    float edgeY = v[1].y - v[0].y;
+    float weight2 = -(v[0].x * edgeX + v[0].y * edgeY);
+    float weight1 = v[1].x * edgeX + v[1].y * edgeY;
+
+    if (weight2 <= 0.0f)
+    {
+        v[0].weight = 1.0f;
+        simplex->count = 1;
+    }
+    else if (weight1 <= 0.0f)
+    {
+        v[0] = v[1];
+        v[0].weight = 1.0f;
+        simplex->count = 1;
+    }
+    else
+    {
+        float inverse = 1.0f / (weight1 + weight2);
+        v[0].weight = weight1 * inverse;
+        v[1].weight = weight2 * inverse;
+    }
+}
+
+// Reduces a triangle to the sub-simplex closest to the origin, using the Voronoi regions of its features
+static void narrowphaseSolveTriangle(NarrowphaseSimplex* simplex)
+{
+    NarrowphaseSimplexVertex* v = simplex->vertex;
+    float e12X = v[1].x - v[0].x, e12Y = v[1].y - v[0].y;
+    float e13X = v[2].x - v[0].x, e13Y = v[2].y - v[0].y;
+    float e23X = v[2].x - v[1].x, e23Y = v[2].y - v[1].y;
+
+    float d12_1 = v[1].x * e12X + v[1].y * e12Y;
+    float d12_2 = -(v[0].x * e12X + v[0].y * e12Y);
+    float d13_1 = v[2].x * e13X + v[2].y * e13Y;
+    float d13_2 = -(v[0].x * e13X + v[0].y * e13Y);
+    float d23_1 = v[2].x * e23X + v[2].y * e23Y;
+    float d23_2 = -(v[1].x * e23X + v[1].y * e23Y);
+
+    float area = e12X * e13Y - e12Y * e13X;
+    float d123_1 = area * (v[1].x * v[2].y - v[1].y * v[2].x);
+    float d123_2 = area * (v[2].x * v[0].y - v[2].y * v[0].x);
+    float d123_3 = area * (v[0].x * v[1].y - v[0].y * v[1].x);
+
+    if (d12_2 <= 0.0f && d13_2 <= 0.0f)
+    {
+        v[0].weight = 1.0f;
+        simplex->count = 1;
+    }
+    else if (d12_1 > 0.0f && d12_2 > 0.0f && d123_3 <= 0.0f)
+    {
+        float inverse = 1.0f / (d12_1 + d12_2);
+        v[0].weight = d12_1 * inverse;
+        v[1].weight = d12_2 * inverse;
+        simplex->count = 2;
+    }
+    else if (d13_1 > 0.0f && d13_2 > 0.0f && d123_2 <= 0.0f)
+    {
+        float inverse = 1.0f / (d13_1 + d13_2);
+        v[0].weight = d13_1 * inverse;
+        v[1] = v[2];
+        v[1].weight = d13_2 * inverse;
+        simplex->count = 2;
+    }
+    else if (d12_1 <= 0.0f && d23_2 <= 0.0f)
+    {
+        v[0] = v[1];
+        v[0].weight = 1.0f;
+        simplex->count = 1;
+    }
+    else if (d13_1 <= 0.0f && d23_1 <= 0.0f)
+    {
+        v[0] = v[2];
+        v[0].weight = 1.0f;
+        simplex->count = 1;
+    }
+    else if (d23_1 > 0.0f && d23_2 > 0.0f && d123_1 <= 0.0f)
+    {
+        float inverse = 1.0f / (d23_1 + d23_2);
+        v[0] = v[2];
+        v[0].weight = d23_2 * inverse;
+        v[1].weight = d23_1 * inverse;
+        simplex->count = 2;
+    }
+    else
+    {
+        // The origin is inside the triangle
+        float inverse = 1.0f / (d123_1 + d123_2 + d123_3);
+        v[0].weight = d123_1 * inverse;
+        v[1].weight = d123_2 * inverse;
+        v[2].weight = d123_3 * inverse;
+    }
+}
+
+// Returns the entry holding the key, or the empty entry where the key would be inserted.
+// The tables are never more than half full, so the probe always terminates.
+static SimplexCacheEntry* narrowphaseFindSimplex(SimplexCacheEntry* table, int capacity, unsigned int slotA, unsigned int slotB)
+{
+    unsigned int mask = (unsigned int)capacity - 1;
+    unsigned int i = (slotA * 73856093u ^ slotB * 19349663u) & mask;
+
+    while (table[i].slotB != WORLD_INVALID_SLOT && (table[i].slotA != slotA || table[i].slotB != slotB))
+    {
+        i = (i + 1) & mask;
+    }
+    return &table[i];
+}
+
+static void narrowphaseClearSimplices(SimplexCacheEntry* table, int capacity)
+{
+    for (int i = 0; i < capacity; i++)
+    {
+        table[i].slotB = WORLD_INVALID_SLOT;
+    }
+}
+
+static int narrowphaseReserveSimplices(ContactBuffer* buffer, int pairCount)
+{
+    // Keep the load factor of the tables at or below one half
+    int capacity = buffer->simplexCapacity > 0 ? buffer->simplexCapacity : 64;
+    while (capacity < pairCount * 2)
+    {
+        capacity *= 2;
+    }
+    if (capacity == buffer->simplexCapacity)
+    {
+        return 1;
+    }
+
+    SimplexCacheEntry* cache = malloc(sizeof(SimplexCacheEntry) * (size_t)capacity);
+    SimplexCacheEntry* nextCache = malloc(sizeof(SimplexCacheEntry) * (size_t)capacity);
+    if (cache == NULL || nextCache == NULL)
+    {
+        free(cache);
+        free(nextCache);
+        return 0;
+    }
+
+    // Rehash the simplices of the previous call into the larger table
+    narrowphaseClearSimplices(cache, capacity);
+    for (int i = 0; i < buffer->simplexCapacity; i++)
+    {
+        const SimplexCacheEntry* old = &buffer->simplexCache[i];
+        if (old->slotB != WORLD_INVALID_SLOT)
+        {
+            *narrowphaseFindSimplex(cache, capacity, old->slotA, old->slotB) = *old;
+        }
+    }
+
+    free(buffer->simplexCache);
+    free(buffer->nextSimplexCache);
+    buffer->simplexCache = cache;
+    buffer->nextSimplexCache = nextCache;
+    buffer->simplexCapacity = capacity;
+    return 1;
+}
+
+// Distance between two convex shapes with GJK, started from the simplex cached for the pair.
+// Returns the distance and the closest points; on overlap the distance is 0 and the simplex
+// holds a triangle enclosing the origin (or a smaller simplex when the shapes only touch)
+static float narrowphaseGjk(ContactBuffer* buffer, unsigned int slotA, const NarrowphasePolygon* shapeA,
+    unsigned int slotB, const NarrowphasePolygon* shapeB, NarrowphaseSimplex* simplex,
+    float* closestAX, float* closestAY, float* closestBX, float* closestBY)
+{
+    const SimplexCacheEntry* cached = narrowphaseFindSimplex(buffer->simplexCache, buffer->simplexCapacity, slotA, slotB);
+    simplex->count = 0;
+    if (cached->slotB != WORLD_INVALID_SLOT)
+    {
+        for (int i = 0; i < cached->count; i++)
+        {
+            if (cached->indexA[i] >= shapeA->count || cached->indexB[i] >= shapeB->count)
+            {
+                simplex->count = 0;
+                break;
+            }
+            narrowphaseSetSimplexVertex(&simplex->vertex[simplex->count++], shapeA, cached->indexA[i], shapeB, cached->indexB[i]);
+        }
+        buffer->gjkCachedCount += simplex->count > 0;
+    }
+    if (simplex->count == 0)
+    {
+        narrowphaseSetSimplexVertex(&simplex->vertex[0], shapeA, 0, shapeB, 0);
+        simplex->count = 1;
+    }
+    buffer->gjkPairCount++;
+
+    for (int iteration = 0; iteration < NARROWPHASE_GJK_MAX_ITERATIONS; iteration++)
+    {
+        int previousCount = simplex->count;
+        int previousA[3], previousB[3];
+        for (int i = 0; i < previousCount; i++)
+        {
+            previousA[i] = simplex->vertex[i].indexA;
+            previousB[i] = simplex->vertex[i].indexB;
+        }
+
+        if (simplex->count == 2)
+        {
+            narrowphaseSolveSegment(simplex);
+        }
+        else if (simplex->count == 3)
+        {
+            narrowphaseSolveTriangle(simplex);
+        }
+        if (simplex->count == 3)
+        {
+            break;
+        }
+
+        // Search towards the origin from the closest feature
+        const NarrowphaseSimplexVertex* v = simplex->vertex;
+        float directionX, directionY;
+        if (simplex->count == 1)
+        {
+            directionX = -v[0].x;
+            directionY = -v[0].y;
+        }
+        else
+        {
+            float edgeX = v[1].x - v[0].x;
+            float edgeY = v[1].y - v[0].y;
+            int left = edgeX * -v[0].y - edgeY * -v[0].x > 0.0f;
+            directionX = left ? -edgeY : edgeY;
+            directionY = left ? edgeX : -edgeX;
+        }
+        if (directionX * directionX + directionY * directionY < NARROWPHASE_GJK_EPSILON * NARROWPHASE_GJK_EPSILON)
+        {
+            break; // The origin lies on the simplex: the shapes touch
+        }
+
+        NarrowphaseSimplexVertex* next = &simplex->vertex[simplex->count];
+        narrowphaseSetSimplexVertex(next, shapeA, narrowphaseSupport(shapeA, -directionX, -directionY),
+            shapeB, narrowphaseSupport(shapeB, directionX, directionY));
+        buffer->gjkIterationCount++;
+
+        // A support vertex seen in the previous simplex means no further progress is possible
+        int duplicate = 0;
+        for (int i = 0; i < previousCount; i++)
+        {
+            duplicate |= next->indexA == previousA[i] && next->indexB == previousB[i];
+        }
+        if (duplicate)
+        {
+            break;
+        }
+        simplex->count++;
+    }
+
+    // Closest points from the barycentric weights
+    *closestAX = *closestAY = *closestBX = *closestBY = 0.0f;
+    for (int i = 0; i < simplex->count; i++)
+    {
+        const NarrowphaseSimplexVertex* v = &simplex->vertex[i];
+        *closestAX += v->weight * v->pointAX;
+        *closestAY += v->weight * v->pointAY;
+        *closestBX += v->weight * v->pointBX;
+        *closestBY += v->weight * v->pointBY;
+    }
+
+    SimplexCacheEntry* entry = narrowphaseFindSimplex(buffer->nextSimplexCache, buffer->simplexCapacity, slotA, slotB);
+    entry->slotA = slotA;
+    entry->slotB = slotB;
+    entry->count = (unsigned char)simplex->count;
+    for (int i = 0; i < simplex->count; i++)
+    {
+        entry->indexA[i] = (unsigned char)simplex->vertex[i].indexA;
+        entry->indexB[i] = (unsigned char)simplex->vertex[i].indexB;
+    }
+
+    if (simplex->count == 3)
+    {
+        return 0.0f;
+    }
+    float dx = *closestBX - *closestAX;
+    float dy = *closestBY - *closestAY;
+    return sqrtf(dx * dx + dy * dy);
+}
+
+// Penetration of two overlapping shapes with EPA, expanding the GJK triangle towards the boundary
+// of the Minkowski difference B - A. Returns the unit normal pointing from A to B and the depth
+static int narrowphaseEpa(const NarrowphasePolygon* shapeA, const NarrowphasePolygon* shapeB, const NarrowphaseSimplex* simplex,
+    float* normalX, float* normalY, float* depth)
+{
+    float polytopeX[NARROWPHASE_EPA_MAX_VERTICES], polytopeY[NARROWPHASE_EPA_MAX_VERTICES];
+    int count = 3;
+    for (int i = 0; i < 3; i++)
+    {
+        polytopeX[i] = simplex->vertex[i].x;
+        polytopeY[i] = simplex->vertex[i].y;
+    }
+
+    // Make the triangle counter-clockwise, so that outward normals are on the right of the edges
+    float area = (polytopeX[1] - polytopeX[0]) * (polytopeY[2] - polytopeY[0]) - (polytopeY[1] - polytopeY[0]) * (polytopeX[2] - polytopeX[0]);
+    if (area < 0.0f)
+    {
+        float swapX = polytopeX[1], swapY = polytopeY[1];
+        polytopeX[1] = polytopeX[2];
+        polytopeY[1] = polytopeY[2];
+        polytopeX[2] = swapX;
+        polytopeY[2] = swapY;
+    }
+    else if (area == 0.0f)
+    {
+        return 0;
+    }
+
+    for (;;)
+    {
+        // Edge of the polytope closest to the origin
+        int closest = 0;
+        float closestDistance = INFINITY, closestNormalX = 0.0f, closestNormalY = 0.0f;
+        for (int i = 0; i < count; i++)
+        {
+            int j = i + 1 < count ? i + 1 : 0;
+            float edgeX = polytopeX[j] - polytopeX[i];
+            float edgeY = polytopeY[j] - polytopeY[i];
+            float length = sqrtf(edgeX * edgeX + edgeY * edgeY);
+            if (length == 0.0f)
+            {
+                continue;
+            }
+            float edgeNormalX = edgeY / length;
+            float edgeNormalY = -edgeX / length;
+            float distance = edgeNormalX * polytopeX[i] + edgeNormalY * polytopeY[i];
+            if (distance < closestDistance)
+            {
+                closest = i;
+                closestDistance = distance;
+                closestNormalX = edgeNormalX;
+                closestNormalY = edgeNormalY;
+            }
+        }
+
+        // Push the edge out to the boundary; stop when it is already there
+        int indexA = narrowphaseSupport(shapeA, -closestNormalX, -closestNormalY);
+        int indexB = narrowphaseSupport(shapeB, closestNormalX, closestNormalY);
+        float supportX = shapeB->vertexX[indexB] - shapeA->vertexX[indexA];
+        float supportY = shapeB->vertexY[indexB] - shapeA->vertexY[indexA];
+        float supportDistance = closestNormalX * supportX + closestNormalY * supportY;
+        if (supportDistance - closestDistance < NARROWPHASE_EPA_TOLERANCE || count == NARROWPHASE_EPA_MAX_VERTICES)
+        {
+            // Moving B by -normal * depth separates the shapes, so the contact normal is the opposite
+            *normalX = -closestNormalX;
+            *normalY = -closestNormalY;
+            *depth = fmaxf(closestDistance, 0.0f);
+            return 1;
+        }
+
+        for (int i = count; i > closest + 1; i--)
+        {
+            polytopeX[i] = polytopeX[i - 1];
+            polytopeY[i] = polytopeY[i - 1];
+        }
+        polytopeX[closest + 1] = supportX;
+        polytopeY[closest + 1] = supportY;
+        count++;
+
+        // The GJK vertices need not be corners of the Minkowski difference (the first one is not
+        // even a support point), so a new point can leave some of them inside: drop those to keep
+        // the polytope convex
+        for (int i = 0; i < count && count > 3;)
+        {
+            int previous = i > 0 ? i - 1 : count - 1;
+            int next = i + 1 < count ? i + 1 : 0;
+            float turn = (polytopeX[i] - polytopeX[previous]) * (polytopeY[next] - polytopeY[i])
+                - (polytopeY[i] - polytopeY[previous]) * (polytopeX[next] - polytopeX[i]);
+            if (turn > 0.0f)
+            {
+                i++;
+                continue;
+            }
+            for (int j = i; j + 1 < count; j++)
+            {
+                polytopeX[j] = polytopeX[j + 1];
+                polytopeY[j] = polytopeY[j + 1];
+            }
+            count--;
+            i = i > 0 ? i - 1 : 0;
+        }
+    }
+}
+
+static void narrowphasePolygonPolygon(ContactBuffer* buffer, const World* world, const BodyPair* pair, int pairIndex)
+{
+    NarrowphasePolygon shapeA, shapeB;
+    narrowphaseMakePolygon(world, pair->a, &shapeA);
+    narrowphaseMakePolygon(world, pair->b, &shapeB);
+
+    NarrowphaseSimplex simplex;
+    float closestAX, closestAY, closestBX, closestBY;
+    float distance = narrowphaseGjk(buffer, world->bodySlot[pair->a], &shapeA, world->bodySlot[pair->b], &shapeB,
+        &simplex, &closestAX, &closestAY, &closestBX, &closestBY);
+    float normalX, normalY, depth;
+    if (distance > 0.0f || simplex.count < 3 || !narrowphaseEpa(&shapeA, &shapeB, &simplex, &normalX, &normalY, &depth))
+    {
+        return; // Separated, or only touching
+    }
+
+    // The faces most aligned with the penetration normal become the reference and incident faces
+    int faceA = 0, faceB = 0;
+    float alignmentA = -INFINITY, alignmentB = -INFINITY;
+    for (int i = 0; i < shapeA.count; i++)
+    {
+        float alignment = shapeA.normalX[i] * normalX + shapeA.normalY[i] * normalY;
+        if (alignment > alignmentA)
+        {
+            alignmentA = alignment;
+            faceA = i;
+        }
+    }
+    for (int i = 0; i < shapeB.count; i++)
+    {
+        float alignment = -(shapeB.normalX[i] * normalX + shapeB.normalY[i] * normalY);
+        if (alignment > alignmentB)
+        {
+            alignmentB = alignment;
+            faceB = i;
+        }
+    }
+
+    if (alignmentB > alignmentA + NARROWPHASE_ALIGNMENT_TOLERANCE)
+    {
+        narrowphaseClipManifold(&shapeB, faceB, &shapeA, 1, pairIndex, buffer);
+    }
+    else
+    {
+        narrowphaseClipManifold(&shapeA, faceA, &shapeB, 0, pairIndex, buffer);
+    }
+}
+
+static void narrowphasePolygonCircle(ContactBuffer* buffer, const World* world, int polygon, int circle, int circleIsA, int pairIndex)
+{
+    NarrowphasePolygon shape, center;
+    narrowphaseMakePolygon(world, polygon, &shape);
+    center.count = 1;
+    center.vertexX[0] = world->posX[circle];
+    center.vertexY[0] = world->posY[circle];
+    float radius = world->radius[circle];
+
+    NarrowphaseSimplex simplex;
+    float closestX, closestY, centerX, centerY;
+    float distance = narrowphaseGjk(buffer, world->bodySlot[polygon], &shape, world->bodySlot[circle], &center,
+        &simplex, &closestX, &closestY, &centerX, &centerY);
+    if (distance > radius)
+    {
+        return;
+    }
+
+    float normalX, normalY, depth;
+    if (distance > NARROWPHASE_GJK_EPSILON)
+    {
+        normalX = (centerX - closestX) / distance;
+        normalY = (centerY - closestY) / distance;
+        depth = radius - distance;
+    }
+    else
+    {
+        // The center is inside the polygon: push it out through the face it is least deep behind
+        int face = 0;
+        float separation = narrowphaseMaxSeparation(&shape, &center, &face);
+        normalX = shape.normalX[face];
+        normalY = shape.normalY[face];
+        closestX = centerX - normalX * separation;
+        closestY = centerY - normalY * separation;
+        depth = radius - separation;
+    }
+
+    Contact* contact = &buffer->contacts[buffer->count++];
+    contact->normalX = circleIsA ? -normalX : normalX;
+    contact->normalY = circleIsA ? -normalY : normalY;
+    contact->depth = depth;
+    contact->pointX = 0.5f * (closestX + centerX - normalX * radius);
+    contact->pointY = 0.5f * (closestY + centerY - normalY * radius);
+    contact->feature = 0;
+    contact->pairIndex = pairIndex;
+}
+
+int narrowphaseCollide(const World* world, const BodyPair* pairs, int pairCount, ContactBuffer* buffer)
+{
+    if (!narrowphaseCollideCircles(world, pairs, pairCount, buffer))
+    {
+        return 0;
+    }
+
+    const unsigned char* type = world->type;
+    buffer->gjkPairCount = 0;
+    buffer->gjkCachedCount = 0;
+    buffer->gjkIterationCount = 0;
+    if (world->vertexPoolCount > 0)
+    {
+        int polygonPairs = 0;
+        for (int i = 0; i < pairCount; i++)
+        {
+            polygonPairs += type[pairs[i].a] == BODY_POLYGON || type[pairs[i].b] == BODY_POLYGON;
+        }
+        if (!narrowphaseReserveSimplices(buffer, polygonPairs))
+        {
+            return 0;
+        }
+    }
+    if (buffer->simplexCapacity > 0)
+    {
+        narrowphaseClearSimplices(buffer->nextSimplexCache, buffer->simplexCapacity);
+    }
+
+    for (int i = 0; i < pairCount; i++)
+    {
+        int a = pairs[i].a;
+        int b = pairs[i].b;
+        if (type[a] == BODY_CIRCLE && type[b] == BODY_CIRCLE)
+        {
+            continue;
+        }
+
+        if (buffer->count + NARROWPHASE_MAX_MANIFOLD_POINTS > buffer->capacity
+            && !contactBufferReserve(buffer, buffer->capacity * 2 + NARROWPHASE_MAX_MANIFOLD_POINTS))
+        {
+            return 0;
+        }
+
+        if (type[a] == BODY_POLYGON || type[b] == BODY_POLYGON)
+        {
+            if (type[a] == BODY_CIRCLE)
+            {
+                narrowphasePolygonCircle(buffer, world, b, a, 1, i);
+            }
+            else if (type[b] == BODY_CIRCLE)
+            {
+                narrowphasePolygonCircle(buffer, world, a, b, 0, i);
+            }
+            else
+            {
+                narrowphasePolygonPolygon(buffer, world, &pairs[i], i);
+            }
+        }
+        else if (type[a] == BODY_RECTANGLE && type[b] == BODY_RECTANGLE)
+        {
+            narrowphaseBoxBox(world, &pairs[i], i, buffer);
+        }
+        else if (type[a] == BODY_RECTANGLE)
+        {
+            narrowphaseBoxCircle(world, a, b, 0, i, buffer);
+        }
+        else
+        {
+            narrowphaseBoxCircle(world, b, a, 1, i, buffer);
+        }
+    }
+
+    // Pairs that were not tested this call are simply not carried over
+    SimplexCacheEntry* table = buffer->nextSimplexCache;
+    buffer->nextSimplexCache = buffer->simplexCache;
+    buffer->simplexCache = table;
+    return 1;
+}
+
+void narrowphaseResolveContacts(World* world, const BodyPair* pairs, const ContactBuffer* buffer)
+{
+    for (int i = 0; i < buffer->count; i++)
+    {
+        const Contact* contact = &buffer->contacts[i];
+        int a = pairs[contact->pairIndex].a;
+        int b = pairs[contact->pairIndex].b;
+        float invMassA = world->invMass[a];
+        float invMassB = world->invMass[b];
+        float invMassSum = invMassA + invMassB;
+        if (invMassA == 0.0f || invMassSum == 0.0f)
+        {
+            continue;
+        }
+
+        // Separate the circles by pushing the first one back along the collision normal
+        world->posX[a] -= contact->depth * contact->normalX;
+        world->posY[a] -= contact->depth * contact->normalY;
+
+        // Relative velocity along the normal, then impulse = 2 * v / (m1 + m2) scaled by m2,
+        // written with inverse masses so that static bodies need no special case
+        float relativeVelocity = (world->velX[a] - world->velX[b]) * contact->normalX
+            + (world->velY[a] - world->velY[b]) * contact->normalY;
+        float impulse = 2.0f * relativeVelocity * invMassA / invMassSum;
+
+        world->velX[a] -= impulse * contact->normalX;
+        world->velY[a] -= impulse * contact->normalY;
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef __PREVIEW_INTERFACE_H__
+#define __PREVIEW_INTERFACE_H__
+
+/**
+ * @struct Preview
+ * @brief Shows on the PC what the SFB rasterizer would send to the TFT.
+ *
+ * The frame is drawn in software into an RGB565 SFB frame buffer, the same code and pixel format
+ * as on the STM32 target, and each finished band is uploaded to a streaming SDL_PIXELFORMAT_RGB565
+ * texture that is stretched over the window by previewPresent(). With a band shorter than the
+ * screen the frame is drawn once per band, as on the target, so the MCU frame cost can be
+ * measured and tuned on the desktop; a band as tall as the screen draws the frame in one pass.
+ *
+ * The pixels are uploaded as they are, so the SFB module must store them in the native byte order
+ * (SFB_PIXEL_ORDER_NATIVE, the default).
+ *
+ * Drawing only the rectangles of an SFB_DirtyRegion_t with previewBeginRegion() uploads only those
+ * parts of the texture; the rest keeps the pixels of the earlier frames.
+ *
+ * The SDL, STD_TYPES, FB config and FB headers must be included before this header.
+ */
+typedef struct
+{
+    SDL_Renderer* renderer;             /**< Renderer the texture belongs to. */
+    SDL_Texture* texture;               /**< Streaming RGB565 texture holding the last frame. */
+    unsigned short* pixels;             /**< Storage of the band. */
+    SFB_FrameBuffer_t frameBuffer;      /**< The band being drawn. */
+    int bandCount;                      /**< Counter: bands uploaded since the last previewPresent(). */
+    long uploadedPixels;                /**< Counter: pixels uploaded since the last previewPresent(). */
+} Preview;
+
+
+/**
+ * @brief Creates the texture and the band storage.
+ * @param preview Pointer to the Preview struct to initialize.
+ * @param renderer The SDL_Renderer the frames are presented with.
+ * @param width Width of the emulated screen in pixels.
+ * @param height Height of the emulated screen in pixels.
+ * @param bandHeight Rows drawn per pass: the screen height for a full frame buffer, or the band of the target.
+ * @return 1 on success, 0 if the texture or the storage could not be created.
+ */
+int previewInit(Preview* preview, SDL_Renderer* renderer, int width, int height, int bandHeight);
+
+/**
+ * @brief Destroys the texture and releases the band storage.
+ * @param preview Pointer to the Preview struct to release.
+ */
+void previewFree(Preview* preview);
+
+/**
+ * @brief Starts a frame on the top band, cleared to the background color.
+ * @param preview Pointer to the Preview.
+ * @param background RGB565 background color.
+ * @return The frame buffer to draw the band into with the SFB functions.
+ */
+SFB_FrameBuffer_t* previewBeginFrame(Preview* preview, unsigned short background);
+
+/**
+ * @brief Starts drawing a part of the frame, leaving the rest of the texture as it is.
+ * @param preview Pointer to the Preview.
+ * @param region The part of the screen to draw, for example a rectangle of an SFB_DirtyRegion_t.
+ * @param background RGB565 background color.
+ * @return The frame buffer to draw the band into with the SFB functions.
+ */
+SFB_FrameBuffer_t* previewBeginRegion(Preview* preview, const SFB_Rect_t* region, unsigned short background);
+
+/**
+ * @brief Uploads the current band to the texture and starts the next one.
+ * @param preview Pointer to the Preview.
+ * @return 1 if another band was started and the frame must be drawn again, 0 when the frame is complete.
+ */
+int previewEndBand(Preview* preview);
+
+/**
+ * @brief Copies the texture over the whole render target and resets the upload counters.
+ * @param preview Pointer to the Preview.
+ * @return 1 on success, 0 if SDL reported an error.
+ */
+int previewPresent(Preview* preview);
+
+
+#endif /**< __PREVIEW_INTERFACE_H__ */
@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+#include "STD_TYPES.h"
+#include "FB_config.h"
+#include "FB_interface.h"
+#include "PREVIEW_interface.h"
+
+// The band callback has the signature of TFT_voidDisplayImage() and no context, so it finds the
+// texture through the preview whose frame is being drawn
+static Preview* previewActive = NULL;
+
+static void previewUploadBand(u16 x, u16 y, const u16* pixels, u16 width, u16 height)
+{
+    SDL_Rect rect = { x, y, width, height };
+    if (previewActive != NULL && SDL_UpdateTexture(previewActive->texture, &rect, pixels, width * (int)sizeof(u16)) == 0)
+    {
+        previewActive->bandCount++;
+        previewActive->uploadedPixels += (long)width * height;
+    }
+}
+
+int previewInit(Preview* preview, SDL_Renderer* renderer, int width, int height, int bandHeight)
+{
+    memset(preview, 0, sizeof(*preview));
+    preview->renderer = renderer;
+    if (width <= 0 || height <= 0 || bandHeight <= 0 || width > 0xFFFF || height > 0xFFFF)
+    {
+        return 0;
+    }
+    bandHeight = bandHeight < height ? bandHeight : height;
+
+    preview->pixels = malloc(sizeof(unsigned short) * (size_t)width * (size_t)bandHeight);
+    preview->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB565, SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (preview->pixels == NULL || preview->texture == NULL
+        || SFB_u8Init(&preview->frameBuffer, preview->pixels, (u16)width, (u16)height, (u16)bandHeight) != 0)
+    {
+        previewFree(preview);
+        return 0;
+    }
+    return 1;
+}
+
+void previewFree(Preview* preview)
+{
+    if (preview->texture != NULL)
+    {
+        SDL_DestroyTexture(preview->texture);
+        preview->texture = NULL;
+    }
+    free(preview->pixels);
+    preview->pixels = NULL;
+    if (previewActive == preview)
+    {
+        previewActive = NULL;
+    }
+}
+
+SFB_FrameBuffer_t* previewBeginFrame(Preview* preview, unsigned short background)
+{
+    SFB_voidBeginFrame(&preview->frameBuffer, background);
+    return &preview->frameBuffer;
+}
+
+SFB_FrameBuffer_t* previewBeginRegion(Preview* preview, const SFB_Rect_t* region, unsigned short background)
+{
+    SFB_voidBeginRegion(&preview->frameBuffer, region, background);
+    return &preview->frameBuffer;
+}
+
+int previewEndBand(Preview* preview)
+{
+    previewActive = preview;
+    int moreBands = SFB_u8EndBand(&preview->frameBuffer, previewUploadBand);
+    previewActive = NULL;
+    return moreBands;
+}
+
+int previewPresent(Preview* preview)
+{
+    preview->bandCount = 0;
+    preview->uploadedPixels = 0;
+    return SDL_RenderCopy(preview->renderer, preview->texture, NULL, NULL) == 0;
+}
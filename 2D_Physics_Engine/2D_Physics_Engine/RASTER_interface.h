@@ -0,0 +1,29 @@
+#ifndef __RASTER_INTERFACE_H__
+#define __RASTER_INTERFACE_H__
+
+/**
+ * @brief Packs 8-bit red, green and blue into an RGB565 color, the format of TFT_Color_t.
+ */
+#define RASTER_RGB565(r, g, b)  ((unsigned short)((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3)))
+
+
+/**
+ * @brief Draws the bodies of a world into the current band of an SFB frame buffer.
+ *
+ * This is the software counterpart of renderBatchWorld(): circles are drawn as outlines, rectangles
+ * and polygons are filled, in RGB565 through the same rasterizer the TFT target uses. With a band
+ * frame buffer it is called once per band, between SFB_voidBeginFrame() or SFB_voidBeginRegion()
+ * and SFB_u8EndBand(). Bodies that cannot reach the band are skipped before any transform.
+ *
+ * The STD_TYPES, FB config, FB and WORLD headers must be included before this header.
+ *
+ * @param frameBuffer The frame buffer whose current band is drawn.
+ * @param world Pointer to the World to draw.
+ * @param scale Screen pixels per world unit, for example 0.3 to fit an 800x600 scene on a 240x320 TFT.
+ * @param awakeColor RGB565 color of awake bodies.
+ * @param restingColor RGB565 color of sleeping bodies.
+ */
+void rasterWorld(SFB_FrameBuffer_t* frameBuffer, const World* world, float scale, unsigned short awakeColor, unsigned short restingColor);
+
+
+#endif /**< __RASTER_INTERFACE_H__ */
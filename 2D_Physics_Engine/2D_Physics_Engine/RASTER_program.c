@@ -0,0 +1,72 @@
+#include <math.h>
+#include "STD_TYPES.h"
+#include "FB_config.h"
+#include "FB_interface.h"
+#include "WORLD_interface.h"
+#include "RASTER_interface.h"
+
+// Rounds a screen coordinate, saturating at the range of the rasterizer's s16 coordinates
+static s16 rasterCoordinate(float value)
+{
+    value = floorf(value + 0.5f);
+    return value < -32768.0f ? -32768 : value > 32767.0f ? 32767 : (s16)value;
+}
+
+void rasterWorld(SFB_FrameBuffer_t* frameBuffer, const World* world, float scale, unsigned short awakeColor, unsigned short restingColor)
+{
+    float bandLeft = (float)frameBuffer->OriginX;
+    float bandRight = (float)(frameBuffer->OriginX + frameBuffer->Columns);
+    float bandTop = (float)frameBuffer->OriginY;
+    float bandBottom = (float)(frameBuffer->OriginY + frameBuffer->Rows);
+    s16 vertexX[WORLD_MAX_POLYGON_VERTICES];
+    s16 vertexY[WORLD_MAX_POLYGON_VERTICES];
+
+    for (int i = 0; i < world->count; i++)
+    {
+        // Every band visits every body, so reject the ones that cannot reach this band first
+        float centerX = world->posX[i] * scale;
+        float centerY = world->posY[i] * scale;
+        float reachX = world->halfWidth[i] * scale + 1.0f; // One pixel of slack for rounding
+        float reachY = world->halfHeight[i] * scale + 1.0f;
+        if (centerY + reachY < bandTop || centerY - reachY >= bandBottom || centerX + reachX < bandLeft || centerX - reachX >= bandRight)
+        {
+            continue;
+        }
+
+        u16 color = world->awake[i] ? awakeColor : restingColor;
+        if (world->type[i] == BODY_CIRCLE)
+        {
+            SFB_voidDrawCircle(frameBuffer, rasterCoordinate(centerX), rasterCoordinate(centerY),
+                rasterCoordinate(world->radius[i] * scale), color);
+            continue;
+        }
+
+        // Transform the outline to screen space: corners for rectangles, pool vertices for polygons
+        float cosine = cosf(world->angle[i]);
+        float sine = sinf(world->angle[i]);
+        int count;
+        if (world->type[i] == BODY_RECTANGLE)
+        {
+            float cornerX[4] = { -world->extentX[i], world->extentX[i], world->extentX[i], -world->extentX[i] };
+            float cornerY[4] = { -world->extentY[i], -world->extentY[i], world->extentY[i], world->extentY[i] };
+            for (int v = 0; v < 4; v++)
+            {
+                vertexX[v] = rasterCoordinate((world->posX[i] + cosine * cornerX[v] - sine * cornerY[v]) * scale);
+                vertexY[v] = rasterCoordinate((world->posY[i] + sine * cornerX[v] + cosine * cornerY[v]) * scale);
+            }
+            count = 4;
+        }
+        else
+        {
+            const float* localX = &world->vertexX[world->vertexStart[i]];
+            const float* localY = &world->vertexY[world->vertexStart[i]];
+            count = world->vertexCount[i];
+            for (int v = 0; v < count; v++)
+            {
+                vertexX[v] = rasterCoordinate((world->posX[i] + cosine * localX[v] - sine * localY[v]) * scale);
+                vertexY[v] = rasterCoordinate((world->posY[i] + sine * localX[v] + cosine * localY[v]) * scale);
+            }
+        }
+        SFB_voidFillPolygon(frameBuffer, vertexX, vertexY, (u8)count, color);
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef __RENDER_INTERFACE_H__
+#define __RENDER_INTERFACE_H__
+
+/**
+ * @brief Largest number of segments used to approximate a filled circle.
+ */
+#define RENDER_MAX_CIRCLE_SEGMENTS  64
+
+/**
+ * @struct RenderRun
+ * @brief Consecutive batched items sharing one draw color.
+ */
+typedef struct
+{
+    SDL_Color color;    /**< Draw color of the run. */
+    int count;          /**< Number of items in the run. */
+} RenderRun;
+
+/**
+ * @struct RenderBatch
+ * @brief Collects the shapes of a frame and submits them to SDL in a handful of calls.
+ *
+ * Drawing a shape only appends to arrays reused from frame to frame; nothing reaches the renderer
+ * until renderBatchFlush(). Axis-aligned rectangles become one SDL_RenderFillRects call per color
+ * run, circle outlines one SDL_RenderDrawPoints call per color run, and every filled circle and
+ * polygon goes into a single colored SDL_RenderGeometry triangle list, so a frame that uses one
+ * color per kind costs three submissions whatever the number of bodies.
+ *
+ * With a SpriteCache attached, circle outlines are queued as atlas quads instead of points and
+ * submitted by the same flush in one more call; an outline the cache cannot hold falls back to points.
+ *
+ * The SDL and SPRITE headers must be included before this header.
+ */
+typedef struct
+{
+    SDL_Renderer* renderer;     /**< Renderer the batch is submitted to. */
+    SpriteCache* sprites;       /**< Cache drawing the circle outlines, on the same renderer; NULL draws them as points. */
+
+    SDL_Rect* rects;            /**< Batched axis-aligned rectangles. */
+    int rectCount;              /**< Number of batched rectangles. */
+    int rectCapacity;           /**< Number of rectangles the array can hold. */
+    RenderRun* rectRuns;        /**< Color runs covering the rectangles in order. */
+    int rectRunCount;           /**< Number of rectangle color runs. */
+    int rectRunCapacity;        /**< Number of rectangle color runs the array can hold. */
+
+    SDL_Point* points;          /**< Batched outline points. */
+    int pointCount;             /**< Number of batched points. */
+    int pointCapacity;          /**< Number of points the array can hold. */
+    RenderRun* pointRuns;       /**< Color runs covering the points in order. */
+    int pointRunCount;          /**< Number of point color runs. */
+    int pointRunCapacity;       /**< Number of point color runs the array can hold. */
+
+    SDL_Vertex* vertices;       /**< Batched vertices of the filled shapes. */
+    int vertexCount;            /**< Number of batched vertices. */
+    int vertexCapacity;         /**< Number of vertices the array can hold. */
+    int* indices;               /**< Triangle list indexing the vertices, three per triangle. */
+    int indexCount;             /**< Number of batched indices. */
+    int indexCapacity;          /**< Number of indices the array can hold. */
+
+    int submissionCount;        /**< Counter: SDL draw calls made by the last flush. */
+} RenderBatch;
+
+
+/**
+ * @brief Initializes an empty batch drawing to a renderer, with no sprite cache attached.
+ * @param batch Pointer to the RenderBatch struct to initialize.
+ * @param renderer The SDL_Renderer the batch is submitted to.
+ */
+void renderBatchInit(RenderBatch* batch, SDL_Renderer* renderer);
+
+/**
+ * @brief Releases the storage owned by a batch. An attached sprite cache stays attached and is not freed.
+ * @param batch Pointer to the RenderBatch struct to release.
+ */
+void renderBatchFree(RenderBatch* batch);
+
+/**
+ * @brief Adds a solid axis-aligned rectangle.
+ * @param batch Pointer to the RenderBatch.
+ * @param x The x-coordinate of the top-left corner of the rectangle.
+ * @param y The y-coordinate of the top-left corner of the rectangle.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param color The color of the rectangle.
+ * @return 1 on success, 0 if the batch could not grow.
+ */
+int renderBatchRectangle(RenderBatch* batch, int x, int y, int width, int height, SDL_Color color);
+
+/**
+ * @brief Adds the outline of a circle, with the same pixels as drawCircle().
+ *
+ * When the batch has a sprite cache the outline is queued on it, rasterized once per radius.
+ *
+ * @param batch Pointer to the RenderBatch.
+ * @param x The x coordinate of the circle's center.
+ * @param y The y coordinate of the circle's center.
+ * @param radius The radius of the circle.
+ * @param color The color of the outline.
+ * @return 1 on success, 0 if the batch could not grow.
+ */
+int renderBatchCircle(RenderBatch* batch, int x, int y, int radius, SDL_Color color);
+
+/**
+ * @brief Adds a filled circle, approximated by a polygon whose edges stay within half a pixel of the circle.
+ * @param batch Pointer to the RenderBatch.
+ * @param x The x coordinate of the circle's center.
+ * @param y The y coordinate of the circle's center.
+ * @param radius The radius of the circle.
+ * @param color The color of the circle.
+ * @return 1 on success, 0 if the batch could not grow.
+ */
+int renderBatchFilledCircle(RenderBatch* batch, float x, float y, float radius, SDL_Color color);
+
+/**
+ * @brief Adds a filled convex polygon.
+ * @param batch Pointer to the RenderBatch.
+ * @param vertexX The x coordinates of the vertices, in order around the polygon.
+ * @param vertexY The y coordinates of the vertices.
+ * @param vertexCount Number of vertices (at least 3).
+ * @param color The color of the polygon.
+ * @return 1 on success, 0 if the batch could not grow or has fewer than 3 vertices.
+ */
+int renderBatchPolygon(RenderBatch* batch, const float* vertexX, const float* vertexY, int vertexCount, SDL_Color color);
+
+/**
+ * @brief Adds every body of a world: circles as outlines, rectangles and polygons filled at their angle.
+ *
+ * Sleeping and static bodies use a second color, so resting islands stand out. The World header
+ * must be included before this header.
+ *
+ * @param batch Pointer to the RenderBatch.
+ * @param world Pointer to the World holding the bodies.
+ * @param awakeColor Color of the awake bodies.
+ * @param restingColor Color of the sleeping and static bodies.
+ * @return 1 on success, 0 if the batch could not grow.
+ */
+int renderBatchWorld(RenderBatch* batch, const World* world, SDL_Color awakeColor, SDL_Color restingColor);
+
+/**
+ * @brief Submits the batched shapes and empties the batch.
+ *
+ * Rectangles are drawn first, then filled shapes, then cached outlines and point outlines, so outlines
+ * stay visible over fills. The attached sprite cache is flushed too. The renderer draw color is left at the color of the last run.
+ *
+ * @param batch Pointer to the RenderBatch.
+ * @return 1 on success, 0 if SDL reported an error.
+ */
+int renderBatchFlush(RenderBatch* batch);
+
+
+#endif /**< __RENDER_INTERFACE_H__ */
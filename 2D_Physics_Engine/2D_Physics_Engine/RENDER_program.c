@@ -0,0 +1,322 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <SDL.h>
+#include "WORLD_interface.h"
+#include "SPRITE_interface.h"
+#include "RENDER_interface.h"
+
+#define RENDER_PI               3.14159265f
+#define RENDER_CIRCLE_TOLERANCE 0.5f    /**< Largest gap in pixels between a filled circle and its polygon. */
+
+void renderBatchInit(RenderBatch* batch, SDL_Renderer* renderer)
+{
+    memset(batch, 0, sizeof(*batch));
+    batch->renderer = renderer;
+}
+
+void renderBatchFree(RenderBatch* batch)
+{
+    free(batch->rects);
+    free(batch->rectRuns);
+    free(batch->points);
+    free(batch->pointRuns);
+    free(batch->vertices);
+    free(batch->indices);
+    SpriteCache* sprites = batch->sprites;
+    renderBatchInit(batch, batch->renderer);
+    batch->sprites = sprites;
+}
+
+// Grows an array to hold at least needed items, doubling its capacity
+static int renderReserve(void** items, int* capacity, int needed, size_t itemSize)
+{
+    if (needed <= *capacity)
+    {
+        return 1;
+    }
+
+    int newCapacity = *capacity > 0 ? *capacity : 256;
+    while (newCapacity < needed)
+    {
+        newCapacity *= 2;
+    }
+    void* newItems = realloc(*items, itemSize * (size_t)newCapacity);
+    if (newItems == NULL)
+    {
+        return 0;
+    }
+    *items = newItems;
+    *capacity = newCapacity;
+    return 1;
+}
+
+// Extends the last color run, or starts a new one when the color changes
+static int renderAddToRun(RenderRun** runs, int* runCount, int* runCapacity, SDL_Color color, int count)
+{
+    if (*runCount > 0)
+    {
+        RenderRun* last = &(*runs)[*runCount - 1];
+        if (last->color.r == color.r && last->color.g == color.g && last->color.b == color.b && last->color.a == color.a)
+        {
+            last->count += count;
+            return 1;
+        }
+    }
+
+    if (!renderReserve((void**)runs, runCapacity, *runCount + 1, sizeof(RenderRun)))
+    {
+        return 0;
+    }
+    (*runs)[*runCount].color = color;
+    (*runs)[*runCount].count = count;
+    (*runCount)++;
+    return 1;
+}
+
+int renderBatchRectangle(RenderBatch* batch, int x, int y, int width, int height, SDL_Color color)
+{
+    if (!renderReserve((void**)&batch->rects, &batch->rectCapacity, batch->rectCount + 1, sizeof(SDL_Rect))
+        || !renderAddToRun(&batch->rectRuns, &batch->rectRunCount, &batch->rectRunCapacity, color, 1))
+    {
+        return 0;
+    }
+
+    SDL_Rect* rect = &batch->rects[batch->rectCount++];
+    rect->x = x;
+    rect->y = y;
+    rect->w = width;
+    rect->h = height;
+    return 1;
+}
+
+int renderBatchCircle(RenderBatch* batch, int x, int y, int radius, SDL_Color color)
+{
+    if (batch->sprites != NULL && spriteCacheQueue(batch->sprites, x, y, radius, color, SPRITE_OUTLINE))
+    {
+        return 1;
+    }
+
+    // Bresenham's circle emits 8 points per step and takes at most radius + 2 steps
+    int maxPoints = 8 * (radius + 2);
+    if (!renderReserve((void**)&batch->points, &batch->pointCapacity, batch->pointCount + maxPoints, sizeof(SDL_Point)))
+    {
+        return 0;
+    }
+
+    SDL_Point* points = &batch->points[batch->pointCount];
+    int count = 0;
+    int centerX = radius;
+    int centerY = 0;
+    int errorVal = 0;
+
+    while (centerX >= centerY)
+    {
+        points[count++] = (SDL_Point){ x + centerX, y + centerY };
+        points[count++] = (SDL_Point){ x + centerY, y + centerX };
+        points[count++] = (SDL_Point){ x - centerY, y + centerX };
+        points[count++] = (SDL_Point){ x - centerX, y + centerY };
+        points[count++] = (SDL_Point){ x - centerX, y - centerY };
+        points[count++] = (SDL_Point){ x - centerY, y - centerX };
+        points[count++] = (SDL_Point){ x + centerY, y - centerX };
+        points[count++] = (SDL_Point){ x + centerX, y - centerY };
+
+        if (errorVal <= 0)
+        {
+            centerY += 1;
+            errorVal += 2 * centerY + 1;
+        }
+
+        if (errorVal > 0)
+        {
+            centerX -= 1;
+            errorVal -= 2 * centerX + 1;
+        }
+    }
+
+    if (!renderAddToRun(&batch->pointRuns, &batch->pointRunCount, &batch->pointRunCapacity, color, count))
+    {
+        return 0;
+    }
+    batch->pointCount += count;
+    return 1;
+}
+
+// Appends a convex fan of vertexCount vertices already written at the end of the vertex array
+static int renderAddFan(RenderBatch* batch, int vertexCount)
+{
+    int indexCount = 3 * (vertexCount - 2);
+    if (!renderReserve((void**)&batch->indices, &batch->indexCapacity, batch->indexCount + indexCount, sizeof(int)))
+    {
+        return 0;
+    }
+
+    int first = batch->vertexCount;
+    int* indices = &batch->indices[batch->indexCount];
+    for (int i = 1; i < vertexCount - 1; i++)
+    {
+        *indices++ = first;
+        *indices++ = first + i;
+        *indices++ = first + i + 1;
+    }
+    batch->vertexCount += vertexCount;
+    batch->indexCount += indexCount;
+    return 1;
+}
+
+static void renderSetVertex(SDL_Vertex* vertex, float x, float y, SDL_Color color)
+{
+    vertex->position.x = x;
+    vertex->position.y = y;
+    vertex->color = color;
+    vertex->tex_coord.x = 0.0f;
+    vertex->tex_coord.y = 0.0f;
+}
+
+int renderBatchFilledCircle(RenderBatch* batch, float x, float y, float radius, SDL_Color color)
+{
+    // Fewest segments whose chords stay within the tolerance of the arc
+    int segments = RENDER_MAX_CIRCLE_SEGMENTS;
+    if (radius > RENDER_CIRCLE_TOLERANCE)
+    {
+        segments = (int)ceilf(RENDER_PI / acosf(1.0f - RENDER_CIRCLE_TOLERANCE / radius));
+    }
+    segments = segments < 8 ? 8 : segments > RENDER_MAX_CIRCLE_SEGMENTS ? RENDER_MAX_CIRCLE_SEGMENTS : segments;
+
+    if (!renderReserve((void**)&batch->vertices, &batch->vertexCapacity, batch->vertexCount + segments, sizeof(SDL_Vertex)))
+    {
+        return 0;
+    }
+
+    // Rotate one step at a time instead of calling cosf and sinf per vertex
+    float stepCos = cosf(2.0f * RENDER_PI / segments);
+    float stepSin = sinf(2.0f * RENDER_PI / segments);
+    float offsetX = radius;
+    float offsetY = 0.0f;
+    SDL_Vertex* vertices = &batch->vertices[batch->vertexCount];
+    for (int i = 0; i < segments; i++)
+    {
+        renderSetVertex(&vertices[i], x + offsetX, y + offsetY, color);
+        float rotatedX = offsetX * stepCos - offsetY * stepSin;
+        offsetY = offsetX * stepSin + offsetY * stepCos;
+        offsetX = rotatedX;
+    }
+    return renderAddFan(batch, segments);
+}
+
+int renderBatchPolygon(RenderBatch* batch, const float* vertexX, const float* vertexY, int vertexCount, SDL_Color color)
+{
+    if (vertexCount < 3
+        || !renderReserve((void**)&batch->vertices, &batch->vertexCapacity, batch->vertexCount + vertexCount, sizeof(SDL_Vertex)))
+    {
+        return 0;
+    }
+
+    SDL_Vertex* vertices = &batch->vertices[batch->vertexCount];
+    for (int i = 0; i < vertexCount; i++)
+    {
+        renderSetVertex(&vertices[i], vertexX[i], vertexY[i], color);
+    }
+    return renderAddFan(batch, vertexCount);
+}
+
+int renderBatchWorld(RenderBatch* batch, const World* world, SDL_Color awakeColor, SDL_Color restingColor)
+{
+    float vertexX[WORLD_MAX_POLYGON_VERTICES];
+    float vertexY[WORLD_MAX_POLYGON_VERTICES];
+
+    for (int i = 0; i < world->count; i++)
+    {
+        SDL_Color color = world->awake[i] ? awakeColor : restingColor;
+        int success;
+
+        if (world->type[i] == BODY_CIRCLE)
+        {
+            success = renderBatchCircle(batch, (int)world->posX[i], (int)world->posY[i], (int)world->radius[i], color);
+        }
+        else
+        {
+            // Transform the outline to world space: corners for rectangles, pool vertices for polygons
+            float cosine = cosf(world->angle[i]);
+            float sine = sinf(world->angle[i]);
+            int count;
+            if (world->type[i] == BODY_RECTANGLE)
+            {
+                float cornerX[4] = { -world->extentX[i], world->extentX[i], world->extentX[i], -world->extentX[i] };
+                float cornerY[4] = { -world->extentY[i], -world->extentY[i], world->extentY[i], world->extentY[i] };
+                for (int v = 0; v < 4; v++)
+                {
+                    vertexX[v] = world->posX[i] + cosine * cornerX[v] - sine * cornerY[v];
+                    vertexY[v] = world->posY[i] + sine * cornerX[v] + cosine * cornerY[v];
+                }
+                count = 4;
+            }
+            else
+            {
+                const float* localX = &world->vertexX[world->vertexStart[i]];
+                const float* localY = &world->vertexY[world->vertexStart[i]];
+                count = world->vertexCount[i];
+                for (int v = 0; v < count; v++)
+                {
+                    vertexX[v] = world->posX[i] + cosine * localX[v] - sine * localY[v];
+                    vertexY[v] = world->posY[i] + sine * localX[v] + cosine * localY[v];
+                }
+            }
+            success = renderBatchPolygon(batch, vertexX, vertexY, count, color);
+        }
+
+        if (!success)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int renderBatchFlush(RenderBatch* batch)
+{
+    int success = 1;
+    batch->submissionCount = 0;
+
+    int first = 0;
+    for (int i = 0; i < batch->rectRunCount; i++)
+    {
+        const RenderRun* run = &batch->rectRuns[i];
+        SDL_SetRenderDrawColor(batch->renderer, run->color.r, run->color.g, run->color.b, run->color.a);
+        success &= SDL_RenderFillRects(batch->renderer, &batch->rects[first], run->count) == 0;
+        first += run->count;
+        batch->submissionCount++;
+    }
+
+    // Filled shapes carry their color in the vertices, so they all go in one call
+    if (batch->indexCount > 0)
+    {
+        success &= SDL_RenderGeometry(batch->renderer, NULL, batch->vertices, batch->vertexCount,
+            batch->indices, batch->indexCount) == 0;
+        batch->submissionCount++;
+    }
+
+    if (batch->sprites != NULL)
+    {
+        batch->submissionCount += batch->sprites->quadCount > 0;
+        success &= spriteCacheFlush(batch->sprites);
+    }
+
+    first = 0;
+    for (int i = 0; i < batch->pointRunCount; i++)
+    {
+        const RenderRun* run = &batch->pointRuns[i];
+        SDL_SetRenderDrawColor(batch->renderer, run->color.r, run->color.g, run->color.b, run->color.a);
+        success &= SDL_RenderDrawPoints(batch->renderer, &batch->points[first], run->count) == 0;
+        first += run->count;
+        batch->submissionCount++;
+    }
+
+    batch->rectCount = 0;
+    batch->rectRunCount = 0;
+    batch->pointCount = 0;
+    batch->pointRunCount = 0;
+    batch->vertexCount = 0;
+    batch->indexCount = 0;
+    return success;
+}
@@ -0,0 +1,76 @@
+#ifndef __SAP_INTERFACE_H__
+#define __SAP_INTERFACE_H__
+
+/**
+ * @struct SapEndpoint
+ * @brief One end of a body's bounding interval on an axis.
+ */
+typedef struct
+{
+    float value;            /**< Coordinate of the endpoint on the axis. */
+    unsigned int key;       /**< Dense body index shifted left by one, with bit 0 set for a maximum endpoint. */
+} SapEndpoint;
+
+/**
+ * @struct SweepAndPrune
+ * @brief Sweep-and-prune broadphase over the bodies of a World.
+ *
+ * The minimum and maximum endpoints of every body's bounding box are kept in one sorted list per
+ * axis. The lists persist between updates and are re-sorted with insertion sort, which costs close
+ * to O(n) when bodies move coherently. Sleeping bodies keep the endpoints of their last refresh. Pairs are then found by sweeping the axis on which the
+ * bodies are most spread out and checking the other axis for the bodies currently open.
+ * Because it works on bounding intervals, bodies of very different sizes (circles and rectangles
+ * alike) cost the same, unlike a grid with a fixed cell size.
+ *
+ * Adding or removing bodies in the World triggers a full rebuild of the lists.
+ * The World header must be included before this header.
+ */
+typedef struct
+{
+    SapEndpoint* axis[2];       /**< Sorted endpoint lists for the X (0) and Y (1) axes. */
+    int endpointCapacity;       /**< Number of endpoints each list can hold. */
+
+    int* active;                /**< Bodies whose interval is open during the sweep. */
+    int* activePosition;        /**< Position of each body in the active list. */
+    unsigned char* wasAwake;    /**< Awake flag of each body at the last update. */
+
+    int trackedCount;           /**< World body count seen by the last update. */
+    unsigned int trackedVersion; /**< World structure version seen by the last update. */
+
+    BodyPair* pairs;            /**< Candidate pairs produced by the last update. */
+    int pairCapacity;           /**< Number of pairs the buffer can hold. */
+
+    int sweepAxis;              /**< Counter: axis swept by the last update (0 = X, 1 = Y). */
+    int pairCount;              /**< Counter: candidate pairs produced by the last update. */
+    int swapCount;              /**< Counter: insertion sort swaps done by the last update. */
+    double buildTimeMs;         /**< Counter: time spent in the last update, in milliseconds. */
+} SweepAndPrune;
+
+
+/**
+ * @brief Initializes an empty sweep-and-prune broadphase.
+ * @param sap Pointer to the SweepAndPrune struct to initialize.
+ */
+void sapInit(SweepAndPrune* sap);
+
+/**
+ * @brief Releases all storage owned by a sweep-and-prune broadphase.
+ * @param sap Pointer to the SweepAndPrune struct to release.
+ */
+void sapFree(SweepAndPrune* sap);
+
+/**
+ * @brief Re-sorts the endpoint lists for the current body positions and collects the candidate pairs.
+ *
+ * After this call sap->pairs holds sap->pairCount pairs whose bounding boxes overlap, ready to be
+ * passed to a narrowphase such as collideCirclePairs(). Pairs of two bodies that are static or
+ * asleep are skipped.
+ *
+ * @param sap Pointer to the SweepAndPrune struct.
+ * @param world Pointer to the World whose bodies are tracked.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int sapUpdate(SweepAndPrune* sap, const World* world);
+
+
+#endif /**< __SAP_INTERFACE_H__ */
@@ -0,0 +1,270 @@
+#include <stdlib.h>
+#include "WORLD_interface.h"
+#include "TIMER_interface.h"
+#include "SAP_interface.h"
+
+void sapInit(SweepAndPrune* sap)
+{
+    sap->axis[0] = NULL;
+    sap->axis[1] = NULL;
+    sap->endpointCapacity = 0;
+    sap->active = NULL;
+    sap->activePosition = NULL;
+    sap->wasAwake = NULL;
+    sap->trackedCount = -1;
+    sap->trackedVersion = 0;
+    sap->pairs = NULL;
+    sap->pairCapacity = 0;
+    sap->sweepAxis = 0;
+    sap->pairCount = 0;
+    sap->swapCount = 0;
+    sap->buildTimeMs = 0.0;
+}
+
+void sapFree(SweepAndPrune* sap)
+{
+    free(sap->axis[0]);
+    free(sap->axis[1]);
+    free(sap->active);
+    free(sap->activePosition);
+    free(sap->wasAwake);
+    free(sap->pairs);
+    sapInit(sap);
+}
+
+static int sapReserve(SweepAndPrune* sap, int bodyCount)
+{
+    if (2 * bodyCount <= sap->endpointCapacity)
+    {
+        return 1;
+    }
+
+    int capacity = sap->endpointCapacity > 0 ? sap->endpointCapacity : 128;
+    while (capacity < 2 * bodyCount)
+    {
+        capacity *= 2;
+    }
+
+    SapEndpoint* axisX = realloc(sap->axis[0], sizeof(SapEndpoint) * (size_t)capacity);
+    SapEndpoint* axisY = realloc(sap->axis[1], sizeof(SapEndpoint) * (size_t)capacity);
+    int* active = realloc(sap->active, sizeof(int) * (size_t)(capacity / 2));
+    int* activePosition = realloc(sap->activePosition, sizeof(int) * (size_t)(capacity / 2));
+    unsigned char* wasAwake = realloc(sap->wasAwake, (size_t)(capacity / 2));
+
+    // Keep whatever was reallocated so that sapFree releases it
+    if (axisX != NULL) sap->axis[0] = axisX;
+    if (axisY != NULL) sap->axis[1] = axisY;
+    if (active != NULL) sap->active = active;
+    if (activePosition != NULL) sap->activePosition = activePosition;
+    if (wasAwake != NULL) sap->wasAwake = wasAwake;
+
+    if (axisX == NULL || axisY == NULL || active == NULL || activePosition == NULL || wasAwake == NULL)
+    {
+        return 0;
+    }
+
+    sap->endpointCapacity = capacity;
+    return 1;
+}
+
+static int sapPushPair(SweepAndPrune* sap, int a, int b)
+{
+    if (sap->pairCount == sap->pairCapacity)
+    {
+        int capacity = sap->pairCapacity > 0 ? sap->pairCapacity * 2 : 256;
+        BodyPair* pairs = realloc(sap->pairs, sizeof(BodyPair) * (size_t)capacity);
+        if (pairs == NULL)
+        {
+            return 0;
+        }
+        sap->pairs = pairs;
+        sap->pairCapacity = capacity;
+    }
+
+    // Store pairs with the lower index first, the same way the grid does
+    sap->pairs[sap->pairCount].a = a < b ? a : b;
+    sap->pairs[sap->pairCount].b = a < b ? b : a;
+    sap->pairCount++;
+    return 1;
+}
+
+static float sapEndpointValue(const World* world, int axis, unsigned int key)
+{
+    int body = (int)(key >> 1);
+    const float* center = axis == 0 ? world->posX : world->posY;
+    const float* half = axis == 0 ? world->halfWidth : world->halfHeight;
+    return (key & 1u) ? center[body] + half[body] : center[body] - half[body];
+}
+
+static int sapOutOfOrder(const SapEndpoint* left, const SapEndpoint* right)
+{
+    // On ties minimum endpoints go first so that touching boxes are reported, as in the grid
+    return left->value > right->value
+        || (left->value == right->value && (left->key & 1u) && !(right->key & 1u));
+}
+
+static int sapInsertionSort(SapEndpoint* endpoints, int count)
+{
+    int swaps = 0;
+    for (int i = 1; i < count; i++)
+    {
+        SapEndpoint endpoint = endpoints[i];
+        int j = i - 1;
+        while (j >= 0 && sapOutOfOrder(&endpoints[j], &endpoint))
+        {
+            endpoints[j + 1] = endpoints[j];
+            j--;
+            swaps++;
+        }
+        endpoints[j + 1] = endpoint;
+    }
+    return swaps;
+}
+
+static int sapCompareEndpoints(const void* left, const void* right)
+{
+    const SapEndpoint* a = left;
+    const SapEndpoint* b = right;
+    return sapOutOfOrder(a, b) ? 1 : (sapOutOfOrder(b, a) ? -1 : 0);
+}
+
+static void sapRebuild(SweepAndPrune* sap, const World* world)
+{
+    for (int axis = 0; axis < 2; axis++)
+    {
+        for (int body = 0; body < world->count; body++)
+        {
+            sap->axis[axis][2 * body].key = (unsigned int)body << 1;
+            sap->axis[axis][2 * body + 1].key = ((unsigned int)body << 1) | 1u;
+        }
+    }
+    sap->trackedCount = world->count;
+    sap->trackedVersion = world->structureVersion;
+}
+
+static int sapChooseSweepAxis(const World* world)
+{
+    // Sweep along the axis with the largest spread of centers to keep the active list short
+    float meanX = 0.0f, meanY = 0.0f, varianceX = 0.0f, varianceY = 0.0f;
+    for (int body = 0; body < world->count; body++)
+    {
+        meanX += world->posX[body];
+        meanY += world->posY[body];
+    }
+    meanX /= (float)world->count;
+    meanY /= (float)world->count;
+
+    for (int body = 0; body < world->count; body++)
+    {
+        float dx = world->posX[body] - meanX;
+        float dy = world->posY[body] - meanY;
+        varianceX += dx * dx;
+        varianceY += dy * dy;
+    }
+    return varianceY > varianceX ? 1 : 0;
+}
+
+static int sapSweep(SweepAndPrune* sap, const World* world)
+{
+    const SapEndpoint* endpoints = sap->axis[sap->sweepAxis];
+    const float* otherCenter = sap->sweepAxis == 0 ? world->posY : world->posX;
+    const float* otherHalf = sap->sweepAxis == 0 ? world->halfHeight : world->halfWidth;
+    int activeCount = 0;
+
+    for (int i = 0; i < 2 * world->count; i++)
+    {
+        int body = (int)(endpoints[i].key >> 1);
+
+        if (endpoints[i].key & 1u)
+        {
+            // Maximum endpoint: close the interval by swapping the last active body into its place
+            int position = sap->activePosition[body];
+            int last = sap->active[--activeCount];
+            sap->active[position] = last;
+            sap->activePosition[last] = position;
+            continue;
+        }
+
+        // Minimum endpoint: every open interval overlaps on this axis, so only test the other one
+        for (int k = 0; k < activeCount; k++)
+        {
+            int other = sap->active[k];
+            if (!world->awake[body] && !world->awake[other])
+            {
+                continue; // Resting and static bodies never pair with each other
+            }
+
+            float distance = otherCenter[body] - otherCenter[other];
+            if (distance < 0.0f)
+            {
+                distance = -distance;
+            }
+            if (distance <= otherHalf[body] + otherHalf[other] && !sapPushPair(sap, body, other))
+            {
+                return 0;
+            }
+        }
+        sap->activePosition[body] = activeCount;
+        sap->active[activeCount++] = body;
+    }
+    return 1;
+}
+
+int sapUpdate(SweepAndPrune* sap, const World* world)
+{
+    double start = timerGetMilliseconds();
+
+    sap->pairCount = 0;
+    sap->swapCount = 0;
+    if (world->count == 0)
+    {
+        sap->buildTimeMs = timerGetMilliseconds() - start;
+        return 1;
+    }
+    if (!sapReserve(sap, world->count))
+    {
+        return 0;
+    }
+
+    int rebuilt = sap->trackedCount != world->count || sap->trackedVersion != world->structureVersion;
+    if (rebuilt)
+    {
+        sapRebuild(sap, world);
+    }
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+        SapEndpoint* endpoints = sap->axis[axis];
+        for (int i = 0; i < 2 * world->count; i++)
+        {
+            // Sleeping bodies do not move, so their endpoints keep the values of their last refresh. A body
+            // that fell asleep since the last update is refreshed once more: the solver may have pushed it
+            // after that update.
+            int body = (int)(endpoints[i].key >> 1);
+            if (rebuilt || world->awake[body] || sap->wasAwake[body] || world->invMass[body] == 0.0f)
+            {
+                endpoints[i].value = sapEndpointValue(world, axis, endpoints[i].key);
+            }
+        }
+
+        // A fresh list is in arbitrary order, so sort it once; afterwards it stays nearly sorted
+        if (rebuilt)
+        {
+            qsort(endpoints, (size_t)(2 * world->count), sizeof(SapEndpoint), sapCompareEndpoints);
+        }
+        else
+        {
+            sap->swapCount += sapInsertionSort(endpoints, 2 * world->count);
+        }
+    }
+
+    for (int body = 0; body < world->count; body++)
+    {
+        sap->wasAwake[body] = world->awake[body];
+    }
+
+    sap->sweepAxis = sapChooseSweepAxis(world);
+    int success = sapSweep(sap, world);
+    sap->buildTimeMs = timerGetMilliseconds() - start;
+    return success;
+}
@@ -0,0 +1,107 @@
+#ifndef __SCALAR_INTERFACE_H__
+#define __SCALAR_INTERFACE_H__
+
+/**
+ * @brief Options for SCALAR_TYPE.
+ *
+ * SCALAR_FLOAT  : Scalar is a 32-bit float (PC builds, targets with an FPU).
+ * SCALAR_FIXED  : Scalar is a Q16.16 fixed-point number (FPU-less targets such as the STM32F103C8).
+ *
+ * Select the backend by defining SCALAR_TYPE in the project settings (for example -DSCALAR_TYPE=1);
+ * float is used when it is not defined. In fixed-point the representable range is [-32768, 32768)
+ * with a resolution of 1/65536, which covers screen coordinates, velocities and masses of the demo scenes.
+ */
+#define SCALAR_FLOAT            0
+#define SCALAR_FIXED            1
+
+#ifndef SCALAR_TYPE
+#define SCALAR_TYPE             SCALAR_FLOAT
+#endif
+
+#if SCALAR_TYPE == SCALAR_FIXED
+
+#include <stdint.h>
+
+typedef int32_t Scalar;                 /**< Q16.16 fixed-point number. */
+
+#define SCALAR_FRACTION_BITS    16
+#define SCALAR_ONE              ((Scalar)1 << SCALAR_FRACTION_BITS)
+#define SCALAR_MAX              ((Scalar)0x7FFFFFFF)
+
+/** Converts a float to a Scalar; with a literal argument the compiler folds it to an integer constant. */
+#define SCALAR_FROM_FLOAT(f)    ((Scalar)((f) * 65536.0f))
+#define SCALAR_FROM_INT(i)      ((Scalar)((i) * SCALAR_ONE))
+#define SCALAR_TO_FLOAT(s)      ((float)(s) * (1.0f / 65536.0f))
+#define SCALAR_TO_INT(s)        ((int)((s) >> SCALAR_FRACTION_BITS))
+
+/**
+ * @brief Multiplies two Q16.16 numbers (a single SMULL plus shifts on Cortex-M3).
+ */
+static inline Scalar scalarMul(Scalar a, Scalar b)
+{
+    return (Scalar)(((int64_t)a * b) >> SCALAR_FRACTION_BITS);
+}
+
+/**
+ * @brief Computes the reciprocal of a Q16.16 number with Newton-Raphson iterations.
+ *
+ * Avoids the 64-bit division, which has no hardware support on Cortex-M3.
+ *
+ * @param value The number to invert.
+ * @return 1 / value, saturated to +/-SCALAR_MAX (SCALAR_MAX for 0).
+ */
+Scalar scalarReciprocal(Scalar value);
+
+/**
+ * @brief Computes the square root of a Q16.16 number using an integer digit-by-digit method.
+ * @param value The number to take the root of; negative values give 0.
+ * @return The square root of the value.
+ */
+Scalar scalarSqrt(Scalar value);
+
+/**
+ * @brief Divides two Q16.16 numbers as a multiplication by the reciprocal.
+ */
+static inline Scalar scalarDiv(Scalar a, Scalar b)
+{
+    return scalarMul(a, scalarReciprocal(b));
+}
+
+#else
+
+#include <math.h>
+
+typedef float Scalar;                   /**< Plain 32-bit float. */
+
+#define SCALAR_ONE              1.0f
+#define SCALAR_MAX              3.402823466e+38f
+
+#define SCALAR_FROM_FLOAT(f)    ((Scalar)(f))
+#define SCALAR_FROM_INT(i)      ((Scalar)(i))
+#define SCALAR_TO_FLOAT(s)      ((float)(s))
+#define SCALAR_TO_INT(s)        ((int)(s))
+
+static inline Scalar scalarMul(Scalar a, Scalar b)
+{
+    return a * b;
+}
+
+static inline Scalar scalarDiv(Scalar a, Scalar b)
+{
+    return a / b;
+}
+
+static inline Scalar scalarReciprocal(Scalar value)
+{
+    return 1.0f / value;
+}
+
+static inline Scalar scalarSqrt(Scalar value)
+{
+    return sqrtf(value);
+}
+
+#endif /**< SCALAR_TYPE */
+
+
+#endif /**< __SCALAR_INTERFACE_H__ */
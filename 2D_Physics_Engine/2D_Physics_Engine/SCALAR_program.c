@@ -0,0 +1,102 @@
+#include "SCALAR_interface.h"
+
+#if SCALAR_TYPE == SCALAR_FIXED
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Number of leading zero bits of a non-zero 32-bit value (a single CLZ instruction on Cortex-M3)
+static int scalarCountLeadingZeros(uint32_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_clz(value);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, value);
+    return 31 - (int)index;
+#else
+    int count = 0;
+    while (!(value & 0x80000000u))
+    {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+Scalar scalarReciprocal(Scalar value)
+{
+    if (value == 0)
+    {
+        return SCALAR_MAX;
+    }
+
+    int negative = value < 0;
+    uint32_t magnitude = negative ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+
+    // Normalize the magnitude to m in [0.5, 1), stored as Q0.32
+    int shift = scalarCountLeadingZeros(magnitude);
+    uint64_t m = (uint64_t)(magnitude << shift);
+
+    // Linear first guess 48/17 - 32/17 * m of 1/m in Q2.30, then three Newton-Raphson steps
+    // r = r * (2 - m * r), each doubling the number of correct bits
+    uint64_t r = 0xB4B4B4B4u - ((m * 0x78787878u) >> 32);
+    for (int i = 0; i < 3; i++)
+    {
+        uint64_t mr = (m * r) >> 32;
+        r = (r * (0x80000000u - mr)) >> 30;
+    }
+
+    // The value is m * 2^(16 - shift), so its reciprocal in Q16.16 is r * 2^(shift - 30)
+    uint64_t result;
+    if (shift >= 30)
+    {
+        result = r << (shift - 30);
+    }
+    else
+    {
+        result = r >> (30 - shift);
+    }
+    if (result > (uint64_t)SCALAR_MAX)
+    {
+        result = (uint64_t)SCALAR_MAX;
+    }
+    return negative ? -(Scalar)result : (Scalar)result;
+}
+
+Scalar scalarSqrt(Scalar value)
+{
+    if (value <= 0)
+    {
+        return 0;
+    }
+
+    // sqrt(v / 2^16) * 2^16 = sqrt(v * 2^16): take the integer root of the value widened by 16 bits,
+    // one result bit per iteration
+    uint64_t remainder = (uint64_t)value << SCALAR_FRACTION_BITS;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > remainder)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (remainder >= root + bit)
+        {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (Scalar)root;
+}
+
+#endif /**< SCALAR_TYPE */
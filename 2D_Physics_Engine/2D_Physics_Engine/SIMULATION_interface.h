@@ -0,0 +1,82 @@
+#ifndef __SIMULATION_INTERFACE_H__
+#define __SIMULATION_INTERFACE_H__
+
+/**
+ * @enum BroadphaseKind
+ * @brief The broadphase a Simulation uses to find candidate pairs.
+ */
+typedef enum
+{
+    BROADPHASE_GRID = 0,    /**< Uniform grid; best for many bodies of similar size. */
+    BROADPHASE_SAP = 1,     /**< Sweep and prune; best for coherent motion along one axis. */
+    BROADPHASE_TREE = 2     /**< Dynamic AABB tree; best for mixed sizes and mostly static scenes. */
+} BroadphaseKind;
+
+/**
+ * @struct Simulation
+ * @brief Complete stepping pipeline: a World plus the broadphase, narrowphase and solver state it needs.
+ *
+ * Setting jobs spreads the grid and tree pair searches, the islands of the solver, gravity and
+ * integration over the threads of a JobSystem; the bodies end up exactly where a serial step puts them.
+ *
+ * The World, Job, Grid, Sap, AabbTree, Narrowphase, Island, Solver and Ccd headers must be included before this header.
+ */
+typedef struct
+{
+    World world;                    /**< The bodies being simulated. */
+
+    BroadphaseKind broadphase;      /**< The broadphase in use. */
+    Grid grid;                      /**< Uniform grid state (used with BROADPHASE_GRID). */
+    SweepAndPrune sap;              /**< Sweep and prune state (used with BROADPHASE_SAP). */
+    AabbTree tree;                  /**< Dynamic tree state (used with BROADPHASE_TREE). */
+
+    ContactBuffer contacts;         /**< Contacts found by the last step. */
+    Islands islands;                /**< Contact islands of the last step and the sleep settings. */
+    Solver solver;                  /**< Contact solver and its impulse cache. */
+    Ccd ccd;                        /**< Continuous collision detection for bullet bodies. */
+    JobSystem* jobs;                /**< Job system running the parallel phases, NULL to step on the calling thread. */
+
+    int boundsWidth;                /**< Width of the box the bodies bounce in (0 disables the box). */
+    int boundsHeight;               /**< Height of the box the bodies bounce in (0 disables the box). */
+
+    int pairCount;                  /**< Counter: candidate pairs of the last step. */
+    double broadphaseTimeMs;        /**< Counter: broadphase time of the last step, in milliseconds. */
+    double narrowphaseTimeMs;       /**< Counter: narrowphase time of the last step, in milliseconds. */
+    double islandTimeMs;            /**< Counter: island building and sleep time of the last step, in milliseconds. */
+    double solverTimeMs;            /**< Counter: solver time of the last step, in milliseconds. */
+    double integrateTimeMs;         /**< Counter: gravity, integration and bounds time of the last step, in milliseconds. */
+    double stepTimeMs;              /**< Counter: total time of the last step, in milliseconds. */
+} Simulation;
+
+
+/**
+ * @brief Initializes a simulation with an empty world.
+ * @param simulation Pointer to the Simulation struct to initialize.
+ * @param broadphase The broadphase to use.
+ * @param initialCapacity Number of bodies to reserve storage for.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int simulationInit(Simulation* simulation, BroadphaseKind broadphase, int initialCapacity);
+
+/**
+ * @brief Releases all storage owned by a simulation, including its world.
+ * @param simulation Pointer to the Simulation struct to release.
+ */
+void simulationFree(Simulation* simulation);
+
+/**
+ * @brief Advances the simulation by one time step.
+ *
+ * Applies gravity, finds candidate pairs with the selected broadphase, builds the contacts and
+ * the islands (waking sleeping bodies that were touched), solves the contacts, puts resting islands
+ * to sleep, integrates the positions, sweeps the bullets back to their first impact and finally
+ * keeps the bodies inside the bounds.
+ *
+ * @param simulation Pointer to the Simulation struct.
+ * @param deltaTime The time step for the simulation.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int simulationStep(Simulation* simulation, float deltaTime);
+
+
+#endif /**< __SIMULATION_INTERFACE_H__ */
@@ -0,0 +1,178 @@
+#include <stdlib.h>
+#include "WORLD_interface.h"
+#include "JOB_interface.h"
+#include "GRID_interface.h"
+#include "SAP_interface.h"
+#include "AABBTREE_interface.h"
+#include "NARROWPHASE_interface.h"
+#include "ISLAND_interface.h"
+#include "SOLVER_interface.h"
+#include "CCD_interface.h"
+#include "SIMULATION_interface.h"
+#include "TIMER_interface.h"
+#include "TRACE_interface.h"
+
+#define SIMULATION_BODY_GRAIN   1024    /**< Bodies per job for gravity and integration; smaller worlds stay on one thread. */
+
+int simulationInit(Simulation* simulation, BroadphaseKind broadphase, int initialCapacity)
+{
+    simulation->broadphase = broadphase;
+    gridInit(&simulation->grid, 32.0f);
+    sapInit(&simulation->sap);
+    aabbTreeInit(&simulation->tree, AABBTREE_DEFAULT_MARGIN);
+    contactBufferInit(&simulation->contacts);
+    islandsInit(&simulation->islands);
+    solverInit(&simulation->solver, SOLVER_DEFAULT_ITERATIONS);
+    ccdInit(&simulation->ccd);
+    simulation->jobs = NULL;
+
+    simulation->boundsWidth = 0;
+    simulation->boundsHeight = 0;
+
+    simulation->pairCount = 0;
+    simulation->broadphaseTimeMs = 0.0;
+    simulation->narrowphaseTimeMs = 0.0;
+    simulation->islandTimeMs = 0.0;
+    simulation->solverTimeMs = 0.0;
+    simulation->integrateTimeMs = 0.0;
+    simulation->stepTimeMs = 0.0;
+
+    return worldInit(&simulation->world, initialCapacity);
+}
+
+void simulationFree(Simulation* simulation)
+{
+    gridFree(&simulation->grid);
+    sapFree(&simulation->sap);
+    aabbTreeFree(&simulation->tree);
+    contactBufferFree(&simulation->contacts);
+    islandsFree(&simulation->islands);
+    solverFree(&simulation->solver);
+    ccdFree(&simulation->ccd);
+    worldFree(&simulation->world);
+}
+
+// Runs the selected broadphase and points pairs at its pair buffer
+static int simulationFindPairs(Simulation* simulation, float deltaTime, const BodyPair** pairs)
+{
+    int success;
+
+    switch (simulation->broadphase)
+    {
+    case BROADPHASE_SAP:
+        success = sapUpdate(&simulation->sap, &simulation->world);
+        simulation->pairCount = simulation->sap.pairCount;
+        *pairs = simulation->sap.pairs;
+        break;
+    case BROADPHASE_TREE:
+        success = aabbTreeUpdateParallel(&simulation->tree, &simulation->world, deltaTime, simulation->jobs);
+        simulation->pairCount = simulation->tree.pairCount;
+        *pairs = simulation->tree.pairs;
+        break;
+    case BROADPHASE_GRID:
+    default:
+        success = gridUpdateParallel(&simulation->grid, &simulation->world, simulation->jobs);
+        simulation->pairCount = simulation->grid.pairCount;
+        *pairs = simulation->grid.pairs;
+        break;
+    }
+    return success;
+}
+
+typedef struct
+{
+    World* world;
+    float deltaTime;
+} SimulationBodyJob;
+
+static void simulationApplyGravityRange(void* data, int begin, int end)
+{
+    const SimulationBodyJob* job = data;
+    worldApplyGravityRange(job->world, begin, end, job->deltaTime);
+}
+
+static void simulationIntegrateRange(void* data, int begin, int end)
+{
+    const SimulationBodyJob* job = data;
+    worldIntegrateRange(job->world, begin, end, job->deltaTime);
+}
+
+int simulationStep(Simulation* simulation, float deltaTime)
+{
+    World* world = &simulation->world;
+    SimulationBodyJob bodyJob = { world, deltaTime };
+    double start = timerGetMilliseconds();
+    TraceZone stepZone = TRACE_BEGIN("step");
+
+    TraceZone zone = TRACE_BEGIN("gravity");
+    jobSystemParallelFor(simulation->jobs, simulationApplyGravityRange, &bodyJob, world->count, SIMULATION_BODY_GRAIN);
+    TRACE_END(zone);
+    double phase = timerGetMilliseconds();
+    simulation->integrateTimeMs = phase - start;
+
+    const BodyPair* pairs;
+    zone = TRACE_BEGIN("broadphase");
+    if (!simulationFindPairs(simulation, deltaTime, &pairs))
+    {
+        return 0;
+    }
+    TRACE_END(zone);
+    simulation->broadphaseTimeMs = timerGetMilliseconds() - phase;
+    phase = timerGetMilliseconds();
+
+    zone = TRACE_BEGIN("narrowphase");
+    if (!narrowphaseCollide(world, pairs, simulation->pairCount, &simulation->contacts))
+    {
+        return 0;
+    }
+    TRACE_END(zone);
+    simulation->narrowphaseTimeMs = timerGetMilliseconds() - phase;
+    phase = timerGetMilliseconds();
+
+    zone = TRACE_BEGIN("islands");
+    if (!islandsBuild(&simulation->islands, world, pairs, &simulation->contacts))
+    {
+        return 0;
+    }
+    TRACE_END(zone);
+    simulation->islandTimeMs = timerGetMilliseconds() - phase;
+    phase = timerGetMilliseconds();
+
+    zone = TRACE_BEGIN("solve");
+    if (!solverSolveIslands(&simulation->solver, world, pairs, &simulation->contacts, &simulation->islands, simulation->jobs))
+    {
+        return 0;
+    }
+    TRACE_END(zone);
+    simulation->solverTimeMs = timerGetMilliseconds() - phase;
+    phase = timerGetMilliseconds();
+
+    TRACE_SCOPE("sleep")
+    {
+        islandsUpdateSleep(&simulation->islands, world, deltaTime);
+    }
+    simulation->islandTimeMs += timerGetMilliseconds() - phase;
+    phase = timerGetMilliseconds();
+
+    TRACE_SCOPE("integrate")
+    {
+        jobSystemParallelFor(simulation->jobs, simulationIntegrateRange, &bodyJob, world->count, SIMULATION_BODY_GRAIN);
+    }
+    zone = TRACE_BEGIN("ccd");
+    // Only the tree broadphase can be queried with the swept boxes; the others leave it empty
+    const AabbTree* tree = simulation->broadphase == BROADPHASE_TREE ? &simulation->tree : NULL;
+    if (!ccdSweepBullets(&simulation->ccd, world, tree, deltaTime))
+    {
+        return 0;
+    }
+    TRACE_END(zone);
+    if (simulation->boundsWidth > 0 && simulation->boundsHeight > 0)
+    {
+        worldCollideWithWindow(world, simulation->boundsWidth, simulation->boundsHeight);
+    }
+    double end = timerGetMilliseconds();
+    simulation->integrateTimeMs += end - phase;
+    simulation->stepTimeMs = end - start;
+    TRACE_END(stepZone);
+    return 1;
+}
@@ -1,49 +1,53 @@
+#ifndef PHYSICS_HEADLESS
 #include <SDL.h>
-#include "solid2DRectangle_interface.h"
+#endif
+#include "SCALAR_interface.h"
+#include "SOLID2DRectangle_interface.h"
 
+#ifndef PHYSICS_HEADLESS
 void drawSolidRectangle(SDL_Renderer* renderer, int x, int y, int width, int height, SDL_Color color)
 {
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
 
-    // Draw individual points for each pixel in the rectangle
-    for (int row = y; row < y + height; row++)
-    {
-        for (int col = x; col < x + width; col++)
-        {
-            SDL_RenderDrawPoint(renderer, col, row);
-        }
-    }
+    // One fill call for the whole rectangle rather than one point call per pixel
+    SDL_Rect rect = { x, y, width, height };
+    SDL_RenderFillRect(renderer, &rect);
 }
+#endif
 
-void applyForce(Rectangle* rectangle, float forceX, float forceY, float deltaTime)
+void applyForce(Rectangle* rectangle, Scalar forceX, Scalar forceY, Scalar deltaTime)
 {
     // Apply the force to the rectangle using Newton's second law: F = ma
-    float accelerationX = forceX / rectangle->mass;
-    float accelerationY = forceY / rectangle->mass;
+    Scalar inverseMass = scalarReciprocal(rectangle->mass);
+    Scalar accelerationX = scalarMul(forceX, inverseMass);
+    Scalar accelerationY = scalarMul(forceY, inverseMass);
 
-    rectangle->velX += accelerationX * deltaTime;
-    rectangle->velY += accelerationY * deltaTime;
+    rectangle->velX += scalarMul(accelerationX, deltaTime);
+    rectangle->velY += scalarMul(accelerationY, deltaTime);
 }
 
 void resetRectangle(Rectangle* rectangle)
 {
-    rectangle->x = 400.0f; // Set the x-coordinate to 400.0f
-    rectangle->y = 300.0f; // Set the y-coordinate to 300.0f
-    rectangle->velX = 0.0f; // Set the velocity along the x-axis to 0.0f
-    rectangle->velY = 0.0f; // Set the velocity along the y-axis to 0.0f
+    rectangle->x = SCALAR_FROM_FLOAT(400.0f); // Set the x-coordinate to 400.0f
+    rectangle->y = SCALAR_FROM_FLOAT(300.0f); // Set the y-coordinate to 300.0f
+    rectangle->velX = 0; // Set the velocity along the x-axis to 0
+    rectangle->velY = 0; // Set the velocity along the y-axis to 0
 }
 
 void checkCollisionWithWindow(Rectangle* rectangle, int windowWidth, int windowHeight)
 {
+    Scalar width = SCALAR_FROM_INT(windowWidth);
+    Scalar height = SCALAR_FROM_INT(windowHeight);
+
     // Check for collision with the left and right boundaries
     if (rectangle->x - rectangle->width / 2 < 0)
     {
         rectangle->x = rectangle->width / 2;
         rectangle->velX = -rectangle->velX; // Reverse the X-velocity to simulate a bounce.
     }
-    else if (rectangle->x + rectangle->width / 2 > windowWidth)
+    else if (rectangle->x + rectangle->width / 2 > width)
     {
-        rectangle->x = windowWidth - rectangle->width / 2;
+        rectangle->x = width - rectangle->width / 2;
         rectangle->velX = -rectangle->velX; // Reverse the X-velocity to simulate a bounce.
     }
 
@@ -53,15 +57,15 @@ void checkCollisionWithWindow(Rectangle* rectangle, int windowWidth, int windowH
         rectangle->y = rectangle->height / 2;
         rectangle->velY = -rectangle->velY; // Reverse the Y-velocity to simulate a bounce.
     }
-    else if (rectangle->y + rectangle->height / 2 > windowHeight)
+    else if (rectangle->y + rectangle->height / 2 > height)
     {
-        rectangle->y = windowHeight - rectangle->height / 2;
+        rectangle->y = height - rectangle->height / 2;
         rectangle->velY = -rectangle->velY; // Reverse the Y-velocity to simulate a bounce.
     }
 }
 
-void updateRectanglePosition(Rectangle* rectangle, float deltaTime)
+void updateRectanglePosition(Rectangle* rectangle, Scalar deltaTime)
 {
-    rectangle->x += rectangle->velX * deltaTime;
-    rectangle->y += rectangle->velY * deltaTime;
+    rectangle->x += scalarMul(rectangle->velX, deltaTime);
+    rectangle->y += scalarMul(rectangle->velY, deltaTime);
 }
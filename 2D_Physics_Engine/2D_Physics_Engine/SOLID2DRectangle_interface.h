@@ -8,22 +8,26 @@
  * This struct is used to represent a rectangle in a 2D physics simulation. It contains information
  * about the rectangle's position, velocity, dimensions (width and height), and mass. The rectangle
  * can be affected by forces and will move and interact with other objects accordingly.
+ * Fields use the Scalar type, so the Scalar header must be included before this header.
  */
 typedef struct
 {
-    float x;            /**< The x-coordinate of the rectangle's center. */
-    float y;            /**< The y-coordinate of the rectangle's center. */
-    float velX;         /**< The velocity component along the X-axis. */
-    float velY;         /**< The velocity component along the Y-axis. */
-    float width;        /**< The width of the rectangle. */
-    float height;       /**< The height of the rectangle. */
-    float mass;         /**< The mass of the rectangle. */
+    Scalar x;           /**< The x-coordinate of the rectangle's center. */
+    Scalar y;           /**< The y-coordinate of the rectangle's center. */
+    Scalar velX;        /**< The velocity component along the X-axis. */
+    Scalar velY;        /**< The velocity component along the Y-axis. */
+    Scalar width;       /**< The width of the rectangle. */
+    Scalar height;      /**< The height of the rectangle. */
+    Scalar mass;        /**< The mass of the rectangle. */
 } Rectangle;
 
 
+#ifndef PHYSICS_HEADLESS
 /**
  * @brief Draw a solid (filled) rectangle on the renderer using the specified color.
  *
+ * Not declared when PHYSICS_HEADLESS is defined, for builds that do not use SDL such as the benchmarks.
+ *
  * @param renderer The SDL_Renderer on which to draw the rectangle.
  * @param x The x-coordinate of the top-left corner of the rectangle.
  * @param y The y-coordinate of the top-left corner of the rectangle.
@@ -32,6 +36,7 @@ typedef struct
  * @param color The SDL_Color representing the color of the rectangle (RGBA).
  */
 void drawSolidRectangle(SDL_Renderer* renderer, int x, int y, int width, int height, SDL_Color color);
+#endif
 
 /**
  * @brief Applies a force to a rectangle.
@@ -40,7 +45,7 @@ void drawSolidRectangle(SDL_Renderer* renderer, int x, int y, int width, int hei
  * @param forceY The force along the Y-axis.
  * @param deltaTime The time step for the simulation.
  */
-void applyForce(Rectangle* rectangle, float forceX, float forceY, float deltaTime);
+void applyForce(Rectangle* rectangle, Scalar forceX, Scalar forceY, Scalar deltaTime);
 
 /**
  * @brief Reset the position and velocity of a rectangle to initial values.
@@ -66,7 +71,7 @@ void checkCollisionWithWindow(Rectangle* rectangle, int windowWidth, int windowH
  * @param rectangle Pointer to the Rectangle struct to update its position.
  * @param deltaTime The time step for the simulation.
  */
-void updateRectanglePosition(Rectangle* rectangle, float deltaTime);
+void updateRectanglePosition(Rectangle* rectangle, Scalar deltaTime);
 
 
 
@@ -0,0 +1,158 @@
+#ifndef __SOLVER_INTERFACE_H__
+#define __SOLVER_INTERFACE_H__
+
+/**
+ * @brief Default number of velocity iterations; enough for stable piles thanks to warm starting.
+ */
+#define SOLVER_DEFAULT_ITERATIONS       4
+
+/**
+ * @brief Default number of position iterations used to remove penetration.
+ */
+#define SOLVER_DEFAULT_POSITION_ITERATIONS  2
+
+/**
+ * @struct SolverContact
+ * @brief Contact prepared for the velocity iterations.
+ */
+typedef struct
+{
+    int a;                  /**< Dense index of the first body. */
+    int b;                  /**< Dense index of the second body. */
+    float normalX;          /**< Unit normal along the X-axis, pointing from body a to body b. */
+    float normalY;          /**< Unit normal along the Y-axis, pointing from body a to body b. */
+    float anchorAX;         /**< Contact point relative to the center of body a along the X-axis. */
+    float anchorAY;         /**< Contact point relative to the center of body a along the Y-axis. */
+    float anchorBX;         /**< Contact point relative to the center of body b along the X-axis. */
+    float anchorBY;         /**< Contact point relative to the center of body b along the Y-axis. */
+    float normalMass;       /**< Effective mass along the normal at the contact point, rotation included. */
+    float tangentMass;      /**< Effective mass along the tangent at the contact point, rotation included. */
+    float positionMass;     /**< Linear mass used by the position correction: 1 / (invMassA + invMassB). */
+    float velocityBias;     /**< Target separating velocity from restitution. */
+    float depth;            /**< Penetration depth found by the narrowphase. */
+    float deltaX;           /**< Center offset from body a to body b along the X-axis when the depth was measured. */
+    float deltaY;           /**< Center offset from body a to body b along the Y-axis when the depth was measured. */
+    float normalImpulse;    /**< Accumulated impulse along the normal (never negative). */
+    float tangentImpulse;   /**< Accumulated friction impulse along the tangent (-normalY, normalX). */
+    unsigned int slotA;     /**< World handle slot of the first body, used as cache key. */
+    unsigned int slotB;     /**< World handle slot of the second body, used as cache key. */
+    unsigned int feature;   /**< Feature id of the contact point, used as cache key. */
+    int warmStarted;        /**< Non-zero if the impulses were taken from the cache. */
+} SolverContact;
+
+/**
+ * @struct ContactCacheEntry
+ * @brief Accumulated impulses of one contact point kept from one step to the next.
+ *
+ * The key is the body pair, ordered so that slotA < slotB, and the feature id of the point, so the
+ * two points of a rectangle manifold keep their own impulses. The tangent impulse is stored in slot order.
+ */
+typedef struct
+{
+    unsigned int slotA;     /**< Smaller handle slot of the pair. */
+    unsigned int slotB;     /**< Larger handle slot of the pair, WORLD_INVALID_SLOT for an empty entry. */
+    unsigned int feature;   /**< Feature id of the contact point. */
+    float normalImpulse;    /**< Accumulated normal impulse at the end of the step. */
+    float tangentImpulse;   /**< Accumulated tangent impulse at the end of the step. */
+} ContactCacheEntry;
+
+/**
+ * @struct Solver
+ * @brief Sequential-impulse contact solver with a persistent, warm-started contact cache.
+ *
+ * Every step the contacts are turned into velocity constraints, their impulses are initialized
+ * from the values the same body pairs reached in the previous step (warm starting), and a few
+ * Gauss-Seidel iterations enforce non-penetration with restitution and Coulomb friction. The final
+ * impulses are written into the cache for the next step. Penetration is then removed by moving the
+ * bodies directly in a few position iterations, so the correction never turns into velocity and is
+ * never warm-started (warm-starting a Baumgarte bias makes piles jitter). The cache is an open-addressing hash
+ * table keyed by World handle slots and contact feature ids, rebuilt every step so that pairs that
+ * stopped touching drop out.
+ *
+ * Impulses act at the contact point, so they spin bodies with a non-zero inverse inertia (rectangles).
+ * The position correction only moves the centers.
+ *
+ * solverSolveIslands() solves island by island instead. Islands share no dynamic body, so they can
+ * be solved on different threads of a JobSystem, and static bodies are never written by the solver.
+ * The result does not depend on the number of threads.
+ *
+ * The World, Narrowphase, Island and Job headers must be included before this header.
+ */
+typedef struct
+{
+    SolverContact* contacts;        /**< Contacts of the current step. */
+    int contactCount;               /**< Number of valid contacts. */
+    int contactCapacity;            /**< Number of contacts the array can hold. */
+
+    ContactCacheEntry* cache;       /**< Impulses of the previous step. */
+    ContactCacheEntry* nextCache;   /**< Impulses of the current step, swapped with cache at the end. */
+    int cacheCapacity;              /**< Number of entries of each table (a power of two). */
+
+    int iterations;                 /**< Velocity iterations per step. */
+    int positionIterations;         /**< Position iterations per step. */
+    int warmStarting;               /**< Non-zero to start from the cached impulses. */
+    float restitution;              /**< Coefficient of restitution (0 = no bounce, 1 = elastic). */
+    float restitutionThreshold;     /**< Approach speeds below this do not bounce, so resting contacts settle. */
+    float friction;                 /**< Coulomb friction coefficient. */
+    float baumgarte;                /**< Fraction of the penetration removed per position iteration. */
+    float allowedPenetration;       /**< Penetration left uncorrected to keep contacts persistent. */
+    float maxCorrection;            /**< Largest distance a contact may move its bodies in one position iteration. */
+
+    int warmStartCount;             /**< Counter: contacts of the last step found in the cache. */
+    double solveTimeMs;             /**< Counter: time spent in the last solve, in milliseconds. */
+} Solver;
+
+
+/**
+ * @brief Initializes a solver with default material settings and an empty cache.
+ * @param solver Pointer to the Solver struct to initialize.
+ * @param iterations Number of velocity iterations per step (SOLVER_DEFAULT_ITERATIONS is a good start).
+ */
+void solverInit(Solver* solver, int iterations);
+
+/**
+ * @brief Releases all storage owned by a solver.
+ * @param solver Pointer to the Solver struct to release.
+ */
+void solverFree(Solver* solver);
+
+/**
+ * @brief Forgets every cached impulse, for example after teleporting bodies.
+ * @param solver Pointer to the Solver struct.
+ */
+void solverClearCache(Solver* solver);
+
+/**
+ * @brief Solves the contacts of one step.
+ *
+ * Both bodies of a contact receive equal and opposite impulses weighted by their inverse masses,
+ * then overlapping bodies are pushed apart. The call belongs between the narrowphase and the
+ * integration of the step.
+ *
+ * @param solver Pointer to the Solver struct.
+ * @param world Pointer to the World holding the bodies.
+ * @param pairs The candidate pairs passed to the narrowphase.
+ * @param buffer The contacts produced from those pairs.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int solverSolve(Solver* solver, World* world, const BodyPair* pairs, const ContactBuffer* buffer);
+
+/**
+ * @brief Solves the contacts of one step island by island, optionally on several threads.
+ *
+ * Each island is prepared, iterated and position-corrected on its own, in the order given by the
+ * islands; a single large pile therefore runs on one thread. Only the cache update is serial.
+ * Contacts that belong to no island (between static or sleeping bodies) are ignored.
+ *
+ * @param solver Pointer to the Solver struct.
+ * @param world Pointer to the World holding the bodies.
+ * @param pairs The candidate pairs passed to the narrowphase.
+ * @param buffer The contacts produced from those pairs.
+ * @param islands The islands built from the same contacts.
+ * @param jobs Pointer to the JobSystem solving the islands, or NULL to solve them on the calling thread.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int solverSolveIslands(Solver* solver, World* world, const BodyPair* pairs, const ContactBuffer* buffer, const Islands* islands, JobSystem* jobs);
+
+
+#endif /**< __SOLVER_INTERFACE_H__ */
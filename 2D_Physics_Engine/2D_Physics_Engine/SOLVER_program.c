@@ -0,0 +1,430 @@
+#include <stdlib.h>
+#include <math.h>
+#include "WORLD_interface.h"
+#include "NARROWPHASE_interface.h"
+#include "ISLAND_interface.h"
+#include "JOB_interface.h"
+#include "SOLVER_interface.h"
+#include "TIMER_interface.h"
+
+void solverInit(Solver* solver, int iterations)
+{
+    solver->contacts = NULL;
+    solver->contactCount = 0;
+    solver->contactCapacity = 0;
+    solver->cache = NULL;
+    solver->nextCache = NULL;
+    solver->cacheCapacity = 0;
+
+    solver->iterations = iterations > 0 ? iterations : SOLVER_DEFAULT_ITERATIONS;
+    solver->positionIterations = SOLVER_DEFAULT_POSITION_ITERATIONS;
+    solver->warmStarting = 1;
+    solver->restitution = 0.5f;
+    solver->restitutionThreshold = 20.0f; // Pixels per second; slower approaches are resting contacts, not impacts
+    solver->friction = 0.4f;
+    solver->baumgarte = 0.2f;
+    solver->allowedPenetration = 0.5f;
+    solver->maxCorrection = 4.0f;
+
+    solver->warmStartCount = 0;
+    solver->solveTimeMs = 0.0;
+}
+
+void solverFree(Solver* solver)
+{
+    free(solver->contacts);
+    free(solver->cache);
+    free(solver->nextCache);
+    solverInit(solver, solver->iterations);
+}
+
+static void solverClearTable(ContactCacheEntry* table, int capacity)
+{
+    for (int i = 0; i < capacity; i++)
+    {
+        table[i].slotB = WORLD_INVALID_SLOT;
+    }
+}
+
+void solverClearCache(Solver* solver)
+{
+    if (solver->cache != NULL)
+    {
+        solverClearTable(solver->cache, solver->cacheCapacity);
+    }
+}
+
+// Returns the entry holding the key, or the empty entry where the key would be inserted.
+// The tables are never more than half full, so the probe always terminates.
+static ContactCacheEntry* solverFindEntry(ContactCacheEntry* table, int capacity, unsigned int slotA, unsigned int slotB, unsigned int feature)
+{
+    unsigned int mask = (unsigned int)capacity - 1;
+    unsigned int i = (slotA * 73856093u ^ slotB * 19349663u ^ feature * 83492791u) & mask;
+
+    while (table[i].slotB != WORLD_INVALID_SLOT
+        && (table[i].slotA != slotA || table[i].slotB != slotB || table[i].feature != feature))
+    {
+        i = (i + 1) & mask;
+    }
+    return &table[i];
+}
+
+static int solverReserve(Solver* solver, int contactCount)
+{
+    if (contactCount > solver->contactCapacity)
+    {
+        int capacity = solver->contactCapacity > 0 ? solver->contactCapacity : 64;
+        while (capacity < contactCount)
+        {
+            capacity *= 2;
+        }
+
+        SolverContact* contacts = realloc(solver->contacts, sizeof(SolverContact) * (size_t)capacity);
+        if (contacts == NULL)
+        {
+            return 0;
+        }
+        solver->contacts = contacts;
+        solver->contactCapacity = capacity;
+    }
+
+    // Keep the load factor of the cache tables at or below one half
+    int cacheCapacity = solver->cacheCapacity > 0 ? solver->cacheCapacity : 128;
+    while (cacheCapacity < contactCount * 2)
+    {
+        cacheCapacity *= 2;
+    }
+    if (cacheCapacity == solver->cacheCapacity)
+    {
+        return 1;
+    }
+
+    ContactCacheEntry* cache = malloc(sizeof(ContactCacheEntry) * (size_t)cacheCapacity);
+    ContactCacheEntry* nextCache = malloc(sizeof(ContactCacheEntry) * (size_t)cacheCapacity);
+    if (cache == NULL || nextCache == NULL)
+    {
+        free(cache);
+        free(nextCache);
+        return 0;
+    }
+
+    // Rehash the impulses of the previous step into the larger table
+    solverClearTable(cache, cacheCapacity);
+    for (int i = 0; i < solver->cacheCapacity; i++)
+    {
+        const ContactCacheEntry* old = &solver->cache[i];
+        if (old->slotB != WORLD_INVALID_SLOT)
+        {
+            *solverFindEntry(cache, cacheCapacity, old->slotA, old->slotB, old->feature) = *old;
+        }
+    }
+
+    free(solver->cache);
+    free(solver->nextCache);
+    solver->cache = cache;
+    solver->nextCache = nextCache;
+    solver->cacheCapacity = cacheCapacity;
+    return 1;
+}
+
+static void solverApplyImpulse(World* world, const SolverContact* contact, float impulseX, float impulseY)
+{
+    float invMassA = world->invMass[contact->a];
+    float invMassB = world->invMass[contact->b];
+    float invInertiaA = world->invInertia[contact->a];
+    float invInertiaB = world->invInertia[contact->b];
+
+    // Static bodies are never written, so islands touching the same static body can be solved concurrently
+    if (invMassA > 0.0f)
+    {
+        world->velX[contact->a] -= impulseX * invMassA;
+        world->velY[contact->a] -= impulseY * invMassA;
+    }
+    if (invMassB > 0.0f)
+    {
+        world->velX[contact->b] += impulseX * invMassB;
+        world->velY[contact->b] += impulseY * invMassB;
+    }
+    if (invInertiaA > 0.0f)
+    {
+        world->angularVelocity[contact->a] -= invInertiaA * (contact->anchorAX * impulseY - contact->anchorAY * impulseX);
+    }
+    if (invInertiaB > 0.0f)
+    {
+        world->angularVelocity[contact->b] += invInertiaB * (contact->anchorBX * impulseY - contact->anchorBY * impulseX);
+    }
+}
+
+// Velocity of the contact point of body b relative to the contact point of body a
+static void solverRelativeVelocity(const World* world, const SolverContact* contact, float* relativeX, float* relativeY)
+{
+    int a = contact->a;
+    int b = contact->b;
+    float angularA = world->angularVelocity[a];
+    float angularB = world->angularVelocity[b];
+
+    *relativeX = world->velX[b] - angularB * contact->anchorBY - world->velX[a] + angularA * contact->anchorAY;
+    *relativeY = world->velY[b] + angularB * contact->anchorBX - world->velY[a] - angularA * contact->anchorAX;
+}
+
+// Turns a contact into a velocity constraint and applies its warm-start impulse
+static void solverPrepareContact(const Solver* solver, World* world, const BodyPair* pairs, const Contact* contact, SolverContact* solverContact)
+{
+    int a = pairs[contact->pairIndex].a;
+    int b = pairs[contact->pairIndex].b;
+    float normalX = contact->normalX;
+    float normalY = contact->normalY;
+    float invMassSum = world->invMass[a] + world->invMass[b];
+    float invInertiaA = world->invInertia[a];
+    float invInertiaB = world->invInertia[b];
+
+    solverContact->a = a;
+    solverContact->b = b;
+    solverContact->normalX = normalX;
+    solverContact->normalY = normalY;
+    solverContact->anchorAX = contact->pointX - world->posX[a];
+    solverContact->anchorAY = contact->pointY - world->posY[a];
+    solverContact->anchorBX = contact->pointX - world->posX[b];
+    solverContact->anchorBY = contact->pointY - world->posY[b];
+
+    // Effective masses at the contact point: the lever arm adds the rotational inertia of each body
+    float normalArmA = solverContact->anchorAX * normalY - solverContact->anchorAY * normalX;
+    float normalArmB = solverContact->anchorBX * normalY - solverContact->anchorBY * normalX;
+    float tangentArmA = solverContact->anchorAX * normalX + solverContact->anchorAY * normalY;
+    float tangentArmB = solverContact->anchorBX * normalX + solverContact->anchorBY * normalY;
+    float normalSum = invMassSum + invInertiaA * normalArmA * normalArmA + invInertiaB * normalArmB * normalArmB;
+    float tangentSum = invMassSum + invInertiaA * tangentArmA * tangentArmA + invInertiaB * tangentArmB * tangentArmB;
+    solverContact->normalMass = normalSum > 0.0f ? 1.0f / normalSum : 0.0f;
+    solverContact->tangentMass = tangentSum > 0.0f ? 1.0f / tangentSum : 0.0f;
+    solverContact->positionMass = invMassSum > 0.0f ? 1.0f / invMassSum : 0.0f;
+
+    solverContact->slotA = world->bodySlot[a];
+    solverContact->slotB = world->bodySlot[b];
+    solverContact->feature = contact->feature;
+    solverContact->depth = contact->depth;
+    solverContact->deltaX = world->posX[b] - world->posX[a];
+    solverContact->deltaY = world->posY[b] - world->posY[a];
+
+    solverContact->velocityBias = 0.0f;
+    solverContact->normalImpulse = 0.0f;
+    solverContact->tangentImpulse = 0.0f;
+    solverContact->warmStarted = 0;
+
+    int swapped = solverContact->slotA > solverContact->slotB;
+    const ContactCacheEntry* entry = swapped
+        ? solverFindEntry(solver->cache, solver->cacheCapacity, solverContact->slotB, solverContact->slotA, solverContact->feature)
+        : solverFindEntry(solver->cache, solver->cacheCapacity, solverContact->slotA, solverContact->slotB, solverContact->feature);
+    if (entry->slotB == WORLD_INVALID_SLOT)
+    {
+        // Only a new contact is an impact and may bounce; points that were already touching in the
+        // previous step are resting, so that piles settle. The approach speed is taken at the
+        // centers, so that the corners of a slightly tilted rectangle do not bounce
+        float normalVelocity = (world->velX[b] - world->velX[a]) * normalX + (world->velY[b] - world->velY[a]) * normalY;
+        solverContact->velocityBias = normalVelocity < -solver->restitutionThreshold ? -solver->restitution * normalVelocity : 0.0f;
+        return;
+    }
+    if (!solver->warmStarting)
+    {
+        return;
+    }
+
+    // Start resting contacts from the impulses the point reached in the previous step. Swapping
+    // the bodies flips the normal, and with it the tangent direction
+    solverContact->normalImpulse = entry->normalImpulse;
+    solverContact->tangentImpulse = swapped ? -entry->tangentImpulse : entry->tangentImpulse;
+    solverContact->warmStarted = 1;
+
+    float impulseX = solverContact->normalImpulse * solverContact->normalX - solverContact->tangentImpulse * solverContact->normalY;
+    float impulseY = solverContact->normalImpulse * solverContact->normalY + solverContact->tangentImpulse * solverContact->normalX;
+    solverApplyImpulse(world, solverContact, impulseX, impulseY);
+}
+
+static void solverPrepare(Solver* solver, World* world, const BodyPair* pairs, const ContactBuffer* buffer)
+{
+    solver->contactCount = 0;
+
+    for (int i = 0; i < buffer->count; i++)
+    {
+        const Contact* contact = &buffer->contacts[i];
+        if (world->invMass[pairs[contact->pairIndex].a] + world->invMass[pairs[contact->pairIndex].b] == 0.0f)
+        {
+            continue;
+        }
+        solverPrepareContact(solver, world, pairs, contact, &solver->contacts[solver->contactCount++]);
+    }
+}
+
+static void solverIterate(Solver* solver, World* world, int begin, int end)
+{
+    float friction = solver->friction;
+
+    for (int i = begin; i < end; i++)
+    {
+        SolverContact* contact = &solver->contacts[i];
+        float normalX = contact->normalX;
+        float normalY = contact->normalY;
+        float relativeX, relativeY;
+
+        // Normal constraint: clamp the accumulated impulse, not the increment, so that earlier
+        // iterations can be partially undone
+        solverRelativeVelocity(world, contact, &relativeX, &relativeY);
+        float normalVelocity = relativeX * normalX + relativeY * normalY;
+        float lambda = contact->normalMass * (contact->velocityBias - normalVelocity);
+        float normalImpulse = fmaxf(contact->normalImpulse + lambda, 0.0f);
+        lambda = normalImpulse - contact->normalImpulse;
+        contact->normalImpulse = normalImpulse;
+        solverApplyImpulse(world, contact, lambda * normalX, lambda * normalY);
+
+        // Friction along the tangent (-normalY, normalX), bounded by the Coulomb cone
+        solverRelativeVelocity(world, contact, &relativeX, &relativeY);
+        float tangentVelocity = -relativeX * normalY + relativeY * normalX;
+        float maxFriction = friction * contact->normalImpulse;
+        float tangentImpulse = contact->tangentImpulse - contact->tangentMass * tangentVelocity;
+        tangentImpulse = fmaxf(-maxFriction, fminf(tangentImpulse, maxFriction));
+        lambda = tangentImpulse - contact->tangentImpulse;
+        contact->tangentImpulse = tangentImpulse;
+        solverApplyImpulse(world, contact, -lambda * normalY, lambda * normalX);
+    }
+}
+
+static void solverCorrectPositions(Solver* solver, World* world, int begin, int end)
+{
+    float* posX = world->posX;
+    float* posY = world->posY;
+    const float* invMass = world->invMass;
+
+    for (int i = begin; i < end; i++)
+    {
+        const SolverContact* contact = &solver->contacts[i];
+        int a = contact->a;
+        int b = contact->b;
+
+        // Current depth, from how far the centers moved along the normal since the narrowphase
+        float separation = (posX[b] - posX[a] - contact->deltaX) * contact->normalX
+            + (posY[b] - posY[a] - contact->deltaY) * contact->normalY;
+        float depth = contact->depth - separation;
+        float correction = fminf(solver->baumgarte * (depth - solver->allowedPenetration), solver->maxCorrection);
+        if (correction <= 0.0f)
+        {
+            continue;
+        }
+
+        // Only the centers move: rotation is left to the velocity constraints
+        float push = correction * contact->positionMass;
+        if (invMass[a] > 0.0f)
+        {
+            posX[a] -= push * invMass[a] * contact->normalX;
+            posY[a] -= push * invMass[a] * contact->normalY;
+        }
+        if (invMass[b] > 0.0f)
+        {
+            posX[b] += push * invMass[b] * contact->normalX;
+            posY[b] += push * invMass[b] * contact->normalY;
+        }
+    }
+}
+
+static void solverStoreImpulses(Solver* solver)
+{
+    ContactCacheEntry* table = solver->nextCache;
+    solverClearTable(table, solver->cacheCapacity);
+
+    solver->warmStartCount = 0;
+    for (int i = 0; i < solver->contactCount; i++)
+    {
+        const SolverContact* contact = &solver->contacts[i];
+        solver->warmStartCount += contact->warmStarted;
+        int swapped = contact->slotA > contact->slotB;
+        unsigned int slotA = swapped ? contact->slotB : contact->slotA;
+        unsigned int slotB = swapped ? contact->slotA : contact->slotB;
+
+        ContactCacheEntry* entry = solverFindEntry(table, solver->cacheCapacity, slotA, slotB, contact->feature);
+        entry->slotA = slotA;
+        entry->slotB = slotB;
+        entry->feature = contact->feature;
+        entry->normalImpulse = contact->normalImpulse;
+        entry->tangentImpulse = swapped ? -contact->tangentImpulse : contact->tangentImpulse;
+    }
+
+    // Pairs that did not touch this step are simply not carried over
+    solver->nextCache = solver->cache;
+    solver->cache = table;
+}
+
+int solverSolve(Solver* solver, World* world, const BodyPair* pairs, const ContactBuffer* buffer)
+{
+    double start = timerGetMilliseconds();
+
+    if (!solverReserve(solver, buffer->count))
+    {
+        return 0;
+    }
+
+    solverPrepare(solver, world, pairs, buffer);
+    for (int iteration = 0; iteration < solver->iterations; iteration++)
+    {
+        solverIterate(solver, world, 0, solver->contactCount);
+    }
+    solverStoreImpulses(solver);
+
+    for (int iteration = 0; iteration < solver->positionIterations; iteration++)
+    {
+        solverCorrectPositions(solver, world, 0, solver->contactCount);
+    }
+
+    solver->solveTimeMs = timerGetMilliseconds() - start;
+    return 1;
+}
+
+typedef struct
+{
+    Solver* solver;
+    World* world;
+    const BodyPair* pairs;
+    const ContactBuffer* buffer;
+    const Islands* islands;
+} SolverIslandJob;
+
+// Solves the islands of [begin, end); their contacts are contiguous, so they are solved as one block
+static void solverSolveIslandRange(void* data, int begin, int end)
+{
+    const SolverIslandJob* job = data;
+    Solver* solver = job->solver;
+    int first = job->islands->contactStart[begin];
+    int last = job->islands->contactStart[end];
+
+    // Solver contacts keep the island order, so contact i of the islands becomes solver contact i
+    for (int i = first; i < last; i++)
+    {
+        const Contact* contact = &job->buffer->contacts[job->islands->contacts[i]];
+        solverPrepareContact(solver, job->world, job->pairs, contact, &solver->contacts[i]);
+    }
+    for (int iteration = 0; iteration < solver->iterations; iteration++)
+    {
+        solverIterate(solver, job->world, first, last);
+    }
+    for (int iteration = 0; iteration < solver->positionIterations; iteration++)
+    {
+        solverCorrectPositions(solver, job->world, first, last);
+    }
+}
+
+int solverSolveIslands(Solver* solver, World* world, const BodyPair* pairs, const ContactBuffer* buffer, const Islands* islands, JobSystem* jobs)
+{
+    double start = timerGetMilliseconds();
+
+    if (!solverReserve(solver, buffer->count))
+    {
+        return 0;
+    }
+
+    SolverIslandJob job = { solver, world, pairs, buffer, islands };
+    solver->contactCount = islands->islandCount > 0 ? islands->contactStart[islands->islandCount] : 0;
+    jobSystemParallelFor(jobs, solverSolveIslandRange, &job, islands->islandCount, 0);
+
+    // Position correction does not touch the impulses, so storing them afterwards gives the same cache
+    solverStoreImpulses(solver);
+
+    solver->solveTimeMs = timerGetMilliseconds() - start;
+    return 1;
+}
@@ -0,0 +1,153 @@
+#ifndef __SPRITE_INTERFACE_H__
+#define __SPRITE_INTERFACE_H__
+
+#define SPRITE_DEFAULT_ATLAS_SIZE   1024    /**< Edge length of the atlas texture, in pixels. */
+#define SPRITE_CLASS_COUNT          6       /**< Slot size classes: 8, 16, 32, 64, 128 and 256 pixels. */
+#define SPRITE_MAX_RADIUS           127     /**< Largest radius that fits the largest slot. */
+#define SPRITE_MAX_ENTRIES          1024    /**< Sprites the cache can hold at once. */
+#define SPRITE_HASH_BUCKETS         256     /**< Hash buckets of the sprite lookup (a power of two). */
+
+/**
+ * @enum SpriteMode
+ * @brief How a circle sprite is rasterized.
+ */
+typedef enum
+{
+    SPRITE_OUTLINE = 0,     /**< One pixel outline, the same pixels as drawCircle(). */
+    SPRITE_FILLED = 1       /**< Solid disc. */
+} SpriteMode;
+
+/**
+ * @struct SpriteEntry
+ * @brief One cached sprite and its place in the atlas.
+ */
+typedef struct
+{
+    int radius;             /**< Radius of the circle, -1 for an unused entry. */
+    unsigned char mode;     /**< The SpriteMode of the sprite. */
+    unsigned char sizeClass; /**< Size class of the slot holding it. */
+    int slotX;              /**< Left edge of the slot in the atlas. */
+    int slotY;              /**< Top edge of the slot in the atlas. */
+    unsigned int lastFrame; /**< Flush count when the sprite was last queued. */
+    int shelf;              /**< Shelf holding its slot. */
+    int hashNext;           /**< Next entry of the same bucket, or of the free list when unused (-1 at the end). */
+    int lruPrev;            /**< More recently used entry (-1 for the most recent). */
+    int lruNext;            /**< Less recently used entry (-1 for the least recent). */
+} SpriteEntry;
+
+/**
+ * @struct SpriteShelf
+ * @brief A band of the atlas cut into the slots of one size class.
+ */
+typedef struct
+{
+    int top;                /**< Top edge of the shelf in the atlas. */
+    int height;             /**< Height of the shelf: the slot size of the class it was opened for. */
+    unsigned char sizeClass; /**< Size class its slots are cut for; smaller than height once reclaimed. */
+    unsigned int lastUsed;  /**< Flush count when one of its sprites was last drawn or queued. */
+    unsigned int lastQueued; /**< Flush count when one of its sprites was last queued. */
+} SpriteShelf;
+
+/**
+ * @struct SpriteCache
+ * @brief Circles rasterized once per radius and fill mode into a shared atlas texture.
+ *
+ * Sprites are rasterized in white and tinted when drawn, so one sprite serves every color. The
+ * atlas is cut into shelves of square slots whose size is a power of two; a shelf is opened the
+ * first time its size class needs room, and a sprite takes the smallest slot that holds its
+ * 2 * radius + 1 pixels. When a class has no free slot and no shelf can be opened, the least
+ * recently used sprite of that class is evicted and its slot reused. A class with nothing to evict
+ * takes over the least recently used shelf that is at least as tall as its slots and holds no
+ * sprite queued for the next flush: the shelf is emptied and cut into rows of the new slots.
+ * Shelves keep the height they were opened with, so once the atlas is full a class larger than
+ * every shelf gets no slot.
+ *
+ * Circles can be drawn one SDL_RenderCopy at a time with spriteCacheDraw(), or queued with
+ * spriteCacheQueue() and submitted as a single SDL_RenderGeometry call on the atlas by
+ * spriteCacheFlush(). Sprites queued since the last flush are never evicted, so the queued
+ * quads always sample the pixels they were queued with.
+ *
+ * The SDL header must be included before this header.
+ */
+typedef struct
+{
+    SDL_Renderer* renderer;     /**< Renderer owning the atlas. */
+    SDL_Texture* atlas;         /**< Atlas texture holding every sprite. */
+    int atlasSize;              /**< Edge length of the atlas, in pixels. */
+    int shelfTop;               /**< Top of the unused part of the atlas; shelves are stacked above it. */
+    SpriteShelf* shelves;       /**< Shelves opened so far, from the top of the atlas down. */
+    int shelfCount;             /**< Number of shelves opened. */
+    int* shelfOfRow;            /**< Shelf covering each band of 8 atlas rows, the smallest slot. */
+
+    SpriteEntry entries[SPRITE_MAX_ENTRIES];    /**< Entry pool. */
+    int buckets[SPRITE_HASH_BUCKETS];           /**< First entry of each hash bucket (-1 when empty). */
+    int freeEntry;                              /**< First unused entry (-1 when the pool is full). */
+    int lruHead;                                /**< Most recently used entry (-1 when empty). */
+    int lruTail;                                /**< Least recently used entry (-1 when empty). */
+
+    int* freeSlots[SPRITE_CLASS_COUNT];         /**< Free slots of each class, as slotY * atlasSize + slotX. */
+    int freeSlotCount[SPRITE_CLASS_COUNT];      /**< Number of free slots of each class. */
+    unsigned int* pixels;                       /**< Scratch buffer a sprite is rasterized into before upload. */
+
+    SDL_Vertex* vertices;       /**< Queued quads, four vertices each. */
+    int* indices;               /**< Two triangles per queued quad. */
+    int quadCount;              /**< Number of queued quads. */
+    int quadCapacity;           /**< Number of quads the arrays can hold. */
+    unsigned int frame;         /**< Number of flushes so far. */
+
+    unsigned long hitCount;     /**< Counter: draws that found their sprite in the cache. */
+    unsigned long missCount;    /**< Counter: draws that rasterized their sprite. */
+    unsigned long evictionCount; /**< Counter: sprites evicted to make room. */
+    unsigned long reclaimCount; /**< Counter: shelves taken over by another size class. */
+} SpriteCache;
+
+
+/**
+ * @brief Creates the atlas texture and initializes an empty cache.
+ * @param cache Pointer to the SpriteCache struct to initialize.
+ * @param renderer The SDL_Renderer the sprites are drawn with.
+ * @param atlasSize Edge length of the atlas (a multiple of 256), for example SPRITE_DEFAULT_ATLAS_SIZE.
+ * @return 1 on success, 0 if the texture or the storage could not be created.
+ */
+int spriteCacheInit(SpriteCache* cache, SDL_Renderer* renderer, int atlasSize);
+
+/**
+ * @brief Destroys the atlas texture and releases the storage owned by a cache.
+ * @param cache Pointer to the SpriteCache struct to release.
+ */
+void spriteCacheFree(SpriteCache* cache);
+
+/**
+ * @brief Draws a circle with one SDL_RenderCopy from the atlas, rasterizing it on a miss.
+ * @param cache Pointer to the SpriteCache.
+ * @param x The x coordinate of the circle's center.
+ * @param y The y coordinate of the circle's center.
+ * @param radius The radius of the circle.
+ * @param color The color of the circle.
+ * @param mode SPRITE_OUTLINE or SPRITE_FILLED.
+ * @return 1 if the circle was drawn, 0 if it cannot be cached (radius above SPRITE_MAX_RADIUS or
+ *         no slot free) and must be drawn another way, for example with drawCircle().
+ */
+int spriteCacheDraw(SpriteCache* cache, int x, int y, int radius, SDL_Color color, SpriteMode mode);
+
+/**
+ * @brief Queues a circle for the next spriteCacheFlush(), rasterizing it on a miss.
+ * @param cache Pointer to the SpriteCache.
+ * @param x The x coordinate of the circle's center.
+ * @param y The y coordinate of the circle's center.
+ * @param radius The radius of the circle.
+ * @param color The color of the circle.
+ * @param mode SPRITE_OUTLINE or SPRITE_FILLED.
+ * @return 1 if the circle was queued, 0 if it cannot be cached or the queue could not grow.
+ */
+int spriteCacheQueue(SpriteCache* cache, int x, int y, int radius, SDL_Color color, SpriteMode mode);
+
+/**
+ * @brief Draws every queued circle with a single SDL_RenderGeometry call and empties the queue.
+ * @param cache Pointer to the SpriteCache.
+ * @return 1 on success, 0 if SDL reported an error.
+ */
+int spriteCacheFlush(SpriteCache* cache);
+
+
+#endif /**< __SPRITE_INTERFACE_H__ */
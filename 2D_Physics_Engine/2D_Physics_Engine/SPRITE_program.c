@@ -0,0 +1,495 @@
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+#include "SPRITE_interface.h"
+
+#define SPRITE_MIN_SLOT_SIZE    8       /**< Slot edge of the smallest size class. */
+
+static int spriteSlotSize(int sizeClass)
+{
+    return SPRITE_MIN_SLOT_SIZE << sizeClass;
+}
+
+int spriteCacheInit(SpriteCache* cache, SDL_Renderer* renderer, int atlasSize)
+{
+    memset(cache, 0, sizeof(*cache));
+    cache->renderer = renderer;
+    cache->atlasSize = atlasSize;
+    cache->freeEntry = 0;
+    cache->lruHead = -1;
+    cache->lruTail = -1;
+    cache->frame = 1;
+
+    for (int i = 0; i < SPRITE_HASH_BUCKETS; i++)
+    {
+        cache->buckets[i] = -1;
+    }
+    for (int i = 0; i < SPRITE_MAX_ENTRIES; i++)
+    {
+        cache->entries[i].radius = -1;
+        cache->entries[i].hashNext = i + 1 < SPRITE_MAX_ENTRIES ? i + 1 : -1;
+    }
+
+    int maxSize = spriteSlotSize(SPRITE_CLASS_COUNT - 1);
+    if (atlasSize < maxSize || atlasSize % maxSize != 0)
+    {
+        return 0;
+    }
+
+    // Enough room for the whole atlas cut into slots of the class, or into shelves of the smallest class
+    for (int c = 0; c < SPRITE_CLASS_COUNT; c++)
+    {
+        int perRow = atlasSize / spriteSlotSize(c);
+        cache->freeSlots[c] = malloc(sizeof(int) * (size_t)perRow * (size_t)perRow);
+    }
+    int maxShelves = atlasSize / SPRITE_MIN_SLOT_SIZE;
+    cache->shelves = malloc(sizeof(SpriteShelf) * (size_t)maxShelves);
+    cache->shelfOfRow = malloc(sizeof(int) * (size_t)maxShelves);
+    cache->pixels = malloc(sizeof(unsigned int) * (size_t)maxSize * (size_t)maxSize);
+    cache->atlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, atlasSize, atlasSize);
+
+    int success = cache->pixels != NULL && cache->atlas != NULL && cache->shelves != NULL && cache->shelfOfRow != NULL;
+    for (int c = 0; c < SPRITE_CLASS_COUNT; c++)
+    {
+        success &= cache->freeSlots[c] != NULL;
+    }
+    if (!success)
+    {
+        spriteCacheFree(cache);
+        return 0;
+    }
+
+    SDL_SetTextureBlendMode(cache->atlas, SDL_BLENDMODE_BLEND);
+    return 1;
+}
+
+void spriteCacheFree(SpriteCache* cache)
+{
+    if (cache->atlas != NULL)
+    {
+        SDL_DestroyTexture(cache->atlas);
+        cache->atlas = NULL;
+    }
+    for (int c = 0; c < SPRITE_CLASS_COUNT; c++)
+    {
+        free(cache->freeSlots[c]);
+        cache->freeSlots[c] = NULL;
+        cache->freeSlotCount[c] = 0;
+    }
+    free(cache->shelves);
+    free(cache->shelfOfRow);
+    free(cache->pixels);
+    free(cache->vertices);
+    free(cache->indices);
+    cache->shelves = NULL;
+    cache->shelfOfRow = NULL;
+    cache->shelfCount = 0;
+    cache->pixels = NULL;
+    cache->vertices = NULL;
+    cache->indices = NULL;
+    cache->quadCount = 0;
+    cache->quadCapacity = 0;
+}
+
+static int spriteHash(int radius, SpriteMode mode)
+{
+    return (radius * 2 + (int)mode) & (SPRITE_HASH_BUCKETS - 1);
+}
+
+static void spriteLruUnlink(SpriteCache* cache, int index)
+{
+    SpriteEntry* entry = &cache->entries[index];
+    if (entry->lruPrev >= 0)
+    {
+        cache->entries[entry->lruPrev].lruNext = entry->lruNext;
+    }
+    else
+    {
+        cache->lruHead = entry->lruNext;
+    }
+    if (entry->lruNext >= 0)
+    {
+        cache->entries[entry->lruNext].lruPrev = entry->lruPrev;
+    }
+    else
+    {
+        cache->lruTail = entry->lruPrev;
+    }
+}
+
+static void spriteLruPushFront(SpriteCache* cache, int index)
+{
+    SpriteEntry* entry = &cache->entries[index];
+    entry->lruPrev = -1;
+    entry->lruNext = cache->lruHead;
+    if (cache->lruHead >= 0)
+    {
+        cache->entries[cache->lruHead].lruPrev = index;
+    }
+    else
+    {
+        cache->lruTail = index;
+    }
+    cache->lruHead = index;
+}
+
+// Removes a sprite from the lookup and the LRU list, giving its slot back to its class
+static void spriteEvict(SpriteCache* cache, int index)
+{
+    SpriteEntry* entry = &cache->entries[index];
+    int* link = &cache->buckets[spriteHash(entry->radius, (SpriteMode)entry->mode)];
+    while (*link != index)
+    {
+        link = &cache->entries[*link].hashNext;
+    }
+    *link = entry->hashNext;
+    spriteLruUnlink(cache, index);
+
+    cache->freeSlots[entry->sizeClass][cache->freeSlotCount[entry->sizeClass]++] = entry->slotY * cache->atlasSize + entry->slotX;
+    entry->radius = -1;
+    entry->hashNext = cache->freeEntry;
+    cache->freeEntry = index;
+    cache->evictionCount++;
+}
+
+// Least recently used sprite that is not queued for the next flush, of the given class or of any class (-1)
+static int spriteFindVictim(const SpriteCache* cache, int sizeClass)
+{
+    for (int index = cache->lruTail; index >= 0; index = cache->entries[index].lruPrev)
+    {
+        const SpriteEntry* entry = &cache->entries[index];
+        if (entry->lastFrame != cache->frame && (sizeClass < 0 || entry->sizeClass == sizeClass))
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+// Cuts a shelf into rows of slots of the class and makes them free
+static void spriteCutShelf(SpriteCache* cache, int shelfIndex, int sizeClass)
+{
+    SpriteShelf* shelf = &cache->shelves[shelfIndex];
+    int size = spriteSlotSize(sizeClass);
+    shelf->sizeClass = (unsigned char)sizeClass;
+
+    // Push the slots bottom to top and right to left so that they are handed out from the top left
+    for (int y = shelf->top + shelf->height - size; y >= shelf->top; y -= size)
+    {
+        for (int x = cache->atlasSize - size; x >= 0; x -= size)
+        {
+            cache->freeSlots[sizeClass][cache->freeSlotCount[sizeClass]++] = y * cache->atlasSize + x;
+        }
+    }
+}
+
+// Empties the least recently used shelf tall enough for the class with nothing queued for the next flush, and cuts it for the class
+static int spriteReclaimShelf(SpriteCache* cache, int sizeClass)
+{
+    int size = spriteSlotSize(sizeClass);
+    int best = -1;
+    for (int i = 0; i < cache->shelfCount; i++)
+    {
+        const SpriteShelf* shelf = &cache->shelves[i];
+        if (shelf->height >= size && shelf->lastQueued != cache->frame
+            && (best < 0 || shelf->lastUsed < cache->shelves[best].lastUsed))
+        {
+            best = i;
+        }
+    }
+    if (best < 0)
+    {
+        return 0;
+    }
+
+    for (int index = 0; index < SPRITE_MAX_ENTRIES; index++)
+    {
+        if (cache->entries[index].radius >= 0 && cache->entries[index].shelf == best)
+        {
+            spriteEvict(cache, index);
+        }
+    }
+
+    // Take the slots of the shelf back from its old class
+    SpriteShelf* shelf = &cache->shelves[best];
+    int oldClass = shelf->sizeClass;
+    int* slots = cache->freeSlots[oldClass];
+    int kept = 0;
+    for (int i = 0; i < cache->freeSlotCount[oldClass]; i++)
+    {
+        int slotY = slots[i] / cache->atlasSize;
+        if (slotY < shelf->top || slotY >= shelf->top + shelf->height)
+        {
+            slots[kept++] = slots[i];
+        }
+    }
+    cache->freeSlotCount[oldClass] = kept;
+
+    spriteCutShelf(cache, best, sizeClass);
+    cache->reclaimCount++;
+    return 1;
+}
+
+// Takes a free slot of the class, opening a shelf, evicting a sprite of the same class or reclaiming a shelf when none is left
+static int spriteTakeSlot(SpriteCache* cache, int sizeClass, int* slotX, int* slotY)
+{
+    int size = spriteSlotSize(sizeClass);
+    if (cache->freeSlotCount[sizeClass] == 0)
+    {
+        if (cache->shelfTop + size <= cache->atlasSize)
+        {
+            int shelfIndex = cache->shelfCount++;
+            SpriteShelf* shelf = &cache->shelves[shelfIndex];
+            shelf->top = cache->shelfTop;
+            shelf->height = size;
+            shelf->lastUsed = cache->frame;
+            shelf->lastQueued = 0;
+            for (int row = shelf->top / SPRITE_MIN_SLOT_SIZE; row < (shelf->top + size) / SPRITE_MIN_SLOT_SIZE; row++)
+            {
+                cache->shelfOfRow[row] = shelfIndex;
+            }
+            spriteCutShelf(cache, shelfIndex, sizeClass);
+            cache->shelfTop += size;
+        }
+        else
+        {
+            int victim = spriteFindVictim(cache, sizeClass);
+            if (victim >= 0)
+            {
+                spriteEvict(cache, victim);
+            }
+            else if (!spriteReclaimShelf(cache, sizeClass))
+            {
+                return 0;
+            }
+        }
+    }
+
+    int slot = cache->freeSlots[sizeClass][--cache->freeSlotCount[sizeClass]];
+    *slotX = slot % cache->atlasSize;
+    *slotY = slot / cache->atlasSize;
+    return 1;
+}
+
+// Rasterizes a white circle centered in a size x size square and uploads it to a slot
+static int spriteRasterize(SpriteCache* cache, int radius, SpriteMode mode, int slotX, int slotY, int size)
+{
+    unsigned int* pixels = cache->pixels;
+    memset(pixels, 0, sizeof(unsigned int) * (size_t)size * (size_t)size);
+
+    if (mode == SPRITE_FILLED)
+    {
+        // Same coverage rule as the outline: points within half a pixel outside the radius
+        for (int dy = -radius; dy <= radius; dy++)
+        {
+            for (int dx = -radius; dx <= radius; dx++)
+            {
+                if (dx * dx + dy * dy <= radius * radius + radius)
+                {
+                    pixels[(radius + dy) * size + radius + dx] = 0xFFFFFFFFu;
+                }
+            }
+        }
+    }
+    else
+    {
+        // Bresenham's circle, as in drawCircle
+        int centerX = radius;
+        int centerY = 0;
+        int errorVal = 0;
+        while (centerX >= centerY)
+        {
+            pixels[(radius + centerY) * size + radius + centerX] = 0xFFFFFFFFu;
+            pixels[(radius + centerX) * size + radius + centerY] = 0xFFFFFFFFu;
+            pixels[(radius + centerX) * size + radius - centerY] = 0xFFFFFFFFu;
+            pixels[(radius + centerY) * size + radius - centerX] = 0xFFFFFFFFu;
+            pixels[(radius - centerY) * size + radius - centerX] = 0xFFFFFFFFu;
+            pixels[(radius - centerX) * size + radius - centerY] = 0xFFFFFFFFu;
+            pixels[(radius - centerX) * size + radius + centerY] = 0xFFFFFFFFu;
+            pixels[(radius - centerY) * size + radius + centerX] = 0xFFFFFFFFu;
+
+            if (errorVal <= 0)
+            {
+                centerY += 1;
+                errorVal += 2 * centerY + 1;
+            }
+
+            if (errorVal > 0)
+            {
+                centerX -= 1;
+                errorVal -= 2 * centerX + 1;
+            }
+        }
+    }
+
+    // The whole slot is uploaded, which also clears what an evicted sprite left there
+    SDL_Rect rect = { slotX, slotY, size, size };
+    return SDL_UpdateTexture(cache->atlas, &rect, pixels, size * (int)sizeof(unsigned int)) == 0;
+}
+
+// Finds the sprite of a circle, rasterizing it on a miss; returns its entry or -1
+static int spriteLookup(SpriteCache* cache, int radius, SpriteMode mode)
+{
+    if (radius < 0 || radius > SPRITE_MAX_RADIUS || cache->atlas == NULL)
+    {
+        return -1;
+    }
+
+    int bucket = spriteHash(radius, mode);
+    for (int index = cache->buckets[bucket]; index >= 0; index = cache->entries[index].hashNext)
+    {
+        if (cache->entries[index].radius == radius && cache->entries[index].mode == (unsigned char)mode)
+        {
+            spriteLruUnlink(cache, index);
+            spriteLruPushFront(cache, index);
+            cache->shelves[cache->entries[index].shelf].lastUsed = cache->frame;
+            cache->hitCount++;
+            return index;
+        }
+    }
+
+    // Miss: the pool may be full even when the atlas is not
+    if (cache->freeEntry < 0)
+    {
+        int victim = spriteFindVictim(cache, -1);
+        if (victim < 0)
+        {
+            return -1;
+        }
+        spriteEvict(cache, victim);
+    }
+
+    int sizeClass = 0;
+    while (spriteSlotSize(sizeClass) < 2 * radius + 1)
+    {
+        sizeClass++;
+    }
+    int slotX, slotY;
+    if (!spriteTakeSlot(cache, sizeClass, &slotX, &slotY))
+    {
+        return -1;
+    }
+    if (!spriteRasterize(cache, radius, mode, slotX, slotY, spriteSlotSize(sizeClass)))
+    {
+        cache->freeSlots[sizeClass][cache->freeSlotCount[sizeClass]++] = slotY * cache->atlasSize + slotX;
+        return -1;
+    }
+
+    int index = cache->freeEntry;
+    SpriteEntry* entry = &cache->entries[index];
+    cache->freeEntry = entry->hashNext;
+    entry->radius = radius;
+    entry->mode = (unsigned char)mode;
+    entry->sizeClass = (unsigned char)sizeClass;
+    entry->slotX = slotX;
+    entry->slotY = slotY;
+    entry->lastFrame = 0;
+    entry->shelf = cache->shelfOfRow[slotY / SPRITE_MIN_SLOT_SIZE];
+    cache->shelves[entry->shelf].lastUsed = cache->frame;
+    entry->hashNext = cache->buckets[bucket];
+    cache->buckets[bucket] = index;
+    spriteLruPushFront(cache, index);
+    cache->missCount++;
+    return index;
+}
+
+int spriteCacheDraw(SpriteCache* cache, int x, int y, int radius, SDL_Color color, SpriteMode mode)
+{
+    int index = spriteLookup(cache, radius, mode);
+    if (index < 0)
+    {
+        return 0;
+    }
+
+    const SpriteEntry* entry = &cache->entries[index];
+    int side = 2 * radius + 1;
+    SDL_Rect source = { entry->slotX, entry->slotY, side, side };
+    SDL_Rect destination = { x - radius, y - radius, side, side };
+    SDL_SetTextureColorMod(cache->atlas, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(cache->atlas, color.a);
+    return SDL_RenderCopy(cache->renderer, cache->atlas, &source, &destination) == 0;
+}
+
+static int spriteReserveQuads(SpriteCache* cache, int needed)
+{
+    if (needed <= cache->quadCapacity)
+    {
+        return 1;
+    }
+
+    int capacity = cache->quadCapacity > 0 ? cache->quadCapacity * 2 : 256;
+    SDL_Vertex* vertices = realloc(cache->vertices, sizeof(SDL_Vertex) * 4 * (size_t)capacity);
+    if (vertices == NULL)
+    {
+        return 0;
+    }
+    cache->vertices = vertices;
+    int* indices = realloc(cache->indices, sizeof(int) * 6 * (size_t)capacity);
+    if (indices == NULL)
+    {
+        return 0;
+    }
+    cache->indices = indices;
+    cache->quadCapacity = capacity;
+    return 1;
+}
+
+int spriteCacheQueue(SpriteCache* cache, int x, int y, int radius, SDL_Color color, SpriteMode mode)
+{
+    if (!spriteReserveQuads(cache, cache->quadCount + 1))
+    {
+        return 0;
+    }
+    int index = spriteLookup(cache, radius, mode);
+    if (index < 0)
+    {
+        return 0;
+    }
+
+    // Pin the sprite until the flush has drawn it
+    SpriteEntry* entry = &cache->entries[index];
+    entry->lastFrame = cache->frame;
+    cache->shelves[entry->shelf].lastQueued = cache->frame;
+
+    float side = (float)(2 * radius + 1);
+    float scale = 1.0f / (float)cache->atlasSize;
+    float left = (float)(x - radius);
+    float top = (float)(y - radius);
+    float u0 = entry->slotX * scale;
+    float v0 = entry->slotY * scale;
+    float u1 = (entry->slotX + side) * scale;
+    float v1 = (entry->slotY + side) * scale;
+
+    SDL_Vertex* vertices = &cache->vertices[cache->quadCount * 4];
+    vertices[0] = (SDL_Vertex){ { left, top }, color, { u0, v0 } };
+    vertices[1] = (SDL_Vertex){ { left + side, top }, color, { u1, v0 } };
+    vertices[2] = (SDL_Vertex){ { left + side, top + side }, color, { u1, v1 } };
+    vertices[3] = (SDL_Vertex){ { left, top + side }, color, { u0, v1 } };
+
+    int first = cache->quadCount * 4;
+    int* indices = &cache->indices[cache->quadCount * 6];
+    indices[0] = first;
+    indices[1] = first + 1;
+    indices[2] = first + 2;
+    indices[3] = first;
+    indices[4] = first + 2;
+    indices[5] = first + 3;
+    cache->quadCount++;
+    return 1;
+}
+
+int spriteCacheFlush(SpriteCache* cache)
+{
+    int success = 1;
+    if (cache->quadCount > 0)
+    {
+        // The tint is in the vertex colors; undo any modulation left by spriteCacheDraw()
+        SDL_SetTextureColorMod(cache->atlas, 255, 255, 255);
+        SDL_SetTextureAlphaMod(cache->atlas, 255);
+        success = SDL_RenderGeometry(cache->renderer, cache->atlas, cache->vertices, cache->quadCount * 4,
+            cache->indices, cache->quadCount * 6) == 0;
+    }
+    cache->quadCount = 0;
+    cache->frame++;
+    return success;
+}
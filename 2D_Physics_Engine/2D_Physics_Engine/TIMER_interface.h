@@ -0,0 +1,16 @@
+#ifndef __TIMER_INTERFACE_H__
+#define __TIMER_INTERFACE_H__
+
+/**
+ * @brief Reads a monotonic clock for profiling counters.
+ *
+ * The physics modules use this instead of SDL_GetPerformanceCounter so that they can run without
+ * SDL (for example in headless tools). The clock is CLOCK_MONOTONIC on POSIX and the performance
+ * counter on Windows, so NTP or the user stepping the wall clock does not disturb the timings.
+ *
+ * @return The time in milliseconds since an arbitrary start; only differences are meaningful.
+ */
+double timerGetMilliseconds(void);
+
+
+#endif /**< __TIMER_INTERFACE_H__ */
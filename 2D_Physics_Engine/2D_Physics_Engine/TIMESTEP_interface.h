@@ -0,0 +1,64 @@
+#ifndef __TIMESTEP_INTERFACE_H__
+#define __TIMESTEP_INTERFACE_H__
+
+/**
+ * @brief Default physics rate, in steps per second.
+ */
+#define TIMESTEP_DEFAULT_RATE           120.0
+
+/**
+ * @brief Default largest number of physics steps run for one rendered frame.
+ */
+#define TIMESTEP_DEFAULT_MAX_SUBSTEPS   8
+
+/**
+ * @struct Timestep
+ * @brief Fixed-timestep accumulator that decouples the physics rate from the frame rate.
+ *
+ * Each frame adds the real time that passed to the accumulator, and the physics is advanced in
+ * fixed steps until less than one step is left. The leftover fraction of a step is used to
+ * interpolate between the last two physics states when drawing, so that motion stays smooth at any
+ * frame rate. When a frame would need more than maxSubSteps steps (after a stall, or when the
+ * physics cannot keep up) the extra time is dropped, so that slow steps cannot pile up into a
+ * spiral of death; the simulation then runs slower than real time instead.
+ */
+typedef struct
+{
+    double stepSeconds;         /**< Length of one physics step, in seconds. */
+    double accumulator;         /**< Real time not yet simulated, in seconds. */
+    int maxSubSteps;            /**< Largest number of steps run for one frame. */
+
+    int stepCount;              /**< Counter: steps to run for the last frame. */
+    int droppedStepCount;       /**< Counter: steps dropped since initialization by the substep cap. */
+} Timestep;
+
+
+/**
+ * @brief Initializes an accumulator with no pending time.
+ * @param timestep Pointer to the Timestep struct to initialize.
+ * @param rate Physics steps per second (TIMESTEP_DEFAULT_RATE is a good start).
+ * @param maxSubSteps Largest number of steps per frame (TIMESTEP_DEFAULT_MAX_SUBSTEPS is a good start).
+ */
+void timestepInit(Timestep* timestep, double rate, int maxSubSteps);
+
+/**
+ * @brief Adds the real time of a frame and returns how many physics steps to run for it.
+ * @param timestep Pointer to the Timestep struct.
+ * @param elapsedSeconds Real time since the previous frame, in seconds.
+ * @return The number of fixed steps to run, between 0 and maxSubSteps.
+ */
+int timestepAdvance(Timestep* timestep, double elapsedSeconds);
+
+/**
+ * @brief Returns how far the frame lies between the last two physics states.
+ *
+ * Call it after running the steps returned by timestepAdvance(), and draw every body at
+ * previous + (current - previous) * alpha.
+ *
+ * @param timestep Pointer to the Timestep struct.
+ * @return The interpolation factor, in [0, 1].
+ */
+float timestepGetAlpha(const Timestep* timestep);
+
+
+#endif /**< __TIMESTEP_INTERFACE_H__ */
@@ -0,0 +1,38 @@
+#include "TIMESTEP_interface.h"
+
+void timestepInit(Timestep* timestep, double rate, int maxSubSteps)
+{
+    timestep->stepSeconds = 1.0 / rate;
+    timestep->accumulator = 0.0;
+    timestep->maxSubSteps = maxSubSteps > 0 ? maxSubSteps : 1;
+    timestep->stepCount = 0;
+    timestep->droppedStepCount = 0;
+}
+
+int timestepAdvance(Timestep* timestep, double elapsedSeconds)
+{
+    // A clock going backwards must not rewind the simulation
+    if (elapsedSeconds > 0.0)
+    {
+        timestep->accumulator += elapsedSeconds;
+    }
+
+    int steps = (int)(timestep->accumulator / timestep->stepSeconds);
+    if (steps > timestep->maxSubSteps)
+    {
+        // Drop whole steps beyond the cap but keep the fraction, so that interpolation stays continuous
+        timestep->droppedStepCount += steps - timestep->maxSubSteps;
+        timestep->accumulator -= (double)(steps - timestep->maxSubSteps) * timestep->stepSeconds;
+        steps = timestep->maxSubSteps;
+    }
+
+    timestep->accumulator -= (double)steps * timestep->stepSeconds;
+    timestep->stepCount = steps;
+    return steps;
+}
+
+float timestepGetAlpha(const Timestep* timestep)
+{
+    float alpha = (float)(timestep->accumulator / timestep->stepSeconds);
+    return alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+}
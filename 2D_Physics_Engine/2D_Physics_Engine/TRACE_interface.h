@@ -0,0 +1,101 @@
+#ifndef __TRACE_INTERFACE_H__
+#define __TRACE_INTERFACE_H__
+
+/**
+ * @brief Options for TRACE_ENABLED.
+ *
+ * 0 : the markers compile to nothing and traceDump() writes no file (default).
+ * 1 : every marker records a timed event in a ring buffer of the calling thread.
+ *
+ * Select it by defining TRACE_ENABLED in the project settings (for example -DTRACE_ENABLED=1).
+ */
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED           0
+#endif
+
+#define TRACE_MAX_THREADS       72          /**< Threads that can record events (the job workers plus a few more). */
+#define TRACE_RING_CAPACITY     16384       /**< Events kept per thread (a power of two); older events are overwritten. */
+
+/**
+ * @struct TraceZone
+ * @brief A marker that has begun and not ended yet.
+ */
+typedef struct
+{
+    const char* name;               /**< Event name; must be a string literal or otherwise outlive the trace. */
+    unsigned long long startNs;     /**< Time the zone began, in nanoseconds. */
+} TraceZone;
+
+#if TRACE_ENABLED
+
+/**
+ * @brief Begins a zone ended by TRACE_END(); a zone left without TRACE_END() (for example by an early
+ * return) is simply not recorded.
+ */
+#define TRACE_BEGIN(name)       traceBegin(name)
+
+/**
+ * @brief Ends a zone begun by TRACE_BEGIN() and records it.
+ */
+#define TRACE_END(zone)         traceEnd(&(zone))
+
+/**
+ * @brief Records the statement or block that follows as one zone.
+ *
+ * The block must be left through its end, not with return, break or goto.
+ */
+#define TRACE_SCOPE(label)      for (TraceZone traceScope = traceBegin(label); traceScope.name != NULL; traceEnd(&traceScope))
+
+/**
+ * @brief Names the calling thread in the dumped trace.
+ */
+#define TRACE_THREAD_NAME(name) traceSetThreadName(name)
+
+#else
+
+#define TRACE_BEGIN(name)       ((TraceZone){ 0 })
+#define TRACE_END(zone)         ((void)(zone))
+#define TRACE_SCOPE(label)      for (int traceScope = 1; traceScope; traceScope = 0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+
+#endif
+
+
+/**
+ * @brief Starts a zone on the calling thread; use TRACE_BEGIN() so that disabled builds drop the call.
+ * @param name Event name.
+ * @return The zone to pass to traceEnd().
+ */
+TraceZone traceBegin(const char* name);
+
+/**
+ * @brief Records a zone in the ring buffer of the calling thread; use TRACE_END().
+ *
+ * The first event of a thread allocates its ring. Each ring has a single writer, its thread, which
+ * publishes an event by advancing the ring head, so recording takes no lock. A thread that cannot
+ * get a ring (TRACE_MAX_THREADS reached or out of memory) does not record.
+ *
+ * @param zone The zone to end; its name is cleared.
+ */
+void traceEnd(TraceZone* zone);
+
+/**
+ * @brief Sets the name the calling thread is shown with; use TRACE_THREAD_NAME().
+ * @param name Thread name; must be a string literal or otherwise outlive the trace.
+ */
+void traceSetThreadName(const char* name);
+
+/**
+ * @brief Writes the events currently held by every ring as Chrome trace_event JSON.
+ *
+ * The file opens in chrome://tracing or https://ui.perfetto.dev. It can be called at any time,
+ * including while other threads record: events overwritten during the copy are dropped rather
+ * than written torn. The rings keep their events, so successive dumps overlap.
+ *
+ * @param path Path of the file to write.
+ * @return 1 on success, 0 if tracing is compiled out or the file could not be written.
+ */
+int traceDump(const char* path);
+
+
+#endif /**< __TRACE_INTERFACE_H__ */
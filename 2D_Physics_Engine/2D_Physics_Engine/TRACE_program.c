@@ -0,0 +1,217 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "TRACE_interface.h"
+
+#if TRACE_ENABLED
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#define traceAtomicAdd(value, amount)   InterlockedExchangeAdd(value, amount)
+#define traceAtomicLoad64(value)        InterlockedCompareExchange64(value, 0, 0)
+#define traceAtomicStore64(value, v)    InterlockedExchange64(value, v)
+#define traceAtomicLoadPointer(value)   InterlockedCompareExchangePointer((PVOID volatile*)(value), NULL, NULL)
+#define traceAtomicStorePointer(value, v) InterlockedExchangePointer((PVOID volatile*)(value), v)
+#define traceFence()                    MemoryBarrier()
+#define TRACE_THREAD_LOCAL              __declspec(thread)
+#else
+#include <time.h>
+
+#define traceAtomicAdd(value, amount)   __atomic_fetch_add(value, amount, __ATOMIC_ACQ_REL)
+#define traceAtomicLoad64(value)        __atomic_load_n(value, __ATOMIC_ACQUIRE)
+#define traceAtomicStore64(value, v)    __atomic_store_n(value, v, __ATOMIC_RELEASE)
+#define traceAtomicLoadPointer(value)   __atomic_load_n(value, __ATOMIC_ACQUIRE)
+#define traceAtomicStorePointer(value, v) __atomic_store_n(value, v, __ATOMIC_RELEASE)
+#define traceFence()                    __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define TRACE_THREAD_LOCAL              _Thread_local
+#endif
+
+typedef struct
+{
+    const char* name;
+    unsigned long long startNs;
+    unsigned long long durationNs;
+} TraceEvent;
+
+typedef struct
+{
+    TraceEvent events[TRACE_RING_CAPACITY];
+    volatile long long head;    // Events ever written; only the owner thread advances it
+    const char* threadName;
+} TraceRing;
+
+// Rings are published once and never freed, so the dump can read them while their threads run
+static TraceRing* volatile traceRings[TRACE_MAX_THREADS];
+static volatile long traceRingCount = 0;
+
+// Ring of the thread running the code; traceNoRing marks a thread that could not get one
+static TraceRing traceNoRing;
+static TRACE_THREAD_LOCAL TraceRing* traceCurrentRing = NULL;
+
+static unsigned long long traceNow(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (unsigned long long)(counter.QuadPart / frequency.QuadPart) * 1000000000ull
+        + (unsigned long long)(counter.QuadPart % frequency.QuadPart) * 1000000000ull / (unsigned long long)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ull + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+static TraceRing* traceGetRing(void)
+{
+    if (traceCurrentRing != NULL)
+    {
+        return traceCurrentRing;
+    }
+
+    traceCurrentRing = &traceNoRing;
+    long index = traceAtomicAdd(&traceRingCount, 1);
+    if (index >= TRACE_MAX_THREADS)
+    {
+        return traceCurrentRing;
+    }
+
+    TraceRing* ring = calloc(1, sizeof(TraceRing));
+    if (ring != NULL)
+    {
+        traceAtomicStorePointer(&traceRings[index], ring);
+        traceCurrentRing = ring;
+    }
+    return traceCurrentRing;
+}
+
+TraceZone traceBegin(const char* name)
+{
+    TraceZone zone = { name, traceNow() };
+    return zone;
+}
+
+void traceEnd(TraceZone* zone)
+{
+    unsigned long long end = traceNow();
+    TraceRing* ring = traceGetRing();
+    if (ring != &traceNoRing)
+    {
+        long long head = ring->head;
+        TraceEvent* event = &ring->events[head & (TRACE_RING_CAPACITY - 1)];
+        event->name = zone->name;
+        event->startNs = zone->startNs;
+        event->durationNs = end - zone->startNs;
+
+        // Publish the event after its fields
+        traceAtomicStore64(&ring->head, head + 1);
+    }
+    zone->name = NULL;
+}
+
+void traceSetThreadName(const char* name)
+{
+    TraceRing* ring = traceGetRing();
+    if (ring != &traceNoRing)
+    {
+        ring->threadName = name;
+    }
+}
+
+// Copies the events of a ring that are still intact once the copy is done, oldest first
+static int traceCopyRing(TraceRing* ring, TraceEvent* events)
+{
+    long long head = traceAtomicLoad64(&ring->head);
+    long long first = head > TRACE_RING_CAPACITY ? head - TRACE_RING_CAPACITY : 0;
+    for (long long i = first; i < head; i++)
+    {
+        events[i - first] = ring->events[i & (TRACE_RING_CAPACITY - 1)];
+    }
+
+    // The owner may have wrapped over the oldest entries meanwhile, and may be writing the next one
+    traceFence();
+    long long newHead = traceAtomicLoad64(&ring->head);
+    long long intact = newHead + 1 > TRACE_RING_CAPACITY ? newHead + 1 - TRACE_RING_CAPACITY : 0;
+    int skip = intact > first ? (int)(intact - first) : 0;
+    int count = (int)(head - first);
+    if (skip >= count)
+    {
+        return 0;
+    }
+    for (int i = skip; i < count; i++)
+    {
+        events[i - skip] = events[i];
+    }
+    return count - skip;
+}
+
+int traceDump(const char* path)
+{
+    TraceEvent* events = malloc(TRACE_RING_CAPACITY * sizeof(TraceEvent));
+    if (events == NULL)
+    {
+        return 0;
+    }
+    FILE* file = fopen(path, "w");
+    if (file == NULL)
+    {
+        free(events);
+        return 0;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"MicroPhysics\"}}");
+
+    long ringCount = traceAtomicAdd(&traceRingCount, 0);
+    for (long r = 0; r < ringCount && r < TRACE_MAX_THREADS; r++)
+    {
+        TraceRing* ring = traceAtomicLoadPointer(&traceRings[r]);
+        if (ring == NULL)
+        {
+            continue;
+        }
+
+        const char* threadName = ring->threadName;
+        if (threadName != NULL)
+        {
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%ld,\"args\":{\"name\":\"%s\"}}", r, threadName);
+        }
+        else
+        {
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%ld,\"args\":{\"name\":\"thread %ld\"}}", r, r);
+        }
+
+        // Timestamps are in microseconds
+        int count = traceCopyRing(ring, events);
+        for (int i = 0; i < count; i++)
+        {
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%ld,\"ts\":%.3f,\"dur\":%.3f}",
+                events[i].name, r, events[i].startNs / 1000.0, events[i].durationNs / 1000.0);
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    int success = fclose(file) == 0;
+    free(events);
+    return success;
+}
+
+#else
+
+int traceDump(const char* path)
+{
+    (void)path;
+    return 0;
+}
+
+#endif
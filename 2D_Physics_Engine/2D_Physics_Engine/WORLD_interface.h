@@ -0,0 +1,337 @@
+#ifndef __WORLD_INTERFACE_H__
+#define __WORLD_INTERFACE_H__
+
+/**
+ * @brief Byte alignment of every per-body array stored in a World (one AVX register).
+ */
+#define WORLD_ALIGNMENT         32
+
+/**
+ * @brief Slot value carried by a handle that does not refer to any body.
+ */
+#define WORLD_INVALID_SLOT      0xFFFFFFFFu
+
+/**
+ * @brief Largest number of vertices of a polygon body; larger outlines are rejected.
+ */
+#define WORLD_MAX_POLYGON_VERTICES  8
+
+/**
+ * @enum BodyType
+ * @brief The shape kinds a World can hold.
+ */
+typedef enum
+{
+    BODY_CIRCLE = 0,    /**< A circle described by its radius. */
+    BODY_RECTANGLE = 1, /**< A rectangle described by its half extents and rotated by its angle. */
+    BODY_POLYGON = 2    /**< A convex polygon stored in the world vertex pool and rotated by its angle. */
+} BodyType;
+
+/**
+ * @struct BodyHandle
+ * @brief Stable reference to a body stored in a World.
+ *
+ * Dense body indices change when other bodies are removed, so callers keep handles and resolve
+ * them with worldGetIndex(). The generation detects handles to bodies that were already removed.
+ */
+typedef struct
+{
+    unsigned int slot;          /**< Index into the World's handle table. */
+    unsigned int generation;    /**< Generation of the slot when the handle was issued. */
+} BodyHandle;
+
+/**
+ * @struct BodyPair
+ * @brief Candidate collision pair produced by a broadphase, as dense body indices.
+ */
+typedef struct
+{
+    int a;              /**< Dense index of the first body. */
+    int b;              /**< Dense index of the second body. */
+} BodyPair;
+
+/**
+ * @struct PairList
+ * @brief Growable array of body pairs, used by broadphases that collect pairs in parallel chunks.
+ */
+typedef struct
+{
+    BodyPair* pairs;    /**< The pairs, lower index first. */
+    int count;          /**< Number of pairs stored. */
+    int capacity;       /**< Number of pairs the array can hold. */
+} PairList;
+
+/**
+ * @struct Aabb
+ * @brief Axis-aligned bounding box.
+ */
+typedef struct
+{
+    float minX;         /**< Smallest x coordinate covered by the box. */
+    float minY;         /**< Smallest y coordinate covered by the box. */
+    float maxX;         /**< Largest x coordinate covered by the box. */
+    float maxY;         /**< Largest y coordinate covered by the box. */
+} Aabb;
+
+/**
+ * @struct World
+ * @brief Structure-of-arrays container holding every body of a simulation.
+ *
+ * Each per-body property lives in its own contiguous, WORLD_ALIGNMENT-aligned array indexed by the
+ * dense body index (0 .. count - 1). Removing a body moves the last body into the freed index, so
+ * the arrays never contain holes and the batch functions below run over straight loops.
+ *
+ * Polygon outlines live in a shared vertex pool, in the frame of their body (centroid at the
+ * origin, counter-clockwise in a Y-up frame); each polygon owns a contiguous range of the pool.
+ *
+ * Bodies that came to rest are put to sleep by whole islands: their velocity is zeroed, they are
+ * skipped by gravity, broadphase pair searches and the solver, and the bodies of each sleeping island
+ * are linked in a ring so that touching or pushing any of them wakes the island at once.
+ */
+typedef struct
+{
+    int count;                  /**< Number of live bodies. */
+    int capacity;               /**< Number of bodies the arrays can hold before growing. */
+
+    float* posX;                /**< The x coordinates of the body centers. */
+    float* posY;                /**< The y coordinates of the body centers. */
+    float* velX;                /**< The velocity components along the X-axis. */
+    float* velY;                /**< The velocity components along the Y-axis. */
+    float* radius;              /**< Circle radii (0 for rectangles). */
+    float* halfWidth;           /**< Half of the axis-aligned bounding width (the radius for circles). */
+    float* halfHeight;          /**< Half of the axis-aligned bounding height (the radius for circles). */
+    float* invMass;             /**< Inverse masses; 0 marks a static body. */
+    float* angle;               /**< Rotation of each body around its center, in radians. */
+    float* angularVelocity;     /**< Angular velocities, in radians per second. */
+    float* invInertia;          /**< Inverse rotational inertias; 0 for static bodies and circles, which do not rotate. */
+    float* extentX;             /**< Half extent of rectangles and polygons along their own X-axis (the radius for circles). */
+    float* extentY;             /**< Half extent of rectangles and polygons along their own Y-axis (the radius for circles). */
+    int* vertexStart;           /**< First vertex of each polygon in the vertex pool (0 for other shapes). */
+    unsigned char* vertexCount; /**< Number of vertices of each polygon (0 for other shapes). */
+    unsigned char* type;        /**< The BodyType of each body. */
+    unsigned char* awake;       /**< 1 for simulated dynamic bodies, 0 for sleeping and static bodies. */
+    float* sleepTime;           /**< Time each body has spent below the sleep velocity. */
+    unsigned char* bullet;      /**< 1 for fast bodies swept by continuous collision detection. */
+    unsigned int* bodySlot;     /**< Handle slot owning each dense index. */
+
+    float* vertexX;             /**< Vertex pool: x coordinates of the polygon vertices, in body space. */
+    float* vertexY;             /**< Vertex pool: y coordinates of the polygon vertices, in body space. */
+    int vertexPoolCount;        /**< Number of vertices used in the pool. */
+    int vertexPoolCapacity;     /**< Number of vertices the pool can hold before growing. */
+
+    int* slotIndex;             /**< Dense index of each handle slot, or the next free slot when unused. */
+    unsigned int* slotGeneration; /**< Current generation of each handle slot. */
+    int slotCount;              /**< Number of handle slots handed out so far. */
+    int freeSlot;               /**< Head of the free slot list (-1 when empty). */
+    int* sleepNext;             /**< Next slot of the same sleeping island (a ring), or -1 for bodies not asleep. */
+
+    float gravityX;             /**< Gravity acceleration along the X-axis. */
+    float gravityY;             /**< Gravity acceleration along the Y-axis. */
+
+    unsigned int structureVersion; /**< Incremented whenever bodies are added or removed. */
+} World;
+
+
+/**
+ * @brief Initializes an empty world.
+ * @param world Pointer to the World struct to initialize.
+ * @param initialCapacity Number of bodies to reserve storage for.
+ * @return 1 if the storage was allocated, 0 otherwise.
+ */
+int worldInit(World* world, int initialCapacity);
+
+/**
+ * @brief Releases all storage owned by a world.
+ * @param world Pointer to the World struct to release.
+ */
+void worldFree(World* world);
+
+/**
+ * @brief Adds a circle to the world.
+ * @param world Pointer to the World struct.
+ * @param x The x coordinate of the circle's center.
+ * @param y The y coordinate of the circle's center.
+ * @param velX The initial velocity along the X-axis.
+ * @param velY The initial velocity along the Y-axis.
+ * @param radius The radius of the circle.
+ * @param mass The mass of the circle; 0 makes the circle static.
+ * @return Handle to the new body, with slot WORLD_INVALID_SLOT if the world could not grow.
+ */
+BodyHandle worldAddCircle(World* world, float x, float y, float velX, float velY, float radius, float mass);
+
+/**
+ * @brief Adds a rectangle to the world.
+ * @param world Pointer to the World struct.
+ * @param x The x coordinate of the rectangle's center.
+ * @param y The y coordinate of the rectangle's center.
+ * @param velX The initial velocity along the X-axis.
+ * @param velY The initial velocity along the Y-axis.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param mass The mass of the rectangle; 0 makes the rectangle static.
+ * @return Handle to the new body, with slot WORLD_INVALID_SLOT if the world could not grow.
+ */
+BodyHandle worldAddRectangle(World* world, float x, float y, float velX, float velY, float width, float height, float mass);
+
+/**
+ * @brief Adds a convex polygon to the world.
+ *
+ * The convex hull of the given points is used, so they may come in any order. The body center is
+ * placed at the centroid of the hull, which differs from (x, y) when the points are not centered
+ * on the origin.
+ *
+ * @param world Pointer to the World struct.
+ * @param x The x coordinate the points are relative to.
+ * @param y The y coordinate the points are relative to.
+ * @param velX The initial velocity along the X-axis.
+ * @param velY The initial velocity along the Y-axis.
+ * @param vertexX The x coordinates of the points, relative to (x, y).
+ * @param vertexY The y coordinates of the points, relative to (x, y).
+ * @param vertexCount Number of points, at most WORLD_MAX_POLYGON_VERTICES.
+ * @param mass The mass of the polygon; 0 makes the polygon static.
+ * @return Handle to the new body, with slot WORLD_INVALID_SLOT if the world could not grow or the
+ *         hull is degenerate (fewer than three vertices or no area).
+ */
+BodyHandle worldAddPolygon(World* world, float x, float y, float velX, float velY,
+    const float* vertexX, const float* vertexY, int vertexCount, float mass);
+
+/**
+ * @brief Removes a body from the world.
+ *
+ * The last body is moved into the freed dense index, so dense indices obtained before this call
+ * must be resolved again through their handles. The sleeping island of the body is woken, since
+ * bodies resting on it may have lost their support. Stale handles are ignored.
+ *
+ * @param world Pointer to the World struct.
+ * @param handle Handle of the body to remove.
+ */
+void worldRemoveBody(World* world, BodyHandle handle);
+
+/**
+ * @brief Wakes a sleeping body together with every body of its sleeping island.
+ *
+ * Call it after moving or changing the velocity of a body directly; static bodies are not affected.
+ *
+ * @param world Pointer to the World struct.
+ * @param index Dense index of the body.
+ */
+void worldWakeBody(World* world, int index);
+
+/**
+ * @brief Applies a force to a body for one time step, waking it if it sleeps.
+ * @param world Pointer to the World struct.
+ * @param index Dense index of the body.
+ * @param forceX The force along the X-axis.
+ * @param forceY The force along the Y-axis.
+ * @param deltaTime The time step for the simulation.
+ */
+void worldApplyForce(World* world, int index, float forceX, float forceY, float deltaTime);
+
+/**
+ * @brief Rotates a body to an absolute angle and refits its bounding box.
+ * @param world Pointer to the World struct.
+ * @param index Dense index of the body.
+ * @param angle The new angle, in radians.
+ */
+void worldSetAngle(World* world, int index, float angle);
+
+/**
+ * @brief Marks a body as a bullet, so that continuous collision detection keeps it from tunneling.
+ *
+ * Bullets are swept against the other bodies every step, which costs a pass over the world per
+ * bullet; flag only the few bodies fast enough to cross another body within one step.
+ *
+ * @param world Pointer to the World struct.
+ * @param index Dense index of the body.
+ * @param bullet Non-zero to sweep the body, 0 to go back to discrete collision only.
+ */
+void worldSetBullet(World* world, int index, int bullet);
+
+/**
+ * @brief Resolves a handle to the current dense index of its body.
+ * @param world Pointer to the World struct.
+ * @param handle Handle to resolve.
+ * @return The dense index of the body, or -1 if the handle is stale or invalid.
+ */
+int worldGetIndex(const World* world, BodyHandle handle);
+
+/**
+ * @brief Computes the tight bounding box of a body.
+ * @param world Pointer to the World struct.
+ * @param index Dense index of the body.
+ * @param bounds Receives the bounding box.
+ */
+void worldGetBounds(const World* world, int index, Aabb* bounds);
+
+/**
+ * @brief Applies the world gravity to every awake dynamic body.
+ * @param world Pointer to the World struct.
+ * @param deltaTime The time step for the simulation.
+ */
+void worldApplyGravity(World* world, float deltaTime);
+
+/**
+ * @brief Updates the position and angle of every body based on its velocities.
+ *
+ * Sleeping bodies are skipped; static bodies are integrated too, so kinematic ones keep moving.
+ * @param world Pointer to the World struct.
+ * @param deltaTime The time step for the simulation.
+ */
+void worldIntegrate(World* world, float deltaTime);
+
+/**
+ * @brief Checks every body against the window boundaries and bounces it back inside.
+ * @param world Pointer to the World struct.
+ * @param windowWidth The width of the window.
+ * @param windowHeight The height of the window.
+ */
+void worldCollideWithWindow(World* world, int windowWidth, int windowHeight);
+
+/**
+ * @brief Applies the world gravity to the awake dynamic bodies of an index range.
+ *
+ * Ranges that do not overlap can be processed by different threads.
+ * @param world Pointer to the World struct.
+ * @param begin First dense index of the range.
+ * @param end One past the last dense index of the range.
+ * @param deltaTime The time step for the simulation.
+ */
+void worldApplyGravityRange(World* world, int begin, int end, float deltaTime);
+
+/**
+ * @brief Updates the positions and angles of the bodies of an index range based on their velocities.
+ *
+ * Sleeping bodies are skipped, as in worldIntegrate(). Ranges that do not overlap can be processed by different threads.
+ * @param world Pointer to the World struct.
+ * @param begin First dense index of the range.
+ * @param end One past the last dense index of the range.
+ * @param deltaTime The time step for the simulation.
+ */
+void worldIntegrateRange(World* world, int begin, int end, float deltaTime);
+
+/**
+ * @brief Appends a pair to a pair list, growing it when full.
+ * @param list Pointer to the PairList struct.
+ * @param a Dense index of the first body.
+ * @param b Dense index of the second body.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int pairListPush(PairList* list, int a, int b);
+
+/**
+ * @brief Appends every pair of another list to a pair list.
+ * @param list Pointer to the PairList struct to append to.
+ * @param other Pointer to the PairList struct whose pairs are copied.
+ * @return 1 on success, 0 if memory could not be allocated.
+ */
+int pairListAppend(PairList* list, const PairList* other);
+
+/**
+ * @brief Advances the whole world by one time step (gravity, then integration).
+ * @param world Pointer to the World struct.
+ * @param deltaTime The time step for the simulation.
+ */
+void worldStep(World* world, float deltaTime);
+
+
+#endif /**< __WORLD_INTERFACE_H__ */
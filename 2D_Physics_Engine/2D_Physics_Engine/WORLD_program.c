@@ -0,0 +1,641 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "WORLD_interface.h"
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#define WORLD_RESTRICT __restrict
+#else
+#define WORLD_RESTRICT restrict
+#endif
+
+static void* worldAlignedAlloc(size_t size)
+{
+    // Round up so that the size is a multiple of the alignment, as aligned_alloc requires
+    size = (size + WORLD_ALIGNMENT - 1) & ~(size_t)(WORLD_ALIGNMENT - 1);
+#if defined(_MSC_VER)
+    return _aligned_malloc(size, WORLD_ALIGNMENT);
+#else
+    return aligned_alloc(WORLD_ALIGNMENT, size);
+#endif
+}
+
+static void worldAlignedFree(void* memory)
+{
+#if defined(_MSC_VER)
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+static int worldGrowArray(void** array, size_t elementSize, int count, int newCapacity)
+{
+    void* grown = worldAlignedAlloc(elementSize * (size_t)newCapacity);
+    if (grown == NULL)
+    {
+        return 0;
+    }
+
+    if (*array != NULL)
+    {
+        memcpy(grown, *array, elementSize * (size_t)count);
+        worldAlignedFree(*array);
+    }
+    *array = grown;
+    return 1;
+}
+
+static int worldReserve(World* world, int capacity)
+{
+    if (capacity <= world->capacity)
+    {
+        return 1;
+    }
+
+    // Keep the capacity a multiple of 8 so that batch loops can always run full AVX lanes
+    capacity = (capacity + 7) & ~7;
+
+    int count = world->count;
+    int slotCount = world->slotCount;
+    int success = worldGrowArray((void**)&world->posX, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->posY, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->velX, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->velY, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->radius, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->halfWidth, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->halfHeight, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->invMass, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->angle, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->angularVelocity, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->invInertia, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->extentX, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->extentY, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->vertexStart, sizeof(int), count, capacity)
+        && worldGrowArray((void**)&world->vertexCount, sizeof(unsigned char), count, capacity)
+        && worldGrowArray((void**)&world->type, sizeof(unsigned char), count, capacity)
+        && worldGrowArray((void**)&world->awake, sizeof(unsigned char), count, capacity)
+        && worldGrowArray((void**)&world->sleepTime, sizeof(float), count, capacity)
+        && worldGrowArray((void**)&world->bullet, sizeof(unsigned char), count, capacity)
+        && worldGrowArray((void**)&world->bodySlot, sizeof(unsigned int), count, capacity)
+        && worldGrowArray((void**)&world->slotIndex, sizeof(int), slotCount, capacity)
+        && worldGrowArray((void**)&world->slotGeneration, sizeof(unsigned int), slotCount, capacity)
+        && worldGrowArray((void**)&world->sleepNext, sizeof(int), slotCount, capacity);
+
+    if (success)
+    {
+        world->capacity = capacity;
+    }
+    return success;
+}
+
+static int worldReserveVertices(World* world, int capacity)
+{
+    if (capacity <= world->vertexPoolCapacity)
+    {
+        return 1;
+    }
+
+    capacity = capacity > world->vertexPoolCapacity * 2 ? capacity : world->vertexPoolCapacity * 2;
+    capacity = capacity > 64 ? capacity : 64;
+    int success = worldGrowArray((void**)&world->vertexX, sizeof(float), world->vertexPoolCount, capacity)
+        && worldGrowArray((void**)&world->vertexY, sizeof(float), world->vertexPoolCount, capacity);
+
+    if (success)
+    {
+        world->vertexPoolCapacity = capacity;
+    }
+    return success;
+}
+
+int worldInit(World* world, int initialCapacity)
+{
+    memset(world, 0, sizeof(*world));
+    world->freeSlot = -1;
+    world->gravityX = 0.0f;
+    world->gravityY = 9.81f; // Same downward acceleration as applyGravity
+
+    return worldReserve(world, initialCapacity > 0 ? initialCapacity : 8);
+}
+
+void worldFree(World* world)
+{
+    worldAlignedFree(world->posX);
+    worldAlignedFree(world->posY);
+    worldAlignedFree(world->velX);
+    worldAlignedFree(world->velY);
+    worldAlignedFree(world->radius);
+    worldAlignedFree(world->halfWidth);
+    worldAlignedFree(world->halfHeight);
+    worldAlignedFree(world->invMass);
+    worldAlignedFree(world->angle);
+    worldAlignedFree(world->angularVelocity);
+    worldAlignedFree(world->invInertia);
+    worldAlignedFree(world->extentX);
+    worldAlignedFree(world->extentY);
+    worldAlignedFree(world->vertexStart);
+    worldAlignedFree(world->vertexCount);
+    worldAlignedFree(world->vertexX);
+    worldAlignedFree(world->vertexY);
+    worldAlignedFree(world->type);
+    worldAlignedFree(world->awake);
+    worldAlignedFree(world->sleepTime);
+    worldAlignedFree(world->bullet);
+    worldAlignedFree(world->bodySlot);
+    worldAlignedFree(world->slotIndex);
+    worldAlignedFree(world->slotGeneration);
+    worldAlignedFree(world->sleepNext);
+    memset(world, 0, sizeof(*world));
+    world->freeSlot = -1;
+}
+
+static BodyHandle worldAddBody(World* world, BodyType type, float x, float y, float velX, float velY,
+    float radius, float halfWidth, float halfHeight, float mass)
+{
+    BodyHandle handle = { WORLD_INVALID_SLOT, 0 };
+
+    if (world->count == world->capacity && !worldReserve(world, world->capacity * 2))
+    {
+        return handle;
+    }
+
+    // Reuse a released slot when possible so that the handle table stays compact
+    int slot = world->freeSlot;
+    if (slot >= 0)
+    {
+        world->freeSlot = world->slotIndex[slot];
+    }
+    else
+    {
+        slot = world->slotCount++;
+        world->slotGeneration[slot] = 1;
+    }
+
+    int index = world->count++;
+    world->posX[index] = x;
+    world->posY[index] = y;
+    world->velX[index] = velX;
+    world->velY[index] = velY;
+    world->radius[index] = radius;
+    world->halfWidth[index] = halfWidth;
+    world->halfHeight[index] = halfHeight;
+    world->invMass[index] = mass > 0.0f ? 1.0f / mass : 0.0f;
+    world->angle[index] = 0.0f;
+    world->angularVelocity[index] = 0.0f;
+    world->extentX[index] = halfWidth;
+    world->extentY[index] = halfHeight;
+    world->vertexStart[index] = 0;
+    world->vertexCount[index] = 0;
+    world->type[index] = (unsigned char)type;
+
+    // Rectangles rotate with the inertia of a solid box, m * (w^2 + h^2) / 12; circles do not rotate
+    float inertia = mass * (halfWidth * halfWidth + halfHeight * halfHeight) / 3.0f;
+    world->invInertia[index] = type == BODY_RECTANGLE && inertia > 0.0f ? 1.0f / inertia : 0.0f;
+    world->awake[index] = mass > 0.0f ? 1 : 0;
+    world->sleepTime[index] = 0.0f;
+    world->bullet[index] = 0;
+    world->bodySlot[index] = (unsigned int)slot;
+    world->slotIndex[slot] = index;
+    world->sleepNext[slot] = -1;
+    world->structureVersion++;
+
+    handle.slot = (unsigned int)slot;
+    handle.generation = world->slotGeneration[slot];
+    return handle;
+}
+
+BodyHandle worldAddCircle(World* world, float x, float y, float velX, float velY, float radius, float mass)
+{
+    return worldAddBody(world, BODY_CIRCLE, x, y, velX, velY, radius, radius, radius, mass);
+}
+
+BodyHandle worldAddRectangle(World* world, float x, float y, float velX, float velY, float width, float height, float mass)
+{
+    return worldAddBody(world, BODY_RECTANGLE, x, y, velX, velY, 0.0f, width / 2, height / 2, mass);
+}
+
+// Sorts the points and keeps their convex hull, counter-clockwise in a Y-up frame (monotone chain)
+static int worldConvexHull(const float* pointX, const float* pointY, int pointCount, float* hullX, float* hullY)
+{
+    float sortedX[WORLD_MAX_POLYGON_VERTICES], sortedY[WORLD_MAX_POLYGON_VERTICES];
+    for (int i = 0; i < pointCount; i++)
+    {
+        int j = i;
+        while (j > 0 && (sortedX[j - 1] > pointX[i] || (sortedX[j - 1] == pointX[i] && sortedY[j - 1] > pointY[i])))
+        {
+            sortedX[j] = sortedX[j - 1];
+            sortedY[j] = sortedY[j - 1];
+            j--;
+        }
+        sortedX[j] = pointX[i];
+        sortedY[j] = pointY[i];
+    }
+
+    // Lower chain left to right, then upper chain right to left; collinear points are dropped
+    float chainX[2 * WORLD_MAX_POLYGON_VERTICES], chainY[2 * WORLD_MAX_POLYGON_VERTICES];
+    int count = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int lowerCount = count;
+        for (int k = 0; k < pointCount; k++)
+        {
+            int i = pass == 0 ? k : pointCount - 1 - k;
+            while (count >= lowerCount + 2)
+            {
+                float cross = (chainX[count - 1] - chainX[count - 2]) * (sortedY[i] - chainY[count - 2])
+                    - (chainY[count - 1] - chainY[count - 2]) * (sortedX[i] - chainX[count - 2]);
+                if (cross > 0.0f)
+                {
+                    break;
+                }
+                count--;
+            }
+            chainX[count] = sortedX[i];
+            chainY[count] = sortedY[i];
+            count++;
+        }
+        count--; // The last point of each chain starts the other one
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        hullX[i] = chainX[i];
+        hullY[i] = chainY[i];
+    }
+    return count;
+}
+
+BodyHandle worldAddPolygon(World* world, float x, float y, float velX, float velY,
+    const float* vertexX, const float* vertexY, int vertexCount, float mass)
+{
+    BodyHandle handle = { WORLD_INVALID_SLOT, 0 };
+    if (vertexCount < 3 || vertexCount > WORLD_MAX_POLYGON_VERTICES)
+    {
+        return handle;
+    }
+
+    float hullX[WORLD_MAX_POLYGON_VERTICES], hullY[WORLD_MAX_POLYGON_VERTICES];
+    int hullCount = worldConvexHull(vertexX, vertexY, vertexCount, hullX, hullY);
+    if (hullCount < 3)
+    {
+        return handle;
+    }
+
+    // Area and centroid from the triangle fan around the origin
+    float area = 0.0f, centroidX = 0.0f, centroidY = 0.0f;
+    for (int i = 0; i < hullCount; i++)
+    {
+        int j = (i + 1) % hullCount;
+        float cross = hullX[i] * hullY[j] - hullX[j] * hullY[i];
+        area += cross;
+        centroidX += (hullX[i] + hullX[j]) * cross;
+        centroidY += (hullY[i] + hullY[j]) * cross;
+    }
+    if (area <= 0.0f)
+    {
+        return handle;
+    }
+    centroidX /= 3.0f * area;
+    centroidY /= 3.0f * area;
+
+    // Move the outline to the centroid; the inertia of a solid polygon follows from the same fan
+    float extentX = 0.0f, extentY = 0.0f, crossSum = 0.0f, inertiaSum = 0.0f;
+    for (int i = 0; i < hullCount; i++)
+    {
+        hullX[i] -= centroidX;
+        hullY[i] -= centroidY;
+        extentX = fmaxf(extentX, fabsf(hullX[i]));
+        extentY = fmaxf(extentY, fabsf(hullY[i]));
+    }
+    for (int i = 0; i < hullCount; i++)
+    {
+        int j = (i + 1) % hullCount;
+        float cross = hullX[i] * hullY[j] - hullX[j] * hullY[i];
+        crossSum += cross;
+        inertiaSum += cross * (hullX[i] * hullX[i] + hullX[i] * hullX[j] + hullX[j] * hullX[j]
+            + hullY[i] * hullY[i] + hullY[i] * hullY[j] + hullY[j] * hullY[j]);
+    }
+    float inertia = mass * inertiaSum / (6.0f * crossSum);
+
+    if (!worldReserveVertices(world, world->vertexPoolCount + hullCount))
+    {
+        return handle;
+    }
+    handle = worldAddBody(world, BODY_POLYGON, x + centroidX, y + centroidY, velX, velY, 0.0f, extentX, extentY, mass);
+    if (handle.slot == WORLD_INVALID_SLOT)
+    {
+        return handle;
+    }
+
+    int index = world->count - 1;
+    int start = world->vertexPoolCount;
+    for (int i = 0; i < hullCount; i++)
+    {
+        world->vertexX[start + i] = hullX[i];
+        world->vertexY[start + i] = hullY[i];
+    }
+    world->vertexPoolCount += hullCount;
+    world->vertexStart[index] = start;
+    world->vertexCount[index] = (unsigned char)hullCount;
+    world->invInertia[index] = inertia > 0.0f ? 1.0f / inertia : 0.0f;
+    return handle;
+}
+
+// Closes the gap left in the vertex pool by a removed polygon
+static void worldReleaseVertices(World* world, int index)
+{
+    int start = world->vertexStart[index];
+    int count = world->vertexCount[index];
+    int tail = world->vertexPoolCount - start - count;
+
+    memmove(&world->vertexX[start], &world->vertexX[start + count], sizeof(float) * (size_t)tail);
+    memmove(&world->vertexY[start], &world->vertexY[start + count], sizeof(float) * (size_t)tail);
+    world->vertexPoolCount -= count;
+    for (int i = 0; i < world->count; i++)
+    {
+        if (world->vertexStart[i] > start)
+        {
+            world->vertexStart[i] -= count;
+        }
+    }
+}
+
+void worldRemoveBody(World* world, BodyHandle handle)
+{
+    int index = worldGetIndex(world, handle);
+    if (index < 0)
+    {
+        return;
+    }
+    worldWakeBody(world, index);
+    if (world->type[index] == BODY_POLYGON)
+    {
+        worldReleaseVertices(world, index);
+    }
+
+    // Move the last body into the freed index to keep the arrays dense
+    int last = world->count - 1;
+    if (index != last)
+    {
+        world->posX[index] = world->posX[last];
+        world->posY[index] = world->posY[last];
+        world->velX[index] = world->velX[last];
+        world->velY[index] = world->velY[last];
+        world->radius[index] = world->radius[last];
+        world->halfWidth[index] = world->halfWidth[last];
+        world->halfHeight[index] = world->halfHeight[last];
+        world->invMass[index] = world->invMass[last];
+        world->angle[index] = world->angle[last];
+        world->angularVelocity[index] = world->angularVelocity[last];
+        world->invInertia[index] = world->invInertia[last];
+        world->extentX[index] = world->extentX[last];
+        world->extentY[index] = world->extentY[last];
+        world->vertexStart[index] = world->vertexStart[last];
+        world->vertexCount[index] = world->vertexCount[last];
+        world->type[index] = world->type[last];
+        world->awake[index] = world->awake[last];
+        world->sleepTime[index] = world->sleepTime[last];
+        world->bullet[index] = world->bullet[last];
+        world->bodySlot[index] = world->bodySlot[last];
+        world->slotIndex[world->bodySlot[index]] = index;
+    }
+    world->count--;
+
+    // Invalidate outstanding handles and push the slot on the free list
+    world->slotGeneration[handle.slot]++;
+    world->slotIndex[handle.slot] = world->freeSlot;
+    world->freeSlot = (int)handle.slot;
+    world->structureVersion++;
+}
+
+void worldWakeBody(World* world, int index)
+{
+    world->sleepTime[index] = 0.0f;
+    if (world->invMass[index] == 0.0f || world->awake[index])
+    {
+        return;
+    }
+
+    // Walk the ring of the sleeping island and wake every body on it
+    int slot = (int)world->bodySlot[index];
+    while (slot >= 0)
+    {
+        int body = world->slotIndex[slot];
+        int next = world->sleepNext[slot];
+        world->awake[body] = 1;
+        world->sleepTime[body] = 0.0f;
+        world->sleepNext[slot] = -1;
+        slot = next;
+    }
+}
+
+void worldApplyForce(World* world, int index, float forceX, float forceY, float deltaTime)
+{
+    // Same rule as applyForce: a = F / m, with the inverse mass stored by the world
+    worldWakeBody(world, index);
+    world->velX[index] += forceX * world->invMass[index] * deltaTime;
+    world->velY[index] += forceY * world->invMass[index] * deltaTime;
+}
+
+// Refits the bounding half extents of a rectangle or polygon to its current angle
+static void worldRotateBounds(World* world, int index)
+{
+    if (world->type[index] == BODY_POLYGON)
+    {
+        float cosine = cosf(world->angle[index]);
+        float sine = sinf(world->angle[index]);
+        float halfWidth = 0.0f, halfHeight = 0.0f;
+        int end = world->vertexStart[index] + world->vertexCount[index];
+        for (int i = world->vertexStart[index]; i < end; i++)
+        {
+            halfWidth = fmaxf(halfWidth, fabsf(cosine * world->vertexX[i] - sine * world->vertexY[i]));
+            halfHeight = fmaxf(halfHeight, fabsf(sine * world->vertexX[i] + cosine * world->vertexY[i]));
+        }
+        world->halfWidth[index] = halfWidth;
+        world->halfHeight[index] = halfHeight;
+        return;
+    }
+
+    float cosine = fabsf(cosf(world->angle[index]));
+    float sine = fabsf(sinf(world->angle[index]));
+    world->halfWidth[index] = cosine * world->extentX[index] + sine * world->extentY[index];
+    world->halfHeight[index] = sine * world->extentX[index] + cosine * world->extentY[index];
+}
+
+void worldSetAngle(World* world, int index, float angle)
+{
+    world->angle[index] = angle;
+    if (world->type[index] != BODY_CIRCLE)
+    {
+        worldRotateBounds(world, index);
+    }
+    worldWakeBody(world, index);
+}
+
+void worldSetBullet(World* world, int index, int bullet)
+{
+    world->bullet[index] = bullet ? 1 : 0;
+}
+
+int worldGetIndex(const World* world, BodyHandle handle)
+{
+    if (handle.slot >= (unsigned int)world->slotCount || world->slotGeneration[handle.slot] != handle.generation)
+    {
+        return -1;
+    }
+    return world->slotIndex[handle.slot];
+}
+
+void worldGetBounds(const World* world, int index, Aabb* bounds)
+{
+    bounds->minX = world->posX[index] - world->halfWidth[index];
+    bounds->minY = world->posY[index] - world->halfHeight[index];
+    bounds->maxX = world->posX[index] + world->halfWidth[index];
+    bounds->maxY = world->posY[index] + world->halfHeight[index];
+}
+
+void worldApplyGravity(World* world, float deltaTime)
+{
+    worldApplyGravityRange(world, 0, world->count, deltaTime);
+}
+
+void worldApplyGravityRange(World* world, int begin, int end, float deltaTime)
+{
+    const unsigned char* WORLD_RESTRICT awake = world->awake;
+    float* WORLD_RESTRICT velX = world->velX;
+    float* WORLD_RESTRICT velY = world->velY;
+    float gravityX = world->gravityX * deltaTime;
+    float gravityY = world->gravityY * deltaTime;
+
+    // Vf = Vi + a * dt for every awake body; static and sleeping bodies (awake == 0) are left untouched
+    for (int i = begin; i < end; i++)
+    {
+        float active = (float)awake[i];
+        velX[i] += gravityX * active;
+        velY[i] += gravityY * active;
+    }
+}
+
+void worldIntegrate(World* world, float deltaTime)
+{
+    worldIntegrateRange(world, 0, world->count, deltaTime);
+}
+
+void worldIntegrateRange(World* world, int begin, int end, float deltaTime)
+{
+    const unsigned char* WORLD_RESTRICT awake = world->awake;
+    const float* WORLD_RESTRICT invMass = world->invMass;
+    float* WORLD_RESTRICT posX = world->posX;
+    float* WORLD_RESTRICT posY = world->posY;
+    const float* WORLD_RESTRICT velX = world->velX;
+    const float* WORLD_RESTRICT velY = world->velY;
+    const float* WORLD_RESTRICT angularVelocity = world->angularVelocity;
+
+    // Sleeping bodies are skipped; static bodies are not, since they may be kinematic and carry a velocity
+    for (int i = begin; i < end; i++)
+    {
+        if (!awake[i] && invMass[i] > 0.0f)
+        {
+            continue;
+        }
+        posX[i] += velX[i] * deltaTime;
+        posY[i] += velY[i] * deltaTime;
+        if (angularVelocity[i] != 0.0f)
+        {
+            world->angle[i] += angularVelocity[i] * deltaTime;
+            worldRotateBounds(world, i);
+        }
+    }
+}
+
+void worldCollideWithWindow(World* world, int windowWidth, int windowHeight)
+{
+    float* WORLD_RESTRICT posX = world->posX;
+    float* WORLD_RESTRICT posY = world->posY;
+    float* WORLD_RESTRICT velX = world->velX;
+    float* WORLD_RESTRICT velY = world->velY;
+    const float* WORLD_RESTRICT halfWidth = world->halfWidth;
+    const float* WORLD_RESTRICT halfHeight = world->halfHeight;
+    float width = (float)windowWidth;
+    float height = (float)windowHeight;
+    int count = world->count;
+
+    // Same bounce rules as checkCollisionWithWindow, applied to the whole world
+    for (int i = 0; i < count; i++)
+    {
+        if (posX[i] - halfWidth[i] < 0)
+        {
+            posX[i] = halfWidth[i];
+            velX[i] = -velX[i];
+        }
+        else if (posX[i] + halfWidth[i] > width)
+        {
+            posX[i] = width - halfWidth[i];
+            velX[i] = -velX[i];
+        }
+
+        if (posY[i] - halfHeight[i] < 0)
+        {
+            posY[i] = halfHeight[i];
+            velY[i] = -velY[i];
+        }
+        else if (posY[i] + halfHeight[i] > height)
+        {
+            posY[i] = height - halfHeight[i];
+            velY[i] = -velY[i];
+        }
+    }
+}
+
+void worldStep(World* world, float deltaTime)
+{
+    worldApplyGravity(world, deltaTime);
+    worldIntegrate(world, deltaTime);
+}
+
+int pairListPush(PairList* list, int a, int b)
+{
+    if (list->count == list->capacity)
+    {
+        int capacity = list->capacity > 0 ? list->capacity * 2 : 256;
+        BodyPair* pairs = realloc(list->pairs, sizeof(BodyPair) * (size_t)capacity);
+        if (pairs == NULL)
+        {
+            return 0;
+        }
+        list->pairs = pairs;
+        list->capacity = capacity;
+    }
+
+    list->pairs[list->count].a = a < b ? a : b;
+    list->pairs[list->count].b = a < b ? b : a;
+    list->count++;
+    return 1;
+}
+
+int pairListAppend(PairList* list, const PairList* other)
+{
+    if (list->count + other->count > list->capacity)
+    {
+        int capacity = list->capacity > 0 ? list->capacity : 256;
+        while (capacity < list->count + other->count)
+        {
+            capacity *= 2;
+        }
+        BodyPair* pairs = realloc(list->pairs, sizeof(BodyPair) * (size_t)capacity);
+        if (pairs == NULL)
+        {
+            return 0;
+        }
+        list->pairs = pairs;
+        list->capacity = capacity;
+    }
+
+    if (other->count > 0)
+    {
+        memcpy(&list->pairs[list->count], other->pairs, sizeof(BodyPair) * (size_t)other->count);
+    }
+    list->count += other->count;
+    return 1;
+}
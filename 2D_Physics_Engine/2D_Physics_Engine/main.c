@@ -3,17 +3,39 @@
 #include <math.h>
 #include <SDL.h>
 
+#include "SCALAR_interface.h"
 #include "SOLID2DRectangle_interface.h"
+#include "WORLD_interface.h"
+#include "SPRITE_interface.h"
+#include "RENDER_interface.h"
+#include "TIMESTEP_interface.h"
+#include "TRACE_interface.h"
+#include "STD_TYPES.h"
+#include "FB_config.h"
+#include "FB_interface.h"
+#include "PREVIEW_interface.h"
 
+// 1 draws the frames with the RGB565 rasterizer of the TFT target instead of the SDL primitives
+#ifndef RGB565_PREVIEW
+#define RGB565_PREVIEW 0
+#endif
+
+// Rows the RGB565 preview draws per pass; 600 draws the whole window at once, 16 mimics the target's band
+#define PREVIEW_BAND_HEIGHT 600
 
 
 /**
  * @brief The main function to run the 2D physics engine.
  *
- * This function initializes SDL, creates a window and a renderer, and sets up two circles for simulation.
- * It runs the game loop, where gravity is applied to the circles, their positions are updated based on velocity,
- * and collisions between the circles are checked and resolved. The circles are drawn on the window using SDL_RenderDrawPoint
- * and SDL_RenderDrawLine to visualize their movement and collision.
+ * This function initializes SDL, creates a window and a renderer, and sets up a rectangle for simulation.
+ * It runs the game loop, where gravity, a lifting force and friction are applied to the rectangle, its position is
+ * updated based on velocity, and it bounces off the window edges. The rectangle can be dragged with the mouse, and
+ * pressing space throws it from its start position. The physics runs in fixed steps of TIMESTEP_DEFAULT_RATE per
+ * second whatever the frame rate, and the rectangle is drawn between its last two positions. The shapes are collected
+ * in a RenderBatch and submitted to the renderer in a few calls per frame.
+ * In builds with TRACE_ENABLED, pressing T writes the recent frames to trace.json for chrome://tracing.
+ * In builds with RGB565_PREVIEW, the frames are drawn by the software rasterizer shared with the TFT target,
+ * and only the areas the rectangle left and entered are redrawn and uploaded.
  *
  * @param argc Number of command-line arguments (not used in this program).
  * @param args Array of command-line argument strings (not used in this program).
@@ -27,27 +49,57 @@ int main(int argc, char* args[])
     SDL_Window* window = SDL_CreateWindow("2D Physics Engine", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
         800, 600, 0);
 
-    // Create a renderer to draw graphics on the window
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    // Create a renderer to draw graphics on the window, presenting in sync with the display
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+
+    // Shapes are collected over the frame and submitted in a few calls
+    RenderBatch batch;
+    renderBatchInit(&batch, renderer);
+
+#if RGB565_PREVIEW
+    Preview preview;
+    previewInit(&preview, renderer, 800, 600, PREVIEW_BAND_HEIGHT);
+
+    // The whole screen is drawn once, then only what changed
+    SFB_DirtyRegion_t dirty;
+    SFB_voidDirtyInit(&dirty, 800, 600);
+    SFB_voidDirtyAdd(&dirty, 0, 0, 800, 600);
+    s16 drawnX = 0, drawnY = 0, drawnWidth = 0, drawnHeight = 0; // Where the rectangle is on the texture
+#endif
 
     // Set up a rectangle with initial position, velocities, width, height, and mass
-    Rectangle rectangle = { .x = 400.0f, .y = 300.0f, .velX = 0.0f, .velY = 0.0f, .width = 40.0f, .height = 30.0f, .mass = 2.0f };
+    Rectangle rectangle = { .x = SCALAR_FROM_FLOAT(400.0f), .y = SCALAR_FROM_FLOAT(300.0f), .velX = 0, .velY = 0,
+        .width = SCALAR_FROM_FLOAT(40.0f), .height = SCALAR_FROM_FLOAT(30.0f), .mass = SCALAR_FROM_FLOAT(2.0f) };
 
     // Seed the random number generator
     srand(SDL_GetTicks());
 
     // Generate random initial velocities for the rectangle
-    rectangle.velX = 0.0f;
-    rectangle.velY = 0.0f;
+    rectangle.velX = 0;
+    rectangle.velY = 0;
 
-    float deltaTime = 0.016f; // Time step for simulation (adjust as needed)
+    // Run the physics at a fixed rate, and never more than a few steps per frame
+    Timestep timestep;
+    timestepInit(&timestep, TIMESTEP_DEFAULT_RATE, TIMESTEP_DEFAULT_MAX_SUBSTEPS);
+    Scalar deltaTime = SCALAR_FROM_FLOAT((float)timestep.stepSeconds);
+
+    // Position before the last physics step, used to interpolate the drawing
+    Scalar previousX = rectangle.x;
+    Scalar previousY = rectangle.y;
+
+    Uint64 counterFrequency = SDL_GetPerformanceFrequency();
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
 
     int quit = 0;
     int isDragging = 0; // Set to 0 initially to indicate the rectangle is not moving
 
+    TRACE_THREAD_NAME("main");
     while (!quit)
     {
+        TraceZone frameZone = TRACE_BEGIN("frame");
+
         // Handle SDL events, such as window close and mouse events
+        TraceZone zone = TRACE_BEGIN("events");
         SDL_Event event;
         while (SDL_PollEvent(&event))
         {
@@ -59,10 +111,10 @@ int main(int argc, char* args[])
             case SDL_MOUSEBUTTONDOWN:
                 // Check if the mouse is clicked within the rectangle
                 if (event.button.button == SDL_BUTTON_LEFT &&
-                    event.button.x >= (int)(rectangle.x - rectangle.width / 2) &&
-                    event.button.x <= (int)(rectangle.x + rectangle.width / 2) &&
-                    event.button.y >= (int)(rectangle.y - rectangle.height / 2) &&
-                    event.button.y <= (int)(rectangle.y + rectangle.height / 2))
+                    event.button.x >= SCALAR_TO_INT(rectangle.x - rectangle.width / 2) &&
+                    event.button.x <= SCALAR_TO_INT(rectangle.x + rectangle.width / 2) &&
+                    event.button.y >= SCALAR_TO_INT(rectangle.y - rectangle.height / 2) &&
+                    event.button.y <= SCALAR_TO_INT(rectangle.y + rectangle.height / 2))
                 {
                     isDragging = 1; // Start moving the rectangle when the mouse button is clicked
                 }
@@ -78,8 +130,10 @@ int main(int argc, char* args[])
                 // If dragging the rectangle, update its position to the mouse position
                 if (isDragging)
                 {
-                    rectangle.x = (float)event.motion.x;
-                    rectangle.y = (float)event.motion.y;
+                    rectangle.x = SCALAR_FROM_INT(event.motion.x);
+                    rectangle.y = SCALAR_FROM_INT(event.motion.y);
+                    previousX = rectangle.x; // Jump there instead of interpolating from the old position
+                    previousY = rectangle.y;
                 }
                 break;
             case SDL_KEYDOWN:
@@ -88,74 +142,138 @@ int main(int argc, char* args[])
                 {
                     isDragging = 0; // Stop dragging the rectangle when the button is pressed
                     resetRectangle(&rectangle); // Reset the rectangle's position and velocity
-                    rectangle.velX = 500.0f; // Set initial X velocity
-                    rectangle.velY = -800.0f; // Set initial Y velocity (negative for upward force)
+                    rectangle.velX = SCALAR_FROM_FLOAT(500.0f); // Set initial X velocity
+                    rectangle.velY = SCALAR_FROM_FLOAT(-800.0f); // Set initial Y velocity (negative for upward force)
+                    previousX = rectangle.x;
+                    previousY = rectangle.y;
+                }
+                else if (event.key.keysym.sym == SDLK_t)
+                {
+                    traceDump("trace.json"); // Save the recent frames for chrome://tracing
                 }
                 break;
             }
         }
+        TRACE_END(zone);
 
-        // Calculate the force applied to the rectangle based on Newton's second law (F = m * a)
-
-        // Gravity force (pointing downwards)
-        float gravityX = 0.0f;
-        float gravityY = -9.8f * rectangle.mass; // Adjust gravity strength as needed (negative for downward force)
+        // Add the real time of this frame and run the physics steps it covers
+        Uint64 counter = SDL_GetPerformanceCounter();
+        int steps = timestepAdvance(&timestep, (double)(counter - lastCounter) / (double)counterFrequency);
+        lastCounter = counter;
 
-        // Dragging force (if not dragging, these forces will be zero)
-        float forceX = 0.0f;
-        float forceY = 0.0f;
-        if (!isDragging)
+        for (int step = 0; step < steps; step++)
         {
-            // Adjust the force values as needed
-            forceX = 0.0f;
-            forceY = 800.0f; // Negative value for upward force
-        }
+            TraceZone stepZone = TRACE_BEGIN("step");
+            previousX = rectangle.x;
+            previousY = rectangle.y;
+
+            // Calculate the force applied to the rectangle based on Newton's second law (F = m * a)
 
-        // Frictional force (opposite to the direction of motion)
-        float frictionForceX = -rectangle.velX * 5.0f; // Adjust the friction coefficient (5.0f in this case)
-        float frictionForceY = -rectangle.velY * 5.0f; // Adjust the friction coefficient (5.0f in this case)
+            zone = TRACE_BEGIN("forces");
 
-        // Calculate the total force components
-        float totalForceX = forceX + gravityX + frictionForceX;
-        float totalForceY = forceY + gravityY + frictionForceY;
+            // Gravity force (pointing downwards)
+            Scalar gravityX = 0;
+            Scalar gravityY = scalarMul(SCALAR_FROM_FLOAT(-9.8f), rectangle.mass); // Adjust gravity strength as needed (negative for downward force)
 
-        // Calculate the acceleration based on the total force and mass
-        float accelerationX = totalForceX / rectangle.mass;
-        float accelerationY = totalForceY / rectangle.mass;
+            // Dragging force (if not dragging, these forces will be zero)
+            Scalar forceX = 0;
+            Scalar forceY = 0;
+            if (!isDragging)
+            {
+                // Adjust the force values as needed
+                forceX = 0;
+                forceY = SCALAR_FROM_FLOAT(800.0f); // Negative value for upward force
+            }
 
-        // Update the velocity of the rectangle based on the acceleration
-        rectangle.velX += accelerationX * deltaTime;
-        rectangle.velY += accelerationY * deltaTime;
+            // Frictional force (opposite to the direction of motion)
+            Scalar frictionForceX = -rectangle.velX * 5; // Adjust the friction coefficient (5 in this case)
+            Scalar frictionForceY = -rectangle.velY * 5; // Adjust the friction coefficient (5.0f in this case)
 
-        // If the rectangle's velocity becomes very small, stop its movement
-        if (fabs(rectangle.velX) < 0.1f && fabs(rectangle.velY) < 0.1f)
-        {
-            rectangle.velX = 0.0f;
-            rectangle.velY = 0.0f;
-        }
+            // Calculate the total force components
+            Scalar totalForceX = forceX + gravityX + frictionForceX;
+            Scalar totalForceY = forceY + gravityY + frictionForceY;
 
-        // Update the position of the rectangle based on its velocity
-        updateRectanglePosition(&rectangle, deltaTime);
+            // Update the velocity of the rectangle based on the total force and mass
+            applyForce(&rectangle, totalForceX, totalForceY, deltaTime);
+            TRACE_END(zone);
 
-        // Check for collision with window boundaries and simulate reality
-        checkCollisionWithWindow(&rectangle, 800, 600);
+            zone = TRACE_BEGIN("integrate");
+
+            // If the rectangle's velocity becomes very small, stop its movement
+            Scalar restSpeed = SCALAR_FROM_FLOAT(0.1f);
+            if (rectangle.velX < restSpeed && rectangle.velX > -restSpeed &&
+                rectangle.velY < restSpeed && rectangle.velY > -restSpeed)
+            {
+                rectangle.velX = 0;
+                rectangle.velY = 0;
+            }
+
+            // Update the position of the rectangle based on its velocity
+            updateRectanglePosition(&rectangle, deltaTime);
+            TRACE_END(zone);
+
+            // Check for collision with window boundaries and simulate reality
+            TRACE_SCOPE("collision")
+            {
+                checkCollisionWithWindow(&rectangle, 800, 600);
+            }
+            TRACE_END(stepZone);
+        }
 
         // Clear the renderer with a black color
+        zone = TRACE_BEGIN("draw");
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
 
-        // Draw the rectangle with a green color
+        // Draw the rectangle with a green color, between its last two physics positions
+        Scalar alpha = SCALAR_FROM_FLOAT(timestepGetAlpha(&timestep));
+        Scalar drawX = previousX + scalarMul(rectangle.x - previousX, alpha);
+        Scalar drawY = previousY + scalarMul(rectangle.y - previousY, alpha);
+#if RGB565_PREVIEW
+        // Redraw where the rectangle was and where it is now, one pass per band as the target draws
+        s16 rectX = (s16)SCALAR_TO_INT(drawX - rectangle.width / 2);
+        s16 rectY = (s16)SCALAR_TO_INT(drawY - rectangle.height / 2);
+        s16 rectWidth = (s16)SCALAR_TO_INT(rectangle.width);
+        s16 rectHeight = (s16)SCALAR_TO_INT(rectangle.height);
+        if (rectX != drawnX || rectY != drawnY)
+        {
+            SFB_voidDirtyAdd(&dirty, drawnX, drawnY, drawnWidth, drawnHeight);
+            SFB_voidDirtyAdd(&dirty, rectX, rectY, rectWidth, rectHeight);
+        }
+        for (int i = 0; i < dirty.Count; i++)
+        {
+            SFB_FrameBuffer_t* frameBuffer = previewBeginRegion(&preview, &dirty.Rects[i], 0x0000);
+            do
+            {
+                SFB_voidFillRect(frameBuffer, rectX, rectY, rectWidth, rectHeight, 0x07E0);
+            } while (previewEndBand(&preview));
+        }
+        SFB_voidDirtyClear(&dirty);
+        drawnX = rectX;
+        drawnY = rectY;
+        drawnWidth = rectWidth;
+        drawnHeight = rectHeight;
+        previewPresent(&preview);
+#else
         SDL_Color greenColor = { 0, 255, 0, 255 };
-        drawSolidRectangle(renderer, (int)(rectangle.x - rectangle.width / 2), (int)(rectangle.y - rectangle.height / 2), (int)rectangle.width, (int)rectangle.height, greenColor);
-
-        // Render the graphics on the window
-        SDL_RenderPresent(renderer);
+        renderBatchRectangle(&batch, SCALAR_TO_INT(drawX - rectangle.width / 2), SCALAR_TO_INT(drawY - rectangle.height / 2), SCALAR_TO_INT(rectangle.width), SCALAR_TO_INT(rectangle.height), greenColor);
+        renderBatchFlush(&batch);
+#endif
+        TRACE_END(zone);
 
-        // Add a delay to control the frame rate (approximately 60 fps in this case)
-        SDL_Delay(16);
+        // Render the graphics on the window; with vsync this waits for the display
+        TRACE_SCOPE("present")
+        {
+            SDL_RenderPresent(renderer);
+        }
+        TRACE_END(frameZone);
     }
 
     // Clean up resources and quit SDL
+    renderBatchFree(&batch);
+#if RGB565_PREVIEW
+    previewFree(&preview);
+#endif
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
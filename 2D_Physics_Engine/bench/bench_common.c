@@ -0,0 +1,12 @@
+#include "STD_TYPES.h"
+#include "bench_common.h"
+
+long benchFlushedPixels = 0;
+
+void benchCountBand(u16 x, u16 y, const u16* pixels, u16 width, u16 height)
+{
+    (void)x;
+    (void)y;
+    (void)pixels;
+    benchFlushedPixels += (long)width * height;
+}
@@ -0,0 +1,26 @@
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+/**
+ * @brief Pixels the bands passed to benchCountBand() would have sent to the display.
+ *
+ * The benchmarks reset it before the frames they measure and read it afterwards.
+ */
+extern long benchFlushedPixels;
+
+/**
+ * @brief Band flush callback for SFB_u8EndBand() that only counts the pixels of the band.
+ *
+ * It stands in for the TFT driver, so the benchmarks time the drawing without a display.
+ * The STD_TYPES header must be included before this header.
+ *
+ * @param x The x coordinate of the band on the screen (not used).
+ * @param y The y coordinate of the band on the screen (not used).
+ * @param pixels The RGB565 pixels of the band (not used).
+ * @param width The width of the band in pixels.
+ * @param height The height of the band in pixels.
+ */
+void benchCountBand(u16 x, u16 y, const u16* pixels, u16 width, u16 height);
+
+
+#endif /**< __BENCH_COMMON_H__ */
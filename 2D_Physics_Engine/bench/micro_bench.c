@@ -0,0 +1,386 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOGDI   // wingdi.h declares a Rectangle function
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "SCALAR_interface.h"
+#include "WORLD_interface.h"
+#include "CIRCLE_interface.h"
+#include "SOLID2DRectangle_interface.h"
+#include "TIMER_interface.h"
+
+#define MICRO_SEED              12345u              /**< Default seed of the data generator. */
+#define MICRO_MAX_COUNT         (1 << 20)           /**< Largest data set, in items. */
+#define MICRO_TARGET_OPS        (1 << 22)           /**< Operations timed per hot measurement. */
+#define MICRO_MAX_PASSES        4096                /**< Upper bound on the passes of one measurement. */
+#define MICRO_COLD_PASSES       16                  /**< Passes of one cold measurement (each one flushes the caches). */
+#define MICRO_FLUSH_BYTES       (64 << 20)          /**< Bytes streamed to evict the data set before a cold pass. */
+#define MICRO_WINDOW_WIDTH      800                 /**< Window of the demo, used by checkCollisionWithWindow. */
+#define MICRO_WINDOW_HEIGHT     600
+
+/**
+ * @struct MicroData
+ * @brief Inputs of the benchmarks, plus pristine copies used to reset them before every pass.
+ *
+ * Every pass starts from the same state, so functions that change their inputs (bounces, separation,
+ * integration) take the same branches on every pass and the fixed-point values never drift out of range.
+ */
+typedef struct
+{
+    Circle* circles;
+    Circle* pristineCircles;
+    Rectangle* rectangles;
+    Rectangle* pristineRectangles;
+    int* pairA;                 /**< First circle of each candidate pair. */
+    int* pairB;                 /**< Second circle of each candidate pair. */
+    unsigned char* flush;       /**< Buffer streamed through to evict the caches. */
+} MicroData;
+
+/**
+ * @struct MicroKernel
+ * @brief One primitive under test: a pass calls it once per item of the data set.
+ */
+typedef struct
+{
+    const char* name;
+    int rectangles;             /**< 1 if the kernel works on rectangles, 0 for circles. */
+    int (*pass)(MicroData* data, int count);
+} MicroKernel;
+
+static volatile unsigned int microSink;    // Keeps the results of pure kernels observable (unsigned, so it wraps)
+
+// Small linear congruential generator: rand() differs between C libraries, and the data sets must not
+static float microRandom(unsigned int* seed, float low, float high)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return low + (high - low) * (float)(*seed >> 8) / 16777216.0f;
+}
+
+static int microApplyGravity(MicroData* data, int count)
+{
+    Scalar deltaTime = SCALAR_FROM_FLOAT(1.0f / 120.0f);
+    for (int i = 0; i < count; i++)
+    {
+        applyGravity(&data->circles[i], deltaTime);
+    }
+    return 0;
+}
+
+static int microUpdateCirclePosition(MicroData* data, int count)
+{
+    Scalar deltaTime = SCALAR_FROM_FLOAT(1.0f / 120.0f);
+    for (int i = 0; i < count; i++)
+    {
+        updateCirclePosition(&data->circles[i], deltaTime);
+    }
+    return 0;
+}
+
+static int microCheckCollision(MicroData* data, int count)
+{
+    int hits = 0;
+    for (int i = 0; i < count; i++)
+    {
+        hits += checkCollision(&data->circles[data->pairA[i]], &data->circles[data->pairB[i]]);
+    }
+    return hits;
+}
+
+static int microResolveCollision(MicroData* data, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        resolveCollision(&data->circles[data->pairA[i]], &data->circles[data->pairB[i]]);
+    }
+    return 0;
+}
+
+static int microApplyForce(MicroData* data, int count)
+{
+    Scalar forceX = SCALAR_FROM_FLOAT(3.0f);
+    Scalar forceY = SCALAR_FROM_FLOAT(-20.0f);
+    Scalar deltaTime = SCALAR_FROM_FLOAT(1.0f / 120.0f);
+    for (int i = 0; i < count; i++)
+    {
+        applyForce(&data->rectangles[i], forceX, forceY, deltaTime);
+    }
+    return 0;
+}
+
+static int microCheckCollisionWithWindow(MicroData* data, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        checkCollisionWithWindow(&data->rectangles[i], MICRO_WINDOW_WIDTH, MICRO_WINDOW_HEIGHT);
+    }
+    return 0;
+}
+
+static const MicroKernel microKernels[] =
+{
+    { "applyGravity", 0, microApplyGravity },
+    { "updateCirclePosition", 0, microUpdateCirclePosition },
+    { "checkCollision", 0, microCheckCollision },
+    { "resolveCollision", 0, microResolveCollision },
+    { "applyForce", 1, microApplyForce },
+    { "checkCollisionWithWindow", 1, microCheckCollisionWithWindow },
+};
+
+static const int microCounts[] = { 1 << 10, 1 << 16, MICRO_MAX_COUNT };
+
+static void microFree(MicroData* data)
+{
+    free(data->circles);
+    free(data->pristineCircles);
+    free(data->rectangles);
+    free(data->pristineRectangles);
+    free(data->pairA);
+    free(data->pairB);
+    free(data->flush);
+}
+
+// Builds the largest data set; smaller sets use its prefix, so every size sees the same kind of items
+static int microInit(MicroData* data, unsigned int seed)
+{
+    data->circles = malloc(MICRO_MAX_COUNT * sizeof(Circle));
+    data->pristineCircles = malloc(MICRO_MAX_COUNT * sizeof(Circle));
+    data->rectangles = malloc(MICRO_MAX_COUNT * sizeof(Rectangle));
+    data->pristineRectangles = malloc(MICRO_MAX_COUNT * sizeof(Rectangle));
+    data->pairA = malloc(MICRO_MAX_COUNT * sizeof(int));
+    data->pairB = malloc(MICRO_MAX_COUNT * sizeof(int));
+    data->flush = malloc(MICRO_FLUSH_BYTES);
+    if (data->circles == NULL || data->pristineCircles == NULL || data->rectangles == NULL || data->pristineRectangles == NULL
+        || data->pairA == NULL || data->pairB == NULL || data->flush == NULL)
+    {
+        microFree(data);
+        return 0;
+    }
+    memset(data->flush, 1, MICRO_FLUSH_BYTES);
+
+    // Circles on a jittered lattice one diameter apart, so about half of the neighbor pairs touch
+    const int columns = 256;
+    const float spacing = 10.0f;
+    for (int i = 0; i < MICRO_MAX_COUNT; i++)
+    {
+        Circle* circle = &data->pristineCircles[i];
+        circle->x = SCALAR_FROM_FLOAT((i % columns) * spacing + microRandom(&seed, -1.0f, 1.0f));
+        circle->y = SCALAR_FROM_FLOAT(((i / columns) % 1024) * spacing + microRandom(&seed, -1.0f, 1.0f));
+        circle->velX = SCALAR_FROM_FLOAT(microRandom(&seed, -50.0f, 50.0f));
+        circle->velY = SCALAR_FROM_FLOAT(microRandom(&seed, -50.0f, 50.0f));
+        circle->radius = SCALAR_FROM_FLOAT(5.0f);
+        circle->mass = SCALAR_FROM_FLOAT(microRandom(&seed, 1.0f, 4.0f));
+    }
+
+    // Candidate pairs as a grid broadphase reports them: each body with its right or lower neighbor
+    for (int i = 0; i < MICRO_MAX_COUNT; i++)
+    {
+        data->pairA[i] = i;
+        data->pairB[i] = (i & 1) ? (i + columns) % MICRO_MAX_COUNT : (i + 1) % MICRO_MAX_COUNT;
+    }
+
+    // Rectangles spread slightly past the window, so about a fifth of them bounce off an edge
+    for (int i = 0; i < MICRO_MAX_COUNT; i++)
+    {
+        Rectangle* rectangle = &data->pristineRectangles[i];
+        rectangle->x = SCALAR_FROM_FLOAT(microRandom(&seed, -40.0f, MICRO_WINDOW_WIDTH + 40.0f));
+        rectangle->y = SCALAR_FROM_FLOAT(microRandom(&seed, -40.0f, MICRO_WINDOW_HEIGHT + 40.0f));
+        rectangle->velX = SCALAR_FROM_FLOAT(microRandom(&seed, -50.0f, 50.0f));
+        rectangle->velY = SCALAR_FROM_FLOAT(microRandom(&seed, -50.0f, 50.0f));
+        rectangle->width = SCALAR_FROM_FLOAT(microRandom(&seed, 10.0f, 60.0f));
+        rectangle->height = SCALAR_FROM_FLOAT(microRandom(&seed, 10.0f, 60.0f));
+        rectangle->mass = SCALAR_FROM_FLOAT(microRandom(&seed, 1.0f, 4.0f));
+    }
+    return 1;
+}
+
+// Streams a buffer larger than the last level cache through it, evicting the data set
+static void microFlushCaches(MicroData* data)
+{
+    unsigned int sum = 0;
+    for (int i = 0; i < MICRO_FLUSH_BYTES; i += 64)
+    {
+        data->flush[i]++;
+        sum += data->flush[i];
+    }
+    microSink += sum;
+}
+
+static int microPinToCpu(int cpu)
+{
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return 0;   // No thread affinity API (macOS): results are noisier
+#endif
+}
+
+static int microCompareDouble(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Times passes of the kernel over the first count items and prints one JSON record
+static void microMeasure(const MicroKernel* kernel, MicroData* data, int count, int cold, int last)
+{
+    static double passMs[MICRO_MAX_PASSES];
+    int passCount = cold ? MICRO_COLD_PASSES : MICRO_TARGET_OPS / count;
+    passCount = passCount < 1 ? 1 : passCount > MICRO_MAX_PASSES ? MICRO_MAX_PASSES : passCount;
+    size_t itemSize = kernel->rectangles ? sizeof(Rectangle) : sizeof(Circle);
+
+    // Untimed warm-up pass: faults the pages in and trains the branch predictors
+    for (int pass = -1; pass < passCount; pass++)
+    {
+        // Restoring the inputs also leaves them in the cache, which is the hot case
+        if (kernel->rectangles)
+        {
+            memcpy(data->rectangles, data->pristineRectangles, count * sizeof(Rectangle));
+        }
+        else
+        {
+            memcpy(data->circles, data->pristineCircles, count * sizeof(Circle));
+        }
+        if (cold)
+        {
+            microFlushCaches(data);
+        }
+
+        double start = timerGetMilliseconds();
+        microSink += (unsigned int)kernel->pass(data, count);
+        double elapsed = timerGetMilliseconds() - start;
+        if (pass >= 0)
+        {
+            passMs[pass] = elapsed;
+        }
+    }
+
+    qsort(passMs, passCount, sizeof(double), microCompareDouble);
+    double medianNs = passMs[passCount / 2] * 1e6 / count;
+    double minNs = passMs[0] * 1e6 / count;
+
+    printf("    { \"function\": \"%s\", \"dataset\": \"%s\", \"count\": %d, \"bytes\": %lu, \"passes\": %d, "
+        "\"nsPerOp\": %.3f, \"minNsPerOp\": %.3f, \"mopsPerSecond\": %.1f }%s\n",
+        kernel->name, cold ? "cold" : "hot", count, (unsigned long)(count * itemSize), passCount,
+        medianNs, minNs, medianNs > 0.0 ? 1e3 / medianNs : 0.0, last ? "" : ",");
+}
+
+static void microUsage(const char* program)
+{
+    fprintf(stderr, "usage: %s [--function NAME] [--seed N] [--cpu N]\n", program);
+    fprintf(stderr, "  --function  run a single primitive:");
+    for (size_t i = 0; i < sizeof(microKernels) / sizeof(microKernels[0]); i++)
+    {
+        fprintf(stderr, " %s", microKernels[i].name);
+    }
+    fprintf(stderr, "\n  --seed      seed of the data sets (default %u)\n", MICRO_SEED);
+    fprintf(stderr, "  --cpu       CPU to pin the benchmark to, -1 to leave it unpinned (default 0)\n");
+}
+
+/**
+ * @brief Measures the per-body primitives of the demo scenes and prints their cost as JSON.
+ *
+ * Each primitive is run over data sets of 1K, 64K and 1M items, hot (inputs restored into the cache
+ * before every pass) and cold (caches flushed before every pass). A pass calls the primitive once
+ * per item; the reported ns/op is the median pass time divided by the item count, with the fastest
+ * pass next to it. The data sets come from a fixed seed and the thread is pinned to one CPU, so
+ * results can be compared across changes on the same machine. Pairwise primitives run over
+ * neighbor pairs of a jittered lattice, half of which touch.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings.
+ * @return 0 on success, 1 on a usage error, 2 if the data sets could not be allocated.
+ */
+int main(int argc, char* argv[])
+{
+    const char* functionName = NULL;
+    unsigned int seed = MICRO_SEED;
+    int cpu = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--function") == 0 && i + 1 < argc)
+        {
+            functionName = argv[++i];
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc)
+        {
+            cpu = atoi(argv[++i]);
+        }
+        else
+        {
+            microUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    int kernelCount = (int)(sizeof(microKernels) / sizeof(microKernels[0]));
+    int first = 0;
+    int last = kernelCount - 1;
+    if (functionName != NULL)
+    {
+        while (first < kernelCount && strcmp(microKernels[first].name, functionName) != 0)
+        {
+            first++;
+        }
+        if (first == kernelCount)
+        {
+            microUsage(argv[0]);
+            return 1;
+        }
+        last = first;
+    }
+
+    MicroData data;
+    if (!microInit(&data, seed))
+    {
+        fprintf(stderr, "micro_bench: out of memory\n");
+        return 2;
+    }
+    int pinned = cpu >= 0 && microPinToCpu(cpu);
+
+    printf("{\n");
+    printf("  \"benchmark\": \"micro_bench\",\n");
+    printf("  \"scalar\": \"%s\",\n", SCALAR_TYPE == SCALAR_FIXED ? "fixed" : "float");
+    printf("  \"seed\": %u,\n", seed);
+    printf("  \"cpu\": %d,\n", pinned ? cpu : -1);
+    printf("  \"results\": [\n");
+
+    int countCount = (int)(sizeof(microCounts) / sizeof(microCounts[0]));
+    for (int k = first; k <= last; k++)
+    {
+        for (int c = 0; c < countCount; c++)
+        {
+            for (int cold = 0; cold <= 1; cold++)
+            {
+                microMeasure(&microKernels[k], &data, microCounts[c], cold, k == last && c == countCount - 1 && cold);
+            }
+        }
+    }
+
+    printf("  ]\n");
+    printf("}\n");
+
+    microFree(&data);
+    return 0;
+}
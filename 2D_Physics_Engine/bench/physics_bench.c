@@ -0,0 +1,523 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "WORLD_interface.h"
+#include "JOB_interface.h"
+#include "GRID_interface.h"
+#include "SAP_interface.h"
+#include "AABBTREE_interface.h"
+#include "NARROWPHASE_interface.h"
+#include "ISLAND_interface.h"
+#include "SOLVER_interface.h"
+#include "CCD_interface.h"
+#include "SIMULATION_interface.h"
+#include "TIMER_interface.h"
+#include "TRACE_interface.h"
+#include "STD_TYPES.h"
+#include "FB_config.h"
+#include "FB_interface.h"
+#include "RASTER_interface.h"
+#include "DIRTY_interface.h"
+#include "bench_common.h"
+
+#define BENCH_STEP_SECONDS      (1.0f / 120.0f)     /**< Same fixed step as TIMESTEP_DEFAULT_RATE. */
+#define BENCH_GRAVITY           500.0f              /**< Downward acceleration, in pixels per second squared. */
+#define BENCH_SEED              12345u              /**< Seed of the scene generator, so that every run builds the same scenes. */
+#define BENCH_SCREEN_WIDTH      240                 /**< Width of the TFT the --raster frames are drawn for. */
+#define BENCH_SCREEN_HEIGHT     320                 /**< Height of the TFT the --raster frames are drawn for. */
+#define BENCH_RASTER_SCALE      0.3f                /**< Screen pixels per world unit: the 800 unit wide scenes fit the TFT width. */
+
+/**
+ * @struct BenchScene
+ * @brief One canonical scene: how to build it and how long to run it by default.
+ */
+typedef struct
+{
+    const char* name;
+    BroadphaseKind broadphase;
+    int defaultSteps;
+    int (*build)(Simulation* simulation, unsigned int* seed);
+} BenchScene;
+
+/**
+ * @struct BenchResult
+ * @brief Timings accumulated over the steps of one scene run.
+ */
+typedef struct
+{
+    int steps;
+    double totalMs;
+    double maxStepMs;
+    double integrateMs;
+    double broadphaseMs;
+    double narrowphaseMs;
+    double islandMs;
+    double solveMs;
+    double pairCount;
+    double rasterMs;
+    double flushedPixels;
+} BenchResult;
+
+// Small linear congruential generator: rand() differs between C libraries, and the scenes must not
+static float benchRandom(unsigned int* seed, float low, float high)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return low + (high - low) * (float)(*seed >> 8) / 16777216.0f;
+}
+
+// Static floor and walls around a box of the given size, inside the simulation bounds
+static int benchAddBox(Simulation* simulation, float width, float height)
+{
+    World* world = &simulation->world;
+    simulation->boundsWidth = (int)width;
+    simulation->boundsHeight = (int)height;
+    return worldAddRectangle(world, width / 2, height - 10.0f, 0.0f, 0.0f, width, 20.0f, 0.0f).slot != WORLD_INVALID_SLOT
+        && worldAddRectangle(world, 10.0f, height / 2, 0.0f, 0.0f, 20.0f, height, 0.0f).slot != WORLD_INVALID_SLOT
+        && worldAddRectangle(world, width - 10.0f, height / 2, 0.0f, 0.0f, 20.0f, height, 0.0f).slot != WORLD_INVALID_SLOT;
+}
+
+// Circles of mixed sizes dropped in a loose cloud, settling into a heap
+static int benchBuildPile(Simulation* simulation, unsigned int* seed)
+{
+    if (!benchAddBox(simulation, 1600.0f, 1200.0f))
+    {
+        return 0;
+    }
+    for (int i = 0; i < 2000; i++)
+    {
+        float radius = benchRandom(seed, 4.0f, 10.0f);
+        if (worldAddCircle(&simulation->world, benchRandom(seed, 40.0f, 1560.0f), benchRandom(seed, 40.0f, 900.0f),
+            benchRandom(seed, -50.0f, 50.0f), 0.0f, radius, radius * radius).slot == WORLD_INVALID_SLOT)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Pyramid of rectangles resting on a static floor; exercises manifolds and warm starting
+static int benchBuildPyramid(Simulation* simulation, unsigned int* seed)
+{
+    (void)seed;
+    if (!benchAddBox(simulation, 1600.0f, 1200.0f))
+    {
+        return 0;
+    }
+
+    const int base = 20;
+    const float size = 30.0f;
+    for (int row = 0; row < base; row++)
+    {
+        for (int column = 0; column < base - row; column++)
+        {
+            float x = 800.0f + (column - (base - row - 1) * 0.5f) * size;
+            float y = 1180.0f - size * 0.5f - row * size;
+            if (worldAddRectangle(&simulation->world, x, y, 0.0f, 0.0f, size, size, 1.0f).slot == WORLD_INVALID_SLOT)
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// Loose lattice of equal small grains resting on the floor of a wide box, jostled so they collapse into a granular bed
+static int benchBuildGranular(Simulation* simulation, unsigned int* seed, int count)
+{
+    int columns = (int)sqrtf((float)count * 4.0f);
+    float spacing = 7.0f;
+    float width = columns * spacing + 80.0f;
+    float height = (count / columns + 1) * spacing + 200.0f;
+    if (!benchAddBox(simulation, width, height))
+    {
+        return 0;
+    }
+
+    // The default cell is sized for the demo's circles; a cell of one grain keeps each neighborhood small
+    gridSetCellSize(&simulation->grid, spacing);
+    for (int i = 0; i < count; i++)
+    {
+        float x = 40.0f + (i % columns) * spacing + benchRandom(seed, -0.5f, 0.5f);
+        float y = height - 24.0f - (i / columns) * spacing;
+        if (worldAddCircle(&simulation->world, x, y, benchRandom(seed, -40.0f, 40.0f), benchRandom(seed, -40.0f, 40.0f),
+            3.0f, 1.0f).slot == WORLD_INVALID_SLOT)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int benchBuildGranular10k(Simulation* simulation, unsigned int* seed)
+{
+    return benchBuildGranular(simulation, seed, 10000);
+}
+
+static int benchBuildGranular100k(Simulation* simulation, unsigned int* seed)
+{
+    return benchBuildGranular(simulation, seed, 100000);
+}
+
+// Fast bullets fired through thin walls and a field of small obstacles; exercises continuous collision
+static int benchBuildBullets(Simulation* simulation, unsigned int* seed)
+{
+    World* world = &simulation->world;
+    world->gravityY = 0.0f;
+    simulation->boundsWidth = 1600;
+    simulation->boundsHeight = 1200;
+
+    for (int i = 0; i < 8; i++)
+    {
+        if (worldAddRectangle(world, 400.0f + i * 120.0f, 600.0f, 0.0f, 0.0f, 4.0f, 1000.0f, 0.0f).slot == WORLD_INVALID_SLOT)
+        {
+            return 0;
+        }
+    }
+    for (int i = 0; i < 400; i++)
+    {
+        if (worldAddCircle(world, benchRandom(seed, 300.0f, 1400.0f), benchRandom(seed, 100.0f, 1100.0f),
+            0.0f, 0.0f, 3.0f, 1.0f).slot == WORLD_INVALID_SLOT)
+        {
+            return 0;
+        }
+    }
+    for (int i = 0; i < 64; i++)
+    {
+        BodyHandle handle = worldAddCircle(world, 100.0f, 150.0f + i * 14.0f,
+            benchRandom(seed, 4000.0f, 8000.0f), benchRandom(seed, -500.0f, 500.0f), 3.0f, 1.0f);
+        if (handle.slot == WORLD_INVALID_SLOT)
+        {
+            return 0;
+        }
+        worldSetBullet(world, worldGetIndex(world, handle), 1);
+    }
+    return 1;
+}
+
+static const BenchScene benchScenes[] =
+{
+    { "pile", BROADPHASE_GRID, 1200, benchBuildPile },
+    { "pyramid", BROADPHASE_TREE, 1200, benchBuildPyramid },
+    { "granular_10k", BROADPHASE_GRID, 600, benchBuildGranular10k },
+    { "granular_100k", BROADPHASE_GRID, 120, benchBuildGranular100k },
+    { "bullets", BROADPHASE_TREE, 600, benchBuildBullets },
+};
+
+// Peak resident memory of the process so far, in kilobytes
+static long benchPeakMemoryKb(void)
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return -1;
+    }
+    return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return -1;
+    }
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Draws a region of the TFT-sized frame buffer one band at a time, as the target would; the bands are only counted
+static void benchRasterRegion(SFB_FrameBuffer_t* frameBuffer, const SFB_Rect_t* region, const World* world)
+{
+    SFB_voidBeginRegion(frameBuffer, region, RASTER_RGB565(0, 0, 0));
+    do
+    {
+        rasterWorld(frameBuffer, world, BENCH_RASTER_SCALE, RASTER_RGB565(0, 255, 0), RASTER_RGB565(128, 128, 128));
+    } while (SFB_u8EndBand(frameBuffer, benchCountBand));
+}
+
+// Draws the whole screen, or with a tracker only the areas the last step changed
+static int benchRasterFrame(SFB_FrameBuffer_t* frameBuffer, DirtyTracker* tracker, SFB_DirtyRegion_t* dirty, const World* world)
+{
+    if (tracker == NULL)
+    {
+        SFB_Rect_t screen = { 0, 0, BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT };
+        benchRasterRegion(frameBuffer, &screen, world);
+        return 1;
+    }
+
+    int success = dirtyTrackerUpdate(tracker, world, BENCH_RASTER_SCALE, dirty);
+    for (int i = 0; i < dirty->Count; i++)
+    {
+        benchRasterRegion(frameBuffer, &dirty->Rects[i], world);
+    }
+    SFB_voidDirtyClear(dirty);
+    return success;
+}
+
+static int benchRunScene(const BenchScene* scene, int steps, int rasterRows, int rasterDirty, u16* bandPixels, JobSystem* jobs,
+    Simulation* simulation, BenchResult* result)
+{
+    unsigned int seed = BENCH_SEED;
+    memset(result, 0, sizeof(*result));
+
+    SFB_FrameBuffer_t frameBuffer;
+    SFB_DirtyRegion_t dirty;
+    DirtyTracker tracker;
+    dirtyTrackerInit(&tracker);
+    SFB_voidDirtyInit(&dirty, BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT);
+    if (rasterRows > 0 && SFB_u8Init(&frameBuffer, bandPixels, BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT, (u16)rasterRows) != 0)
+    {
+        return 0;
+    }
+
+    if (!simulationInit(simulation, scene->broadphase, 1024))
+    {
+        return 0;
+    }
+    simulation->world.gravityY = BENCH_GRAVITY;
+    simulation->jobs = jobs;
+    if (!scene->build(simulation, &seed))
+    {
+        return 0;
+    }
+
+    for (int step = 0; step < steps; step++)
+    {
+        double start = timerGetMilliseconds();
+        if (!simulationStep(simulation, BENCH_STEP_SECONDS))
+        {
+            dirtyTrackerFree(&tracker);
+            return 0;
+        }
+        double elapsed = timerGetMilliseconds() - start;
+
+        result->steps++;
+        result->totalMs += elapsed;
+        result->maxStepMs = elapsed > result->maxStepMs ? elapsed : result->maxStepMs;
+        result->integrateMs += simulation->integrateTimeMs;
+        result->broadphaseMs += simulation->broadphaseTimeMs;
+        result->narrowphaseMs += simulation->narrowphaseTimeMs;
+        result->islandMs += simulation->islandTimeMs;
+        result->solveMs += simulation->solverTimeMs;
+        result->pairCount += simulation->pairCount;
+
+        if (rasterRows > 0)
+        {
+            benchFlushedPixels = 0;
+            start = timerGetMilliseconds();
+            if (!benchRasterFrame(&frameBuffer, rasterDirty ? &tracker : NULL, &dirty, &simulation->world))
+            {
+                dirtyTrackerFree(&tracker);
+                return 0;
+            }
+            result->rasterMs += timerGetMilliseconds() - start;
+            result->flushedPixels += benchFlushedPixels;
+        }
+    }
+    dirtyTrackerFree(&tracker);
+    return 1;
+}
+
+static const char* benchBroadphaseName(BroadphaseKind broadphase)
+{
+    return broadphase == BROADPHASE_GRID ? "grid" : broadphase == BROADPHASE_SAP ? "sap" : "tree";
+}
+
+static void benchPrintScene(const BenchScene* scene, const Simulation* simulation, const BenchResult* result, int rasterRows,
+    int rasterDirty, int last)
+{
+    double steps = result->steps > 0 ? result->steps : 1;
+    printf("    {\n");
+    printf("      \"name\": \"%s\",\n", scene->name);
+    printf("      \"broadphase\": \"%s\",\n", benchBroadphaseName(simulation->broadphase));
+    printf("      \"bodies\": %d,\n", simulation->world.count);
+    printf("      \"steps\": %d,\n", result->steps);
+    printf("      \"totalMs\": %.3f,\n", result->totalMs);
+    printf("      \"stepsPerSecond\": %.1f,\n", result->totalMs > 0.0 ? result->steps * 1000.0 / result->totalMs : 0.0);
+    printf("      \"meanStepMs\": %.4f,\n", result->totalMs / steps);
+    printf("      \"maxStepMs\": %.4f,\n", result->maxStepMs);
+    printf("      \"phasesMs\": {\n");
+    printf("        \"integrate\": %.4f,\n", result->integrateMs / steps);
+    printf("        \"broadphase\": %.4f,\n", result->broadphaseMs / steps);
+    printf("        \"narrowphase\": %.4f,\n", result->narrowphaseMs / steps);
+    printf("        \"islands\": %.4f,\n", result->islandMs / steps);
+    printf("        \"solve\": %.4f\n", result->solveMs / steps);
+    printf("      },\n");
+    printf("      \"meanPairs\": %.1f,\n", result->pairCount / steps);
+    printf("      \"contacts\": %d,\n", simulation->contacts.count);
+    printf("      \"sleeping\": %d,\n", simulation->islands.sleepingCount);
+    printf("      \"bulletImpacts\": %d,\n", simulation->ccd.impactCount);
+    if (rasterRows > 0)
+    {
+        printf("      \"rasterBandRows\": %d,\n", rasterRows);
+        printf("      \"rasterDirty\": %s,\n", rasterDirty ? "true" : "false");
+        printf("      \"rasterFrameMs\": %.4f,\n", result->steps > 0 ? result->rasterMs / result->steps : 0.0);
+        printf("      \"rasterFlushKb\": %.2f,\n", result->steps > 0 ? result->flushedPixels * sizeof(u16) / 1024.0 / result->steps : 0.0);
+    }
+    printf("      \"peakMemoryKb\": %ld\n", benchPeakMemoryKb());
+    printf("    }%s\n", last ? "" : ",");
+}
+
+static void benchUsage(const char* program)
+{
+    fprintf(stderr, "usage: %s [--scene NAME] [--steps N] [--threads N] [--trace FILE] [--raster ROWS [--dirty]]\n", program);
+    fprintf(stderr, "  --scene    run a single scene:");
+    for (size_t i = 0; i < sizeof(benchScenes) / sizeof(benchScenes[0]); i++)
+    {
+        fprintf(stderr, " %s", benchScenes[i].name);
+    }
+    fprintf(stderr, "\n  --steps    steps per scene (default: the scene's own count)\n");
+    fprintf(stderr, "  --threads  worker threads, 0 for one per CPU (default: step on the calling thread)\n");
+    fprintf(stderr, "  --trace    write the last steps of each thread as Chrome trace JSON (builds with TRACE_ENABLED)\n");
+    fprintf(stderr, "  --raster   after each step, draw the world in RGB565 for a %dx%d TFT in bands of ROWS rows\n",
+        BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT);
+    fprintf(stderr, "  --dirty    with --raster, draw and send only the areas each step changed\n");
+}
+
+/**
+ * @brief Runs the canonical physics scenes without any window and prints their timings as JSON.
+ *
+ * Every scene is built from a fixed seed and stepped at a fixed rate, so two runs on the same
+ * machine measure the same work. Per-phase times are the Simulation counters averaged over the
+ * steps. The memory high-water mark is the peak resident size of the process when the scene
+ * ends, so it only grows from scene to scene; run one scene with --scene to isolate it. Built with
+ * TRACE_ENABLED, --trace writes the step phases and job chunks of every thread as a Chrome trace.
+ * With --raster, every step is also drawn by the RGB565 rasterizer of the TFT target, in bands of
+ * the given height, and the mean frame time and bytes sent are reported; it is not included in
+ * the step times. Adding --dirty draws only the areas the step changed, as the target would.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings.
+ * @return 0 on success, 1 on a usage error, 2 if a scene could not be allocated.
+ */
+int main(int argc, char* argv[])
+{
+    const char* sceneName = NULL;
+    int steps = 0;
+    int threads = -1;
+    const char* tracePath = NULL;
+    int rasterRows = 0;
+    int rasterDirty = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+        {
+            sceneName = argv[++i];
+        }
+        else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+        {
+            steps = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--raster") == 0 && i + 1 < argc)
+        {
+            rasterRows = atoi(argv[++i]);
+            rasterRows = rasterRows > BENCH_SCREEN_HEIGHT ? BENCH_SCREEN_HEIGHT : rasterRows;
+        }
+        else if (strcmp(argv[i], "--dirty") == 0)
+        {
+            rasterDirty = 1;
+        }
+        else
+        {
+            benchUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    int sceneCount = (int)(sizeof(benchScenes) / sizeof(benchScenes[0]));
+    int first = 0;
+    int last = sceneCount - 1;
+    if (sceneName != NULL)
+    {
+        while (first < sceneCount && strcmp(benchScenes[first].name, sceneName) != 0)
+        {
+            first++;
+        }
+        if (first == sceneCount)
+        {
+            benchUsage(argv[0]);
+            return 1;
+        }
+        last = first;
+    }
+
+    TRACE_THREAD_NAME("main");
+    JobSystem jobSystem;
+    JobSystem* jobs = NULL;
+    if (threads >= 0)
+    {
+        if (!jobSystemInit(&jobSystem, threads))
+        {
+            return 2;
+        }
+        jobs = &jobSystem;
+    }
+
+    printf("{\n");
+    printf("  \"benchmark\": \"physics_bench\",\n");
+    printf("  \"stepSeconds\": %.6f,\n", BENCH_STEP_SECONDS);
+    printf("  \"threads\": %d,\n", jobs != NULL ? jobs->workerCount : 1);
+    printf("  \"narrowphasePath\": %d,\n", (int)narrowphaseDetectPath());
+    printf("  \"scenes\": [\n");
+
+    int status = 0;
+    u16* bandPixels = NULL;
+    if (rasterRows > 0)
+    {
+        bandPixels = malloc(sizeof(u16) * BENCH_SCREEN_WIDTH * (size_t)rasterRows);
+        if (bandPixels == NULL)
+        {
+            return 2;
+        }
+    }
+    for (int i = first; i <= last; i++)
+    {
+        Simulation simulation;
+        BenchResult result;
+        const BenchScene* scene = &benchScenes[i];
+        if (!benchRunScene(scene, steps > 0 ? steps : scene->defaultSteps, rasterRows, rasterDirty, bandPixels, jobs, &simulation, &result))
+        {
+            fprintf(stderr, "physics_bench: scene %s ran out of memory\n", scene->name);
+            status = 2;
+        }
+        benchPrintScene(scene, &simulation, &result, rasterRows, rasterDirty, i == last);
+        simulationFree(&simulation);
+    }
+
+    printf("  ]\n");
+    printf("}\n");
+    free(bandPixels);
+
+    if (tracePath != NULL && !traceDump(tracePath))
+    {
+        fprintf(stderr, "physics_bench: no trace written to %s (build with TRACE_ENABLED=1)\n", tracePath);
+    }
+    if (jobs != NULL)
+    {
+        jobSystemFree(jobs);
+    }
+    return status;
+}
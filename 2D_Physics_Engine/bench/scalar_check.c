@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "SCALAR_interface.h"
+#include "WORLD_interface.h"
+#include "CIRCLE_interface.h"
+#include "SOLID2DRectangle_interface.h"
+
+#define CHECK_SEED              12345u              /**< Seed of the scene generator. */
+#define CHECK_BODY_COUNT        256                 /**< Circles, and as many rectangles, in the scene. */
+#define CHECK_PAIR_COUNT        8                   /**< Pairs of circles that collide head-on. */
+#define CHECK_TOTAL_BODIES      (2 * CHECK_BODY_COUNT + 2 * CHECK_PAIR_COUNT)
+#define CHECK_DEFAULT_STEPS     600                 /**< Steps simulated by default (5 s at 120 Hz). */
+#define CHECK_MAX_DIVERGENCE    2.5f                /**< Default bound on the distance between the two builds, in pixels. */
+#define CHECK_WINDOW_WIDTH      800                 /**< Window the rectangles bounce in. */
+#define CHECK_WINDOW_HEIGHT     600
+
+/**
+ * @struct CheckScene
+ * @brief Bodies stepped by the check: circles falling freely, rectangles bouncing inside the window and
+ *        pairs of circles that collide.
+ *
+ * Each pair is a light circle thrown at a heavy one; it bounces off once and the two never meet again.
+ * Repeated collisions are chaotic, so any rounding difference would grow until the two builds no longer
+ * compare, while a single collision shows the error of checkCollision and resolveCollision. The error
+ * still grows with the run length: Q16.16 rounds the 1/120 s step to 546/65536 s, which the falling
+ * circles integrate twice and each bounce shifts in time.
+ */
+typedef struct
+{
+    Circle circles[CHECK_BODY_COUNT];
+    Rectangle rectangles[CHECK_BODY_COUNT];
+    Circle pairs[2 * CHECK_PAIR_COUNT];     /**< The light circle of each pair, then the heavy one. */
+} CheckScene;
+
+// Same generator as micro_bench: rand() differs between C libraries, and the scene must not
+static float checkRandom(unsigned int* seed, float low, float high)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return low + (high - low) * (float)(*seed >> 8) / 16777216.0f;
+}
+
+static void checkInit(CheckScene* scene)
+{
+    unsigned int seed = CHECK_SEED;
+    for (int i = 0; i < CHECK_BODY_COUNT; i++)
+    {
+        Circle* circle = &scene->circles[i];
+        circle->x = SCALAR_FROM_FLOAT(checkRandom(&seed, 0.0f, CHECK_WINDOW_WIDTH));
+        circle->y = SCALAR_FROM_FLOAT(checkRandom(&seed, 0.0f, CHECK_WINDOW_HEIGHT));
+        circle->velX = SCALAR_FROM_FLOAT(checkRandom(&seed, -50.0f, 50.0f));
+        circle->velY = SCALAR_FROM_FLOAT(checkRandom(&seed, -50.0f, 50.0f));
+        circle->radius = SCALAR_FROM_FLOAT(5.0f);
+        circle->mass = SCALAR_FROM_FLOAT(checkRandom(&seed, 1.0f, 4.0f));
+    }
+    for (int i = 0; i < CHECK_BODY_COUNT; i++)
+    {
+        Rectangle* rectangle = &scene->rectangles[i];
+        rectangle->x = SCALAR_FROM_FLOAT(checkRandom(&seed, 40.0f, CHECK_WINDOW_WIDTH - 40.0f));
+        rectangle->y = SCALAR_FROM_FLOAT(checkRandom(&seed, 40.0f, CHECK_WINDOW_HEIGHT - 40.0f));
+        rectangle->velX = SCALAR_FROM_FLOAT(checkRandom(&seed, -200.0f, 200.0f));
+        rectangle->velY = SCALAR_FROM_FLOAT(checkRandom(&seed, -200.0f, 200.0f));
+        rectangle->width = SCALAR_FROM_FLOAT(checkRandom(&seed, 10.0f, 60.0f));
+        rectangle->height = SCALAR_FROM_FLOAT(checkRandom(&seed, 10.0f, 60.0f));
+        rectangle->mass = SCALAR_FROM_FLOAT(checkRandom(&seed, 1.0f, 4.0f));
+    }
+    for (int i = 0; i < CHECK_PAIR_COUNT; i++)
+    {
+        // Both circles fall alike, so they stay on the same row and meet after 0.3 to 0.6 s
+        float y = 40.0f + 60.0f * i;
+        float speed = checkRandom(&seed, 50.0f, 100.0f);
+        Circle* light = &scene->pairs[2 * i];
+        Circle* heavy = &scene->pairs[2 * i + 1];
+        light->x = SCALAR_FROM_FLOAT(100.0f);
+        light->y = SCALAR_FROM_FLOAT(y + checkRandom(&seed, -4.0f, 4.0f));
+        light->velX = SCALAR_FROM_FLOAT(speed);
+        light->velY = 0;
+        light->radius = SCALAR_FROM_FLOAT(10.0f);
+        light->mass = SCALAR_FROM_FLOAT(1.0f);
+        heavy->x = SCALAR_FROM_FLOAT(100.0f + 20.0f + speed * checkRandom(&seed, 0.3f, 0.6f));
+        heavy->y = SCALAR_FROM_FLOAT(y);
+        heavy->velX = 0;
+        heavy->velY = 0;
+        heavy->radius = SCALAR_FROM_FLOAT(10.0f);
+        heavy->mass = SCALAR_FROM_FLOAT(100.0f);
+    }
+}
+
+static void checkStep(CheckScene* scene)
+{
+    Scalar deltaTime = SCALAR_FROM_FLOAT(1.0f / 120.0f);
+    Scalar forceX = SCALAR_FROM_FLOAT(3.0f);
+    Scalar forceY = SCALAR_FROM_FLOAT(20.0f);
+    for (int i = 0; i < CHECK_BODY_COUNT; i++)
+    {
+        applyGravity(&scene->circles[i], deltaTime);
+        updateCirclePosition(&scene->circles[i], deltaTime);
+    }
+    for (int i = 0; i < CHECK_BODY_COUNT; i++)
+    {
+        applyForce(&scene->rectangles[i], forceX, forceY, deltaTime);
+        updateRectanglePosition(&scene->rectangles[i], deltaTime);
+        checkCollisionWithWindow(&scene->rectangles[i], CHECK_WINDOW_WIDTH, CHECK_WINDOW_HEIGHT);
+    }
+    for (int i = 0; i < 2 * CHECK_PAIR_COUNT; i++)
+    {
+        applyGravity(&scene->pairs[i], deltaTime);
+        updateCirclePosition(&scene->pairs[i], deltaTime);
+    }
+    for (int i = 0; i < CHECK_PAIR_COUNT; i++)
+    {
+        if (checkCollision(&scene->pairs[2 * i], &scene->pairs[2 * i + 1]))
+        {
+            resolveCollision(&scene->pairs[2 * i], &scene->pairs[2 * i + 1]);
+        }
+    }
+}
+
+// Positions of every body in a fixed order: the circles, the rectangles, then the pairs
+static void checkPositions(const CheckScene* scene, float* positions)
+{
+    for (int i = 0; i < CHECK_BODY_COUNT; i++)
+    {
+        positions[2 * i] = SCALAR_TO_FLOAT(scene->circles[i].x);
+        positions[2 * i + 1] = SCALAR_TO_FLOAT(scene->circles[i].y);
+        positions[2 * (CHECK_BODY_COUNT + i)] = SCALAR_TO_FLOAT(scene->rectangles[i].x);
+        positions[2 * (CHECK_BODY_COUNT + i) + 1] = SCALAR_TO_FLOAT(scene->rectangles[i].y);
+    }
+    for (int i = 0; i < 2 * CHECK_PAIR_COUNT; i++)
+    {
+        positions[2 * (2 * CHECK_BODY_COUNT + i)] = SCALAR_TO_FLOAT(scene->pairs[i].x);
+        positions[2 * (2 * CHECK_BODY_COUNT + i) + 1] = SCALAR_TO_FLOAT(scene->pairs[i].y);
+    }
+}
+
+// Reads the positions printed by the other build; returns 0 if the file does not match this run
+static int checkReadReference(const char* path, int steps, float* positions)
+{
+    FILE* file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return 0;
+    }
+    char scalar[16];
+    int referenceSteps = 0;
+    int referenceBodies = 0;
+    int ok = fscanf(file, "scalar_check %15s %d %d", scalar, &referenceSteps, &referenceBodies) == 3
+        && referenceSteps == steps && referenceBodies == CHECK_TOTAL_BODIES;
+    for (int i = 0; ok && i < CHECK_TOTAL_BODIES; i++)
+    {
+        ok = fscanf(file, "%f %f", &positions[2 * i], &positions[2 * i + 1]) == 2;
+    }
+    fclose(file);
+    return ok;
+}
+
+static void checkUsage(const char* program)
+{
+    fprintf(stderr, "usage: %s [--steps N] [--reference FILE] [--bound PX]\n", program);
+    fprintf(stderr, "  --steps      steps to simulate (default %d)\n", CHECK_DEFAULT_STEPS);
+    fprintf(stderr, "  --reference  positions printed by the build with the other Scalar type; compare against them\n");
+    fprintf(stderr, "  --bound      largest accepted divergence in pixels (default %.1f, sized for the default steps)\n",
+        CHECK_MAX_DIVERGENCE);
+}
+
+/**
+ * @brief Checks that the float and Q16.16 fixed-point Scalar builds simulate the same scene alike.
+ *
+ * The scene is stepped for a number of steps. Without --reference the final body positions are printed.
+ * With --reference the positions printed by the build with the other Scalar type are read back and the
+ * largest distance between the two builds is reported; it must not exceed the bound, CHECK_MAX_DIVERGENCE
+ * pixels unless --bound is given. "make check" builds both variants and runs the comparison.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings.
+ * @return 0 on success, 1 on a usage error or unreadable reference, 3 if the builds diverge past the bound.
+ */
+int main(int argc, char* argv[])
+{
+    const char* referencePath = NULL;
+    int steps = CHECK_DEFAULT_STEPS;
+    float bound = CHECK_MAX_DIVERGENCE;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+        {
+            steps = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--reference") == 0 && i + 1 < argc)
+        {
+            referencePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--bound") == 0 && i + 1 < argc)
+        {
+            bound = (float)atof(argv[++i]);
+        }
+        else
+        {
+            checkUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    static CheckScene scene;
+    static float positions[2 * CHECK_TOTAL_BODIES];
+    static float reference[2 * CHECK_TOTAL_BODIES];
+    checkInit(&scene);
+    for (int step = 0; step < steps; step++)
+    {
+        checkStep(&scene);
+    }
+    checkPositions(&scene, positions);
+
+    const char* scalarName = SCALAR_TYPE == SCALAR_FIXED ? "fixed" : "float";
+    if (referencePath == NULL)
+    {
+        printf("scalar_check %s %d %d\n", scalarName, steps, CHECK_TOTAL_BODIES);
+        for (int i = 0; i < CHECK_TOTAL_BODIES; i++)
+        {
+            printf("%.6f %.6f\n", positions[2 * i], positions[2 * i + 1]);
+        }
+        return 0;
+    }
+
+    if (!checkReadReference(referencePath, steps, reference))
+    {
+        fprintf(stderr, "scalar_check: %s is not the output of a %d-step run\n", referencePath, steps);
+        return 1;
+    }
+
+    float maxDivergence = 0.0f;
+    int worstBody = 0;
+    for (int i = 0; i < CHECK_TOTAL_BODIES; i++)
+    {
+        float divergence = hypotf(positions[2 * i] - reference[2 * i], positions[2 * i + 1] - reference[2 * i + 1]);
+        if (divergence > maxDivergence)
+        {
+            maxDivergence = divergence;
+            worstBody = i;
+        }
+    }
+
+    int passed = maxDivergence <= bound;
+    printf("scalar_check: %s against %s, %d steps, %d bodies, max divergence %.4f px (body %d, bound %.2f px): %s\n",
+        scalarName, referencePath, steps, CHECK_TOTAL_BODIES, maxDivergence, worstBody, bound,
+        passed ? "ok" : "FAILED");
+    return passed ? 0 : 3;
+}
@@ -0,0 +1,278 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "WORLD_interface.h"
+#include "JOB_interface.h"
+#include "GRID_interface.h"
+#include "SAP_interface.h"
+#include "AABBTREE_interface.h"
+#include "NARROWPHASE_interface.h"
+#include "ISLAND_interface.h"
+#include "SOLVER_interface.h"
+#include "CCD_interface.h"
+#include "SIMULATION_interface.h"
+#include "STD_TYPES.h"
+#include "FB_config.h"
+#include "FB_interface.h"
+#include "RASTER_interface.h"
+#include "DIRTY_interface.h"
+#include "OS_config.h"
+#include "OS_interface.h"
+#include "SIM_interface.h"
+#include "bench_common.h"
+
+#define BENCH_GRAVITY           500.0f              /**< Downward acceleration, in pixels per second squared. */
+#define BENCH_SEED              12345u              /**< Seed of the scene generator, so that every run builds the same scene. */
+#define BENCH_SCREEN_WIDTH      240                 /**< Width of the TFT the render task draws for. */
+#define BENCH_SCREEN_HEIGHT     320                 /**< Height of the TFT the render task draws for. */
+#define BENCH_BAND_ROWS         16                  /**< Rows of the band the render task draws at a time. */
+#define BENCH_RASTER_SCALE      0.3f                /**< Screen pixels per world unit: the 800 unit wide scene fits the TFT width. */
+#define BENCH_PHYSICS_TASK      0                   /**< SOS priority of the physics task. */
+#define BENCH_RENDER_TASK       1                   /**< SOS priority of the render task. */
+#define BENCH_TELEMETRY_TASK    2                   /**< SOS priority of the telemetry task. */
+
+/**
+ * @struct BenchTasks
+ * @brief What the three tasks work on: the physics scene, the TFT band and the telemetry line.
+ */
+typedef struct
+{
+    Simulation simulation;
+    float stepSeconds;
+    int failed;
+    u16 bandPixels[BENCH_SCREEN_WIDTH * BENCH_BAND_ROWS];
+    SFB_FrameBuffer_t frameBuffer;
+    SFB_DirtyRegion_t dirty;
+    DirtyTracker tracker;
+    char telemetry[256];
+    long telemetryBytes;
+} BenchTasks;
+
+// The tasks take no arguments, like the tasks of the target
+static BenchTasks benchTasks;
+
+// Small linear congruential generator: rand() differs between C libraries, and the scene must not
+static float benchRandom(unsigned int* seed, float low, float high)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return low + (high - low) * (float)(*seed >> 8) / 16777216.0f;
+}
+
+// Circles dropped into an 800x600 box, the size of the desktop demo
+static int benchBuildScene(Simulation* simulation, int bodies)
+{
+    unsigned int seed = BENCH_SEED;
+    World* world = &simulation->world;
+    simulation->boundsWidth = 800;
+    simulation->boundsHeight = 600;
+    if (worldAddRectangle(world, 400.0f, 590.0f, 0.0f, 0.0f, 800.0f, 20.0f, 0.0f).slot == WORLD_INVALID_SLOT
+        || worldAddRectangle(world, 10.0f, 300.0f, 0.0f, 0.0f, 20.0f, 600.0f, 0.0f).slot == WORLD_INVALID_SLOT
+        || worldAddRectangle(world, 790.0f, 300.0f, 0.0f, 0.0f, 20.0f, 600.0f, 0.0f).slot == WORLD_INVALID_SLOT)
+    {
+        return 0;
+    }
+    for (int i = 0; i < bodies; i++)
+    {
+        float radius = benchRandom(&seed, 6.0f, 14.0f);
+        if (worldAddCircle(world, benchRandom(&seed, 40.0f, 760.0f), benchRandom(&seed, 20.0f, 400.0f),
+            benchRandom(&seed, -50.0f, 50.0f), 0.0f, radius, radius * radius).slot == WORLD_INVALID_SLOT)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void benchPhysicsTask(void)
+{
+    if (!simulationStep(&benchTasks.simulation, benchTasks.stepSeconds))
+    {
+        benchTasks.failed = 1;
+    }
+}
+
+// Draws the areas the physics changed since the last frame, one TFT band at a time
+static void benchRenderTask(void)
+{
+    const World* world = &benchTasks.simulation.world;
+    if (!dirtyTrackerUpdate(&benchTasks.tracker, world, BENCH_RASTER_SCALE, &benchTasks.dirty))
+    {
+        benchTasks.failed = 1;
+    }
+    for (int i = 0; i < benchTasks.dirty.Count; i++)
+    {
+        SFB_voidBeginRegion(&benchTasks.frameBuffer, &benchTasks.dirty.Rects[i], RASTER_RGB565(0, 0, 0));
+        do
+        {
+            rasterWorld(&benchTasks.frameBuffer, world, BENCH_RASTER_SCALE, RASTER_RGB565(0, 255, 0), RASTER_RGB565(128, 128, 128));
+        } while (SFB_u8EndBand(&benchTasks.frameBuffer, benchCountBand));
+    }
+    SFB_voidDirtyClear(&benchTasks.dirty);
+}
+
+// Stands in for UART_voidTransmit(): keeps the last line and counts the bytes
+static void benchSendLine(u8* data, u16 size)
+{
+    u16 length = size < sizeof(benchTasks.telemetry) - 1 ? size : sizeof(benchTasks.telemetry) - 1;
+    memcpy(benchTasks.telemetry, data, length);
+    benchTasks.telemetry[length] = '\0';
+    benchTasks.telemetryBytes += size;
+}
+
+// Sends the scene status and the SOS task statistics, as the UART telemetry task of the target would
+static void benchTelemetryTask(void)
+{
+    char line[64];
+    int length = snprintf(line, sizeof(line), "bodies=%d sleeping=%d\r\n",
+        benchTasks.simulation.world.count, benchTasks.simulation.islands.sleepingCount);
+    benchSendLine((u8*)line, (u16)(length > 0 ? length : 0));
+    SOS_voidSendStats(benchSendLine);
+}
+
+static void benchPrintTask(const char* name, u8 priority, int periodMs, double seconds, int last)
+{
+    PSIM_TaskStats_t stats;
+    SOS_TaskStats_t sosStats;
+    PSIM_u8GetTaskStats(priority, &stats);
+    SOS_u8GetTaskStats(priority, &sosStats);
+    double releases = stats.Releases > 0 ? stats.Releases : 1.0;
+    printf("    {\n");
+    printf("      \"name\": \"%s\",\n", name);
+    printf("      \"priority\": %d,\n", priority);
+    printf("      \"periodMs\": %d,\n", periodMs);
+    printf("      \"releases\": %u,\n", stats.Releases);
+    printf("      \"meanLatencyUs\": %.1f,\n", stats.TotalLatencyUs / releases);
+    printf("      \"maxLatencyUs\": %u,\n", stats.MaxLatencyUs);
+    printf("      \"maxDriftUs\": %u,\n", stats.MaxDriftUs);
+    printf("      \"maxJitterUs\": %u,\n", stats.MaxJitterUs);
+    printf("      \"meanExecutionUs\": %.1f,\n", stats.TotalExecutionUs / releases);
+    printf("      \"maxExecutionUs\": %u,\n", stats.MaxExecutionUs);
+    printf("      \"overruns\": %u,\n", stats.Overruns);
+    printf("      \"cpuLoad\": %.4f,\n", seconds > 0.0 ? stats.TotalExecutionUs / (seconds * 1e6) : 0.0);
+    printf("      \"sos\": { \"runs\": %u, \"minExecutionUs\": %u, \"avgExecutionUs\": %u, \"maxExecutionUs\": %u, "
+        "\"deadlineMisses\": %u, \"load\": %.4f }\n", sosStats.Runs, sosStats.MinExecutionUs, sosStats.AvgExecutionUs,
+        sosStats.MaxExecutionUs, sosStats.DeadlineMisses, sosStats.Load / 10000.0);
+    printf("    }%s\n", last ? "" : ",");
+}
+
+static void benchUsage(const char* program)
+{
+    fprintf(stderr, "usage: %s [--seconds N] [--slowdown X] [--bodies N] [--physics MS] [--render MS] [--telemetry MS]\n", program);
+    fprintf(stderr, "  --seconds    simulated time to run (default: 10)\n");
+    fprintf(stderr, "  --slowdown   how many times slower than this PC the simulated CPU is (default: 1)\n");
+    fprintf(stderr, "  --bodies     circles in the scene (default: 150)\n");
+    fprintf(stderr, "  --physics    period of the physics task in ticks (ms), which is also its time step (default: 8)\n");
+    fprintf(stderr, "  --render     period of the render task in ticks (default: 33)\n");
+    fprintf(stderr, "  --telemetry  period of the telemetry task in ticks (default: 100)\n");
+}
+
+/**
+ * @brief Runs the physics, render and telemetry tasks under SOS on a simulated SysTick and prints their timing as JSON.
+ *
+ * The COTS STK driver, TMR timer service and SOS scheduler run unchanged on the PSIM host port. The
+ * physics task steps the scene by its period, the render task draws the changed areas of a 240x320
+ * TFT in RGB565 bands and the telemetry task sends a status line and the SOS task statistics through
+ * a stand-in UART. For each task the release latency, drift, jitter, execution time, overruns and
+ * CPU load measured by the port are reported, with the statistics SOS keeps itself and the number of
+ * CPU wakeups. The time of the simulated CPU is the CPU time of this process times --slowdown, so a
+ * slowdown of 10 models a CPU ten times slower than the PC; idle time is skipped, so the run is short.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line argument strings.
+ * @return 0 on success, 1 on a usage error, 2 if the scene could not be allocated or stepped.
+ */
+int main(int argc, char* argv[])
+{
+    int seconds = 10;
+    float slowdown = 1.0f;
+    int bodies = 150;
+    int physicsMs = 8;
+    int renderMs = 33;
+    int telemetryMs = 100;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            seconds = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--slowdown") == 0 && i + 1 < argc)
+        {
+            slowdown = (float)atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--bodies") == 0 && i + 1 < argc)
+        {
+            bodies = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--physics") == 0 && i + 1 < argc)
+        {
+            physicsMs = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--render") == 0 && i + 1 < argc)
+        {
+            renderMs = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc)
+        {
+            telemetryMs = atoi(argv[++i]);
+        }
+        else
+        {
+            benchUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (seconds <= 0 || slowdown <= 0.0f || bodies < 0 || physicsMs <= 0 || renderMs <= 0 || telemetryMs <= 0)
+    {
+        benchUsage(argv[0]);
+        return 1;
+    }
+
+    memset(&benchTasks, 0, sizeof(benchTasks));
+    benchTasks.stepSeconds = physicsMs / 1000.0f;
+    dirtyTrackerInit(&benchTasks.tracker);
+    SFB_voidDirtyInit(&benchTasks.dirty, BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT);
+    if (SFB_u8Init(&benchTasks.frameBuffer, benchTasks.bandPixels, BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT, BENCH_BAND_ROWS) != 0
+        || !simulationInit(&benchTasks.simulation, BROADPHASE_GRID, 1024))
+    {
+        return 2;
+    }
+    benchTasks.simulation.world.gravityY = BENCH_GRAVITY;
+    if (!benchBuildScene(&benchTasks.simulation, bodies) || PSIM_u8Init(slowdown) != 0)
+    {
+        simulationFree(&benchTasks.simulation);
+        return 2;
+    }
+
+    PSIM_u8CreateTask(BENCH_PHYSICS_TASK, (u32)physicsMs, benchPhysicsTask, 0);
+    PSIM_u8CreateTask(BENCH_RENDER_TASK, (u32)renderMs, benchRenderTask, 1);
+    PSIM_u8CreateTask(BENCH_TELEMETRY_TASK, (u32)telemetryMs, benchTelemetryTask, 2);
+    PSIM_voidStartScheduler();
+    PSIM_voidRun((u32)seconds * 1000);
+    PSIM_voidDeinit();
+
+    printf("{\n");
+    printf("  \"benchmark\": \"sos_bench\",\n");
+    printf("  \"seconds\": %d,\n", seconds);
+    printf("  \"slowdown\": %.2f,\n", slowdown);
+    printf("  \"bodies\": %d,\n", benchTasks.simulation.world.count);
+    printf("  \"wakeups\": %u,\n", PSIM_u32GetInterruptCount());
+    printf("  \"flushKbPerSecond\": %.2f,\n", benchFlushedPixels * sizeof(u16) / 1024.0 / seconds);
+    printf("  \"telemetryBytesPerSecond\": %.1f,\n", (double)benchTasks.telemetryBytes / seconds);
+    printf("  \"sosCpuLoad\": %.4f,\n", SOS_u16GetCpuLoad() / 10000.0);
+    printf("  \"tasks\": [\n");
+    benchPrintTask("physics", BENCH_PHYSICS_TASK, physicsMs, seconds, 0);
+    benchPrintTask("render", BENCH_RENDER_TASK, renderMs, seconds, 0);
+    benchPrintTask("telemetry", BENCH_TELEMETRY_TASK, telemetryMs, seconds, 1);
+    printf("  ]\n");
+    printf("}\n");
+
+    int status = benchTasks.failed ? 2 : 0;
+    dirtyTrackerFree(&benchTasks.tracker);
+    simulationFree(&benchTasks.simulation);
+    return status;
+}
@@ -56,6 +56,21 @@
  */
 #define STK_CTRL_TICKINT       STK_CTRL_TICKINT_ENABLE
 
+/**
+ * @brief Specifies where the driver runs.
+ *
+ * A host build passes -DSTK_PORT=STK_PORT_HOST and links the PSIM port, which backs the registers
+ * with a virtual clock so that the driver and the services above it run unchanged on a PC.
+ *
+ * @param STK_PORT_TARGET The SysTick of the STM32 (default).
+ * @param STK_PORT_HOST   The simulated SysTick of the PSIM host port.
+ *
+ * @retval None
+ */
+#ifndef STK_PORT
+#define STK_PORT               STK_PORT_TARGET
+#endif
+
 
 
 
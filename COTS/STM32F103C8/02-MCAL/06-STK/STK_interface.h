@@ -56,7 +56,7 @@ void MSTK_voidStop(void);
  * @brief Resets the SysTick timer.
  *
  * This function disables the SysTick timer, clears the current value, sets the reload value to 0,
- * and clears the count flag.
+ * and clears the count flag, including the one latched by MSTK_u8ReadCountFlag().
  *
  * @param None
  *
@@ -85,6 +85,7 @@ u32 MSTK_u32GetRemainingCounts(void);
  *
  * @note This function assumes that the SysTick timer is running and has not overflowed since it was last reset.
  * If the timer has overflowed, the elapsed ticks value will be incorrect and the function may return unexpected results.
+ * A counter at zero has not loaded the interval yet, or has just ended it and set the count flag: 0 is returned.
  *
  * @param None.
  * 
@@ -92,12 +93,41 @@ u32 MSTK_u32GetRemainingCounts(void);
  */
 u32 MSTK_u32GetElapsedCounts(void);
 
+/**
+ * @brief Reads and clears the count flag of the SysTick timer.
+ *
+ * The flag is set each time the counter reaches zero. It tells a caller timing code with
+ * MSTK_u32GetElapsedCounts() that the interval ended and the counter started again.
+ * Any read of the CTRL register clears the flag, so the driver latches it on every read it makes,
+ * such as the read-modify-writes of the interval functions and the check of the busy waits, and this
+ * function returns the latch. MSTK_voidReset() clears it.
+ *
+ * @param None.
+ *
+ * @return 1 if the counter reached zero since the flag was last cleared, 0 otherwise.
+ */
+u8 MSTK_u8ReadCountFlag(void);
+
+/**
+ * @brief Gets the number of SysTick counts in one microsecond.
+ *
+ * It follows the clock source chosen in STK_config.h, so a service converting the counts of
+ * MSTK_u32GetElapsedCounts() to time does not repeat that choice in its own configuration.
+ *
+ * @param None.
+ *
+ * @return The SysTick counts per microsecond: 1 with the 8 MHz clock divided by 8, 8 with the undivided clock.
+ */
+u32 MSTK_u32GetCountsPerUs(void);
+
 /**
  * @brief Blocks the CPU for the specified number of microseconds.
  *
  * This function blocks the CPU for the specified number of microseconds using the SysTick timer. The function calculates the
  * number of ticks required to wait for the specified number of microseconds based on the current system clock frequency and
  * the reload value of the SysTick timer.
+ * While SysTick runs an interval, such as the software timers of the TMR service, the function only
+ * reads the counter, so the interval and its callback are not disturbed.
  *
  * @param[in] Copy_u32Microseconds The number of microseconds to wait. This value should be less than or equal to 16777215 (0x00FFFFFF).
  *
@@ -112,6 +142,8 @@ void MSTK_voidSetBusyWait(u32 Copy_u32Microseconds);
  * This function blocks the CPU for the specified number of microseconds using the SysTick timer. The function calculates the
  * number of ticks required to wait for the specified number of microseconds based on the current system clock frequency and
  * the reload value of the SysTick timer.
+ * While SysTick runs an interval, such as the software timers of the TMR service, the function only
+ * reads the counter, so the interval and its callback are not disturbed.
  *
  * @param[in] Copy_u32Milliseconds The number of milliseconds to wait. This value should be less than or equal to 16777215 (0x00FFFFFF).
  *
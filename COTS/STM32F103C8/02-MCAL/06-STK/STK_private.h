@@ -27,7 +27,28 @@ typedef struct STK_RegDef_t{
   volatile u32 CALIB;
 } STK_RegDef_t;
 
-#define STK                     ((STK_RegDef_t *)STK_BASE_ADDRESS)
+/**
+ * @brief Specifies what the STK register block is.
+ *
+ * @param STK_PORT_TARGET The SysTick registers of the Cortex-M core.
+ * @param STK_PORT_HOST   Registers in RAM, counted down by the PSIM host port (05-PORT/SIM).
+ *
+ * CTRL is read with STK_READ_CTRL(), which clears COUNTFLAG like a read of the SysTick CTRL register does.
+ */
+#define STK_PORT_TARGET           0
+#define STK_PORT_HOST             1
+
+#if STK_PORT == STK_PORT_TARGET
+    #define STK                     ((STK_RegDef_t *)STK_BASE_ADDRESS)
+    #define STK_READ_CTRL()         (STK->CTRL)
+#elif STK_PORT == STK_PORT_HOST
+    extern STK_RegDef_t PSIM_sSTK;
+    u32 PSIM_u32ReadCtrl(void);
+    #define STK                     (&PSIM_sSTK)
+    #define STK_READ_CTRL()         PSIM_u32ReadCtrl()
+#else
+    #error "WRONG CHOICE FOR STK_PORT"
+#endif
 
 /*********************< The following are defines for the bit fields in the STK_CTRL register. **********************/
 #define STK_CTRL_ENABLE_MASK               0x00000001      /**< Bit 0 : Counter Enable */
@@ -89,6 +110,14 @@ typedef struct STK_RegDef_t{
     #error "You chose a wrong clock source for the SysTick"
 #endif
 
+/**
+ * @brief The SysTick counts in one microsecond.
+ *
+ * Intervals are converted with this factor rather than with STK_AHB_CLK / 1000000 applied after
+ * the multiplication, which overflows 32 bits for intervals above 4294 microseconds.
+ */
+#define STK_COUNTS_PER_US     (STK_AHB_CLK / 1000000)
+
 
 #endif /**< __STK_PRIVATE_H__ */
 
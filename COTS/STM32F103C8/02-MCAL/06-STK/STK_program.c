@@ -23,26 +23,47 @@
 static void (*STK_pfCallback)(void) = NULL;
 /**< Define Variable for interval mode */
 static u8 MSTK_u8ModeOfInterval;
+/**< COUNTFLAG seen by a read of CTRL, kept until MSTK_u8ReadCountFlag() or MSTK_voidReset() */
+static volatile u8 MSTK_u8CountFlag = 0;
+
+/**
+ * @brief Reads CTRL, latching COUNTFLAG into MSTK_u8CountFlag.
+ *
+ * Reading CTRL clears COUNTFLAG, so every read of the driver goes through this function and the
+ * flag is not lost to the read-modify-writes of the other functions. The value is returned with
+ * COUNTFLAG cleared, so writing it back does not set the flag again on the host port.
+ */
+static u32 MSTK_u32ReadCtrl(void);
+
+/**
+ * @brief Blocks the CPU for a number of SysTick counts.
+ *
+ * While SysTick is stopped, it is loaded with the counts and polled until it reaches zero. While
+ * it runs an interval, of the software timers or of an application, the counter is only read and
+ * the counts it moves down are added up, so the wait neither reprograms the interval nor loses
+ * its interrupt.
+ */
+static void MSTK_voidWaitCounts(u32 Copy_u32Counts);
 
 void MSTK_voidInit(void)
 {
     /**< Disable SysTick timer */
-    STK->CTRL &= ~STK_CTRL_ENABLE_MASK;
+    STK->CTRL = MSTK_u32ReadCtrl() & ~STK_CTRL_ENABLE_MASK;
 
     /**< Configure SysTick timer to use the processor clock */
     #if STK_CTRL_CLKSOURCE == STK_CTRL_CLKSOURCE_1
-        STK -> CTRL |= STK_CTRL_CLKSOURCE_MASK;             /**< Set bit 2 to use the processor clock */
+        STK->CTRL = MSTK_u32ReadCtrl() | STK_CTRL_CLKSOURCE_MASK;     /**< Set bit 2 to use the processor clock */
     #elif STK_CTRL_CLKSOURCE == STK_CTRL_CLKSOURCE_8
-        STK->CTRL &= ~STK_CTRL_CLKSOURCE_MASK;             /**< Clear bit 2 to use the processor clock/8 */
+        STK->CTRL = MSTK_u32ReadCtrl() & ~STK_CTRL_CLKSOURCE_MASK;    /**< Clear bit 2 to use the processor clock/8 */
     #else 
         #error "WRONG CHOICE FOR SYSTICK CLOCK SOURCE"
     #endif
 
     /**< Generate interrupt when it reaches zero */
     #if STK_CTRL_TICKINT == STK_CTRL_TICKINT_ENABLE
-        STK->CTRL |= STK_CTRL_TICKINT_MASK;      /**< Set bit 1 to enable interrupt when the counter reaches zero */
+        STK->CTRL = MSTK_u32ReadCtrl() | STK_CTRL_TICKINT_MASK;       /**< Set bit 1 to enable interrupt when the counter reaches zero */
     #elif STK_CTRL_TICKINT == STK_CTRL_TICKINT_DISABLE
-        STK->CTRL &= ~STK_CTRL_TICKINT_MASK;      /**< Clear bit 1 to enable interrupt when the counter reaches zero */
+        STK->CTRL = MSTK_u32ReadCtrl() & ~STK_CTRL_TICKINT_MASK;      /**< Clear bit 1 to enable interrupt when the counter reaches zero */
     #else
         #error "WRONG OPTION"
     #endif
@@ -51,13 +72,13 @@ void MSTK_voidInit(void)
 void MSTK_voidStart(void)
 {
     /* Start the SysTick timer */
-    STK->CTRL |= STK_CTRL_ENABLE_MASK;
+    STK->CTRL = MSTK_u32ReadCtrl() | STK_CTRL_ENABLE_MASK;
 }
 
 void MSTK_voidStop(void)
 {
     /* Stop the SysTick timer */
-    STK->CTRL &= ~STK_CTRL_ENABLE_MASK;
+    STK->CTRL = MSTK_u32ReadCtrl() & ~STK_CTRL_ENABLE_MASK;
 }
 
 void MSTK_voidReset(void)
@@ -68,8 +89,8 @@ void MSTK_voidReset(void)
     STK->VAL = 0;
     /**< Set the reload value to 0 */
     STK->LOAD = 0;
-    /**< Clear the count/interrupt flag */
-    STK->CTRL &= ~STK_CTRL_COUNTFLAG_MASK;
+    /**< Writing VAL cleared the count flag; drop the one latched for the interval that was reset too */
+    MSTK_u8CountFlag = 0;
 }
 
 
@@ -81,22 +102,40 @@ u32 MSTK_u32GetRemainingCounts(void)
 
 u32 MSTK_u32GetElapsedCounts(void)
 {
-    /* Calculate the number of elapsed ticks */
-    u32 Local_u32ElapsedTicks = ((STK->LOAD + 1) - (STK->VAL));
+    u32 Local_u32ElapsedTicks = 0;
+    u32 Local_u32Value = STK->VAL;
+
+    /* Calculate the number of elapsed ticks: a counter at zero has not started counting the interval */
+    if(Local_u32Value != 0)
+    {
+        Local_u32ElapsedTicks = ((STK->LOAD + 1) - Local_u32Value);
+    }
 
     return Local_u32ElapsedTicks;
 }
 
+u8 MSTK_u8ReadCountFlag(void)
+{
+    /**< Latch the flag CTRL holds now, then hand over the latch */
+    (void)MSTK_u32ReadCtrl();
+    u8 Local_u8Flag = MSTK_u8CountFlag;
+    MSTK_u8CountFlag = 0;
+
+    return Local_u8Flag;
+}
+
+u32 MSTK_u32GetCountsPerUs(void)
+{
+    return STK_COUNTS_PER_US;
+}
+
 void MSTK_voidSetBusyWait(u32 Copy_u32Microseconds)
 {
     /**< Calculate the number of ticks required to wait for the specified number of microseconds */
-    u32 Local_u32Ticks = (Copy_u32Microseconds * STK_AHB_CLK) / 1000000;
+    u32 Local_u32Ticks = Copy_u32Microseconds * STK_COUNTS_PER_US;
 
     /**< Wait for the specified number of ticks using the SysTick timer */
-    STK->LOAD = Local_u32Ticks;
-    STK->CTRL |= STK_CTRL_ENABLE_MASK;              /**< Enable SysTick timer */
-    while (!(STK->CTRL & STK_CTRL_COUNTFLAG_MASK)); /**< Wait until the SysTick timer reach to zero */
-    STK->CTRL &= ~STK_CTRL_ENABLE_MASK;             /**< Disable SysTick timer */
+    MSTK_voidWaitCounts(Local_u32Ticks);
 }
 
 void MSTK_voidSetDelayMs(f32 Copy_u32Milliseconds)
@@ -105,10 +144,7 @@ void MSTK_voidSetDelayMs(f32 Copy_u32Milliseconds)
     u32 Local_u32Ticks = (Copy_u32Milliseconds * STK_AHB_CLK) / 1000.0;
 
     /**< Wait for the specified number of ticks using the SysTick timer */
-    STK->LOAD = Local_u32Ticks;
-    STK->CTRL |= STK_CTRL_ENABLE_MASK;              /**< Enable SysTick timer */
-    while (!(STK->CTRL & STK_CTRL_COUNTFLAG_MASK)); /**< Wait until the SysTick timer reach to zero */
-    STK->CTRL &= ~STK_CTRL_ENABLE_MASK;             /**< Disable SysTick timer */
+    MSTK_voidWaitCounts(Local_u32Ticks);
 }
 
 
@@ -120,17 +156,16 @@ void MSTK_voidSetIntervalSingle(u32 Copy_u32Microseconds, void (*Copy_pfCallback
         STK_pfCallback = Copy_pfCallback;
     
         /* Calculate the number of ticks required to wait for the specified number of microseconds */
-        u32 Local_u32Ticks = (Copy_u32Microseconds * STK_AHB_CLK) / 1000000;
+        u32 Local_u32Ticks = Copy_u32Microseconds * STK_COUNTS_PER_US;
     
-        /* Set the reload value for the SysTick timer */
-        STK->LOAD = Local_u32Ticks;
+        /* Set the reload value for the SysTick timer: it counts LOAD + 1 clocks from one zero to the next */
+        STK->LOAD = (Local_u32Ticks > 0) ? (Local_u32Ticks - 1) : 0;
 
         /**< Set the Mode of interval to be single */
         MSTK_u8ModeOfInterval = MSTK_SINGLE_INTERVAL;
 
         /* Start the SysTick timer and enable the interrupt */
-        STK->CTRL |= STK_CTRL_ENABLE_MASK;
-        STK->CTRL |= STK_CTRL_TICKINT_MASK; 
+        STK->CTRL = MSTK_u32ReadCtrl() | STK_CTRL_ENABLE_MASK | STK_CTRL_TICKINT_MASK;
     }
     else
     {
@@ -147,17 +182,16 @@ void MSTK_voidSetIntervalPeriodic(u32 Copy_u32Microseconds, void (*Copy_pfCallba
         STK_pfCallback = Copy_pfCallback;
 
         /* Calculate the number of ticks required to wait for the specified number of microseconds */
-        u32 Local_u32Ticks = (Copy_u32Microseconds * STK_AHB_CLK) / 1000000;
+        u32 Local_u32Ticks = Copy_u32Microseconds * STK_COUNTS_PER_US;
 
-        /**< Set the reload value for the SysTick timer */
-        STK->LOAD = Local_u32Ticks;
+        /**< Set the reload value for the SysTick timer: it counts LOAD + 1 clocks from one zero to the next */
+        STK->LOAD = (Local_u32Ticks > 0) ? (Local_u32Ticks - 1) : 0;
 
         /**< Set the Mode of interval to be periodic */
         MSTK_u8ModeOfInterval = MSTK_PERIOD_INTERVAL;
 
         /**< Start the SysTick timer */
-        STK->CTRL |= STK_CTRL_ENABLE_MASK;
-        STK->CTRL |= STK_CTRL_TICKINT_MASK;
+        STK->CTRL = MSTK_u32ReadCtrl() | STK_CTRL_ENABLE_MASK | STK_CTRL_TICKINT_MASK;
     }
     else
     {
@@ -165,6 +199,48 @@ void MSTK_voidSetIntervalPeriodic(u32 Copy_u32Microseconds, void (*Copy_pfCallba
     }
 }
 
+static u32 MSTK_u32ReadCtrl(void)
+{
+    u32 Local_u32Ctrl = STK_READ_CTRL();
+    if(Local_u32Ctrl & STK_CTRL_COUNTFLAG_MASK)
+    {
+        MSTK_u8CountFlag = 1;
+    }
+    return Local_u32Ctrl & ~STK_CTRL_COUNTFLAG_MASK;
+}
+
+static void MSTK_voidWaitCounts(u32 Copy_u32Counts)
+{
+    if(MSTK_u32ReadCtrl() & STK_CTRL_ENABLE_MASK)
+    {
+        /**< SysTick runs an interval someone programmed: count its clocks down without touching it */
+        u32 Local_u32Elapsed = 0;
+        u32 Local_u32Previous = STK->VAL;
+        while(Local_u32Elapsed < Copy_u32Counts)
+        {
+            u32 Local_u32Value = STK->VAL;
+            if(Local_u32Value <= Local_u32Previous)
+            {
+                Local_u32Elapsed += Local_u32Previous - Local_u32Value;
+            }
+            else
+            {
+                /**< The counter reached zero and reloaded from LOAD */
+                Local_u32Elapsed += Local_u32Previous + ((STK->LOAD + 1) - Local_u32Value);
+            }
+            Local_u32Previous = Local_u32Value;
+        }
+    }
+    else
+    {
+        STK->LOAD = Copy_u32Counts;
+        STK->CTRL = MSTK_u32ReadCtrl() | STK_CTRL_ENABLE_MASK;        /**< Enable SysTick timer */
+        /**< Wait until the SysTick timer reach to zero; the flag ends this wait, it is not latched */
+        while (!(STK_READ_CTRL() & STK_CTRL_COUNTFLAG_MASK));
+        STK->CTRL = MSTK_u32ReadCtrl() & ~STK_CTRL_ENABLE_MASK;       /**< Disable SysTick timer */
+    }
+}
+
 void SysTick_Handler(void)
 {
     /**< Call the callback function */
@@ -174,11 +250,8 @@ void SysTick_Handler(void)
         {
             MSTK_voidReset();
         }
-        /**< Callback notification */
+        /**< Callback notification; the count flag stays for MSTK_u8ReadCountFlag() to read */
         STK_pfCallback();
-
-         /**< Clear the count/interrupt flag */
-        STK->CTRL &= ~STK_CTRL_COUNTFLAG_MASK;
     }
 }
 
@@ -32,6 +32,19 @@
  */
 #define LEDMTRX_NUM_COLS 8
 
+/**
+ * @brief The time each column is lit by HLEDMTRX_voidDisplayTask(), in milliseconds.
+ *
+ * The whole matrix is refreshed every LEDMTRX_NUM_COLS times this. The coroutine waits in SOS
+ * ticks, so the 2.5 ms of HLEDMTRX_voidDisplay() becomes 2 ms, a 62.5 Hz refresh for 8 columns.
+ */
+#define LEDMTRX_COL_TIME_MS              2
+
+/**
+ * @brief The time the last column stays lit before HLEDMTRX_voidDisplayTask() shifts the data, in milliseconds.
+ */
+#define LEDMTRX_SHIFT_DELAY_MS           500
+
 
 
 /**
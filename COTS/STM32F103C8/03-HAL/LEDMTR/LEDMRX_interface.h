@@ -10,6 +10,12 @@
  */
 #ifndef __LEDMATRIX_INTERFACE_H__
 #define __LEDMATRIX_INTERFACE_H__
+
+/**
+ * @brief The coroutine context of SOS, declared here so that this header does not need the OS headers.
+ */
+struct SOS_Coroutine_t;
+
 /**
  * @brief Turn on an LED at a specific row and column in the LED matrix.
  * 
@@ -60,10 +66,44 @@ void HLEDMTRX_voidInit(void);
  *
  * @param Copy_pau8Data Pointer to an array of 8 bytes representing the data for each column.
  *
+ * @note The function busy-waits 2.5 ms per column and 500 ms after the shift. Under SOS, run
+ * HLEDMTRX_voidDisplayTask() instead, which lets the other tasks run meanwhile.
+ *
  * @return void
  */
 void HLEDMTRX_voidDisplay(u8 *Copy_pau8Data);
 
+/**
+ * @brief Sets the data HLEDMTRX_voidDisplayTask() displays.
+ *
+ * @param Copy_pau8Data Pointer to an array of 8 bytes representing the data for each column. It is
+ *                      shifted in place and must stay valid while the task runs. NULL stops the task.
+ *
+ * @return None.
+ */
+void HLEDMTRX_voidSetDisplayData(u8 *Copy_pau8Data);
+
+/**
+ * @brief Displays the data of HLEDMTRX_voidSetDisplayData() as an SOS coroutine task.
+ *
+ * The task does what HLEDMTRX_voidDisplay() does in a loop: it lights each column for
+ * LEDMTRX_COL_TIME_MS, shifts the data to the left and keeps the last column lit for
+ * LEDMTRX_SHIFT_DELAY_MS. It waits with SOS_WAIT_MS() instead of blocking, so each run only sets
+ * the pins of one column and the other tasks run during the waits. Once the data is set back to
+ * NULL, the task turns the columns off and ends.
+ *
+ * @code
+ * HLEDMTRX_voidInit();
+ * HLEDMTRX_voidSetDisplayData(App_au8Letter);
+ * SOS_u8CreateCoroutine(2, HLEDMTRX_voidDisplayTask, 0);
+ * @endcode
+ *
+ * @param Copy_psTask The coroutine context SOS passes.
+ *
+ * @return None.
+ */
+void HLEDMTRX_voidDisplayTask(struct SOS_Coroutine_t *Copy_psTask);
+
 /**
  * @brief Set the state of an LED at a specific row and column in the LED matrix.
  * 
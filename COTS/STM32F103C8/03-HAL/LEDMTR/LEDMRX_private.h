@@ -18,6 +18,23 @@ static void HLEDMTRX_voidDisableAllCols(void);
 
 static void HLEDMTRX_voidSetRowValues(u8 Copy_u8Value);
 
+/**
+ * @brief Enables one column of the LED matrix.
+ *
+ * @param Copy_u8Col The column number (0-indexed).
+ */
+static void HLEDMTRX_voidEnableCol(u8 Copy_u8Col);
+
+/**
+ * @brief The data HLEDMTRX_voidDisplayTask() displays, NULL until it is set.
+ */
+static u8 *HLEDMTRX_pu8DisplayData = NULL;
+
+/**
+ * @brief The column HLEDMTRX_voidDisplayTask() lights, kept across its waits.
+ */
+static u8 HLEDMTRX_u8DisplayCol = 0;
+
 /*****************************< Concatenate function *****************************/
 #define Conc(NUM)			Conc_Help(NUM)
 #define Conc_Help(NUM)		LEDMTRX_COL##NUM##_PIN
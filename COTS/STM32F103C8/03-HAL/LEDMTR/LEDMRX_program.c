@@ -14,6 +14,9 @@
 /*********************< MCAL *********************/
 #include "GPIO_interface.h"
 #include "STK_interface.h"
+/*********************< SERVICES *********************/
+#include "OS_config.h"
+#include "OS_interface.h"
 /*********************< HAL *********************/
 #include "LEDMRX_private.h"
 #include "LEDMRX_interface.h"
@@ -139,6 +142,62 @@ void HLEDMTRX_voidDisplay(u8 *Copy_pau8Data)
   MSTK_voidSetDelayMs(500);
 }
 
+void HLEDMTRX_voidSetDisplayData(u8 *Copy_pau8Data)
+{
+  HLEDMTRX_pu8DisplayData = Copy_pau8Data;
+}
+
+void HLEDMTRX_voidDisplayTask(SOS_Coroutine_t *Copy_psTask)
+{
+  SOS_BEGIN(Copy_psTask);
+  /**< Nothing to display yet: check again on the next tick */
+  while(HLEDMTRX_pu8DisplayData == NULL)
+  {
+    SOS_YIELD(Copy_psTask);
+  }
+  /**< Display until the data is set back to NULL */
+  while(HLEDMTRX_pu8DisplayData != NULL)
+  {
+    for(HLEDMTRX_u8DisplayCol = 0; HLEDMTRX_u8DisplayCol < LEDMTRX_NUM_COLS && HLEDMTRX_pu8DisplayData != NULL; HLEDMTRX_u8DisplayCol++)
+    {
+      /**< Disable All Columns */
+      HLEDMTRX_voidDisableAllCols();
+      /**< Display the Column Data */
+      HLEDMTRX_voidSetRowValues(HLEDMTRX_pu8DisplayData[HLEDMTRX_u8DisplayCol]);
+      /**< Enable the Column */
+      HLEDMTRX_voidEnableCol(HLEDMTRX_u8DisplayCol);
+      /**< Let the other tasks run while the column is lit */
+      SOS_WAIT_MS(Copy_psTask, LEDMTRX_COL_TIME_MS);
+    }
+    if(HLEDMTRX_pu8DisplayData != NULL)
+    {
+      /****************************< Shift left the data ****************************/
+      HLEDMTRX_voidShiftLeft(HLEDMTRX_pu8DisplayData);
+      SOS_WAIT_MS(Copy_psTask, LEDMTRX_SHIFT_DELAY_MS);
+    }
+  }
+  /**< Turn the matrix off before the task ends */
+  HLEDMTRX_voidDisableAllCols();
+  SOS_END(Copy_psTask);
+}
+
+
+static void HLEDMTRX_voidEnableCol(u8 Copy_u8Col)
+{
+  switch(Copy_u8Col)
+  {
+    case 0: MGPIO_voidSetPinValue(LEDMTRX_COL0_PIN,MGPIO_LOW); break;
+    case 1: MGPIO_voidSetPinValue(LEDMTRX_COL1_PIN,MGPIO_LOW); break;
+    case 2: MGPIO_voidSetPinValue(LEDMTRX_COL2_PIN,MGPIO_LOW); break;
+    case 3: MGPIO_voidSetPinValue(LEDMTRX_COL3_PIN,MGPIO_LOW); break;
+    case 4: MGPIO_voidSetPinValue(LEDMTRX_COL4_PIN,MGPIO_LOW); break;
+    case 5: MGPIO_voidSetPinValue(LEDMTRX_COL5_PIN,MGPIO_LOW); break;
+    case 6: MGPIO_voidSetPinValue(LEDMTRX_COL6_PIN,MGPIO_LOW); break;
+    case 7: MGPIO_voidSetPinValue(LEDMTRX_COL7_PIN,MGPIO_LOW); break;
+    default: /**< Not a column of the matrix */ break;
+  }
+}
+
 
 static void HLEDMTRX_voidDisableAllCols(void)
 {
@@ -0,0 +1,55 @@
+/**
+ * @file FB_config.h
+ * @brief This file contains the configuration options for the frame buffer rasterizer module.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#ifndef __FB_CONFIG_H__
+#define __FB_CONFIG_H__
+
+
+/**
+ * @brief Selects the loop used to fill pixel spans.
+ *
+ * @param SFB_SPAN_LOOP_AUTO      SSE2 when the compiler targets it, NEON when it targets it, portable otherwise.
+ * @param SFB_SPAN_LOOP_PORTABLE  Plain C, two pixels per 32-bit store (the choice for Cortex-M3).
+ * @param SFB_SPAN_LOOP_SSE2      Eight pixels per 128-bit store (x86 PC preview).
+ * @param SFB_SPAN_LOOP_NEON      Eight pixels per 128-bit store (ARM PC preview, Cortex-A).
+ */
+#define SFB_SPAN_LOOP               SFB_SPAN_LOOP_AUTO
+
+/**
+ * @brief Selects the byte order of the pixels stored in the frame buffer.
+ *
+ * SPI TFT controllers take each RGB565 pixel high byte first. Storing the pixels byte swapped on
+ * a little-endian MCU lets a band be sent to the display as a plain byte stream (for example by DMA)
+ * without converting it. Colors passed to the drawing functions are always plain RGB565; images
+ * passed to SFB_voidBlit() must already be in the selected order.
+ *
+ * @param SFB_PIXEL_ORDER_NATIVE   Pixels in the CPU byte order (PC preview, parallel bus displays).
+ * @param SFB_PIXEL_ORDER_SWAPPED  Pixels with their two bytes swapped (SPI displays on little-endian MCUs).
+ */
+#define SFB_PIXEL_ORDER             SFB_PIXEL_ORDER_NATIVE
+
+/**
+ * @brief Largest number of separate rectangles a dirty region keeps.
+ *
+ * Every rectangle costs one address window on the display. When a new one does not fit, it is
+ * merged with the rectangle whose bounding box grows the least.
+ */
+#define SFB_DIRTY_MAX_RECTS         8
+
+/**
+ * @brief Dirty rectangles closer than this many pixels are merged into one.
+ *
+ * Setting an address window costs a few command bytes, so sending a few background pixels
+ * between two close rectangles is cheaper than a second window.
+ */
+#define SFB_DIRTY_MERGE_GAP         4
+
+
+
+
+#endif /**< __FB_CONFIG_H__ */
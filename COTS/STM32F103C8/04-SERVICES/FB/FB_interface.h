@@ -0,0 +1,317 @@
+/**
+ * @file FB_interface.h
+ * @brief This file contains the public interface of the frame buffer rasterizer module.
+ *
+ * The module draws into an RGB565 buffer of u16 pixels in plain C, so the same drawing code runs on
+ * the MCU, where the buffer is sent to the TFT, and on the PC, where it is uploaded to a texture.
+ *
+ * A full 240x320 frame takes 150 KB and the STM32F103C8 has 20 KB of RAM, so the buffer holds a
+ * horizontal band of the screen. A frame is drawn once per band: every drawing call takes screen
+ * coordinates and only writes the pixels that fall in the current band. On the PC the band can be
+ * as tall as the screen, which makes one pass per frame.
+ *
+ * When only a few objects move, only the parts of the screen they covered need to be sent. The
+ * application adds the old and new bounds of every moved object to an SFB_DirtyRegion_t and draws
+ * each of its rectangles instead of the whole frame; every band is then flushed with the address
+ * window it covers, so the display only receives the changed pixels.
+ *
+ * @code
+ * SFB_voidBeginFrame(&Local_sFrameBuffer, COLOR_BLACK);
+ * do
+ * {
+ *     SFB_voidFillCircle(&Local_sFrameBuffer, 120, 160, 20, COLOR_RED);
+ * } while (SFB_u8EndBand(&Local_sFrameBuffer, TFT_voidDisplayImage) == 1);
+ * @endcode
+ *
+ * @code
+ * for (u8 Local_u8Rect = 0; Local_u8Rect < Local_sDirty.Count; Local_u8Rect++)
+ * {
+ *     SFB_voidBeginRegion(&Local_sFrameBuffer, &Local_sDirty.Rects[Local_u8Rect], COLOR_BLACK);
+ *     do
+ *     {
+ *         SFB_voidFillCircle(&Local_sFrameBuffer, 120, 160, 20, COLOR_RED);
+ *     } while (SFB_u8EndBand(&Local_sFrameBuffer, TFT_voidDisplayImage) == 1);
+ * }
+ * SFB_voidDirtyClear(&Local_sDirty);
+ * @endcode
+ *
+ * The FB_config.h header must be included before this header.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+
+#ifndef __FB_INTERFACE_H__
+#define __FB_INTERFACE_H__
+
+
+/**
+ * @brief Receives a finished band, for example TFT_voidDisplayImage().
+ *
+ * @param[in]  Copy_u16X        Screen X-coordinate of the first column of the band.
+ * @param[in]  Copy_u16Y        Screen Y-coordinate of the first row of the band.
+ * @param[in]  Copy_pu16Pixels  Pixels of the band, row after row, Copy_u16Width pixels per row.
+ * @param[in]  Copy_u16Width    Width of the band in pixels.
+ * @param[in]  Copy_u16Height   Number of rows in the band.
+ */
+typedef void (*SFB_Flush_t)(u16 Copy_u16X, u16 Copy_u16Y, const u16* Copy_pu16Pixels, u16 Copy_u16Width, u16 Copy_u16Height);
+
+/**
+ * @brief A rectangle of screen pixels.
+ */
+typedef struct
+{
+    u16 X;                  /**< Screen column of the left edge. */
+    u16 Y;                  /**< Screen row of the top edge. */
+    u16 Width;              /**< Width in pixels. */
+    u16 Height;             /**< Height in pixels. */
+} SFB_Rect_t;
+
+/**
+ * @brief A band of an RGB565 screen.
+ *
+ * The band covers Columns x Rows pixels of the region being drawn, stored row after row. A region
+ * narrower than the screen fits more rows in the same storage, so it takes fewer bands.
+ */
+typedef struct
+{
+    u16* Pixels;            /**< Band storage, Width * BandHeight pixels supplied by the application. */
+    u16 Width;              /**< Screen width in pixels. */
+    u16 ScreenHeight;       /**< Screen height in pixels. */
+    u16 BandHeight;         /**< Rows of the full screen width the storage holds. */
+    u16 OriginX;            /**< Screen column of the first column of the current band. */
+    u16 OriginY;            /**< Screen row of the first row of the current band. */
+    u16 Columns;            /**< Columns of the current band, the width of the region being drawn. */
+    u16 Rows;               /**< Rows of the current band (fewer for the last band of a region). */
+    u16 RegionBottom;       /**< Screen row just below the region being drawn. */
+    u16 Background;         /**< Color every band is cleared to, in the stored pixel order. */
+} SFB_FrameBuffer_t;
+
+/**
+ * @brief The parts of the screen that changed since they were last sent.
+ */
+typedef struct
+{
+    SFB_Rect_t Rects[SFB_DIRTY_MAX_RECTS];  /**< Disjoint rectangles, clipped to the screen. */
+    u8 Count;                               /**< Number of rectangles in use. */
+    u16 ScreenWidth;                        /**< Screen width the rectangles are clipped to. */
+    u16 ScreenHeight;                       /**< Screen height the rectangles are clipped to. */
+} SFB_DirtyRegion_t;
+
+
+/**
+ * @brief Attaches the band storage to a frame buffer.
+ *
+ * @param[out] Copy_psFrameBuffer   The frame buffer to initialize.
+ * @param[in]  Copy_pu16Pixels      Storage for Copy_u16Width * Copy_u16BandHeight pixels.
+ * @param[in]  Copy_u16Width        Screen width in pixels.
+ * @param[in]  Copy_u16ScreenHeight Screen height in pixels.
+ * @param[in]  Copy_u16BandHeight   Rows the storage holds (Copy_u16ScreenHeight for a full frame buffer).
+ *
+ * @retval     0                    The frame buffer was initialized successfully.
+ * @retval     1                    A pointer is NULL or a size is 0.
+ */
+u8 SFB_u8Init(SFB_FrameBuffer_t* Copy_psFrameBuffer, u16* Copy_pu16Pixels, u16 Copy_u16Width, u16 Copy_u16ScreenHeight, u16 Copy_u16BandHeight);
+
+/**
+ * @brief Starts a frame on the top band and clears it.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_u16Background   RGB565 color every band of the frame starts with.
+ *
+ * @retval     None
+ */
+void SFB_voidBeginFrame(SFB_FrameBuffer_t* Copy_psFrameBuffer, u16 Copy_u16Background);
+
+/**
+ * @brief Starts drawing a part of the screen, on the top band of that part, and clears it.
+ *
+ * Drawing calls take screen coordinates as usual and only write the pixels inside the region.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_psRegion        The part of the screen to draw; it is clipped to the screen.
+ * @param[in]  Copy_u16Background   RGB565 color every band of the region starts with.
+ *
+ * @retval     None
+ */
+void SFB_voidBeginRegion(SFB_FrameBuffer_t* Copy_psFrameBuffer, const SFB_Rect_t* Copy_psRegion, u16 Copy_u16Background);
+
+/**
+ * @brief Sends the current band and moves to the next one.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_pfFlush         Receives the finished band.
+ *
+ * @retval     1                    Another band was started and cleared: the frame must be drawn again.
+ * @retval     0                    The frame, or the region, is complete.
+ */
+u8 SFB_u8EndBand(SFB_FrameBuffer_t* Copy_psFrameBuffer, SFB_Flush_t Copy_pfFlush);
+
+/**
+ * @brief Fills the current band with one color.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_u16Color        RGB565 color.
+ *
+ * @retval     None
+ */
+void SFB_voidClear(SFB_FrameBuffer_t* Copy_psFrameBuffer, u16 Copy_u16Color);
+
+/**
+ * @brief Draws one pixel.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_s16X            Screen X-coordinate.
+ * @param[in]  Copy_s16Y            Screen Y-coordinate.
+ * @param[in]  Copy_u16Color        RGB565 color.
+ *
+ * @retval     None
+ */
+void SFB_voidDrawPixel(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X, s16 Copy_s16Y, u16 Copy_u16Color);
+
+/**
+ * @brief Fills a horizontal run of pixels.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_s16X            Screen X-coordinate of the first pixel.
+ * @param[in]  Copy_s16Y            Screen Y-coordinate of the span.
+ * @param[in]  Copy_s16Length       Number of pixels.
+ * @param[in]  Copy_u16Color        RGB565 color.
+ *
+ * @retval     None
+ */
+void SFB_voidFillSpan(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X, s16 Copy_s16Y, s16 Copy_s16Length, u16 Copy_u16Color);
+
+/**
+ * @brief Fills an axis-aligned rectangle.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_s16X            Screen X-coordinate of the left edge.
+ * @param[in]  Copy_s16Y            Screen Y-coordinate of the top edge.
+ * @param[in]  Copy_s16Width        Width in pixels.
+ * @param[in]  Copy_s16Height       Height in pixels.
+ * @param[in]  Copy_u16Color        RGB565 color.
+ *
+ * @retval     None
+ */
+void SFB_voidFillRect(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X, s16 Copy_s16Y, s16 Copy_s16Width, s16 Copy_s16Height, u16 Copy_u16Color);
+
+/**
+ * @brief Draws a one pixel line with Bresenham's algorithm, both end points included.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_s16X0           Screen X-coordinate of the start point.
+ * @param[in]  Copy_s16Y0           Screen Y-coordinate of the start point.
+ * @param[in]  Copy_s16X1           Screen X-coordinate of the end point.
+ * @param[in]  Copy_s16Y1           Screen Y-coordinate of the end point.
+ * @param[in]  Copy_u16Color        RGB565 color.
+ *
+ * @retval     None
+ */
+void SFB_voidDrawLine(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X0, s16 Copy_s16Y0, s16 Copy_s16X1, s16 Copy_s16Y1, u16 Copy_u16Color);
+
+/**
+ * @brief Draws a one pixel circle outline, the same pixels as drawCircle() of the physics engine.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_s16CenterX      Screen X-coordinate of the center.
+ * @param[in]  Copy_s16CenterY      Screen Y-coordinate of the center.
+ * @param[in]  Copy_s16Radius       Radius in pixels.
+ * @param[in]  Copy_u16Color        RGB565 color.
+ *
+ * @retval     None
+ */
+void SFB_voidDrawCircle(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16CenterX, s16 Copy_s16CenterY, s16 Copy_s16Radius, u16 Copy_u16Color);
+
+/**
+ * @brief Fills a disc, one span per row, with the pixels within half a pixel outside the radius.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_s16CenterX      Screen X-coordinate of the center.
+ * @param[in]  Copy_s16CenterY      Screen Y-coordinate of the center.
+ * @param[in]  Copy_s16Radius       Radius in pixels.
+ * @param[in]  Copy_u16Color        RGB565 color.
+ *
+ * @retval     None
+ */
+void SFB_voidFillCircle(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16CenterX, s16 Copy_s16CenterY, s16 Copy_s16Radius, u16 Copy_u16Color);
+
+/**
+ * @brief Fills a convex polygon, one span per row, sampling each row at its pixel centers.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_ps16X           Screen X-coordinates of the vertices, in order around the polygon.
+ * @param[in]  Copy_ps16Y           Screen Y-coordinates of the vertices.
+ * @param[in]  Copy_u8Count         Number of vertices (at least 3).
+ * @param[in]  Copy_u16Color        RGB565 color.
+ *
+ * @retval     None
+ */
+void SFB_voidFillPolygon(SFB_FrameBuffer_t* Copy_psFrameBuffer, const s16* Copy_ps16X, const s16* Copy_ps16Y, u8 Copy_u8Count, u16 Copy_u16Color);
+
+/**
+ * @brief Copies an image into the frame buffer, clipped to the screen and the band.
+ *
+ * @param[in]  Copy_psFrameBuffer   The frame buffer.
+ * @param[in]  Copy_s16X            Screen X-coordinate of the left edge of the image.
+ * @param[in]  Copy_s16Y            Screen Y-coordinate of the top edge of the image.
+ * @param[in]  Copy_pu16Image       Pixels of the image, row after row, in the stored pixel order.
+ * @param[in]  Copy_u16Width        Width of the image in pixels.
+ * @param[in]  Copy_u16Height       Height of the image in pixels.
+ *
+ * @retval     None
+ */
+void SFB_voidBlit(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X, s16 Copy_s16Y, const u16* Copy_pu16Image, u16 Copy_u16Width, u16 Copy_u16Height);
+
+
+/**
+ * @brief Empties a dirty region and sets the screen size its rectangles are clipped to.
+ *
+ * @param[out] Copy_psDirty         The dirty region to initialize.
+ * @param[in]  Copy_u16ScreenWidth  Screen width in pixels.
+ * @param[in]  Copy_u16ScreenHeight Screen height in pixels.
+ *
+ * @retval     None
+ */
+void SFB_voidDirtyInit(SFB_DirtyRegion_t* Copy_psDirty, u16 Copy_u16ScreenWidth, u16 Copy_u16ScreenHeight);
+
+/**
+ * @brief Empties a dirty region, once its rectangles have been drawn and sent.
+ *
+ * @param[in]  Copy_psDirty         The dirty region.
+ *
+ * @retval     None
+ */
+void SFB_voidDirtyClear(SFB_DirtyRegion_t* Copy_psDirty);
+
+/**
+ * @brief Marks a rectangle of the screen as changed.
+ *
+ * The rectangle is clipped to the screen and merged with every rectangle it overlaps or comes
+ * within SFB_DIRTY_MERGE_GAP pixels of, so the region stays a list of disjoint rectangles. When
+ * SFB_DIRTY_MAX_RECTS are already in use, it is merged with the one whose bounds grow the least.
+ *
+ * @param[in]  Copy_psDirty         The dirty region.
+ * @param[in]  Copy_s16X            Screen X-coordinate of the left edge.
+ * @param[in]  Copy_s16Y            Screen Y-coordinate of the top edge.
+ * @param[in]  Copy_s16Width        Width in pixels.
+ * @param[in]  Copy_s16Height       Height in pixels.
+ *
+ * @retval     None
+ */
+void SFB_voidDirtyAdd(SFB_DirtyRegion_t* Copy_psDirty, s16 Copy_s16X, s16 Copy_s16Y, s16 Copy_s16Width, s16 Copy_s16Height);
+
+/**
+ * @brief Counts the pixels a dirty region covers, the pixels its rectangles will send.
+ *
+ * @param[in]  Copy_psDirty         The dirty region.
+ *
+ * @retval     The number of pixels.
+ */
+u32 SFB_u32DirtyArea(const SFB_DirtyRegion_t* Copy_psDirty);
+
+
+
+
+#endif /**< __FB_INTERFACE_H__ */
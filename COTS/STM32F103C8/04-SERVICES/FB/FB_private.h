@@ -0,0 +1,122 @@
+/**
+ * @file FB_private.h
+ * @brief This file contains the private interface of the frame buffer rasterizer module.
+ *
+ * This file should not be included directly by application code.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#ifndef __FB_PRIVATE_H__
+#define __FB_PRIVATE_H__
+
+
+/**< Options of SFB_SPAN_LOOP */
+#define SFB_SPAN_LOOP_AUTO          0
+#define SFB_SPAN_LOOP_PORTABLE      1
+#define SFB_SPAN_LOOP_SSE2          2
+#define SFB_SPAN_LOOP_NEON          3
+
+/**< Options of SFB_PIXEL_ORDER */
+#define SFB_PIXEL_ORDER_NATIVE      0
+#define SFB_PIXEL_ORDER_SWAPPED     1
+
+/**< Resolve the automatic span loop from the compiler target */
+#if SFB_SPAN_LOOP == SFB_SPAN_LOOP_AUTO
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define SFB_SPAN_LOOP_SELECTED  SFB_SPAN_LOOP_SSE2
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define SFB_SPAN_LOOP_SELECTED  SFB_SPAN_LOOP_NEON
+    #else
+        #define SFB_SPAN_LOOP_SELECTED  SFB_SPAN_LOOP_PORTABLE
+    #endif
+#elif SFB_SPAN_LOOP == SFB_SPAN_LOOP_PORTABLE || SFB_SPAN_LOOP == SFB_SPAN_LOOP_SSE2 || SFB_SPAN_LOOP == SFB_SPAN_LOOP_NEON
+    #define SFB_SPAN_LOOP_SELECTED      SFB_SPAN_LOOP
+#else
+    #error "WRONG CHOICE FOR SFB_SPAN_LOOP"
+#endif
+
+/**< Converts a plain RGB565 color to the stored pixel order */
+#if SFB_PIXEL_ORDER == SFB_PIXEL_ORDER_NATIVE
+    #define SFB_STORE_COLOR(COLOR)  ((u16)(COLOR))
+#elif SFB_PIXEL_ORDER == SFB_PIXEL_ORDER_SWAPPED
+    #define SFB_STORE_COLOR(COLOR)  ((u16)((((u16)(COLOR)) << 8) | (((u16)(COLOR)) >> 8)))
+#else
+    #error "WRONG CHOICE FOR SFB_PIXEL_ORDER"
+#endif
+
+
+/**
+ * @brief Fills a run of pixels with one stored color.
+ *
+ * This is the inner loop of every filled shape, so it is written for the selected SFB_SPAN_LOOP.
+ *
+ * @param[in] Copy_pu16Pixels   First pixel of the run.
+ * @param[in] Copy_s32Count     Number of pixels to fill.
+ * @param[in] Copy_u16Pixel     Color already in the stored pixel order.
+ *
+ * @retval     None
+ */
+static void SFB_voidFillPixels(u16* Copy_pu16Pixels, s32 Copy_s32Count, u16 Copy_u16Pixel);
+
+/**
+ * @brief Writes one pixel if it lies in the current band.
+ *
+ * @param[in] Copy_psFrameBuffer    The frame buffer.
+ * @param[in] Copy_s32X             Screen X-coordinate.
+ * @param[in] Copy_s32Y             Screen Y-coordinate.
+ * @param[in] Copy_u16Pixel         Color already in the stored pixel order.
+ *
+ * @retval     None
+ */
+static void SFB_voidPlot(SFB_FrameBuffer_t* Copy_psFrameBuffer, s32 Copy_s32X, s32 Copy_s32Y, u16 Copy_u16Pixel);
+
+/**
+ * @brief Fills the part of a horizontal span that lies in the current band.
+ *
+ * @param[in] Copy_psFrameBuffer    The frame buffer.
+ * @param[in] Copy_s32X0            Screen X-coordinate of the first pixel.
+ * @param[in] Copy_s32X1            Screen X-coordinate of the last pixel (inclusive).
+ * @param[in] Copy_s32Y             Screen Y-coordinate of the span.
+ * @param[in] Copy_u16Pixel         Color already in the stored pixel order.
+ *
+ * @retval     None
+ */
+static void SFB_voidSpan(SFB_FrameBuffer_t* Copy_psFrameBuffer, s32 Copy_s32X0, s32 Copy_s32X1, s32 Copy_s32Y, u16 Copy_u16Pixel);
+
+
+/**
+ * @brief Number of rows of the current region the next band holds.
+ *
+ * @param[in] Copy_psFrameBuffer    The frame buffer, with OriginY on the first row of the band.
+ *
+ * @retval     The rows that fit the storage at the region width, at most the rows left in the region.
+ */
+static u16 SFB_u16BandRows(const SFB_FrameBuffer_t* Copy_psFrameBuffer);
+
+/**
+ * @brief Tells whether two rectangles overlap or are closer than SFB_DIRTY_MERGE_GAP pixels.
+ *
+ * @param[in] Copy_psFirst          One rectangle.
+ * @param[in] Copy_psSecond         The other rectangle.
+ *
+ * @retval     1                    The rectangles should be merged.
+ * @retval     0                    The rectangles are apart.
+ */
+static u8 SFB_u8RectsNear(const SFB_Rect_t* Copy_psFirst, const SFB_Rect_t* Copy_psSecond);
+
+/**
+ * @brief Computes the bounding box of two rectangles.
+ *
+ * @param[in] Copy_psFirst          One rectangle.
+ * @param[in] Copy_psSecond         The other rectangle.
+ *
+ * @retval     The smallest rectangle holding both.
+ */
+static SFB_Rect_t SFB_sRectUnion(const SFB_Rect_t* Copy_psFirst, const SFB_Rect_t* Copy_psSecond);
+
+
+
+
+#endif /**< __FB_PRIVATE_H__ */
@@ -0,0 +1,511 @@
+/**
+ * @file FB_program.c
+ * @brief This file contains the implementation of the frame buffer rasterizer module.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#include <string.h>
+/**< LIB */
+#include "STD_TYPES.h"
+/**< SERVICES */
+#include "FB_config.h"
+#include "FB_interface.h"
+#include "FB_private.h"
+
+#if SFB_SPAN_LOOP_SELECTED == SFB_SPAN_LOOP_SSE2
+#include <emmintrin.h>
+#elif SFB_SPAN_LOOP_SELECTED == SFB_SPAN_LOOP_NEON
+#include <arm_neon.h>
+#endif
+
+
+/****************************************< FUNCTIONS IMPLEMENTATION ****************************************/
+u8 SFB_u8Init(SFB_FrameBuffer_t* Copy_psFrameBuffer, u16* Copy_pu16Pixels, u16 Copy_u16Width, u16 Copy_u16ScreenHeight, u16 Copy_u16BandHeight)
+{
+    u8 Local_u8ErrorStatus = 0;
+    if((Copy_psFrameBuffer != NULL) && (Copy_pu16Pixels != NULL) && (Copy_u16Width != 0) && (Copy_u16ScreenHeight != 0) && (Copy_u16BandHeight != 0))
+    {
+        Copy_psFrameBuffer->Pixels = Copy_pu16Pixels;
+        Copy_psFrameBuffer->Width = Copy_u16Width;
+        Copy_psFrameBuffer->ScreenHeight = Copy_u16ScreenHeight;
+        /**< A band taller than the screen would only waste rows */
+        Copy_psFrameBuffer->BandHeight = (Copy_u16BandHeight < Copy_u16ScreenHeight) ? Copy_u16BandHeight : Copy_u16ScreenHeight;
+        Copy_psFrameBuffer->OriginX = 0;
+        Copy_psFrameBuffer->OriginY = 0;
+        Copy_psFrameBuffer->Columns = Copy_u16Width;
+        Copy_psFrameBuffer->Rows = Copy_psFrameBuffer->BandHeight;
+        Copy_psFrameBuffer->RegionBottom = Copy_u16ScreenHeight;
+        Copy_psFrameBuffer->Background = 0;
+    }
+    else
+    {
+        Local_u8ErrorStatus = 1;
+    }
+    return Local_u8ErrorStatus;
+}
+
+void SFB_voidBeginFrame(SFB_FrameBuffer_t* Copy_psFrameBuffer, u16 Copy_u16Background)
+{
+    SFB_Rect_t Local_sScreen = { 0, 0, Copy_psFrameBuffer->Width, Copy_psFrameBuffer->ScreenHeight };
+    SFB_voidBeginRegion(Copy_psFrameBuffer, &Local_sScreen, Copy_u16Background);
+}
+
+void SFB_voidBeginRegion(SFB_FrameBuffer_t* Copy_psFrameBuffer, const SFB_Rect_t* Copy_psRegion, u16 Copy_u16Background)
+{
+    /**< Clip the region to the screen; an empty region leaves an empty band */
+    u32 Local_u32Right = (u32)Copy_psRegion->X + Copy_psRegion->Width;
+    u32 Local_u32Bottom = (u32)Copy_psRegion->Y + Copy_psRegion->Height;
+    Local_u32Right = (Local_u32Right < Copy_psFrameBuffer->Width) ? Local_u32Right : Copy_psFrameBuffer->Width;
+    Local_u32Bottom = (Local_u32Bottom < Copy_psFrameBuffer->ScreenHeight) ? Local_u32Bottom : Copy_psFrameBuffer->ScreenHeight;
+
+    Copy_psFrameBuffer->Background = SFB_STORE_COLOR(Copy_u16Background);
+    Copy_psFrameBuffer->OriginX = Copy_psRegion->X;
+    Copy_psFrameBuffer->OriginY = Copy_psRegion->Y;
+    Copy_psFrameBuffer->Columns = (Local_u32Right > Copy_psRegion->X) ? (u16)(Local_u32Right - Copy_psRegion->X) : 0;
+    Copy_psFrameBuffer->RegionBottom = (Local_u32Bottom > Copy_psRegion->Y) ? (u16)Local_u32Bottom : Copy_psRegion->Y;
+    Copy_psFrameBuffer->Rows = (Copy_psFrameBuffer->Columns != 0) ? SFB_u16BandRows(Copy_psFrameBuffer) : 0;
+    SFB_voidFillPixels(Copy_psFrameBuffer->Pixels, (s32)Copy_psFrameBuffer->Columns * Copy_psFrameBuffer->Rows, Copy_psFrameBuffer->Background);
+}
+
+u8 SFB_u8EndBand(SFB_FrameBuffer_t* Copy_psFrameBuffer, SFB_Flush_t Copy_pfFlush)
+{
+    u8 Local_u8MoreBands = 0;
+    if((Copy_pfFlush != NULL) && (Copy_psFrameBuffer->Rows != 0))
+    {
+        Copy_pfFlush(Copy_psFrameBuffer->OriginX, Copy_psFrameBuffer->OriginY, Copy_psFrameBuffer->Pixels, Copy_psFrameBuffer->Columns, Copy_psFrameBuffer->Rows);
+    }
+
+    u16 Local_u16NextY = (u16)(Copy_psFrameBuffer->OriginY + Copy_psFrameBuffer->Rows);
+    if((Copy_psFrameBuffer->Rows != 0) && (Local_u16NextY < Copy_psFrameBuffer->RegionBottom))
+    {
+        Copy_psFrameBuffer->OriginY = Local_u16NextY;
+        Copy_psFrameBuffer->Rows = SFB_u16BandRows(Copy_psFrameBuffer);
+        SFB_voidFillPixels(Copy_psFrameBuffer->Pixels, (s32)Copy_psFrameBuffer->Columns * Copy_psFrameBuffer->Rows, Copy_psFrameBuffer->Background);
+        Local_u8MoreBands = 1;
+    }
+    return Local_u8MoreBands;
+}
+
+void SFB_voidClear(SFB_FrameBuffer_t* Copy_psFrameBuffer, u16 Copy_u16Color)
+{
+    SFB_voidFillPixels(Copy_psFrameBuffer->Pixels, (s32)Copy_psFrameBuffer->Columns * Copy_psFrameBuffer->Rows, SFB_STORE_COLOR(Copy_u16Color));
+}
+
+void SFB_voidDrawPixel(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X, s16 Copy_s16Y, u16 Copy_u16Color)
+{
+    SFB_voidPlot(Copy_psFrameBuffer, Copy_s16X, Copy_s16Y, SFB_STORE_COLOR(Copy_u16Color));
+}
+
+void SFB_voidFillSpan(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X, s16 Copy_s16Y, s16 Copy_s16Length, u16 Copy_u16Color)
+{
+    SFB_voidSpan(Copy_psFrameBuffer, Copy_s16X, (s32)Copy_s16X + Copy_s16Length - 1, Copy_s16Y, SFB_STORE_COLOR(Copy_u16Color));
+}
+
+void SFB_voidFillRect(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X, s16 Copy_s16Y, s16 Copy_s16Width, s16 Copy_s16Height, u16 Copy_u16Color)
+{
+    /**< Only the rows inside the band are visited */
+    s32 Local_s32Top = (Copy_s16Y > (s32)Copy_psFrameBuffer->OriginY) ? Copy_s16Y : (s32)Copy_psFrameBuffer->OriginY;
+    s32 Local_s32Bottom = (s32)Copy_s16Y + Copy_s16Height;
+    s32 Local_s32BandBottom = (s32)Copy_psFrameBuffer->OriginY + Copy_psFrameBuffer->Rows;
+    if(Local_s32Bottom > Local_s32BandBottom)
+    {
+        Local_s32Bottom = Local_s32BandBottom;
+    }
+
+    u16 Local_u16Pixel = SFB_STORE_COLOR(Copy_u16Color);
+    for (s32 Local_s32Y = Local_s32Top; Local_s32Y < Local_s32Bottom; Local_s32Y++)
+    {
+        SFB_voidSpan(Copy_psFrameBuffer, Copy_s16X, (s32)Copy_s16X + Copy_s16Width - 1, Local_s32Y, Local_u16Pixel);
+    }
+}
+
+void SFB_voidDrawLine(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X0, s16 Copy_s16Y0, s16 Copy_s16X1, s16 Copy_s16Y1, u16 Copy_u16Color)
+{
+    u16 Local_u16Pixel = SFB_STORE_COLOR(Copy_u16Color);
+    s32 Local_s32BandBottom = (s32)Copy_psFrameBuffer->OriginY + Copy_psFrameBuffer->Rows;
+
+    /**< Skip lines entirely above or below the band */
+    if(((Copy_s16Y0 < (s32)Copy_psFrameBuffer->OriginY) && (Copy_s16Y1 < (s32)Copy_psFrameBuffer->OriginY))
+        || ((Copy_s16Y0 >= Local_s32BandBottom) && (Copy_s16Y1 >= Local_s32BandBottom)))
+    {
+        return;
+    }
+
+    if(Copy_s16Y0 == Copy_s16Y1)
+    {
+        /**< Horizontal lines are spans */
+        if(Copy_s16X0 <= Copy_s16X1)
+        {
+            SFB_voidSpan(Copy_psFrameBuffer, Copy_s16X0, Copy_s16X1, Copy_s16Y0, Local_u16Pixel);
+        }
+        else
+        {
+            SFB_voidSpan(Copy_psFrameBuffer, Copy_s16X1, Copy_s16X0, Copy_s16Y0, Local_u16Pixel);
+        }
+        return;
+    }
+
+    s32 Local_s32X = Copy_s16X0;
+    s32 Local_s32Y = Copy_s16Y0;
+    s32 Local_s32DeltaX = (Copy_s16X1 > Copy_s16X0) ? ((s32)Copy_s16X1 - Copy_s16X0) : ((s32)Copy_s16X0 - Copy_s16X1);
+    s32 Local_s32DeltaY = (Copy_s16Y1 > Copy_s16Y0) ? ((s32)Copy_s16Y0 - Copy_s16Y1) : ((s32)Copy_s16Y1 - Copy_s16Y0);
+    s32 Local_s32StepX = (Copy_s16X1 > Copy_s16X0) ? 1 : -1;
+    s32 Local_s32StepY = (Copy_s16Y1 > Copy_s16Y0) ? 1 : -1;
+    s32 Local_s32Error = Local_s32DeltaX + Local_s32DeltaY;
+
+    while (1)
+    {
+        SFB_voidPlot(Copy_psFrameBuffer, Local_s32X, Local_s32Y, Local_u16Pixel);
+        if((Local_s32X == Copy_s16X1) && (Local_s32Y == Copy_s16Y1))
+        {
+            break;
+        }
+
+        s32 Local_s32Error2 = 2 * Local_s32Error;
+        if(Local_s32Error2 >= Local_s32DeltaY)
+        {
+            Local_s32Error += Local_s32DeltaY;
+            Local_s32X += Local_s32StepX;
+        }
+        if(Local_s32Error2 <= Local_s32DeltaX)
+        {
+            Local_s32Error += Local_s32DeltaX;
+            Local_s32Y += Local_s32StepY;
+        }
+    }
+}
+
+void SFB_voidDrawCircle(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16CenterX, s16 Copy_s16CenterY, s16 Copy_s16Radius, u16 Copy_u16Color)
+{
+    /**< Skip circles entirely above or below the band */
+    if(((s32)Copy_s16CenterY + Copy_s16Radius < (s32)Copy_psFrameBuffer->OriginY)
+        || ((s32)Copy_s16CenterY - Copy_s16Radius >= (s32)Copy_psFrameBuffer->OriginY + Copy_psFrameBuffer->Rows))
+    {
+        return;
+    }
+
+    u16 Local_u16Pixel = SFB_STORE_COLOR(Copy_u16Color);
+    s32 Local_s32OffsetX = Copy_s16Radius;
+    s32 Local_s32OffsetY = 0;
+    s32 Local_s32Error = 0;
+
+    /**< Bresenham's circle, eight octants per step */
+    while (Local_s32OffsetX >= Local_s32OffsetY)
+    {
+        SFB_voidPlot(Copy_psFrameBuffer, Copy_s16CenterX + Local_s32OffsetX, Copy_s16CenterY + Local_s32OffsetY, Local_u16Pixel);
+        SFB_voidPlot(Copy_psFrameBuffer, Copy_s16CenterX + Local_s32OffsetY, Copy_s16CenterY + Local_s32OffsetX, Local_u16Pixel);
+        SFB_voidPlot(Copy_psFrameBuffer, Copy_s16CenterX - Local_s32OffsetY, Copy_s16CenterY + Local_s32OffsetX, Local_u16Pixel);
+        SFB_voidPlot(Copy_psFrameBuffer, Copy_s16CenterX - Local_s32OffsetX, Copy_s16CenterY + Local_s32OffsetY, Local_u16Pixel);
+        SFB_voidPlot(Copy_psFrameBuffer, Copy_s16CenterX - Local_s32OffsetX, Copy_s16CenterY - Local_s32OffsetY, Local_u16Pixel);
+        SFB_voidPlot(Copy_psFrameBuffer, Copy_s16CenterX - Local_s32OffsetY, Copy_s16CenterY - Local_s32OffsetX, Local_u16Pixel);
+        SFB_voidPlot(Copy_psFrameBuffer, Copy_s16CenterX + Local_s32OffsetY, Copy_s16CenterY - Local_s32OffsetX, Local_u16Pixel);
+        SFB_voidPlot(Copy_psFrameBuffer, Copy_s16CenterX + Local_s32OffsetX, Copy_s16CenterY - Local_s32OffsetY, Local_u16Pixel);
+
+        if(Local_s32Error <= 0)
+        {
+            Local_s32OffsetY += 1;
+            Local_s32Error += 2 * Local_s32OffsetY + 1;
+        }
+
+        if(Local_s32Error > 0)
+        {
+            Local_s32OffsetX -= 1;
+            Local_s32Error -= 2 * Local_s32OffsetX + 1;
+        }
+    }
+}
+
+void SFB_voidFillCircle(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16CenterX, s16 Copy_s16CenterY, s16 Copy_s16Radius, u16 Copy_u16Color)
+{
+    /**< Skip discs entirely above or below the band */
+    if((Copy_s16Radius < 0)
+        || ((s32)Copy_s16CenterY + Copy_s16Radius < (s32)Copy_psFrameBuffer->OriginY)
+        || ((s32)Copy_s16CenterY - Copy_s16Radius >= (s32)Copy_psFrameBuffer->OriginY + Copy_psFrameBuffer->Rows))
+    {
+        return;
+    }
+
+    u16 Local_u16Pixel = SFB_STORE_COLOR(Copy_u16Color);
+    s32 Local_s32Limit = (s32)Copy_s16Radius * Copy_s16Radius + Copy_s16Radius;
+    s32 Local_s32HalfWidth = Copy_s16Radius;
+
+    /**< Rows move away from the center, so each half width only ever shrinks */
+    for (s32 Local_s32OffsetY = 0; Local_s32OffsetY <= Copy_s16Radius; Local_s32OffsetY++)
+    {
+        while (Local_s32HalfWidth * Local_s32HalfWidth + Local_s32OffsetY * Local_s32OffsetY > Local_s32Limit)
+        {
+            Local_s32HalfWidth--;
+        }
+        SFB_voidSpan(Copy_psFrameBuffer, Copy_s16CenterX - Local_s32HalfWidth, Copy_s16CenterX + Local_s32HalfWidth, Copy_s16CenterY + Local_s32OffsetY, Local_u16Pixel);
+        if(Local_s32OffsetY != 0)
+        {
+            SFB_voidSpan(Copy_psFrameBuffer, Copy_s16CenterX - Local_s32HalfWidth, Copy_s16CenterX + Local_s32HalfWidth, Copy_s16CenterY - Local_s32OffsetY, Local_u16Pixel);
+        }
+    }
+}
+
+void SFB_voidFillPolygon(SFB_FrameBuffer_t* Copy_psFrameBuffer, const s16* Copy_ps16X, const s16* Copy_ps16Y, u8 Copy_u8Count, u16 Copy_u16Color)
+{
+    if((Copy_ps16X == NULL) || (Copy_ps16Y == NULL) || (Copy_u8Count < 3))
+    {
+        return;
+    }
+
+    /**< Rows covered by the polygon, clipped to the band */
+    s32 Local_s32Top = Copy_ps16Y[0];
+    s32 Local_s32Bottom = Copy_ps16Y[0];
+    for (u8 Local_u8Vertex = 1; Local_u8Vertex < Copy_u8Count; Local_u8Vertex++)
+    {
+        Local_s32Top = (Copy_ps16Y[Local_u8Vertex] < Local_s32Top) ? Copy_ps16Y[Local_u8Vertex] : Local_s32Top;
+        Local_s32Bottom = (Copy_ps16Y[Local_u8Vertex] > Local_s32Bottom) ? Copy_ps16Y[Local_u8Vertex] : Local_s32Bottom;
+    }
+    if(Local_s32Top < (s32)Copy_psFrameBuffer->OriginY)
+    {
+        Local_s32Top = Copy_psFrameBuffer->OriginY;
+    }
+    if(Local_s32Bottom > (s32)Copy_psFrameBuffer->OriginY + Copy_psFrameBuffer->Rows)
+    {
+        Local_s32Bottom = (s32)Copy_psFrameBuffer->OriginY + Copy_psFrameBuffer->Rows;
+    }
+
+    u16 Local_u16Pixel = SFB_STORE_COLOR(Copy_u16Color);
+    for (s32 Local_s32Y = Local_s32Top; Local_s32Y < Local_s32Bottom; Local_s32Y++)
+    {
+        /**< A convex polygon crosses the center of a row at two edges: keep the leftmost and rightmost crossing */
+        s32 Local_s32Left = 0x7FFFFFFF;
+        s32 Local_s32Right = -0x7FFFFFFF;
+        u8 Local_u8Previous = (u8)(Copy_u8Count - 1);
+        for (u8 Local_u8Vertex = 0; Local_u8Vertex < Copy_u8Count; Local_u8Vertex++)
+        {
+            s32 Local_s32X0 = Copy_ps16X[Local_u8Previous];
+            s32 Local_s32Y0 = Copy_ps16Y[Local_u8Previous];
+            s32 Local_s32X1 = Copy_ps16X[Local_u8Vertex];
+            s32 Local_s32Y1 = Copy_ps16Y[Local_u8Vertex];
+            Local_u8Previous = Local_u8Vertex;
+            if(Local_s32Y0 > Local_s32Y1)
+            {
+                s32 Local_s32Swap = Local_s32X0; Local_s32X0 = Local_s32X1; Local_s32X1 = Local_s32Swap;
+                Local_s32Swap = Local_s32Y0; Local_s32Y0 = Local_s32Y1; Local_s32Y1 = Local_s32Swap;
+            }
+            if((Local_s32Y < Local_s32Y0) || (Local_s32Y >= Local_s32Y1))
+            {
+                continue;
+            }
+
+            s32 Local_s32X = Local_s32X0 + ((2 * (Local_s32Y - Local_s32Y0) + 1) * (Local_s32X1 - Local_s32X0)) / (2 * (Local_s32Y1 - Local_s32Y0));
+            Local_s32Left = (Local_s32X < Local_s32Left) ? Local_s32X : Local_s32Left;
+            Local_s32Right = (Local_s32X > Local_s32Right) ? Local_s32X : Local_s32Right;
+        }
+        if(Local_s32Left < Local_s32Right)
+        {
+            /**< Right edges are excluded like bottom edges, so polygons sharing an edge do not overlap */
+            SFB_voidSpan(Copy_psFrameBuffer, Local_s32Left, Local_s32Right - 1, Local_s32Y, Local_u16Pixel);
+        }
+    }
+}
+
+void SFB_voidBlit(SFB_FrameBuffer_t* Copy_psFrameBuffer, s16 Copy_s16X, s16 Copy_s16Y, const u16* Copy_pu16Image, u16 Copy_u16Width, u16 Copy_u16Height)
+{
+    /**< Clip the image against the band */
+    s32 Local_s32BandRight = (s32)Copy_psFrameBuffer->OriginX + Copy_psFrameBuffer->Columns;
+    s32 Local_s32Left = (Copy_s16X > (s32)Copy_psFrameBuffer->OriginX) ? Copy_s16X : (s32)Copy_psFrameBuffer->OriginX;
+    s32 Local_s32Right = (s32)Copy_s16X + Copy_u16Width;
+    s32 Local_s32Top = (Copy_s16Y > (s32)Copy_psFrameBuffer->OriginY) ? Copy_s16Y : (s32)Copy_psFrameBuffer->OriginY;
+    s32 Local_s32Bottom = (s32)Copy_s16Y + Copy_u16Height;
+    s32 Local_s32BandBottom = (s32)Copy_psFrameBuffer->OriginY + Copy_psFrameBuffer->Rows;
+    if(Local_s32Right > Local_s32BandRight)
+    {
+        Local_s32Right = Local_s32BandRight;
+    }
+    if(Local_s32Bottom > Local_s32BandBottom)
+    {
+        Local_s32Bottom = Local_s32BandBottom;
+    }
+    if((Copy_pu16Image == NULL) || (Local_s32Left >= Local_s32Right))
+    {
+        return;
+    }
+
+    for (s32 Local_s32Y = Local_s32Top; Local_s32Y < Local_s32Bottom; Local_s32Y++)
+    {
+        const u16* Local_pu16Source = &Copy_pu16Image[(Local_s32Y - Copy_s16Y) * (s32)Copy_u16Width + (Local_s32Left - Copy_s16X)];
+        u16* Local_pu16Destination = &Copy_psFrameBuffer->Pixels[(Local_s32Y - Copy_psFrameBuffer->OriginY) * (s32)Copy_psFrameBuffer->Columns + (Local_s32Left - Copy_psFrameBuffer->OriginX)];
+        memcpy(Local_pu16Destination, Local_pu16Source, sizeof(u16) * (u32)(Local_s32Right - Local_s32Left));
+    }
+}
+
+void SFB_voidDirtyInit(SFB_DirtyRegion_t* Copy_psDirty, u16 Copy_u16ScreenWidth, u16 Copy_u16ScreenHeight)
+{
+    Copy_psDirty->Count = 0;
+    Copy_psDirty->ScreenWidth = Copy_u16ScreenWidth;
+    Copy_psDirty->ScreenHeight = Copy_u16ScreenHeight;
+}
+
+void SFB_voidDirtyClear(SFB_DirtyRegion_t* Copy_psDirty)
+{
+    Copy_psDirty->Count = 0;
+}
+
+void SFB_voidDirtyAdd(SFB_DirtyRegion_t* Copy_psDirty, s16 Copy_s16X, s16 Copy_s16Y, s16 Copy_s16Width, s16 Copy_s16Height)
+{
+    /**< Clip to the screen, working on the edges */
+    s32 Local_s32Left = (Copy_s16X > 0) ? Copy_s16X : 0;
+    s32 Local_s32Top = (Copy_s16Y > 0) ? Copy_s16Y : 0;
+    s32 Local_s32Right = (s32)Copy_s16X + Copy_s16Width;
+    s32 Local_s32Bottom = (s32)Copy_s16Y + Copy_s16Height;
+    Local_s32Right = (Local_s32Right < (s32)Copy_psDirty->ScreenWidth) ? Local_s32Right : (s32)Copy_psDirty->ScreenWidth;
+    Local_s32Bottom = (Local_s32Bottom < (s32)Copy_psDirty->ScreenHeight) ? Local_s32Bottom : (s32)Copy_psDirty->ScreenHeight;
+    if((Local_s32Left >= Local_s32Right) || (Local_s32Top >= Local_s32Bottom))
+    {
+        return;
+    }
+
+    SFB_Rect_t Local_sRect = { (u16)Local_s32Left, (u16)Local_s32Top, (u16)(Local_s32Right - Local_s32Left), (u16)(Local_s32Bottom - Local_s32Top) };
+    u8 Local_u8Index = 0;
+    while (Local_u8Index < Copy_psDirty->Count)
+    {
+        if(SFB_u8RectsNear(&Copy_psDirty->Rects[Local_u8Index], &Local_sRect) == 1)
+        {
+            /**< Absorb the neighbour and start over: the grown rectangle may now reach others */
+            Local_sRect = SFB_sRectUnion(&Copy_psDirty->Rects[Local_u8Index], &Local_sRect);
+            Copy_psDirty->Rects[Local_u8Index] = Copy_psDirty->Rects[--Copy_psDirty->Count];
+            Local_u8Index = 0;
+        }
+        else if((Local_u8Index == Copy_psDirty->Count - 1) && (Copy_psDirty->Count == SFB_DIRTY_MAX_RECTS))
+        {
+            /**< No room left: absorb the rectangle whose bounds grow the least */
+            u8 Local_u8Best = 0;
+            u32 Local_u32BestGrowth = 0xFFFFFFFFu;
+            for (u8 Local_u8Candidate = 0; Local_u8Candidate < Copy_psDirty->Count; Local_u8Candidate++)
+            {
+                SFB_Rect_t Local_sUnion = SFB_sRectUnion(&Copy_psDirty->Rects[Local_u8Candidate], &Local_sRect);
+                u32 Local_u32Growth = (u32)Local_sUnion.Width * Local_sUnion.Height - (u32)Copy_psDirty->Rects[Local_u8Candidate].Width * Copy_psDirty->Rects[Local_u8Candidate].Height;
+                if(Local_u32Growth < Local_u32BestGrowth)
+                {
+                    Local_u32BestGrowth = Local_u32Growth;
+                    Local_u8Best = Local_u8Candidate;
+                }
+            }
+            Local_sRect = SFB_sRectUnion(&Copy_psDirty->Rects[Local_u8Best], &Local_sRect);
+            Copy_psDirty->Rects[Local_u8Best] = Copy_psDirty->Rects[--Copy_psDirty->Count];
+            Local_u8Index = 0;
+        }
+        else
+        {
+            Local_u8Index++;
+        }
+    }
+    Copy_psDirty->Rects[Copy_psDirty->Count++] = Local_sRect;
+}
+
+u32 SFB_u32DirtyArea(const SFB_DirtyRegion_t* Copy_psDirty)
+{
+    u32 Local_u32Area = 0;
+    for (u8 Local_u8Index = 0; Local_u8Index < Copy_psDirty->Count; Local_u8Index++)
+    {
+        Local_u32Area += (u32)Copy_psDirty->Rects[Local_u8Index].Width * Copy_psDirty->Rects[Local_u8Index].Height;
+    }
+    return Local_u32Area;
+}
+
+static u16 SFB_u16BandRows(const SFB_FrameBuffer_t* Copy_psFrameBuffer)
+{
+    /**< As many rows of the region as the storage holds, and no more than the region has left */
+    u32 Local_u32Rows = ((u32)Copy_psFrameBuffer->Width * Copy_psFrameBuffer->BandHeight) / Copy_psFrameBuffer->Columns;
+    u32 Local_u32RowsLeft = (u32)Copy_psFrameBuffer->RegionBottom - Copy_psFrameBuffer->OriginY;
+    return (u16)((Local_u32Rows < Local_u32RowsLeft) ? Local_u32Rows : Local_u32RowsLeft);
+}
+
+static u8 SFB_u8RectsNear(const SFB_Rect_t* Copy_psFirst, const SFB_Rect_t* Copy_psSecond)
+{
+    return (((s32)Copy_psFirst->X < (s32)Copy_psSecond->X + Copy_psSecond->Width + SFB_DIRTY_MERGE_GAP)
+        && ((s32)Copy_psSecond->X < (s32)Copy_psFirst->X + Copy_psFirst->Width + SFB_DIRTY_MERGE_GAP)
+        && ((s32)Copy_psFirst->Y < (s32)Copy_psSecond->Y + Copy_psSecond->Height + SFB_DIRTY_MERGE_GAP)
+        && ((s32)Copy_psSecond->Y < (s32)Copy_psFirst->Y + Copy_psFirst->Height + SFB_DIRTY_MERGE_GAP)) ? 1 : 0;
+}
+
+static SFB_Rect_t SFB_sRectUnion(const SFB_Rect_t* Copy_psFirst, const SFB_Rect_t* Copy_psSecond)
+{
+    u16 Local_u16Left = (Copy_psFirst->X < Copy_psSecond->X) ? Copy_psFirst->X : Copy_psSecond->X;
+    u16 Local_u16Top = (Copy_psFirst->Y < Copy_psSecond->Y) ? Copy_psFirst->Y : Copy_psSecond->Y;
+    u32 Local_u32Right = (u32)Copy_psFirst->X + Copy_psFirst->Width;
+    u32 Local_u32Bottom = (u32)Copy_psFirst->Y + Copy_psFirst->Height;
+    Local_u32Right = ((u32)Copy_psSecond->X + Copy_psSecond->Width > Local_u32Right) ? (u32)Copy_psSecond->X + Copy_psSecond->Width : Local_u32Right;
+    Local_u32Bottom = ((u32)Copy_psSecond->Y + Copy_psSecond->Height > Local_u32Bottom) ? (u32)Copy_psSecond->Y + Copy_psSecond->Height : Local_u32Bottom;
+    SFB_Rect_t Local_sUnion = { Local_u16Left, Local_u16Top, (u16)(Local_u32Right - Local_u16Left), (u16)(Local_u32Bottom - Local_u16Top) };
+    return Local_sUnion;
+}
+
+static void SFB_voidFillPixels(u16* Copy_pu16Pixels, s32 Copy_s32Count, u16 Copy_u16Pixel)
+{
+#if SFB_SPAN_LOOP_SELECTED == SFB_SPAN_LOOP_SSE2
+    __m128i Local_xEightPixels = _mm_set1_epi16((short)Copy_u16Pixel);
+    while (Copy_s32Count >= 8)
+    {
+        _mm_storeu_si128((__m128i*)Copy_pu16Pixels, Local_xEightPixels);
+        Copy_pu16Pixels += 8;
+        Copy_s32Count -= 8;
+    }
+#elif SFB_SPAN_LOOP_SELECTED == SFB_SPAN_LOOP_NEON
+    uint16x8_t Local_xEightPixels = vdupq_n_u16(Copy_u16Pixel);
+    while (Copy_s32Count >= 8)
+    {
+        vst1q_u16(Copy_pu16Pixels, Local_xEightPixels);
+        Copy_pu16Pixels += 8;
+        Copy_s32Count -= 8;
+    }
+#else
+    /**< Two pixels per word store, four words per iteration; memcpy compiles to a single STR */
+    u32 Local_u32TwoPixels = ((u32)Copy_u16Pixel << 16) | Copy_u16Pixel;
+    while (Copy_s32Count >= 8)
+    {
+        memcpy(&Copy_pu16Pixels[0], &Local_u32TwoPixels, sizeof(u32));
+        memcpy(&Copy_pu16Pixels[2], &Local_u32TwoPixels, sizeof(u32));
+        memcpy(&Copy_pu16Pixels[4], &Local_u32TwoPixels, sizeof(u32));
+        memcpy(&Copy_pu16Pixels[6], &Local_u32TwoPixels, sizeof(u32));
+        Copy_pu16Pixels += 8;
+        Copy_s32Count -= 8;
+    }
+#endif
+    while (Copy_s32Count > 0)
+    {
+        *Copy_pu16Pixels++ = Copy_u16Pixel;
+        Copy_s32Count--;
+    }
+}
+
+static void SFB_voidPlot(SFB_FrameBuffer_t* Copy_psFrameBuffer, s32 Copy_s32X, s32 Copy_s32Y, u16 Copy_u16Pixel)
+{
+    s32 Local_s32Row = Copy_s32Y - Copy_psFrameBuffer->OriginY;
+    s32 Local_s32Column = Copy_s32X - Copy_psFrameBuffer->OriginX;
+    if((Local_s32Column >= 0) && (Local_s32Column < (s32)Copy_psFrameBuffer->Columns) && (Local_s32Row >= 0) && (Local_s32Row < (s32)Copy_psFrameBuffer->Rows))
+    {
+        Copy_psFrameBuffer->Pixels[Local_s32Row * (s32)Copy_psFrameBuffer->Columns + Local_s32Column] = Copy_u16Pixel;
+    }
+}
+
+static void SFB_voidSpan(SFB_FrameBuffer_t* Copy_psFrameBuffer, s32 Copy_s32X0, s32 Copy_s32X1, s32 Copy_s32Y, u16 Copy_u16Pixel)
+{
+    s32 Local_s32Row = Copy_s32Y - Copy_psFrameBuffer->OriginY;
+    if((Local_s32Row < 0) || (Local_s32Row >= (s32)Copy_psFrameBuffer->Rows))
+    {
+        return;
+    }
+    /**< Band columns of the span */
+    Copy_s32X0 -= Copy_psFrameBuffer->OriginX;
+    Copy_s32X1 -= Copy_psFrameBuffer->OriginX;
+    if(Copy_s32X0 < 0)
+    {
+        Copy_s32X0 = 0;
+    }
+    if(Copy_s32X1 >= (s32)Copy_psFrameBuffer->Columns)
+    {
+        Copy_s32X1 = (s32)Copy_psFrameBuffer->Columns - 1;
+    }
+    if(Copy_s32X0 <= Copy_s32X1)
+    {
+        SFB_voidFillPixels(&Copy_psFrameBuffer->Pixels[Local_s32Row * (s32)Copy_psFrameBuffer->Columns + Copy_s32X0], Copy_s32X1 - Copy_s32X0 + 1, Copy_u16Pixel);
+    }
+}
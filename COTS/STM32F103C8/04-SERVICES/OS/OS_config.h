@@ -13,8 +13,45 @@
 #define __OS_CONFIG_H__
 
 
+/**
+ * @brief The number of tasks, which is also the number of task priorities.
+ *
+ * A task is created at a priority between 0 and SOS_NUMBER_OS_TASKS - 1. When several tasks are due
+ * on the same tick they run in priority order, priority 0 first.
+ */
 #define SOS_NUMBER_OS_TASKS             3
 
+/**
+ * @brief The longest time, in ticks, the scheduler sleeps before it wakes up.
+ *
+ * The scheduler starts its software timer for the next due task only, so the CPU is not woken
+ * while no task is due. The timer service reaches any time below 2^31 microseconds, taking several
+ * SysTick intervals for a long one, so the limit only bounds how long a task due later sleeps
+ * before the scheduler checks the queue again. It must stay below 2147483 ticks.
+ */
+#define SOS_MAX_SLEEP_TICKS             1000
+
+/**
+ * @brief The number of events coroutine tasks can wait for with SOS_WAIT_EVENT().
+ *
+ * Events are numbered from 0 to SOS_NUMBER_EVENTS - 1 and cost a byte each.
+ */
+#define SOS_NUMBER_EVENTS               8
+
+/**
+ * @brief Specifies whether the scheduler times the runs of the tasks.
+ *
+ * With the accounting enabled, each run is timestamped with the time of the TMR timer service the
+ * scheduler already wakes up with, giving the execution time, the deadline misses and the CPU load
+ * of each task through SOS_u8GetTaskStats() and SOS_voidSendStats().
+ *
+ * @param SOS_TASK_STATS_ENABLE  The runs of the tasks are timed.
+ * @param SOS_TASK_STATS_DISABLE The runs are not timed and the statistics functions report nothing.
+ */
+#ifndef SOS_TASK_STATS
+#define SOS_TASK_STATS                  SOS_TASK_STATS_ENABLE
+#endif
+
 
 
 
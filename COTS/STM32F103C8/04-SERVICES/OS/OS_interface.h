@@ -14,26 +14,171 @@
 #define __OS_INTERFACE_H__
 
 
+/**
+ * @brief The timing of the runs of a task since the statistics were last reset.
+ *
+ * A run misses its deadline when it ends after the next release of the task, one period after the
+ * wakeup that released it. The load is the share of the time since the reset spent in the task.
+ */
+typedef struct
+{
+    u32 Runs;                   /**< Counter: runs of the task. */
+    u32 DeadlineMisses;         /**< Counter: runs that ended after the next release of the task. */
+    u32 MinExecutionUs;         /**< Shortest execution time, in microseconds, 0 before the first run. */
+    u32 AvgExecutionUs;         /**< Mean execution time, in microseconds. */
+    u32 MaxExecutionUs;         /**< Longest execution time, in microseconds. */
+    u32 TotalExecutionUs;       /**< Sum of the execution times, in microseconds. */
+    u16 Load;                   /**< CPU load of the task, in hundredths of a percent. */
+} SOS_TaskStats_t;
+
+
+/**
+ * @brief What a coroutine task waits for when it returns to the scheduler.
+ */
+#define SOS_COROUTINE_ENDED         0       /**< The coroutine reached SOS_END() or returned: it does not run again. */
+#define SOS_COROUTINE_SLEEPING      1       /**< The coroutine waits for a number of ticks, SOS_WAIT_MS(). */
+#define SOS_COROUTINE_WAITING       2       /**< The coroutine waits for an event, SOS_WAIT_EVENT(). */
+
+/**
+ * @brief The context of a coroutine task: where it resumes and what it waits for.
+ *
+ * A coroutine has no stack of its own. Each wait returns to the scheduler, and the next run jumps
+ * back to the line after the wait, so its local variables are not kept across a wait: a coroutine
+ * keeps its state in static variables. The struct is tagged so that drivers can declare their
+ * coroutines with a forward declaration instead of including the OS headers.
+ */
+typedef struct SOS_Coroutine_t
+{
+    u16 Line;                   /**< The line the coroutine resumes at, 0 to start from SOS_BEGIN(). */
+    u8 State;                   /**< SOS_COROUTINE_ENDED, SOS_COROUTINE_SLEEPING or SOS_COROUTINE_WAITING. */
+    u8 Event;                   /**< The event waited for. */
+    u32 Ticks;                  /**< The ticks slept for. */
+} SOS_Coroutine_t;
+
+/**
+ * @brief Starts the body of a coroutine task, resuming it after its last wait.
+ *
+ * The body runs from SOS_BEGIN() to SOS_END(), and the waits can only be used between them, in the
+ * coroutine function itself, not in a switch statement of its own. A wait is resumed by its line
+ * number, so two waits cannot share a line.
+ *
+ * @code
+ * static u8 App_u8Column;      // kept across the waits
+ * static u8 App_u8Enabled = 1; // cleared to end the task
+ *
+ * void App_voidRefresh(SOS_Coroutine_t* Copy_psTask)
+ * {
+ *     SOS_BEGIN(Copy_psTask);
+ *     while(App_u8Enabled)
+ *     {
+ *         for(App_u8Column = 0; App_u8Column < 8; App_u8Column++)
+ *         {
+ *             App_voidShowColumn(App_u8Column);
+ *             SOS_WAIT_MS(Copy_psTask, 2);                  // the other tasks run meanwhile
+ *         }
+ *         SOS_WAIT_EVENT(Copy_psTask, APP_NEW_FRAME_EVENT);
+ *     }
+ *     SOS_END(Copy_psTask);
+ * }
+ * @endcode
+ */
+#define SOS_BEGIN(Task)                 switch((Task)->Line) { case 0:
+
+/**
+ * @brief Returns to the scheduler and resumes the coroutine a number of ticks after the wakeup that released it.
+ *
+ * Ticks are milliseconds. A wait of 0 resumes the coroutine on the next tick.
+ */
+#define SOS_WAIT_MS(Task, Ms)           do { (Task)->State = SOS_COROUTINE_SLEEPING; (Task)->Ticks = (Ms); \
+                                             (Task)->Line = __LINE__; return; case __LINE__:; } while(0)
+
+/**
+ * @brief Returns to the scheduler until an event is set, then clears it and goes on.
+ *
+ * A coroutine whose event is already set goes on at once.
+ */
+#define SOS_WAIT_EVENT(Task, Ev)        do { (Task)->Line = __LINE__; case __LINE__: \
+                                             if(SOS_u8TakeEvent(Ev) == 0) { (Task)->State = SOS_COROUTINE_WAITING; \
+                                                                            (Task)->Event = (Ev); return; } } while(0)
+
+/**
+ * @brief Lets the other tasks run and resumes the coroutine on the next tick.
+ */
+#define SOS_YIELD(Task)                 SOS_WAIT_MS(Task, 0)
+
+/**
+ * @brief Ends the body of a coroutine task: the task does not run again until it is created again.
+ */
+#define SOS_END(Task)                   } (Task)->Line = 0; (Task)->State = SOS_COROUTINE_ENDED; return
+
+
 /**
  * @brief Creates a new task in the operating system.
  *
  * This function creates a new task with the given priority, periodicity, task function, and first delay.
+ * A task created again at the same priority replaces the earlier one. Tasks are created before
+ * SOS_voidStart() or from inside a running task; the delays of tasks created from a task are
+ * counted from the tick the running task was released on.
  *
- * @param[in]  Copy_u8TaskPriority      The priority of the new task.
- * @param[in]  Copy_u16TaskPeriodicity  The periodicity of the new task in milliseconds.
+ * @param[in]  Copy_u8TaskPriority      The priority of the new task, 0 being the highest.
+ * @param[in]  Copy_u32TaskPeriodicity  The periodicity of the new task in ticks (milliseconds), 0 to run it once.
  * @param[in]  Copy_pfTask              A pointer to the function that implements the new task.
- * @param[in]  Copy_u8FirstDelay        The initial delay of the new task in ticks.
+ * @param[in]  Copy_u32FirstDelay       The ticks until the first run of the new task, 0 for the first tick.
+ *
+ * @retval     0                        The task was created successfully.
+ * @retval     1                        An error occurred while creating the task.
+ */
+u8 SOS_u8CreateTask(u8 Copy_u8TaskPriority, u32 Copy_u32TaskPeriodicity, void (*Copy_pfTask)(void), u32 Copy_u32FirstDelay);
+
+/**
+ * @brief Creates a coroutine task, which waits with SOS_WAIT_MS() and SOS_WAIT_EVENT() instead of blocking.
+ *
+ * The coroutine runs first after its first delay and then whenever its wait is over. A wait returns
+ * to the scheduler, so a driver that would busy-wait between two steps lets the other tasks run
+ * meanwhile. A coroutine takes the priority slot of a task and replaces the task created at the
+ * same priority, and the same rules for creating it apply.
+ *
+ * @param[in]  Copy_u8TaskPriority      The priority of the new task, 0 being the highest.
+ * @param[in]  Copy_pfCoroutine         A pointer to the coroutine function, written between SOS_BEGIN() and SOS_END().
+ * @param[in]  Copy_u32FirstDelay       The ticks until the first run of the new task, 0 for the first tick.
  *
  * @retval     0                        The task was created successfully.
  * @retval     1                        An error occurred while creating the task.
  */
-u8 SOS_u8CreateTask(u8 Copy_u8TaskPriority, u16 Copy_u16TaskPeriodicity, void (*Copy_pfTask)(void));
+u8 SOS_u8CreateCoroutine(u8 Copy_u8TaskPriority, void (*Copy_pfCoroutine)(SOS_Coroutine_t* Copy_psTask), u32 Copy_u32FirstDelay);
+
+/**
+ * @brief Sets an event, releasing the coroutine tasks that wait for it.
+ *
+ * It only stores a byte, so it can be called from a task or from an interrupt handler. The waiting
+ * coroutines are released at the next wakeup of the scheduler: on the next tick for an event set
+ * by a task, and at the next due task, at most SOS_MAX_SLEEP_TICKS later, for an event set by an
+ * interrupt while the scheduler sleeps.
+ *
+ * @param[in]  Copy_u8Event             The event, below SOS_NUMBER_EVENTS.
+ *
+ * @retval     None
+ */
+void SOS_voidSetEvent(u8 Copy_u8Event);
+
+/**
+ * @brief Clears an event if it is set; SOS_WAIT_EVENT() waits with it.
+ *
+ * @param[in]  Copy_u8Event             The event, below SOS_NUMBER_EVENTS.
+ *
+ * @retval     1                        The event was set and is now cleared.
+ * @retval     0                        The event was not set, or is out of range.
+ */
+u8 SOS_u8TakeEvent(u8 Copy_u8Event);
 
 /**
  * @brief Starts the operating system scheduler.
  *
- * This function initializes the system tick timer and starts the operating system scheduler.
+ * This function initializes the TMR timer service and starts the operating system scheduler.
  * The scheduler runs the task functions for each registered task at the appropriate times.
+ * It wakes up with a software timer started for the next due task only, so no interrupt is taken
+ * for it while no task is due and the CPU can sleep until then. SysTick stays shared with the
+ * other timers of the service, which a task may start and stop.
  *
  * @param[in]  None
  * @param[out] None
@@ -42,6 +187,58 @@ u8 SOS_u8CreateTask(u8 Copy_u8TaskPriority, u16 Copy_u16TaskPeriodicity, void (*
  */
 void SOS_voidStart(void);
 
+/**
+ * @brief Gets the timing of the runs of a task.
+ *
+ * Call it from a task, which no other task interrupts, so that the figures are taken between runs.
+ *
+ * @param[in]  Copy_u8TaskPriority      The priority of the task.
+ * @param[out] Copy_psStats             Receives the timing of the task.
+ *
+ * @retval     0                        The timing was copied.
+ * @retval     1                        The priority is out of range, the pointer is NULL or SOS_TASK_STATS is disabled.
+ */
+u8 SOS_u8GetTaskStats(u8 Copy_u8TaskPriority, SOS_TaskStats_t* Copy_psStats);
+
+/**
+ * @brief Gets the share of the time since the statistics were last reset spent in all the tasks.
+ *
+ * @param[in]  None
+ *
+ * @retval     The CPU load in hundredths of a percent, 0 when SOS_TASK_STATS is disabled.
+ */
+u16 SOS_u16GetCpuLoad(void);
+
+/**
+ * @brief Clears the timing of all the tasks and starts a new measurement window.
+ *
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     None
+ */
+void SOS_voidResetStats(void);
+
+/**
+ * @brief Sends the timing of the tasks as text lines, for example to a UART.
+ *
+ * One line gives the total CPU load, then one line per created task gives its runs, its minimum,
+ * mean and maximum execution times, its deadline misses and its load:
+ *
+ * @code
+ * SOS t=10000ms load=9.81%
+ * T0 runs=1250 min=52us avg=68us max=154us miss=0 load=8.60%
+ * @endcode
+ *
+ * Each line ends with "\r\n" and is passed to the send function on its own, so a blocking transmit
+ * such as UART_voidTransmit() can be wrapped directly. Nothing is sent when SOS_TASK_STATS is disabled.
+ *
+ * @param[in]  Copy_pfSend              The function that sends a line.
+ *
+ * @retval     None
+ */
+void SOS_voidSendStats(void (*Copy_pfSend)(u8* Copy_pu8Data, u16 Copy_u16Size));
+
 
 
 
@@ -13,34 +13,135 @@
 #define __OS_PRIVATE_H__
 
 
-#define SOS_TICK_TIME       1000
+#define SOS_TICK_TIME       1000        /**< The length of a tick in microseconds. */
+
+#define SOS_NO_TASK         0xFF        /**< Marks the end of the queue of due tasks. */
+
+#if SOS_NUMBER_OS_TASKS > SOS_NO_TASK
+    #error "WRONG CHOICE FOR SOS_NUMBER_OS_TASKS"
+#endif
+
+#if (SOS_NUMBER_EVENTS < 1) || (SOS_NUMBER_EVENTS > 255)
+    #error "WRONG CHOICE FOR SOS_NUMBER_EVENTS"
+#endif
+
+#if (SOS_MAX_SLEEP_TICKS < 1) || (SOS_MAX_SLEEP_TICKS > 2147483)
+    #error "WRONG CHOICE FOR SOS_MAX_SLEEP_TICKS"
+#endif
+
+/**
+ * @brief Specifies whether the scheduler times the runs of the tasks.
+ *
+ * @param SOS_TASK_STATS_ENABLE  The runs of the tasks are timed.
+ * @param SOS_TASK_STATS_DISABLE The runs are not timed.
+ */
+#define SOS_TASK_STATS_ENABLE       1
+#define SOS_TASK_STATS_DISABLE      0
+
+#if (SOS_TASK_STATS != SOS_TASK_STATS_ENABLE) && (SOS_TASK_STATS != SOS_TASK_STATS_DISABLE)
+    #error "WRONG CHOICE FOR SOS_TASK_STATS"
+#endif
+
+#define SOS_STATS_LINE_SIZE 80          /**< The longest line SOS_voidSendStats() sends. */
 
 /**
  * @brief A struct representing a task in the operating system.
  *
  * This struct represents a task in the operating system. It contains the task's
- * priority, periodicity, task function, and first delay.
+ * periodicity, task function or coroutine, and its place in the queue of due tasks.
  */
 typedef struct {
-    u16 Periodicity;                /**< The periodicity of the task in microsecond. */
+    u32 Periodicity;                /**< The periodicity of the task in ticks, 0 for a task that runs once. */
     void (*OS_pfSetTask)(void);     /**< A pointer to the function that implements the task. */
-    u8 FirstDelay;                  /**< The initial delay of the task in ticks. */
-    /**< The current state of the task's scheduler. */
+    void (*OS_pfCoroutine)(SOS_Coroutine_t* Copy_psTask);   /**< The coroutine function, NULL for a task. */
+    SOS_Coroutine_t Coroutine;      /**< Where the coroutine resumes and what it waits for. */
+    u32 Delay;                      /**< The ticks between the release of the previous task in the queue and the release of this task. */
+    u8 Next;                        /**< The priority of the next task in the queue, or SOS_NO_TASK. */
+    u8 Queued;                      /**< 1 while the task waits in the queue. */
 }SOS_Task_t;
 
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+/**
+ * @brief The timing of the runs of a task, kept in the form that is cheapest to update after each run.
+ */
+typedef struct {
+    u32 Runs;                       /**< Counter: runs of the task. */
+    u32 DeadlineMisses;             /**< Counter: runs that ended after the next release of the task. */
+    u32 MinExecutionUs;             /**< Shortest execution time, in microseconds. */
+    u32 MaxExecutionUs;             /**< Longest execution time, in microseconds. */
+    u32 TotalExecutionUs;           /**< Sum of the execution times, in microseconds. */
+}SOS_TaskTiming_t;
+
+/**
+ * @brief The timing of the runs of each task, indexed by priority.
+ */
+static SOS_TaskTiming_t SOS_Timing[SOS_NUMBER_OS_TASKS] = {0};
+
+/**
+ * @brief The time the statistics were last reset at, in microseconds of STMR_u32GetTimeUs().
+ */
+static u32 SOS_u32StatsStart = 0;
+#endif
+
 /**
  * @brief An array containing the registered tasks for the operating system.
  *
  * This array holds the registered tasks for the operating system. Each task is represented
  * by a "SOS_Task_t" structure.
  */
-static SOS_Task_t SOS_Tasks[SOS_NUMBER_OS_TASKS] = {NULL};
+static SOS_Task_t SOS_Tasks[SOS_NUMBER_OS_TASKS] = {0};
+
+/**
+ * @brief The events coroutine tasks wait for, 1 while set.
+ *
+ * Each event is a byte written with a single store, so an interrupt can set it while a task clears it.
+ */
+static volatile u8 SOS_au8Events[SOS_NUMBER_EVENTS] = {0};
+
+/**
+ * @brief The first task of the delta queue, the next task to be released.
+ *
+ * The queued tasks are linked in the order of their release. Each one stores its delay after the
+ * task before it, so the head alone tells when the scheduler must wake up next, and releasing
+ * the due tasks only touches the front of the queue.
+ */
+static u8 SOS_u8QueueHead = SOS_NO_TASK;
+
+/**
+ * @brief The ticks from the last wakeup the scheduler timer runs for, 0 while it is stopped.
+ */
+static u32 SOS_u32SleepTicks = 0;
+
+/**
+ * @brief The time of the last wakeup, in microseconds of STMR_u32GetTimeUs().
+ *
+ * It moves on by the ticks the timer ran for at each wakeup, however late the interrupt was taken,
+ * so the releases stay on the ideal tick grid and the timer is started for an absolute time.
+ */
+static u32 SOS_u32WakeupUs = 0;
+
+/**
+ * @brief The software timer that wakes the scheduler up.
+ */
+static u8 SOS_u8TimerId = 0;
+
+/**
+ * @brief 1 while the scheduler timer is started for the deferred timers that expired.
+ */
+static u8 SOS_u8DeferredPending = 0;
+
+/**
+ * @brief 1 once SOS_voidStart() was called.
+ */
+static u8 SOS_u8Started = 0;
 
 
 /**
  * @brief The scheduler function for the operating system.
  *
- * This function runs the task functions for each registered task at the appropriate times.
+ * This function is called in the SysTick interrupt when the scheduler timer expires. It releases
+ * the due tasks, queues them again at their periodicity, starts the timer for the next due task,
+ * runs the released tasks in priority order and then the callbacks of the deferred timers.
  *
  * @param[in]  None
  * @param[out] None
@@ -49,8 +150,134 @@ static SOS_Task_t SOS_Tasks[SOS_NUMBER_OS_TASKS] = {NULL};
  */
 static void SOS_voidSetScheduler(void);
 
+/**
+ * @brief Wakes the scheduler up to run the callbacks of the deferred timers, the notification of the TMR service.
+ *
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     None
+ */
+static void SOS_voidWakeDeferred(void);
 
+/**
+ * @brief Queues a task to be released after a number of ticks.
+ *
+ * The queue is walked from the head, taking the delays of the tasks passed off the delay, until
+ * a task released later is found. Tasks released on the same tick are kept in priority order.
+ *
+ * @param[in]  Copy_u8TaskPriority      The priority of the task to queue.
+ * @param[in]  Copy_u32Delay            The ticks from the last scheduler wakeup until the release.
+ *
+ * @retval     None
+ */
+static void SOS_voidInsertTask(u8 Copy_u8TaskPriority, u32 Copy_u32Delay);
 
+/**
+ * @brief Takes a task out of the queue, giving its delay to the task after it.
+ *
+ * @param[in]  Copy_u8TaskPriority      The priority of the task to remove.
+ *
+ * @retval     None
+ */
+static void SOS_voidRemoveTask(u8 Copy_u8TaskPriority);
+
+/**
+ * @brief Starts the scheduler timer for the time the head of the queue is due.
+ *
+ * The time is at least one tick and at most SOS_MAX_SLEEP_TICKS after the last wakeup, so starting
+ * the timer again from a task, as a new task or a coroutine wait does, keeps the releases on the
+ * tick grid. A time already past is delivered at once. The timer is stopped while no task is queued.
+ *
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     None
+ */
+static void SOS_voidProgramTimer(void);
+
+/**
+ * @brief Starts the scheduler timer again when the head of the queue is due before the timer expires.
+ *
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     None
+ */
+static void SOS_voidProgramEarlier(void);
+
+/**
+ * @brief Runs a released task, or resumes a coroutine and queues it for the end of its wait.
+ *
+ * @param[in]  Copy_u8TaskPriority      The priority of the task to run.
+ *
+ * @retval     None
+ */
+static void SOS_voidRunTask(u8 Copy_u8TaskPriority);
+
+/**
+ * @brief Queues the coroutines whose event is set, due at the last wakeup.
+ *
+ * @param[in]  None
+ *
+ * @retval     1 if a coroutine was queued, 0 otherwise.
+ */
+static u8 SOS_u8ReleaseWaiting(void);
+
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+/**
+ * @brief Records a run of a task.
+ *
+ * @param[in]  Copy_u8TaskPriority      The priority of the task that ran.
+ * @param[in]  Copy_u32ReleaseUs        The time of the wakeup that released the task.
+ * @param[in]  Copy_u32StartUs          The time the run started.
+ *
+ * @retval     None
+ */
+static void SOS_voidRecordRun(u8 Copy_u8TaskPriority, u32 Copy_u32ReleaseUs, u32 Copy_u32StartUs);
+
+/**
+ * @brief Computes a share of the time since the statistics were last reset.
+ *
+ * @param[in]  Copy_u32Us               The time spent, in microseconds.
+ *
+ * @retval     The share in hundredths of a percent, at most 10000.
+ */
+static u16 SOS_u16GetLoad(u32 Copy_u32Us);
+
+/**
+ * @brief Writes a decimal number at the end of a line.
+ *
+ * @param[in,out] Copy_pu8Line          The line.
+ * @param[in]     Copy_u8Length         The length of the line.
+ * @param[in]     Copy_u32Value         The number.
+ *
+ * @retval     The new length of the line.
+ */
+static u8 SOS_u8AppendNumber(u8* Copy_pu8Line, u8 Copy_u8Length, u32 Copy_u32Value);
+
+/**
+ * @brief Writes a string at the end of a line.
+ *
+ * @param[in,out] Copy_pu8Line          The line.
+ * @param[in]     Copy_u8Length         The length of the line.
+ * @param[in]     Copy_pcText           The string.
+ *
+ * @retval     The new length of the line.
+ */
+static u8 SOS_u8AppendText(u8* Copy_pu8Line, u8 Copy_u8Length, const char* Copy_pcText);
+
+/**
+ * @brief Writes a load in hundredths of a percent as a percentage with two decimals.
+ *
+ * @param[in,out] Copy_pu8Line          The line.
+ * @param[in]     Copy_u8Length         The length of the line.
+ * @param[in]     Copy_u16Load          The load in hundredths of a percent.
+ *
+ * @retval     The new length of the line.
+ */
+static u8 SOS_u8AppendLoad(u8* Copy_pu8Line, u8 Copy_u8Length, u16 Copy_u16Load);
+#endif
 
 
 
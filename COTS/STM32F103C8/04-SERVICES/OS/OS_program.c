@@ -10,23 +10,28 @@
 /**< LIB */
 #include "STD_TYPES.h"
 #include "BIT_MATH.h"
-/**< MCAL */
-#include "STK_interface.h"
 /**< SERVICES */
+#include "TMR_interface.h"
 #include "OS_config.h"
 #include "OS_interface.h"
 #include "OS_private.h"
 
 
 /****************************************< FUNCTIONS IMPLEMENTATION ****************************************/
-u8 SOS_u8CreateTask(u8 Copy_u8TaskPriority, u16 Copy_u16TaskPeriodicity, void (*Copy_pfTask)(void), u8 Copy_u8FirstDelay)
+u8 SOS_u8CreateTask(u8 Copy_u8TaskPriority, u32 Copy_u32TaskPeriodicity, void (*Copy_pfTask)(void), u32 Copy_u32FirstDelay)
 {
     u8 Local_u8ErrorStatus = 0;
-    if(Copy_pfTask != NULL)
+    if((Copy_pfTask != NULL) && (Copy_u8TaskPriority < SOS_NUMBER_OS_TASKS))
     {
-        SOS_Tasks[Copy_u8TaskPriority].Periodicity = Copy_u16TaskPeriodicity;
+        /**< A task created again at its priority takes the place of the earlier one */
+        SOS_voidRemoveTask(Copy_u8TaskPriority);
+        SOS_Tasks[Copy_u8TaskPriority].Periodicity = Copy_u32TaskPeriodicity;
         SOS_Tasks[Copy_u8TaskPriority].OS_pfSetTask = Copy_pfTask;
-        SOS_Tasks[Copy_u8TaskPriority].FirstDelay = Copy_u8FirstDelay;
+        SOS_Tasks[Copy_u8TaskPriority].OS_pfCoroutine = NULL;
+        SOS_voidInsertTask(Copy_u8TaskPriority, Copy_u32FirstDelay);
+
+        /**< Wake up earlier if the running scheduler would sleep past the new task */
+        SOS_voidProgramEarlier();
     }
     else
     {
@@ -34,29 +39,426 @@ u8 SOS_u8CreateTask(u8 Copy_u8TaskPriority, u16 Copy_u16TaskPeriodicity, void (*
     }
     return Local_u8ErrorStatus;
 }
+
+u8 SOS_u8CreateCoroutine(u8 Copy_u8TaskPriority, void (*Copy_pfCoroutine)(SOS_Coroutine_t* Copy_psTask), u32 Copy_u32FirstDelay)
+{
+    u8 Local_u8ErrorStatus = 0;
+    if((Copy_pfCoroutine != NULL) && (Copy_u8TaskPriority < SOS_NUMBER_OS_TASKS))
+    {
+        SOS_voidRemoveTask(Copy_u8TaskPriority);
+        SOS_Tasks[Copy_u8TaskPriority].Periodicity = 0;
+        SOS_Tasks[Copy_u8TaskPriority].OS_pfSetTask = NULL;
+        SOS_Tasks[Copy_u8TaskPriority].OS_pfCoroutine = Copy_pfCoroutine;
+        /**< The coroutine starts from SOS_BEGIN() */
+        SOS_Tasks[Copy_u8TaskPriority].Coroutine.Line = 0;
+        SOS_Tasks[Copy_u8TaskPriority].Coroutine.State = SOS_COROUTINE_SLEEPING;
+        SOS_voidInsertTask(Copy_u8TaskPriority, Copy_u32FirstDelay);
+
+        SOS_voidProgramEarlier();
+    }
+    else
+    {
+        Local_u8ErrorStatus = 1;
+    }
+    return Local_u8ErrorStatus;
+}
+
+void SOS_voidSetEvent(u8 Copy_u8Event)
+{
+    if(Copy_u8Event < SOS_NUMBER_EVENTS)
+    {
+        SOS_au8Events[Copy_u8Event] = 1;
+    }
+}
+
+u8 SOS_u8TakeEvent(u8 Copy_u8Event)
+{
+    u8 Local_u8Taken = 0;
+    if((Copy_u8Event < SOS_NUMBER_EVENTS) && (SOS_au8Events[Copy_u8Event] == 1))
+    {
+        SOS_au8Events[Copy_u8Event] = 0;
+        Local_u8Taken = 1;
+    }
+    return Local_u8Taken;
+}
+
+u8 SOS_u8GetTaskStats(u8 Copy_u8TaskPriority, SOS_TaskStats_t* Copy_psStats)
+{
+    u8 Local_u8ErrorStatus = 1;
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+    if((Copy_psStats != NULL) && (Copy_u8TaskPriority < SOS_NUMBER_OS_TASKS))
+    {
+        SOS_TaskTiming_t* Local_psTiming = &SOS_Timing[Copy_u8TaskPriority];
+        Copy_psStats->Runs = Local_psTiming->Runs;
+        Copy_psStats->DeadlineMisses = Local_psTiming->DeadlineMisses;
+        Copy_psStats->MinExecutionUs = Local_psTiming->MinExecutionUs;
+        Copy_psStats->AvgExecutionUs = (Local_psTiming->Runs > 0) ? (Local_psTiming->TotalExecutionUs / Local_psTiming->Runs) : 0;
+        Copy_psStats->MaxExecutionUs = Local_psTiming->MaxExecutionUs;
+        Copy_psStats->TotalExecutionUs = Local_psTiming->TotalExecutionUs;
+        Copy_psStats->Load = SOS_u16GetLoad(Local_psTiming->TotalExecutionUs);
+        Local_u8ErrorStatus = 0;
+    }
+#endif
+    return Local_u8ErrorStatus;
+}
+
+u16 SOS_u16GetCpuLoad(void)
+{
+    u16 Local_u16Load = 0;
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+    u32 Local_u32TotalUs = 0;
+    for(u8 Local_u8Count = 0; Local_u8Count < SOS_NUMBER_OS_TASKS; Local_u8Count++)
+    {
+        Local_u32TotalUs += SOS_Timing[Local_u8Count].TotalExecutionUs;
+    }
+    Local_u16Load = SOS_u16GetLoad(Local_u32TotalUs);
+#endif
+    return Local_u16Load;
+}
+
+void SOS_voidResetStats(void)
+{
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+    for(u8 Local_u8Count = 0; Local_u8Count < SOS_NUMBER_OS_TASKS; Local_u8Count++)
+    {
+        SOS_Timing[Local_u8Count].Runs = 0;
+        SOS_Timing[Local_u8Count].DeadlineMisses = 0;
+        SOS_Timing[Local_u8Count].MinExecutionUs = 0;
+        SOS_Timing[Local_u8Count].MaxExecutionUs = 0;
+        SOS_Timing[Local_u8Count].TotalExecutionUs = 0;
+    }
+    SOS_u32StatsStart = STMR_u32GetTimeUs();
+#endif
+}
+
+void SOS_voidSendStats(void (*Copy_pfSend)(u8* Copy_pu8Data, u16 Copy_u16Size))
+{
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+    if(Copy_pfSend != NULL)
+    {
+        u8 Local_u8Line[SOS_STATS_LINE_SIZE];
+        u8 Local_u8Length = 0;
+
+        Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, "SOS t=");
+        Local_u8Length = SOS_u8AppendNumber(Local_u8Line, Local_u8Length, (STMR_u32GetTimeUs() - SOS_u32StatsStart) / SOS_TICK_TIME);
+        Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, "ms load=");
+        Local_u8Length = SOS_u8AppendLoad(Local_u8Line, Local_u8Length, SOS_u16GetCpuLoad());
+        Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, "\r\n");
+        Copy_pfSend(Local_u8Line, Local_u8Length);
+
+        for(u8 Local_u8Count = 0; Local_u8Count < SOS_NUMBER_OS_TASKS; Local_u8Count++)
+        {
+            SOS_TaskStats_t Local_sStats;
+            if(((SOS_Tasks[Local_u8Count].OS_pfSetTask != NULL) || (SOS_Tasks[Local_u8Count].OS_pfCoroutine != NULL))
+                && (SOS_u8GetTaskStats(Local_u8Count, &Local_sStats) == 0))
+            {
+                Local_u8Length = SOS_u8AppendText(Local_u8Line, 0, "T");
+                Local_u8Length = SOS_u8AppendNumber(Local_u8Line, Local_u8Length, Local_u8Count);
+                Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, " runs=");
+                Local_u8Length = SOS_u8AppendNumber(Local_u8Line, Local_u8Length, Local_sStats.Runs);
+                Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, " min=");
+                Local_u8Length = SOS_u8AppendNumber(Local_u8Line, Local_u8Length, Local_sStats.MinExecutionUs);
+                Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, "us avg=");
+                Local_u8Length = SOS_u8AppendNumber(Local_u8Line, Local_u8Length, Local_sStats.AvgExecutionUs);
+                Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, "us max=");
+                Local_u8Length = SOS_u8AppendNumber(Local_u8Line, Local_u8Length, Local_sStats.MaxExecutionUs);
+                Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, "us miss=");
+                Local_u8Length = SOS_u8AppendNumber(Local_u8Line, Local_u8Length, Local_sStats.DeadlineMisses);
+                Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, " load=");
+                Local_u8Length = SOS_u8AppendLoad(Local_u8Line, Local_u8Length, Local_sStats.Load);
+                Local_u8Length = SOS_u8AppendText(Local_u8Line, Local_u8Length, "\r\n");
+                Copy_pfSend(Local_u8Line, Local_u8Length);
+            }
+        }
+    }
+#endif
+}
+
 void SOS_voidStart(void)
 {
     /*****************************< Initialization *****************************/
-    MSTK_voidInit();
-    /**< Set the Tick time to be ===> 1msec */
-    MSTK_voidSetIntervalPeriodic(SOS_TICK_TIME,SOS_voidSetScheduler);
+    STMR_voidInit();
+    /**< The scheduler wakes up with a timer of its own, so SysTick stays shared with the other timers */
+    if(STMR_u8CreateTimer(SOS_voidSetScheduler, STMR_DELIVER_ISR, &SOS_u8TimerId) == 0)
+    {
+        STMR_voidSetDeferredNotify(SOS_voidWakeDeferred);
+        SOS_u32WakeupUs = STMR_u32GetTimeUs();
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+        SOS_u32StatsStart = SOS_u32WakeupUs;
+#endif
+        SOS_u8Started = 1;
+        /**< Sleep until the first task is due */
+        SOS_voidProgramTimer();
+    }
 }
 
 static void SOS_voidSetScheduler(void)
 {
-    for (u8 Local_u8Count = 0; Local_u8Count < SOS_NUMBER_OS_TASKS;Local_u8Count++)
+    u8 Local_u8Released[SOS_NUMBER_OS_TASKS];
+    u8 Local_u8ReleasedCount = 0;
+
+    /**< The wakeup is on the last whole tick, however late the interrupt came, so the releases stay on the tick
+         grid. Ticks the tasks overran are released together now instead of in a burst of wakeups, and a wakeup
+         for a deferred timer between two ticks releases only what is due. The timer is one-shot: it runs again
+         once started for the next due task */
+    u32 Local_u32Elapsed = (STMR_u32GetTimeUs() - SOS_u32WakeupUs) / SOS_TICK_TIME;
+    SOS_u32WakeupUs += Local_u32Elapsed * SOS_TICK_TIME;
+    SOS_u32SleepTicks = 0;
+
+    /**< Coroutines whose event an interrupt set while the scheduler slept are released with the due tasks */
+    SOS_u8ReleaseWaiting();
+
+    /**< Release the tasks due within the interval that just ended, which are at the front of the queue in
+         priority order for the same tick */
+    while((SOS_u8QueueHead != SOS_NO_TASK) && (SOS_Tasks[SOS_u8QueueHead].Delay <= Local_u32Elapsed))
+    {
+        Local_u32Elapsed -= SOS_Tasks[SOS_u8QueueHead].Delay;
+        Local_u8Released[Local_u8ReleasedCount] = SOS_u8QueueHead;
+        Local_u8ReleasedCount++;
+        SOS_Tasks[SOS_u8QueueHead].Queued = 0;
+        SOS_u8QueueHead = SOS_Tasks[SOS_u8QueueHead].Next;
+    }
+    /**< The rest of the queue is now timed from this wakeup */
+    if(SOS_u8QueueHead != SOS_NO_TASK)
+    {
+        SOS_Tasks[SOS_u8QueueHead].Delay -= Local_u32Elapsed;
+    }
+
+    /**< Queue the periodic tasks again and program the next wakeup before running anything, so the
+         execution time of the tasks does not delay the following releases */
+    for(u8 Local_u8Count = 0; Local_u8Count < Local_u8ReleasedCount; Local_u8Count++)
     {
-        if(SOS_Tasks[Local_u8Count].OS_pfSetTask != NULL)
+        if(SOS_Tasks[Local_u8Released[Local_u8Count]].Periodicity != 0)
         {
-            if(SOS_Tasks[Local_u8Count].FirstDelay == 0)
-            {
-                SOS_Tasks[Local_u8Count].FirstDelay = ((SOS_Tasks[Local_u8Count].Periodicity)/SOS_TICK_TIME)-1;
-                SOS_Tasks[Local_u8Count].OS_pfSetTask();
-            }
-            else
-            {
-                SOS_Tasks[Local_u8Count].FirstDelay--;
-            }
+            SOS_voidInsertTask(Local_u8Released[Local_u8Count], SOS_Tasks[Local_u8Released[Local_u8Count]].Periodicity);
+        }
+    }
+    SOS_voidProgramTimer();
+
+    for(u8 Local_u8Count = 0; Local_u8Count < Local_u8ReleasedCount; Local_u8Count++)
+    {
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+        u32 Local_u32StartUs = STMR_u32GetTimeUs();
+        SOS_voidRunTask(Local_u8Released[Local_u8Count]);
+        SOS_voidRecordRun(Local_u8Released[Local_u8Count], SOS_u32WakeupUs, Local_u32StartUs);
+#else
+        SOS_voidRunTask(Local_u8Released[Local_u8Count]);
+#endif
+    }
+
+    /**< The deferred timers run after the tasks, which they do not delay */
+    SOS_u8DeferredPending = 0;
+    STMR_voidRunDeferred();
+
+    /**< Coroutines whose event the tasks set run on the next tick */
+    if(SOS_u8ReleaseWaiting() == 1)
+    {
+        SOS_voidProgramEarlier();
+    }
+}
+
+static void SOS_voidWakeDeferred(void)
+{
+    /**< Called in the SysTick interrupt, where the scheduler timer can be started: the scheduler wakes up at once */
+    if(SOS_u8DeferredPending == 0)
+    {
+        SOS_u8DeferredPending = 1;
+        STMR_u8StartTimerAt(SOS_u8TimerId, STMR_u32GetTimeUs(), 0);
+    }
+}
+
+static void SOS_voidInsertTask(u8 Copy_u8TaskPriority, u32 Copy_u32Delay)
+{
+    u8* Local_pu8Link = &SOS_u8QueueHead;
+
+    /**< Pass the tasks released earlier, and those released on the same tick with a higher priority */
+    while((*Local_pu8Link != SOS_NO_TASK)
+        && ((Copy_u32Delay > SOS_Tasks[*Local_pu8Link].Delay)
+            || ((Copy_u32Delay == SOS_Tasks[*Local_pu8Link].Delay) && (*Local_pu8Link < Copy_u8TaskPriority))))
+    {
+        Copy_u32Delay -= SOS_Tasks[*Local_pu8Link].Delay;
+        Local_pu8Link = &SOS_Tasks[*Local_pu8Link].Next;
+    }
+
+    /**< The task after the new one is now released relative to it */
+    if(*Local_pu8Link != SOS_NO_TASK)
+    {
+        SOS_Tasks[*Local_pu8Link].Delay -= Copy_u32Delay;
+    }
+    SOS_Tasks[Copy_u8TaskPriority].Delay = Copy_u32Delay;
+    SOS_Tasks[Copy_u8TaskPriority].Next = *Local_pu8Link;
+    SOS_Tasks[Copy_u8TaskPriority].Queued = 1;
+    *Local_pu8Link = Copy_u8TaskPriority;
+}
+
+static void SOS_voidRemoveTask(u8 Copy_u8TaskPriority)
+{
+    if(SOS_Tasks[Copy_u8TaskPriority].Queued == 1)
+    {
+        u8* Local_pu8Link = &SOS_u8QueueHead;
+        while(*Local_pu8Link != Copy_u8TaskPriority)
+        {
+            Local_pu8Link = &SOS_Tasks[*Local_pu8Link].Next;
+        }
+        *Local_pu8Link = SOS_Tasks[Copy_u8TaskPriority].Next;
+        if(*Local_pu8Link != SOS_NO_TASK)
+        {
+            SOS_Tasks[*Local_pu8Link].Delay += SOS_Tasks[Copy_u8TaskPriority].Delay;
+        }
+        SOS_Tasks[Copy_u8TaskPriority].Queued = 0;
+    }
+}
+
+static void SOS_voidProgramTimer(void)
+{
+    if(SOS_u8QueueHead != SOS_NO_TASK)
+    {
+        SOS_u32SleepTicks = SOS_Tasks[SOS_u8QueueHead].Delay;
+        if(SOS_u32SleepTicks < 1)
+        {
+            SOS_u32SleepTicks = 1;
         }
+        else if(SOS_u32SleepTicks > SOS_MAX_SLEEP_TICKS)
+        {
+            SOS_u32SleepTicks = SOS_MAX_SLEEP_TICKS;
+        }
+        /**< The expiry is counted from the last wakeup, which the queue delays are relative to, so the time the
+             tasks ran since does not delay the following releases */
+        STMR_u8StartTimerAt(SOS_u8TimerId, SOS_u32WakeupUs + (SOS_u32SleepTicks * SOS_TICK_TIME), 0);
+    }
+    else
+    {
+        /**< No task is queued: the scheduler sleeps until a task is created */
+        STMR_u8StopTimer(SOS_u8TimerId);
+        SOS_u32SleepTicks = 0;
+    }
+}
+
+static void SOS_voidProgramEarlier(void)
+{
+    if((SOS_u8Started == 1) && (SOS_u8QueueHead != SOS_NO_TASK)
+        && ((SOS_u32SleepTicks == 0) || (SOS_Tasks[SOS_u8QueueHead].Delay < SOS_u32SleepTicks)))
+    {
+        SOS_voidProgramTimer();
+    }
+}
+
+static void SOS_voidRunTask(u8 Copy_u8TaskPriority)
+{
+    SOS_Task_t* Local_psTask = &SOS_Tasks[Copy_u8TaskPriority];
+    if(Local_psTask->OS_pfCoroutine != NULL)
+    {
+        /**< A coroutine that returns without a wait has ended */
+        Local_psTask->Coroutine.State = SOS_COROUTINE_ENDED;
+        Local_psTask->OS_pfCoroutine(&Local_psTask->Coroutine);
+        if(Local_psTask->Coroutine.State == SOS_COROUTINE_SLEEPING)
+        {
+            /**< The wait is counted from the wakeup that released the coroutine, like a period */
+            SOS_voidInsertTask(Copy_u8TaskPriority, Local_psTask->Coroutine.Ticks);
+            SOS_voidProgramEarlier();
+        }
+    }
+    else
+    {
+        Local_psTask->OS_pfSetTask();
     }
 }
+
+static u8 SOS_u8ReleaseWaiting(void)
+{
+    u8 Local_u8Released = 0;
+    for(u8 Local_u8Count = 0; Local_u8Count < SOS_NUMBER_OS_TASKS; Local_u8Count++)
+    {
+        /**< The event is left set: SOS_WAIT_EVENT() takes it when the coroutine resumes */
+        if((SOS_Tasks[Local_u8Count].OS_pfCoroutine != NULL) && (SOS_Tasks[Local_u8Count].Queued == 0)
+            && (SOS_Tasks[Local_u8Count].Coroutine.State == SOS_COROUTINE_WAITING)
+            && (SOS_Tasks[Local_u8Count].Coroutine.Event < SOS_NUMBER_EVENTS)
+            && (SOS_au8Events[SOS_Tasks[Local_u8Count].Coroutine.Event] == 1))
+        {
+            SOS_voidInsertTask(Local_u8Count, 0);
+            Local_u8Released = 1;
+        }
+    }
+    return Local_u8Released;
+}
+
+#if SOS_TASK_STATS == SOS_TASK_STATS_ENABLE
+static void SOS_voidRecordRun(u8 Copy_u8TaskPriority, u32 Copy_u32ReleaseUs, u32 Copy_u32StartUs)
+{
+    SOS_TaskTiming_t* Local_psTiming = &SOS_Timing[Copy_u8TaskPriority];
+    u32 Local_u32EndUs = STMR_u32GetTimeUs();
+    u32 Local_u32ExecutionUs = Local_u32EndUs - Copy_u32StartUs;
+
+    if((Local_psTiming->Runs == 0) || (Local_u32ExecutionUs < Local_psTiming->MinExecutionUs))
+    {
+        Local_psTiming->MinExecutionUs = Local_u32ExecutionUs;
+    }
+    if(Local_u32ExecutionUs > Local_psTiming->MaxExecutionUs)
+    {
+        Local_psTiming->MaxExecutionUs = Local_u32ExecutionUs;
+    }
+    Local_psTiming->TotalExecutionUs += Local_u32ExecutionUs;
+    Local_psTiming->Runs++;
+
+    /**< The deadline of a periodic run is the next release of the task, one period after the wakeup that released it */
+    if((SOS_Tasks[Copy_u8TaskPriority].Periodicity != 0)
+        && ((Local_u32EndUs - Copy_u32ReleaseUs) > (SOS_Tasks[Copy_u8TaskPriority].Periodicity * SOS_TICK_TIME)))
+    {
+        Local_psTiming->DeadlineMisses++;
+    }
+}
+
+static u16 SOS_u16GetLoad(u32 Copy_u32Us)
+{
+    u16 Local_u16Load = 0;
+    u32 Local_u32WindowUs = STMR_u32GetTimeUs() - SOS_u32StatsStart;
+
+    if(Local_u32WindowUs > 0)
+    {
+        /**< In floating point: the execution time times 10000 overflows 32 bits after 7 minutes */
+        f32 Local_f32Load = ((f32)Copy_u32Us * 10000.0f) / (f32)Local_u32WindowUs;
+        Local_u16Load = (Local_f32Load < 10000.0f) ? (u16)Local_f32Load : 10000;
+    }
+    return Local_u16Load;
+}
+
+static u8 SOS_u8AppendNumber(u8* Copy_pu8Line, u8 Copy_u8Length, u32 Copy_u32Value)
+{
+    u8 Local_u8Digits[10];
+    u8 Local_u8Count = 0;
+
+    do
+    {
+        Local_u8Digits[Local_u8Count] = (u8)('0' + (Copy_u32Value % 10));
+        Local_u8Count++;
+        Copy_u32Value /= 10;
+    } while(Copy_u32Value != 0);
+
+    while((Local_u8Count > 0) && (Copy_u8Length < SOS_STATS_LINE_SIZE))
+    {
+        Local_u8Count--;
+        Copy_pu8Line[Copy_u8Length] = Local_u8Digits[Local_u8Count];
+        Copy_u8Length++;
+    }
+    return Copy_u8Length;
+}
+
+static u8 SOS_u8AppendText(u8* Copy_pu8Line, u8 Copy_u8Length, const char* Copy_pcText)
+{
+    while((*Copy_pcText != '\0') && (Copy_u8Length < SOS_STATS_LINE_SIZE))
+    {
+        Copy_pu8Line[Copy_u8Length] = (u8)*Copy_pcText;
+        Copy_u8Length++;
+        Copy_pcText++;
+    }
+    return Copy_u8Length;
+}
+
+static u8 SOS_u8AppendLoad(u8* Copy_pu8Line, u8 Copy_u8Length, u16 Copy_u16Load)
+{
+    Copy_u8Length = SOS_u8AppendNumber(Copy_pu8Line, Copy_u8Length, Copy_u16Load / 100);
+    Copy_u8Length = SOS_u8AppendText(Copy_pu8Line, Copy_u8Length, ((Copy_u16Load % 100) < 10) ? ".0" : ".");
+    Copy_u8Length = SOS_u8AppendNumber(Copy_pu8Line, Copy_u8Length, Copy_u16Load % 100);
+    return SOS_u8AppendText(Copy_pu8Line, Copy_u8Length, "%");
+}
+#endif
@@ -0,0 +1,33 @@
+/**
+ * @file TMR_config.h
+ * @brief This file contains the configuration options for the software timer module.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#ifndef __TMR_CONFIG_H__
+#define __TMR_CONFIG_H__
+
+
+/**
+ * @brief The number of software timers, including the one SOS creates for its wakeups.
+ *
+ * The timers are a static table: creating one takes a free entry and allocates nothing.
+ */
+#define STMR_NUMBER_TIMERS              8
+
+/**
+ * @brief The function the timer service reads the SysTick counts elapsed in the current interval with.
+ *
+ * A port can supply its own: the PSIM host port is built with
+ * -DSTMR_ELAPSED_COUNTS=PSIM_u32GetElapsedCounts, which brings the simulated SysTick up to date first.
+ */
+#ifndef STMR_ELAPSED_COUNTS
+#define STMR_ELAPSED_COUNTS             MSTK_u32GetElapsedCounts
+#endif
+
+
+
+
+#endif /**< __TMR_CONFIG_H__ */
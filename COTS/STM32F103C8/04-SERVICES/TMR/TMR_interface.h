@@ -0,0 +1,149 @@
+/**
+ * @file TMR_interface.h
+ * @brief This file contains the public interface of the software timer module.
+ *
+ * The module multiplexes any number of one-shot and periodic timers, up to STMR_NUMBER_TIMERS, on
+ * the single SysTick. It owns SysTick: the scheduler, the drivers and the application each create
+ * their timers instead of programming SysTick with a callback of their own, which replaced the
+ * callback of whoever programmed it before.
+ *
+ * SysTick runs in periodic mode, so the counter reloads by itself and the time base counts on
+ * through each interrupt without losing the interrupt latency. It is programmed for the first timer
+ * to expire only, so no interrupt is taken while no timer expires; timers further away than the
+ * 24-bit counter reaches take several intervals.
+ *
+ * A timer expiry is delivered in one of two ways:
+ * - STMR_DELIVER_ISR: the callback runs in the SysTick interrupt at the expiry. It should be short.
+ * - STMR_DELIVER_DEFERRED: the expiry is recorded and the callback runs from STMR_voidRunDeferred(),
+ *   so a long callback does not delay the other timers. Once SOS_voidStart() is called, the
+ *   scheduler wakes up for it and runs the deferred callbacks after the tasks due at that time.
+ *
+ * Timers are created, started and stopped from the timer callbacks, from SOS tasks, which run in
+ * the SysTick interrupt, or before the scheduler starts, not from other interrupt handlers: an
+ * interrupt handler sets an SOS event instead.
+ *
+ * @code
+ * u8 Local_u8Blink;
+ * STMR_u8CreateTimer(App_voidToggleLed, STMR_DELIVER_ISR, &Local_u8Blink);
+ * STMR_u8StartTimer(Local_u8Blink, 250000, 250000);      // every 250 ms
+ * @endcode
+ *
+ * The STD_TYPES header must be included before this header.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#ifndef __TMR_INTERFACE_H__
+#define __TMR_INTERFACE_H__
+
+
+/**
+ * @brief How the expiries of a timer are delivered.
+ */
+#define STMR_DELIVER_ISR            0       /**< The callback runs in the SysTick interrupt. */
+#define STMR_DELIVER_DEFERRED       1       /**< The callback runs from STMR_voidRunDeferred(). */
+
+
+/**
+ * @brief Initializes SysTick for the timer service; calling it again does nothing.
+ *
+ * SOS_voidStart() calls it, so an application that uses SOS does not need to.
+ *
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     None
+ */
+void STMR_voidInit(void);
+
+/**
+ * @brief Creates a timer, stopped.
+ *
+ * @param[in]  Copy_pfCallback          The function called at each expiry.
+ * @param[in]  Copy_u8Delivery          STMR_DELIVER_ISR or STMR_DELIVER_DEFERRED.
+ * @param[out] Copy_pu8TimerId          Receives the identifier of the timer.
+ *
+ * @retval     0                        The timer was created.
+ * @retval     1                        A pointer is NULL, the delivery is wrong or all the timers are taken.
+ */
+u8 STMR_u8CreateTimer(void (*Copy_pfCallback)(void), u8 Copy_u8Delivery, u8* Copy_pu8TimerId);
+
+/**
+ * @brief Starts a timer that expires after a delay, restarting it if it runs.
+ *
+ * @param[in]  Copy_u8TimerId           The timer.
+ * @param[in]  Copy_u32DelayUs          The microseconds from now to the first expiry.
+ * @param[in]  Copy_u32PeriodUs         The microseconds between the following expiries, 0 for a one-shot timer.
+ *
+ * @retval     0                        The timer was started.
+ * @retval     1                        The timer was not created.
+ */
+u8 STMR_u8StartTimer(u8 Copy_u8TimerId, u32 Copy_u32DelayUs, u32 Copy_u32PeriodUs);
+
+/**
+ * @brief Starts a timer that expires at a time of STMR_u32GetTimeUs(), restarting it if it runs.
+ *
+ * Periodic work that computes each expiry from the previous one stays on its grid however late the
+ * timer is started. An expiry already past is delivered at once.
+ *
+ * @param[in]  Copy_u8TimerId           The timer.
+ * @param[in]  Copy_u32ExpiryUs         The time of the first expiry, less than 2^31 microseconds from now.
+ * @param[in]  Copy_u32PeriodUs         The microseconds between the following expiries, 0 for a one-shot timer.
+ *
+ * @retval     0                        The timer was started.
+ * @retval     1                        The timer was not created.
+ */
+u8 STMR_u8StartTimerAt(u8 Copy_u8TimerId, u32 Copy_u32ExpiryUs, u32 Copy_u32PeriodUs);
+
+/**
+ * @brief Stops a timer. A deferred expiry already recorded is still delivered.
+ *
+ * @param[in]  Copy_u8TimerId           The timer.
+ *
+ * @retval     0                        The timer is stopped.
+ * @retval     1                        The timer was not created.
+ */
+u8 STMR_u8StopTimer(u8 Copy_u8TimerId);
+
+/**
+ * @brief Gets the time of the timer service.
+ *
+ * The time counts on whatever the timers do and wraps around after 2^32 microseconds, about 71
+ * minutes: compare two times by the sign of their difference as s32.
+ *
+ * @param[in]  None
+ *
+ * @retval     The microseconds since STMR_voidInit().
+ */
+u32 STMR_u32GetTimeUs(void);
+
+/**
+ * @brief Runs the callbacks of the deferred timers that expired since the last call.
+ *
+ * The SOS scheduler calls it; an application without SOS calls it from its background loop. Several
+ * expiries of a timer since the last call run its callback once.
+ *
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     None
+ */
+void STMR_voidRunDeferred(void);
+
+/**
+ * @brief Sets the function called in the SysTick interrupt when a deferred timer expires.
+ *
+ * It wakes whoever calls STMR_voidRunDeferred(). SOS_voidStart() sets it to wake the scheduler up,
+ * so an application that uses SOS does not set it.
+ *
+ * @param[in]  Copy_pfNotify            The function, NULL for none.
+ *
+ * @retval     None
+ */
+void STMR_voidSetDeferredNotify(void (*Copy_pfNotify)(void));
+
+
+
+
+#endif /**< __TMR_INTERFACE_H__ */
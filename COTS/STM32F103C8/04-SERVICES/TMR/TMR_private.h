@@ -0,0 +1,139 @@
+/**
+ * @file TMR_private.h
+ * @brief This file contains the private interface of the software timer module.
+ *
+ * This file should not be included directly by application code.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#ifndef __TMR_PRIVATE_H__
+#define __TMR_PRIVATE_H__
+
+
+#define STMR_NO_TIMER           0xFF        /**< Marks the end of the list of running timers. */
+
+#if (STMR_NUMBER_TIMERS < 1) || (STMR_NUMBER_TIMERS >= STMR_NO_TIMER)
+    #error "WRONG CHOICE FOR STMR_NUMBER_TIMERS"
+#endif
+
+#define STMR_MAX_INTERVAL_US    (0x00FFFFFF / MSTK_u32GetCountsPerUs())  /**< The longest SysTick interval, the 24-bit counter. */
+#define STMR_MIN_INTERVAL_US    10          /**< The shortest SysTick interval, for an expiry that is already past. */
+
+/**
+ * @brief A software timer.
+ */
+typedef struct {
+    void (*Callback)(void);         /**< The function called at each expiry, NULL while the timer is not created. */
+    u32 ExpiryUs;                   /**< The time of the next expiry. */
+    u32 PeriodUs;                   /**< The time between expiries, 0 for a one-shot timer. */
+    u8 Delivery;                    /**< STMR_DELIVER_ISR or STMR_DELIVER_DEFERRED. */
+    u8 Running;                     /**< 1 while the timer is in the list of running timers. */
+    u8 Pending;                     /**< 1 while a deferred expiry waits for STMR_voidRunDeferred(). */
+    u8 Next;                        /**< The next timer to expire, or STMR_NO_TIMER. */
+}STMR_Timer_t;
+
+/**
+ * @brief The timers, indexed by their identifier.
+ */
+static STMR_Timer_t STMR_Timers[STMR_NUMBER_TIMERS] = {0};
+
+/**
+ * @brief The first running timer to expire; the running timers are linked in the order of their expiry.
+ */
+static u8 STMR_u8Head = STMR_NO_TIMER;
+
+/**
+ * @brief The time the running SysTick interval started at, in microseconds since STMR_voidInit().
+ */
+static u32 STMR_u32BaseUs = 0;
+
+/**
+ * @brief The length of the running SysTick interval in microseconds, 0 while SysTick is stopped.
+ */
+static u32 STMR_u32IntervalUs = 0;
+
+/**
+ * @brief The last time STMR_u32GetTimeUs() returned, which it never goes below.
+ */
+static u32 STMR_u32LastTimeUs = 0;
+
+/**
+ * @brief 1 while the SysTick interrupt delivers the expiries; SysTick is programmed when it ends.
+ */
+static u8 STMR_u8InHandler = 0;
+
+/**
+ * @brief 1 once STMR_voidInit() was called.
+ */
+static u8 STMR_u8Initialized = 0;
+
+/**
+ * @brief The function called when a deferred timer expires, or NULL.
+ */
+static void (*STMR_pfDeferredNotify)(void) = NULL;
+
+/**
+ * @brief The function that reads the SysTick counts elapsed in the current interval, see STMR_ELAPSED_COUNTS.
+ */
+u32 STMR_ELAPSED_COUNTS(void);
+
+
+/**
+ * @brief The SysTick callback: delivers the expired timers and programs the next interval.
+ *
+ * SysTick reloaded by itself at the end of the interval, so the interval is added to the base
+ * and the counter already counts the latency of the interrupt. The interval ended if the count
+ * flag the STK driver latched is set; a read of CTRL elsewhere in the driver does not lose it. While the callbacks run, SysTick
+ * counts its longest interval, so they are timed without the counter wrapping; a timer that
+ * expires meanwhile is delivered when they end.
+ *
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     None
+ */
+static void STMR_voidOnInterrupt(void);
+
+/**
+ * @brief Restarts SysTick for an interval, adding the time counted in the interval it ran to the base.
+ *
+ * @param[in]  Copy_u32IntervalUs       The new interval in microseconds, 0 to stop SysTick.
+ *
+ * @retval     None
+ */
+static void STMR_voidRestart(u32 Copy_u32IntervalUs);
+
+/**
+ * @brief Programs SysTick for the first timer to expire, unless the SysTick interrupt will when it ends.
+ *
+ * @param[in]  None
+ * @param[out] None
+ *
+ * @retval     None
+ */
+static void STMR_voidProgram(void);
+
+/**
+ * @brief Links a timer into the list of running timers after the timers expiring earlier or at the same time.
+ *
+ * @param[in]  Copy_u8TimerId           The timer.
+ *
+ * @retval     None
+ */
+static void STMR_voidInsert(u8 Copy_u8TimerId);
+
+/**
+ * @brief Unlinks a timer from the list of running timers if it is in it.
+ *
+ * @param[in]  Copy_u8TimerId           The timer.
+ *
+ * @retval     None
+ */
+static void STMR_voidRemove(u8 Copy_u8TimerId);
+
+
+
+
+#endif /**< __TMR_PRIVATE_H__ */
@@ -0,0 +1,241 @@
+/**
+ * @file TMR_program.c
+ * @brief This file contains the implementation of the software timer module.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+/**< LIB */
+#include "STD_TYPES.h"
+/**< MCAL */
+#include "STK_interface.h"
+/**< SERVICES */
+#include "TMR_config.h"
+#include "TMR_interface.h"
+#include "TMR_private.h"
+
+
+/****************************************< FUNCTIONS IMPLEMENTATION ****************************************/
+void STMR_voidInit(void)
+{
+    if(STMR_u8Initialized == 0)
+    {
+        MSTK_voidInit();
+        STMR_u8Initialized = 1;
+        /**< Program the timers started before */
+        STMR_voidProgram();
+    }
+}
+
+u8 STMR_u8CreateTimer(void (*Copy_pfCallback)(void), u8 Copy_u8Delivery, u8* Copy_pu8TimerId)
+{
+    u8 Local_u8ErrorStatus = 1;
+    if((Copy_pfCallback != NULL) && (Copy_pu8TimerId != NULL)
+        && ((Copy_u8Delivery == STMR_DELIVER_ISR) || (Copy_u8Delivery == STMR_DELIVER_DEFERRED)))
+    {
+        for(u8 Local_u8Count = 0; (Local_u8Count < STMR_NUMBER_TIMERS) && (Local_u8ErrorStatus == 1); Local_u8Count++)
+        {
+            if(STMR_Timers[Local_u8Count].Callback == NULL)
+            {
+                STMR_Timers[Local_u8Count].Callback = Copy_pfCallback;
+                STMR_Timers[Local_u8Count].Delivery = Copy_u8Delivery;
+                STMR_Timers[Local_u8Count].Running = 0;
+                STMR_Timers[Local_u8Count].Pending = 0;
+                *Copy_pu8TimerId = Local_u8Count;
+                Local_u8ErrorStatus = 0;
+            }
+        }
+    }
+    return Local_u8ErrorStatus;
+}
+
+u8 STMR_u8StartTimer(u8 Copy_u8TimerId, u32 Copy_u32DelayUs, u32 Copy_u32PeriodUs)
+{
+    return STMR_u8StartTimerAt(Copy_u8TimerId, STMR_u32GetTimeUs() + Copy_u32DelayUs, Copy_u32PeriodUs);
+}
+
+u8 STMR_u8StartTimerAt(u8 Copy_u8TimerId, u32 Copy_u32ExpiryUs, u32 Copy_u32PeriodUs)
+{
+    u8 Local_u8ErrorStatus = 1;
+    if((Copy_u8TimerId < STMR_NUMBER_TIMERS) && (STMR_Timers[Copy_u8TimerId].Callback != NULL))
+    {
+        u8 Local_u8OldHead = STMR_u8Head;
+        STMR_voidRemove(Copy_u8TimerId);
+        STMR_Timers[Copy_u8TimerId].ExpiryUs = Copy_u32ExpiryUs;
+        STMR_Timers[Copy_u8TimerId].PeriodUs = Copy_u32PeriodUs;
+        STMR_voidInsert(Copy_u8TimerId);
+        /**< Only a new first expiry changes the interval SysTick must run */
+        if((STMR_u8Head != Local_u8OldHead) || (STMR_u8Head == Copy_u8TimerId))
+        {
+            STMR_voidProgram();
+        }
+        Local_u8ErrorStatus = 0;
+    }
+    return Local_u8ErrorStatus;
+}
+
+u8 STMR_u8StopTimer(u8 Copy_u8TimerId)
+{
+    u8 Local_u8ErrorStatus = 1;
+    if((Copy_u8TimerId < STMR_NUMBER_TIMERS) && (STMR_Timers[Copy_u8TimerId].Callback != NULL))
+    {
+        u8 Local_u8OldHead = STMR_u8Head;
+        STMR_voidRemove(Copy_u8TimerId);
+        if(STMR_u8Head != Local_u8OldHead)
+        {
+            STMR_voidProgram();
+        }
+        Local_u8ErrorStatus = 0;
+    }
+    return Local_u8ErrorStatus;
+}
+
+u32 STMR_u32GetTimeUs(void)
+{
+    u32 Local_u32TimeUs = STMR_u32BaseUs;
+    if(STMR_u32IntervalUs != 0)
+    {
+        Local_u32TimeUs += STMR_ELAPSED_COUNTS() / MSTK_u32GetCountsPerUs();
+    }
+    /**< Read between the end of an interval and its interrupt, the counter has started again on the old base */
+    if((s32)(Local_u32TimeUs - STMR_u32LastTimeUs) < 0)
+    {
+        Local_u32TimeUs = STMR_u32LastTimeUs;
+    }
+    STMR_u32LastTimeUs = Local_u32TimeUs;
+    return Local_u32TimeUs;
+}
+
+void STMR_voidRunDeferred(void)
+{
+    for(u8 Local_u8Count = 0; Local_u8Count < STMR_NUMBER_TIMERS; Local_u8Count++)
+    {
+        if(STMR_Timers[Local_u8Count].Pending == 1)
+        {
+            STMR_Timers[Local_u8Count].Pending = 0;
+            STMR_Timers[Local_u8Count].Callback();
+        }
+    }
+}
+
+void STMR_voidSetDeferredNotify(void (*Copy_pfNotify)(void))
+{
+    STMR_pfDeferredNotify = Copy_pfNotify;
+}
+
+static void STMR_voidOnInterrupt(void)
+{
+    STMR_u8InHandler = 1;
+    /**< The driver latches the count flag across its reads of CTRL and drops it when SysTick is reset,
+     *   so an interrupt left pending by an interval that was restarted since does not end the running one */
+    if(MSTK_u8ReadCountFlag() == 1)
+    {
+        STMR_u32BaseUs += STMR_u32IntervalUs;
+    }
+    STMR_voidRestart(STMR_MAX_INTERVAL_US);
+
+    /**< Deliver the timers expired by now; a periodic timer goes back in the list first, so its callback can stop it */
+    u32 Local_u32NowUs = STMR_u32GetTimeUs();
+    while((STMR_u8Head != STMR_NO_TIMER) && ((s32)(STMR_Timers[STMR_u8Head].ExpiryUs - Local_u32NowUs) <= 0))
+    {
+        u8 Local_u8TimerId = STMR_u8Head;
+        STMR_Timer_t* Local_psTimer = &STMR_Timers[Local_u8TimerId];
+        STMR_voidRemove(Local_u8TimerId);
+        if(Local_psTimer->PeriodUs != 0)
+        {
+            /**< Periods missed while the interrupt was held off are skipped, not delivered in a burst */
+            do
+            {
+                Local_psTimer->ExpiryUs += Local_psTimer->PeriodUs;
+            } while((s32)(Local_psTimer->ExpiryUs - Local_u32NowUs) <= 0);
+            STMR_voidInsert(Local_u8TimerId);
+        }
+
+        if(Local_psTimer->Delivery == STMR_DELIVER_ISR)
+        {
+            Local_psTimer->Callback();
+        }
+        else
+        {
+            Local_psTimer->Pending = 1;
+            if(STMR_pfDeferredNotify != NULL)
+            {
+                STMR_pfDeferredNotify();
+            }
+        }
+    }
+
+    STMR_u8InHandler = 0;
+    STMR_voidProgram();
+}
+
+static void STMR_voidRestart(u32 Copy_u32IntervalUs)
+{
+    if(STMR_u32IntervalUs != 0)
+    {
+        STMR_u32BaseUs += STMR_ELAPSED_COUNTS() / MSTK_u32GetCountsPerUs();
+    }
+    MSTK_voidReset();
+    STMR_u32IntervalUs = Copy_u32IntervalUs;
+    if(Copy_u32IntervalUs != 0)
+    {
+        /**< Periodic: the counter reloads by itself at the end of the interval and no time is lost until the interrupt */
+        MSTK_voidSetIntervalPeriodic(Copy_u32IntervalUs, STMR_voidOnInterrupt);
+    }
+}
+
+static void STMR_voidProgram(void)
+{
+    if((STMR_u8InHandler == 0) && (STMR_u8Initialized == 1))
+    {
+        u32 Local_u32IntervalUs = 0;
+        if(STMR_u8Head != STMR_NO_TIMER)
+        {
+            s32 Local_s32RemainingUs = (s32)(STMR_Timers[STMR_u8Head].ExpiryUs - STMR_u32GetTimeUs());
+            if(Local_s32RemainingUs < STMR_MIN_INTERVAL_US)
+            {
+                Local_u32IntervalUs = STMR_MIN_INTERVAL_US;
+            }
+            else if(Local_s32RemainingUs > (s32)STMR_MAX_INTERVAL_US)
+            {
+                /**< Too far for one interval: SysTick wakes up on the way */
+                Local_u32IntervalUs = STMR_MAX_INTERVAL_US;
+            }
+            else
+            {
+                Local_u32IntervalUs = (u32)Local_s32RemainingUs;
+            }
+        }
+        STMR_voidRestart(Local_u32IntervalUs);
+    }
+}
+
+static void STMR_voidInsert(u8 Copy_u8TimerId)
+{
+    u8* Local_pu8Link = &STMR_u8Head;
+
+    /**< Pass the timers expiring earlier or at the same time, so timers due together expire in the order they were started */
+    while((*Local_pu8Link != STMR_NO_TIMER)
+        && ((s32)(STMR_Timers[*Local_pu8Link].ExpiryUs - STMR_Timers[Copy_u8TimerId].ExpiryUs) <= 0))
+    {
+        Local_pu8Link = &STMR_Timers[*Local_pu8Link].Next;
+    }
+    STMR_Timers[Copy_u8TimerId].Next = *Local_pu8Link;
+    STMR_Timers[Copy_u8TimerId].Running = 1;
+    *Local_pu8Link = Copy_u8TimerId;
+}
+
+static void STMR_voidRemove(u8 Copy_u8TimerId)
+{
+    if(STMR_Timers[Copy_u8TimerId].Running == 1)
+    {
+        u8* Local_pu8Link = &STMR_u8Head;
+        while(*Local_pu8Link != Copy_u8TimerId)
+        {
+            Local_pu8Link = &STMR_Timers[*Local_pu8Link].Next;
+        }
+        *Local_pu8Link = STMR_Timers[Copy_u8TimerId].Next;
+        STMR_Timers[Copy_u8TimerId].Running = 0;
+    }
+}
@@ -0,0 +1,40 @@
+/**
+ * @file SIM_config.h
+ * @brief This file contains the configuration options for the host simulation port.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#ifndef __SIM_CONFIG_H__
+#define __SIM_CONFIG_H__
+
+
+/**
+ * @brief Host time, in microseconds, between two updates of the simulated SysTick while code runs.
+ *
+ * While the simulated CPU executes, the port thread interrupts it at this rate to count the
+ * SysTick down, so busy waits end and SysTick can preempt running code. Idle time is skipped
+ * exactly and does not depend on this step.
+ */
+#define PSIM_STEP_US                100
+
+/**
+ * @brief The length of an SOS tick in microseconds, SOS_TICK_TIME.
+ *
+ * The ideal release times of the measured tasks are computed in these ticks.
+ */
+#define PSIM_SOS_TICK_US            1000
+
+/**
+ * @brief The largest number of tasks whose timing is measured.
+ *
+ * Each measured task runs through a dispatch function of its own, so this is limited to 8.
+ * It must not be less than SOS_NUMBER_OS_TASKS.
+ */
+#define PSIM_MAX_TASKS              8
+
+
+
+
+#endif /**< __SIM_CONFIG_H__ */
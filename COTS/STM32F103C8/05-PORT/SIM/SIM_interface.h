@@ -0,0 +1,179 @@
+/**
+ * @file SIM_interface.h
+ * @brief This file contains the public interface of the host simulation port.
+ *
+ * The port runs the STK driver, the TMR timer service and the SOS scheduler unchanged in a Linux
+ * process, to benchmark and tune task periods without a board. The STK driver is built with -DSTK_PORT=STK_PORT_HOST, so its
+ * register block is a variable of this port, which counts it down on a virtual clock and calls
+ * SysTick_Handler() when it reaches zero.
+ *
+ * The virtual clock follows the CPU time of the thread that called PSIM_u8Init(), the simulated
+ * CPU, multiplied by a slowdown factor that models an MCU slower than the PC. When the CPU waits
+ * in PSIM_voidRun(), the clock jumps straight to the next SysTick interrupt, so the idle time
+ * costs nothing and a run is as fast as the tasks allow. While the CPU executes, a port thread
+ * interrupts it with SIGALRM every PSIM_STEP_US to count the SysTick down, so busy waits end and
+ * a pending SysTick preempts the running code, as on the target.
+ *
+ * Tasks created through PSIM_u8CreateTask() are timed: each run is compared to the interrupt that
+ * released it and to its ideal release time, counted in SOS ticks from PSIM_voidStartScheduler(),
+ * which gives the release latency, the drift, the jitter of the interval between runs and the runs
+ * that overran their period.
+ *
+ * @code
+ * PSIM_u8Init(10.0f);                              // model a CPU ten times slower than the PC
+ * PSIM_u8CreateTask(0, 8, PhysicsTask, 0);         // every 8 ticks (ms)
+ * PSIM_u8CreateTask(1, 33, RenderTask, 1);
+ * PSIM_voidStartScheduler();
+ * PSIM_voidRun(10000);                             // ten seconds of simulated time
+ * PSIM_u8GetTaskStats(0, &Stats);
+ * PSIM_voidDeinit();
+ * @endcode
+ *
+ * The STD_TYPES, OS config and OS headers must be included before this header.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#ifndef __SIM_INTERFACE_H__
+#define __SIM_INTERFACE_H__
+
+
+/**
+ * @brief Timing of the runs of a measured task.
+ *
+ * The release latency of a run is the time from the SysTick interrupt that released it to its
+ * start. The drift is the difference between that interrupt and the ideal release, a whole number
+ * of ticks from the start; it grows with the time lost each time SysTick is reprogrammed. The
+ * jitter is the difference between the time from one start to the next and the periodicity.
+ */
+typedef struct
+{
+    u32 Releases;               /**< Counter: runs of the task. */
+    u32 Overruns;               /**< Counter: runs that ended more than a period after the interrupt that released them. */
+    u64 TotalLatencyUs;         /**< Sum of the release latencies, in microseconds. */
+    u32 MaxLatencyUs;           /**< Largest release latency, in microseconds. */
+    u32 MaxDriftUs;             /**< Largest drift, in microseconds. */
+    u32 MaxJitterUs;            /**< Largest jitter, in microseconds. */
+    u64 TotalExecutionUs;       /**< Sum of the execution times, in microseconds. */
+    u32 MaxExecutionUs;         /**< Largest execution time, in microseconds. */
+} PSIM_TaskStats_t;
+
+
+/**
+ * @brief Initializes the simulated SysTick and starts the port thread.
+ *
+ * The calling thread becomes the simulated CPU: every other function of the port, and the STK and
+ * SOS functions, must be called from it.
+ *
+ * @param[in]  Copy_f32Slowdown     Simulated time per CPU time of the host, 1 for a CPU as fast as the PC.
+ *
+ * @retval     0                    The port is running.
+ * @retval     1                    The slowdown is not positive, or the signal or the thread could not be set up.
+ */
+u8 PSIM_u8Init(f32 Copy_f32Slowdown);
+
+/**
+ * @brief Stops the port thread and restores the SIGALRM handler.
+ *
+ * @param[in]  None
+ *
+ * @retval     None
+ */
+void PSIM_voidDeinit(void);
+
+/**
+ * @brief Creates an SOS task whose runs are timed.
+ *
+ * The task is created with SOS_u8CreateTask() with the same arguments and runs through a dispatch
+ * function of the port that timestamps it. A task created after PSIM_voidStartScheduler() has its
+ * ideal releases counted from the time it is created.
+ *
+ * @param[in]  Copy_u8TaskPriority      The priority of the task, below PSIM_MAX_TASKS.
+ * @param[in]  Copy_u32TaskPeriodicity  The periodicity of the task in ticks, 0 to run it once.
+ * @param[in]  Copy_pfTask              A pointer to the function that implements the task.
+ * @param[in]  Copy_u32FirstDelay       The ticks until the first run of the task.
+ *
+ * @retval     0                        The task was created successfully.
+ * @retval     1                        An error occurred while creating the task.
+ */
+u8 PSIM_u8CreateTask(u8 Copy_u8TaskPriority, u32 Copy_u32TaskPeriodicity, void (*Copy_pfTask)(void), u32 Copy_u32FirstDelay);
+
+/**
+ * @brief Starts the SOS scheduler and the ideal releases of the measured tasks.
+ *
+ * @param[in]  None
+ *
+ * @retval     None
+ */
+void PSIM_voidStartScheduler(void);
+
+/**
+ * @brief Lets the simulated CPU wait for interrupts, running the due tasks, for a simulated time.
+ *
+ * This is the idle loop of the target (WFI), run for a bounded time.
+ *
+ * @param[in]  Copy_u32Milliseconds     The simulated time to run.
+ *
+ * @retval     None
+ */
+void PSIM_voidRun(u32 Copy_u32Milliseconds);
+
+/**
+ * @brief Gets the simulated time since PSIM_u8Init().
+ *
+ * @param[in]  None
+ *
+ * @retval     The simulated time in microseconds.
+ */
+u64 PSIM_u64GetTimeUs(void);
+
+/**
+ * @brief Gets the SysTick counts elapsed in the current interval, with the simulated SysTick brought up to date.
+ *
+ * The registers are otherwise only counted down every PSIM_STEP_US. The TMR timer service, which
+ * SOS wakes up and times its tasks with, reads the time with this function when it is built with
+ * -DSTMR_ELAPSED_COUNTS=PSIM_u32GetElapsedCounts.
+ *
+ * @param[in]  None
+ *
+ * @retval     The value MSTK_u32GetElapsedCounts() returns after the update.
+ */
+u32 PSIM_u32GetElapsedCounts(void);
+
+/**
+ * @brief Reads the CTRL register of the simulated SysTick and clears its COUNTFLAG.
+ *
+ * A read of the Cortex-M SysTick CTRL register clears COUNTFLAG. The STK driver reads CTRL with this
+ * function on the host port, so it loses the flag to its own reads as it does on the target.
+ *
+ * @param[in]  None
+ *
+ * @retval     The value of CTRL before COUNTFLAG was cleared.
+ */
+u32 PSIM_u32ReadCtrl(void);
+
+/**
+ * @brief Gets the number of SysTick interrupts taken since PSIM_u8Init(), the wakeups of the CPU.
+ *
+ * @param[in]  None
+ *
+ * @retval     The number of interrupts.
+ */
+u32 PSIM_u32GetInterruptCount(void);
+
+/**
+ * @brief Gets the timing of a measured task.
+ *
+ * @param[in]  Copy_u8TaskPriority      The priority of the task.
+ * @param[out] Copy_psStats             Receives the timing of the task.
+ *
+ * @retval     0                        The timing was copied.
+ * @retval     1                        The priority is not below PSIM_MAX_TASKS or the pointer is NULL.
+ */
+u8 PSIM_u8GetTaskStats(u8 Copy_u8TaskPriority, PSIM_TaskStats_t* Copy_psStats);
+
+
+
+
+#endif /**< __SIM_INTERFACE_H__ */
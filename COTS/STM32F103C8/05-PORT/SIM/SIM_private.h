@@ -0,0 +1,186 @@
+/**
+ * @file SIM_private.h
+ * @brief This file contains the private interface of the host simulation port.
+ *
+ * This file should not be included directly by application code.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#ifndef __SIM_PRIVATE_H__
+#define __SIM_PRIVATE_H__
+
+
+#if (PSIM_MAX_TASKS > 8) || (PSIM_MAX_TASKS < SOS_NUMBER_OS_TASKS)
+    #error "WRONG CHOICE FOR PSIM_MAX_TASKS"
+#endif
+
+#define PSIM_STK_MAX_COUNT          0x00FFFFFF      /**< The SysTick counter has 24 bits. */
+
+/**
+ * @brief A measured task: what SOS runs through its dispatch function, and its timing.
+ */
+typedef struct {
+    void (*Task)(void);             /**< The function that implements the task. */
+    u32 Periodicity;                /**< The periodicity of the task in ticks, 0 for a task that runs once. */
+    u32 FirstDelay;                 /**< The ticks until the first run of the task. */
+    u64 BaseCounts;                 /**< Simulated time the releases are counted from, in SysTick counts. */
+    u64 LastStartCounts;            /**< Simulated time the last run started, in SysTick counts. */
+    PSIM_TaskStats_t Stats;         /**< The timing of the runs so far. */
+}PSIM_Task_t;
+
+/**
+ * @brief The simulated time in SysTick counts, and the fraction of a count not yet added.
+ */
+static u64 PSIM_u64Counts = 0;
+static f64 PSIM_f64CountFraction = 0.0;
+
+/**
+ * @brief CPU time of the simulated CPU thread at the last update, in nanoseconds.
+ */
+static u64 PSIM_u64HostNs = 0;
+
+/**
+ * @brief Simulated time per CPU time of the host.
+ */
+static f32 PSIM_f32Slowdown = 1.0f;
+
+/**
+ * @brief The STK registers as the last update left them, to tell the writes of the driver apart.
+ */
+static u32 PSIM_u32ShadowCtrl = 0;
+static u32 PSIM_u32ShadowLoad = 0;
+static u32 PSIM_u32ShadowVal = 0;
+
+/**
+ * @brief 1 while the SysTick exception is pending, 1 while its handler runs.
+ *
+ * They are written by the SIGALRM handler as well as by the CPU thread.
+ */
+static volatile u8 PSIM_u8Pending = 0;
+static volatile u8 PSIM_u8InHandler = 0;
+
+/**
+ * @brief The simulated time the last SysTick interrupt was taken at, in SysTick counts.
+ */
+static u64 PSIM_u64InterruptCounts = 0;
+
+/**
+ * @brief Counter: SysTick interrupts taken.
+ */
+static u32 PSIM_u32Interrupts = 0;
+
+/**
+ * @brief The simulated CPU, the port thread and whether the port thread keeps running.
+ */
+static pthread_t PSIM_sCpuThread;
+static pthread_t PSIM_sClockThread;
+static volatile u8 PSIM_u8Running = 0;
+
+/**
+ * @brief The SIGALRM action in place before PSIM_u8Init().
+ */
+static struct sigaction PSIM_sOldAction;
+
+/**
+ * @brief The measured tasks, indexed by priority.
+ */
+static PSIM_Task_t PSIM_Tasks[PSIM_MAX_TASKS];
+
+
+/**
+ * @brief The SysTick exception handler of the STK driver.
+ */
+void SysTick_Handler(void);
+
+/**
+ * @brief Reads the CPU time of the calling thread.
+ *
+ * @retval     The CPU time in nanoseconds.
+ */
+static u64 PSIM_u64ReadHostNs(void);
+
+/**
+ * @brief Advances the simulated time by the CPU time used since the last update and counts the SysTick down.
+ *
+ * It must be called with SIGALRM blocked or from the SIGALRM handler.
+ *
+ * @retval     None
+ */
+static void PSIM_voidUpdate(void);
+
+/**
+ * @brief Calls PSIM_voidUpdate() with SIGALRM blocked.
+ *
+ * @retval     None
+ */
+static void PSIM_voidUpdateNow(void);
+
+/**
+ * @brief Counts the SysTick down as the hardware would, setting COUNTFLAG and the pending exception.
+ *
+ * @param[in]  Copy_u64Counts       The SysTick counts that elapsed.
+ *
+ * @retval     None
+ */
+static void PSIM_voidCount(u64 Copy_u64Counts);
+
+/**
+ * @brief Runs SysTick_Handler() as the exception would, letting the SysTick count on meanwhile.
+ *
+ * It must be called with SIGALRM blocked or from the SIGALRM handler.
+ *
+ * @retval     None
+ */
+static void PSIM_voidTakeInterrupt(void);
+
+/**
+ * @brief The SIGALRM handler: updates the SysTick and takes its exception if pending.
+ *
+ * @param[in]  Copy_s32Signal       The signal number.
+ *
+ * @retval     None
+ */
+static void PSIM_voidOnStep(int Copy_s32Signal);
+
+/**
+ * @brief The port thread: sends SIGALRM to the simulated CPU every PSIM_STEP_US.
+ *
+ * @param[in]  Copy_pvArgument      Unused.
+ *
+ * @retval     NULL
+ */
+static void* PSIM_pvClockThread(void* Copy_pvArgument);
+
+/**
+ * @brief Runs a measured task and records its timing.
+ *
+ * @param[in]  Copy_u8TaskPriority  The priority of the task.
+ *
+ * @retval     None
+ */
+static void PSIM_voidRunTask(u8 Copy_u8TaskPriority);
+
+/**
+ * @brief The dispatch function SOS runs for the measured task of each priority.
+ */
+static void PSIM_voidDispatch0(void);
+static void PSIM_voidDispatch1(void);
+static void PSIM_voidDispatch2(void);
+static void PSIM_voidDispatch3(void);
+static void PSIM_voidDispatch4(void);
+static void PSIM_voidDispatch5(void);
+static void PSIM_voidDispatch6(void);
+static void PSIM_voidDispatch7(void);
+
+static void (* const PSIM_apfDispatch[8])(void) =
+{
+    PSIM_voidDispatch0, PSIM_voidDispatch1, PSIM_voidDispatch2, PSIM_voidDispatch3,
+    PSIM_voidDispatch4, PSIM_voidDispatch5, PSIM_voidDispatch6, PSIM_voidDispatch7
+};
+
+
+
+
+#endif /**< __SIM_PRIVATE_H__ */
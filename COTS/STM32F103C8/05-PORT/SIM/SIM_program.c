@@ -0,0 +1,428 @@
+/**
+ * @file SIM_program.c
+ * @brief This file contains the implementation of the host simulation port.
+ *
+ * @date 16 Oct 2026
+ * @version V01
+ *
+ */
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+/**< LIB */
+#include "STD_TYPES.h"
+/**< MCAL */
+#include "STK_interface.h"
+#include "STK_config.h"
+#include "STK_private.h"
+/**< SERVICES */
+#include "OS_config.h"
+#include "OS_interface.h"
+/**< PORT */
+#include "SIM_config.h"
+#include "SIM_interface.h"
+#include "SIM_private.h"
+
+#if STK_PORT != STK_PORT_HOST
+    #error "The STK driver must be built with STK_PORT set to STK_PORT_HOST"
+#endif
+
+/**< The STK register block of the host build */
+STK_RegDef_t PSIM_sSTK;
+
+
+/****************************************< FUNCTIONS IMPLEMENTATION ****************************************/
+u8 PSIM_u8Init(f32 Copy_f32Slowdown)
+{
+    u8 Local_u8ErrorStatus = 1;
+    if(Copy_f32Slowdown > 0.0f)
+    {
+        memset(&PSIM_sSTK, 0, sizeof(PSIM_sSTK));
+        memset(PSIM_Tasks, 0, sizeof(PSIM_Tasks));
+        PSIM_u64Counts = 0;
+        PSIM_f64CountFraction = 0.0;
+        PSIM_f32Slowdown = Copy_f32Slowdown;
+        PSIM_u32ShadowCtrl = 0;
+        PSIM_u32ShadowLoad = 0;
+        PSIM_u32ShadowVal = 0;
+        PSIM_u8Pending = 0;
+        PSIM_u8InHandler = 0;
+        PSIM_u32Interrupts = 0;
+        PSIM_sCpuThread = pthread_self();
+        PSIM_u64HostNs = PSIM_u64ReadHostNs();
+
+        struct sigaction Local_sAction;
+        memset(&Local_sAction, 0, sizeof(Local_sAction));
+        Local_sAction.sa_handler = PSIM_voidOnStep;
+        Local_sAction.sa_flags = SA_RESTART;
+        sigemptyset(&Local_sAction.sa_mask);
+        if(sigaction(SIGALRM, &Local_sAction, &PSIM_sOldAction) == 0)
+        {
+            PSIM_u8Running = 1;
+            if(pthread_create(&PSIM_sClockThread, NULL, PSIM_pvClockThread, NULL) == 0)
+            {
+                Local_u8ErrorStatus = 0;
+            }
+            else
+            {
+                PSIM_u8Running = 0;
+                sigaction(SIGALRM, &PSIM_sOldAction, NULL);
+            }
+        }
+    }
+    return Local_u8ErrorStatus;
+}
+
+void PSIM_voidDeinit(void)
+{
+    if(PSIM_u8Running == 1)
+    {
+        PSIM_u8Running = 0;
+        pthread_join(PSIM_sClockThread, NULL);
+        sigaction(SIGALRM, &PSIM_sOldAction, NULL);
+    }
+}
+
+u8 PSIM_u8CreateTask(u8 Copy_u8TaskPriority, u32 Copy_u32TaskPeriodicity, void (*Copy_pfTask)(void), u32 Copy_u32FirstDelay)
+{
+    u8 Local_u8ErrorStatus = 1;
+    if((Copy_pfTask != NULL) && (Copy_u8TaskPriority < PSIM_MAX_TASKS))
+    {
+        sigset_t Local_sBlocked;
+        sigset_t Local_sOldMask;
+        sigemptyset(&Local_sBlocked);
+        sigaddset(&Local_sBlocked, SIGALRM);
+        pthread_sigmask(SIG_BLOCK, &Local_sBlocked, &Local_sOldMask);
+        PSIM_voidUpdate();
+
+        PSIM_Task_t* Local_psTask = &PSIM_Tasks[Copy_u8TaskPriority];
+        memset(Local_psTask, 0, sizeof(*Local_psTask));
+        Local_psTask->Task = Copy_pfTask;
+        Local_psTask->Periodicity = Copy_u32TaskPeriodicity;
+        Local_psTask->FirstDelay = Copy_u32FirstDelay;
+        /**< SOS counts the delay of a task created by a task from the tick that task was released on */
+        if(PSIM_u8InHandler == 1)
+        {
+            Local_psTask->BaseCounts = PSIM_u64InterruptCounts;
+        }
+        else
+        {
+            Local_psTask->BaseCounts = PSIM_u64Counts;
+        }
+        Local_u8ErrorStatus = SOS_u8CreateTask(Copy_u8TaskPriority, Copy_u32TaskPeriodicity, PSIM_apfDispatch[Copy_u8TaskPriority], Copy_u32FirstDelay);
+
+        pthread_sigmask(SIG_SETMASK, &Local_sOldMask, NULL);
+    }
+    return Local_u8ErrorStatus;
+}
+
+void PSIM_voidStartScheduler(void)
+{
+    sigset_t Local_sBlocked;
+    sigset_t Local_sOldMask;
+    sigemptyset(&Local_sBlocked);
+    sigaddset(&Local_sBlocked, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &Local_sBlocked, &Local_sOldMask);
+    PSIM_voidUpdate();
+
+    for(u8 Local_u8Count = 0; Local_u8Count < PSIM_MAX_TASKS; Local_u8Count++)
+    {
+        PSIM_Tasks[Local_u8Count].BaseCounts = PSIM_u64Counts;
+    }
+    SOS_voidStart();
+
+    pthread_sigmask(SIG_SETMASK, &Local_sOldMask, NULL);
+}
+
+void PSIM_voidRun(u32 Copy_u32Milliseconds)
+{
+    sigset_t Local_sBlocked;
+    sigset_t Local_sOldMask;
+    sigemptyset(&Local_sBlocked);
+    sigaddset(&Local_sBlocked, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &Local_sBlocked, &Local_sOldMask);
+    PSIM_voidUpdate();
+
+    u64 Local_u64EndCounts = PSIM_u64Counts + (u64)Copy_u32Milliseconds * 1000 * STK_COUNTS_PER_US;
+    while(PSIM_u64Counts < Local_u64EndCounts)
+    {
+        if(PSIM_u8Pending == 1)
+        {
+            PSIM_voidTakeInterrupt();
+        }
+        else
+        {
+            /**< Sleep until SysTick interrupts, or until the end of the run: the idle time is skipped */
+            u64 Local_u64Jump = Local_u64EndCounts - PSIM_u64Counts;
+            if(((PSIM_sSTK.CTRL & STK_CTRL_ENABLE_MASK) != 0) && ((PSIM_sSTK.CTRL & STK_CTRL_TICKINT_MASK) != 0))
+            {
+                u64 Local_u64ToInterrupt = (PSIM_sSTK.VAL != 0) ? PSIM_sSTK.VAL : (u64)(PSIM_sSTK.LOAD & PSIM_STK_MAX_COUNT) + 1;
+                if((PSIM_sSTK.VAL != 0 || PSIM_sSTK.LOAD != 0) && (Local_u64ToInterrupt < Local_u64Jump))
+                {
+                    Local_u64Jump = Local_u64ToInterrupt;
+                }
+            }
+            PSIM_u64Counts += Local_u64Jump;
+            PSIM_voidCount(Local_u64Jump);
+        }
+        PSIM_voidUpdate();
+    }
+
+    pthread_sigmask(SIG_SETMASK, &Local_sOldMask, NULL);
+}
+
+u64 PSIM_u64GetTimeUs(void)
+{
+    PSIM_voidUpdateNow();
+    return PSIM_u64Counts / STK_COUNTS_PER_US;
+}
+
+u32 PSIM_u32GetElapsedCounts(void)
+{
+    PSIM_voidUpdateNow();
+    return MSTK_u32GetElapsedCounts();
+}
+
+u32 PSIM_u32ReadCtrl(void)
+{
+    /**< One atomic read and clear: the SIGALRM handler can set the flag at any point, and blocking it
+     *   would cost two system calls on every CTRL read, simulated CPU time the driver does not spend */
+    return __atomic_fetch_and(&PSIM_sSTK.CTRL, ~(u32)STK_CTRL_COUNTFLAG_MASK, __ATOMIC_SEQ_CST);
+}
+
+u32 PSIM_u32GetInterruptCount(void)
+{
+    return PSIM_u32Interrupts;
+}
+
+u8 PSIM_u8GetTaskStats(u8 Copy_u8TaskPriority, PSIM_TaskStats_t* Copy_psStats)
+{
+    u8 Local_u8ErrorStatus = 1;
+    if((Copy_psStats != NULL) && (Copy_u8TaskPriority < PSIM_MAX_TASKS))
+    {
+        *Copy_psStats = PSIM_Tasks[Copy_u8TaskPriority].Stats;
+        Local_u8ErrorStatus = 0;
+    }
+    return Local_u8ErrorStatus;
+}
+
+static u64 PSIM_u64ReadHostNs(void)
+{
+    struct timespec Local_sTime;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Local_sTime);
+    return (u64)Local_sTime.tv_sec * 1000000000u + (u64)Local_sTime.tv_nsec;
+}
+
+static void PSIM_voidUpdate(void)
+{
+    u64 Local_u64HostNs = PSIM_u64ReadHostNs();
+    f64 Local_f64Counts = (f64)(Local_u64HostNs - PSIM_u64HostNs) * PSIM_f32Slowdown * STK_COUNTS_PER_US / 1000.0 + PSIM_f64CountFraction;
+    u64 Local_u64Counts = (u64)Local_f64Counts;
+    PSIM_f64CountFraction = Local_f64Counts - (f64)Local_u64Counts;
+    PSIM_u64HostNs = Local_u64HostNs;
+    PSIM_u64Counts += Local_u64Counts;
+
+    /**< The driver reprogrammed SysTick since the last update: it counts from the new values from now */
+    if((PSIM_sSTK.VAL != PSIM_u32ShadowVal) || (PSIM_sSTK.LOAD != PSIM_u32ShadowLoad)
+        || ((PSIM_sSTK.CTRL & STK_CTRL_ENABLE_MASK) != (PSIM_u32ShadowCtrl & STK_CTRL_ENABLE_MASK)))
+    {
+        Local_u64Counts = 0;
+    }
+    PSIM_voidCount(Local_u64Counts);
+}
+
+static void PSIM_voidUpdateNow(void)
+{
+    sigset_t Local_sBlocked;
+    sigset_t Local_sOldMask;
+    sigemptyset(&Local_sBlocked);
+    sigaddset(&Local_sBlocked, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &Local_sBlocked, &Local_sOldMask);
+    PSIM_voidUpdate();
+    pthread_sigmask(SIG_SETMASK, &Local_sOldMask, NULL);
+}
+
+static void PSIM_voidCount(u64 Copy_u64Counts)
+{
+    u8 Local_u8Stopped = 0;
+    while((Copy_u64Counts > 0) && ((PSIM_sSTK.CTRL & STK_CTRL_ENABLE_MASK) != 0) && (Local_u8Stopped == 0))
+    {
+        if(PSIM_sSTK.VAL == 0)
+        {
+            /**< A counter at zero takes the reload value on the next count; a reload value of zero stops it */
+            if(PSIM_sSTK.LOAD == 0)
+            {
+                Local_u8Stopped = 1;
+            }
+            else
+            {
+                PSIM_sSTK.VAL = PSIM_sSTK.LOAD & PSIM_STK_MAX_COUNT;
+                Copy_u64Counts--;
+            }
+        }
+        else if(Copy_u64Counts >= PSIM_sSTK.VAL)
+        {
+            Copy_u64Counts -= PSIM_sSTK.VAL;
+            PSIM_sSTK.VAL = 0;
+            PSIM_sSTK.CTRL |= STK_CTRL_COUNTFLAG_MASK;
+            if((PSIM_sSTK.CTRL & STK_CTRL_TICKINT_MASK) != 0)
+            {
+                PSIM_u8Pending = 1;
+            }
+            /**< Whole periods that passed at once only raise the flags again */
+            Copy_u64Counts %= (u64)(PSIM_sSTK.LOAD & PSIM_STK_MAX_COUNT) + 1;
+        }
+        else
+        {
+            PSIM_sSTK.VAL -= (u32)Copy_u64Counts;
+            Copy_u64Counts = 0;
+        }
+    }
+    PSIM_u32ShadowCtrl = PSIM_sSTK.CTRL;
+    PSIM_u32ShadowLoad = PSIM_sSTK.LOAD;
+    PSIM_u32ShadowVal = PSIM_sSTK.VAL;
+}
+
+static void PSIM_voidTakeInterrupt(void)
+{
+    sigset_t Local_sUnblocked;
+    sigset_t Local_sOldMask;
+    PSIM_u8Pending = 0;
+    PSIM_u8InHandler = 1;
+    PSIM_u64InterruptCounts = PSIM_u64Counts;
+    PSIM_u32Interrupts++;
+
+    /**< The SysTick keeps counting while the handler runs; a SysTick that expires again stays pending until it returns */
+    sigemptyset(&Local_sUnblocked);
+    sigaddset(&Local_sUnblocked, SIGALRM);
+    pthread_sigmask(SIG_UNBLOCK, &Local_sUnblocked, &Local_sOldMask);
+    SysTick_Handler();
+    pthread_sigmask(SIG_SETMASK, &Local_sOldMask, NULL);
+
+    PSIM_u8InHandler = 0;
+    PSIM_voidUpdate();
+}
+
+static void PSIM_voidOnStep(int Copy_s32Signal)
+{
+    (void)Copy_s32Signal;
+    PSIM_voidUpdate();
+    /**< A pending SysTick preempts the code the CPU runs, unless it is the SysTick handler itself */
+    while((PSIM_u8Pending == 1) && (PSIM_u8InHandler == 0))
+    {
+        PSIM_voidTakeInterrupt();
+    }
+}
+
+static void* PSIM_pvClockThread(void* Copy_pvArgument)
+{
+    struct timespec Local_sNext;
+    (void)Copy_pvArgument;
+    clock_gettime(CLOCK_MONOTONIC, &Local_sNext);
+    while(PSIM_u8Running == 1)
+    {
+        Local_sNext.tv_nsec += PSIM_STEP_US * 1000L;
+        if(Local_sNext.tv_nsec >= 1000000000L)
+        {
+            Local_sNext.tv_sec++;
+            Local_sNext.tv_nsec -= 1000000000L;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Local_sNext, NULL);
+        pthread_kill(PSIM_sCpuThread, SIGALRM);
+    }
+    return NULL;
+}
+
+static void PSIM_voidRunTask(u8 Copy_u8TaskPriority)
+{
+    PSIM_Task_t* Local_psTask = &PSIM_Tasks[Copy_u8TaskPriority];
+    const u64 Local_u64TickCounts = (u64)PSIM_SOS_TICK_US * STK_COUNTS_PER_US;
+    const u64 Local_u64PeriodCounts = (u64)Local_psTask->Periodicity * Local_u64TickCounts;
+
+    /**< A first delay of 0 runs the task on the first tick, like a first delay of 1 */
+    u64 Local_u64FirstTicks = (Local_psTask->FirstDelay > 0) ? Local_psTask->FirstDelay : 1;
+    u64 Local_u64ReleaseCounts = Local_psTask->BaseCounts + Local_u64FirstTicks * Local_u64TickCounts
+                               + (u64)Local_psTask->Stats.Releases * Local_u64PeriodCounts;
+
+    PSIM_voidUpdateNow();
+    u64 Local_u64StartCounts = PSIM_u64Counts;
+    Local_psTask->Task();
+    PSIM_voidUpdateNow();
+    u64 Local_u64EndCounts = PSIM_u64Counts;
+
+    PSIM_TaskStats_t* Local_psStats = &Local_psTask->Stats;
+    u32 Local_u32LatencyUs = (u32)((Local_u64StartCounts - PSIM_u64InterruptCounts) / STK_COUNTS_PER_US);
+    Local_psStats->TotalLatencyUs += Local_u32LatencyUs;
+    Local_psStats->MaxLatencyUs = (Local_u32LatencyUs > Local_psStats->MaxLatencyUs) ? Local_u32LatencyUs : Local_psStats->MaxLatencyUs;
+
+    u64 Local_u64DriftCounts = (PSIM_u64InterruptCounts > Local_u64ReleaseCounts) ? (PSIM_u64InterruptCounts - Local_u64ReleaseCounts)
+                                                                                 : (Local_u64ReleaseCounts - PSIM_u64InterruptCounts);
+    u32 Local_u32DriftUs = (u32)(Local_u64DriftCounts / STK_COUNTS_PER_US);
+    Local_psStats->MaxDriftUs = (Local_u32DriftUs > Local_psStats->MaxDriftUs) ? Local_u32DriftUs : Local_psStats->MaxDriftUs;
+
+    if(Local_psStats->Releases > 0)
+    {
+        u64 Local_u64IntervalCounts = Local_u64StartCounts - Local_psTask->LastStartCounts;
+        u64 Local_u64JitterCounts = (Local_u64IntervalCounts > Local_u64PeriodCounts) ? (Local_u64IntervalCounts - Local_u64PeriodCounts)
+                                                                                      : (Local_u64PeriodCounts - Local_u64IntervalCounts);
+        u32 Local_u32JitterUs = (u32)(Local_u64JitterCounts / STK_COUNTS_PER_US);
+        Local_psStats->MaxJitterUs = (Local_u32JitterUs > Local_psStats->MaxJitterUs) ? Local_u32JitterUs : Local_psStats->MaxJitterUs;
+    }
+
+    u32 Local_u32ExecutionUs = (u32)((Local_u64EndCounts - Local_u64StartCounts) / STK_COUNTS_PER_US);
+    Local_psStats->TotalExecutionUs += Local_u32ExecutionUs;
+    Local_psStats->MaxExecutionUs = (Local_u32ExecutionUs > Local_psStats->MaxExecutionUs) ? Local_u32ExecutionUs : Local_psStats->MaxExecutionUs;
+
+    /**< The run overran if it ended a period after the interrupt that released it, when the next release was due */
+    if((Local_psTask->Periodicity != 0) && (Local_u64EndCounts > PSIM_u64InterruptCounts + Local_u64PeriodCounts))
+    {
+        Local_psStats->Overruns++;
+    }
+
+    Local_psStats->Releases++;
+    Local_psTask->LastStartCounts = Local_u64StartCounts;
+}
+
+static void PSIM_voidDispatch0(void)
+{
+    PSIM_voidRunTask(0);
+}
+
+static void PSIM_voidDispatch1(void)
+{
+    PSIM_voidRunTask(1);
+}
+
+static void PSIM_voidDispatch2(void)
+{
+    PSIM_voidRunTask(2);
+}
+
+static void PSIM_voidDispatch3(void)
+{
+    PSIM_voidRunTask(3);
+}
+
+static void PSIM_voidDispatch4(void)
+{
+    PSIM_voidRunTask(4);
+}
+
+static void PSIM_voidDispatch5(void)
+{
+    PSIM_voidRunTask(5);
+}
+
+static void PSIM_voidDispatch6(void)
+{
+    PSIM_voidRunTask(6);
+}
+
+static void PSIM_voidDispatch7(void)
+{
+    PSIM_voidRunTask(7);
+}